@@ -9,6 +9,9 @@ AC_DEFUN([AX_LIBVSHADOW_CHECK_LOCAL],
   dnl Check if library should be build with debug output
   AX_COMMON_CHECK_ENABLE_DEBUG_OUTPUT
 
+  dnl Check if library should be build with USDT probes
+  AX_LIBVSHADOW_CHECK_ENABLE_USDT_PROBES
+
   dnl Check if DLL support is needed
   AS_IF(
     [test "x$enable_shared" = xyes],
@@ -26,11 +29,38 @@ AC_DEFUN([AX_LIBVSHADOW_CHECK_LOCAL],
   ])
 ])
 
+dnl Function to detect if USDT (SystemTap) static probes should be enabled
+AC_DEFUN([AX_LIBVSHADOW_CHECK_ENABLE_USDT_PROBES],
+  [AX_COMMON_ARG_ENABLE(
+    [usdt-probes],
+    [usdt_probes],
+    [enable USDT (SystemTap) static probes],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_usdt_probes" != xno],
+    [AC_CHECK_HEADERS([sys/sdt.h])
+
+    AS_IF(
+      [test "x$ac_cv_header_sys_sdt_h" != xyes],
+      [AC_MSG_FAILURE(
+        [Missing header: sys/sdt.h required for USDT probes],
+        [1])
+    ])
+
+    AC_DEFINE(
+      [HAVE_USDT_PROBES],
+      [1],
+      [Define to 1 if USDT (SystemTap) static probes should be used.])
+
+    ac_cv_enable_usdt_probes=yes])
+])
+
 dnl Function to detect if vshadowtools dependencies are available
 AC_DEFUN([AX_VSHADOWTOOLS_CHECK_LOCAL],
-  [AC_CHECK_HEADERS([signal.h sys/signal.h unistd.h])
+  [AC_CHECK_HEADERS([errno.h fcntl.h linux/fs.h signal.h sys/ioctl.h sys/signal.h sys/socket.h sys/un.h unistd.h])
 
-  AC_CHECK_FUNCS([close getopt setvbuf])
+  AC_CHECK_FUNCS([clock_gettime close copy_file_range getopt gettimeofday nanosleep setvbuf])
 
   AS_IF(
    [test "x$ac_cv_func_close" != xyes],
@@ -0,0 +1,1512 @@
+/*
+ * Block map functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_block_map.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_descriptor.h"
+#include "libvshadow_types.h"
+
+/* Creates a block map
+ * Make sure the value block_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_initialize(
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_initialize";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = memory_allocate_structure(
+	                      libvshadow_internal_block_map_t );
+
+	if( internal_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_block_map,
+	     0,
+	     sizeof( libvshadow_internal_block_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block map.",
+		 function );
+
+		goto on_error;
+	}
+	*block_map = (libvshadow_block_map_t *) internal_block_map;
+
+	return( 1 );
+
+on_error:
+	if( internal_block_map != NULL )
+	{
+		memory_free(
+		 internal_block_map );
+	}
+	return( -1 );
+}
+
+/* Frees a block map
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_free(
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_free";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_map != NULL )
+	{
+		internal_block_map = (libvshadow_internal_block_map_t *) *block_map;
+		*block_map         = NULL;
+
+		if( internal_block_map->physical_blocks != NULL )
+		{
+			memory_free(
+			 internal_block_map->physical_blocks );
+		}
+		if( internal_block_map->mappings != NULL )
+		{
+			memory_free(
+			 internal_block_map->mappings );
+		}
+		memory_free(
+		 internal_block_map );
+	}
+	return( 1 );
+}
+
+/* Compares two offsets
+ * Returns -1 if the first offset is smaller, 0 if equal or 1 if greater
+ */
+int libvshadow_block_map_compare_offsets(
+     const void *first_offset,
+     const void *second_offset )
+{
+	off64_t first_value  = 0;
+	off64_t second_value = 0;
+
+	first_value  = *( (const off64_t *) first_offset );
+	second_value = *( (const off64_t *) second_offset );
+
+	if( first_value == second_value )
+	{
+		return( 0 );
+	}
+	return( ( first_value < second_value ) ? -1 : 1 );
+}
+
+/* Compares two mappings by their (physical) offset, store index and volume offset
+ * Returns -1 if the first mapping is smaller, 0 if equal or 1 if greater
+ */
+int libvshadow_block_map_compare_mappings(
+     const void *first_mapping,
+     const void *second_mapping )
+{
+	const libvshadow_block_mapping_t *first_block_mapping  = NULL;
+	const libvshadow_block_mapping_t *second_block_mapping = NULL;
+
+	first_block_mapping  = (const libvshadow_block_mapping_t *) first_mapping;
+	second_block_mapping = (const libvshadow_block_mapping_t *) second_mapping;
+
+	if( first_block_mapping->offset != second_block_mapping->offset )
+	{
+		return( ( first_block_mapping->offset < second_block_mapping->offset ) ? -1 : 1 );
+	}
+	if( first_block_mapping->store_index != second_block_mapping->store_index )
+	{
+		return( ( first_block_mapping->store_index < second_block_mapping->store_index ) ? -1 : 1 );
+	}
+	if( first_block_mapping->volume_offset != second_block_mapping->volume_offset )
+	{
+		return( ( first_block_mapping->volume_offset < second_block_mapping->volume_offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Appends a mapping
+ * The mapping is merged with the last mapping if it directly follows it
+ * within the same 16 KiB (physical) block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_append_mapping(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     off64_t volume_offset,
+     uint32_t size,
+     uint32_t flags,
+     int store_index,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *last_mapping = NULL;
+	libvshadow_block_mapping_t *mappings     = NULL;
+	static char *function                    = "libvshadow_block_map_append_mapping";
+	int maximum_number_of_mappings           = 0;
+
+	if( internal_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_block_map->number_of_mappings > 0 )
+	{
+		last_mapping = &( internal_block_map->mappings[ internal_block_map->number_of_mappings - 1 ] );
+
+		if( ( last_mapping->store_index == store_index )
+		 && ( last_mapping->flags == flags )
+		 && ( ( last_mapping->offset + last_mapping->size ) == offset )
+		 && ( ( last_mapping->volume_offset + last_mapping->size ) == volume_offset )
+		 && ( ( last_mapping->offset / 0x4000 ) == ( offset / 0x4000 ) ) )
+		{
+			last_mapping->size += size;
+
+			return( 1 );
+		}
+	}
+	if( internal_block_map->number_of_mappings >= internal_block_map->maximum_number_of_mappings )
+	{
+		if( internal_block_map->maximum_number_of_mappings == 0 )
+		{
+			maximum_number_of_mappings = 1024;
+		}
+		else if( internal_block_map->maximum_number_of_mappings <= ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_mappings = internal_block_map->maximum_number_of_mappings * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid block map - number of mappings value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) maximum_number_of_mappings > (size_t) ( SSIZE_MAX / sizeof( libvshadow_block_mapping_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of mappings value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		mappings = (libvshadow_block_mapping_t *) memory_reallocate(
+		                                           internal_block_map->mappings,
+		                                           sizeof( libvshadow_block_mapping_t ) * maximum_number_of_mappings );
+
+		if( mappings == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize mappings.",
+			 function );
+
+			return( -1 );
+		}
+		internal_block_map->mappings                   = mappings;
+		internal_block_map->maximum_number_of_mappings = maximum_number_of_mappings;
+	}
+	last_mapping = &( internal_block_map->mappings[ internal_block_map->number_of_mappings ] );
+
+	last_mapping->offset        = offset;
+	last_mapping->volume_offset = volume_offset;
+	last_mapping->size          = size;
+	last_mapping->flags         = flags;
+	last_mapping->store_index   = store_index;
+
+	internal_block_map->number_of_mappings += 1;
+
+	return( 1 );
+}
+
+/* Reads the block map from the store descriptors
+ * The volume offsets of a store that can differ from the current volume are
+ * the original offsets of the block descriptors of the store and of the next
+ * (more recent) stores in its read chain. These are resolved to extents
+ * through the forwarder and overlay block descriptors, where the sparse
+ * extents and the current volume extents that are not relocated are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_read_store_descriptors(
+     libvshadow_block_map_t *block_map,
+     libcdata_array_t *store_descriptors_array,
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_block_map_t *internal_block_map    = NULL;
+	libvshadow_physical_block_t *physical_block            = NULL;
+	libvshadow_store_descriptor_t *locked_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor        = NULL;
+	off64_t *offsets                                       = NULL;
+	off64_t *reallocated_offsets                           = NULL;
+	uint8_t *block_table                                   = NULL;
+	uint8_t *reallocated_block_table                       = NULL;
+	static char *function                                  = "libvshadow_block_map_read_store_descriptors";
+	size64_t extent_size                                   = 0;
+	size64_t mapping_size                                  = 0;
+	size64_t remaining_size                                = 0;
+	size_t block_table_offset                              = 0;
+	size_t block_table_size                                = 0;
+	size_t maximum_block_table_size                        = 0;
+	size_t maximum_number_of_offsets                       = 0;
+	size_t number_of_offsets                               = 0;
+	size_t offset_index                                    = 0;
+	size_t unique_offset_index                             = 0;
+	uint64_t original_offset                               = 0;
+	uint32_t extent_flags                                  = 0;
+	off64_t block_end_offset                               = 0;
+	off64_t block_offset                                   = 0;
+	off64_t extent_offset                                  = 0;
+	off64_t mapping_end_offset                             = 0;
+	off64_t mapping_offset                                 = 0;
+	off64_t mapping_volume_offset                          = 0;
+	off64_t store_offset                                   = 0;
+	int block_index                                        = 0;
+	int mapping_index                                      = 0;
+	int number_of_blocks                                   = 0;
+	int number_of_physical_blocks                          = 0;
+	int number_of_store_descriptors                        = 0;
+	int result                                             = 0;
+	int store_descriptor_index                             = 0;
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( ( internal_block_map->mappings != NULL )
+	 || ( internal_block_map->physical_blocks != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block map - mappings value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
+		 function );
+
+		goto on_error;
+	}
+	/* The stores are read from the most recent to the oldest so that
+	 * the offsets of the next stores in the read chain are known
+	 */
+	for( store_descriptor_index = number_of_store_descriptors - 1;
+	     store_descriptor_index >= 0;
+	     store_descriptor_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		result = libvshadow_store_descriptor_has_in_volume_data(
+		          store_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if store descriptor: %d has in-volume data.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( libvshadow_store_descriptor_get_number_of_blocks(
+		     store_descriptor,
+		     file_io_handle,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of blocks of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( number_of_blocks > 0 )
+		{
+			if( (size_t) number_of_blocks > (size_t) ( SSIZE_MAX / LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of blocks value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			block_table_size = (size_t) number_of_blocks * LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE;
+
+			if( block_table_size > maximum_block_table_size )
+			{
+				reallocated_block_table = (uint8_t *) memory_reallocate(
+				                                       block_table,
+				                                       sizeof( uint8_t ) * block_table_size );
+
+				if( reallocated_block_table == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize block table.",
+					 function );
+
+					goto on_error;
+				}
+				block_table              = reallocated_block_table;
+				maximum_block_table_size = block_table_size;
+			}
+			if( libvshadow_store_descriptor_get_block_table(
+			     store_descriptor,
+			     file_io_handle,
+			     block_table,
+			     block_table_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block table of store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			if( (size_t) number_of_blocks > ( (size_t) ( SSIZE_MAX / sizeof( off64_t ) ) - number_of_offsets ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of offsets value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( number_of_offsets + (size_t) number_of_blocks ) > maximum_number_of_offsets )
+			{
+				maximum_number_of_offsets = number_of_offsets + (size_t) number_of_blocks;
+
+				reallocated_offsets = (off64_t *) memory_reallocate(
+				                                   offsets,
+				                                   sizeof( off64_t ) * maximum_number_of_offsets );
+
+				if( reallocated_offsets == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize offsets.",
+					 function );
+
+					goto on_error;
+				}
+				offsets = reallocated_offsets;
+			}
+			block_table_offset = 0;
+
+			for( block_index = 0;
+			     block_index < number_of_blocks;
+			     block_index++ )
+			{
+				byte_stream_copy_to_uint64_little_endian(
+				 &( block_table[ block_table_offset ] ),
+				 original_offset );
+
+				block_table_offset += LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE;
+
+				original_offset &= ~( (uint64_t) 0x3fff );
+
+				if( original_offset < volume_size )
+				{
+					offsets[ number_of_offsets++ ] = (off64_t) original_offset;
+				}
+			}
+			if( number_of_offsets > 1 )
+			{
+				qsort(
+				 offsets,
+				 number_of_offsets,
+				 sizeof( off64_t ),
+				 &libvshadow_block_map_compare_offsets );
+
+				/* Remove the duplicate offsets, which are adjacent after sorting
+				 */
+				unique_offset_index = 0;
+
+				for( offset_index = 1;
+				     offset_index < number_of_offsets;
+				     offset_index++ )
+				{
+					if( offsets[ offset_index ] != offsets[ unique_offset_index ] )
+					{
+						unique_offset_index++;
+
+						offsets[ unique_offset_index ] = offsets[ offset_index ];
+					}
+				}
+				number_of_offsets = unique_offset_index + 1;
+			}
+		}
+		/* The block descriptors of the read chain are read and locked once
+		 * per store instead of for every offset
+		 */
+		if( libvshadow_store_descriptor_read_chain_block_descriptors(
+		     store_descriptor,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block descriptors of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_grab_chain_for_read(
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read locks of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		locked_store_descriptor = store_descriptor;
+
+		for( offset_index = 0;
+		     offset_index < number_of_offsets;
+		     offset_index++ )
+		{
+			block_offset     = offsets[ offset_index ];
+			block_end_offset = block_offset + 0x4000;
+
+			if( (size64_t) block_end_offset > volume_size )
+			{
+				block_end_offset = (off64_t) volume_size;
+			}
+			store_offset = block_offset;
+
+			while( store_offset < block_end_offset )
+			{
+				if( libvshadow_store_descriptor_get_chain_extent_at_offset(
+				     store_descriptor,
+				     store_offset,
+				     store_descriptor,
+				     &extent_offset,
+				     &extent_size,
+				     &extent_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve extent at offset: 0x%08" PRIx64 " from store descriptor: %d.",
+					 function,
+					 store_offset,
+					 store_descriptor_index );
+
+					goto on_error;
+				}
+				if( extent_size == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid extent at offset: 0x%08" PRIx64 " from store descriptor: %d - size value out of bounds.",
+					 function,
+					 store_offset,
+					 store_descriptor_index );
+
+					goto on_error;
+				}
+				if( extent_size > (size64_t) ( block_end_offset - store_offset ) )
+				{
+					extent_size = (size64_t) ( block_end_offset - store_offset );
+				}
+				if( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) == 0 )
+				 && ( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) != 0 )
+				  || ( extent_offset != store_offset ) ) )
+				{
+					/* A mapping is split at the 16 KiB (physical) block boundaries
+					 * so that every mapping is contained by a single physical block
+					 */
+					mapping_offset        = extent_offset;
+					mapping_volume_offset = store_offset;
+					remaining_size        = extent_size;
+
+					while( remaining_size > 0 )
+					{
+						mapping_size = (size64_t) ( 0x4000 - ( mapping_offset % 0x4000 ) );
+
+						if( mapping_size > remaining_size )
+						{
+							mapping_size = remaining_size;
+						}
+						if( libvshadow_block_map_append_mapping(
+						     internal_block_map,
+						     mapping_offset,
+						     mapping_volume_offset,
+						     (uint32_t) mapping_size,
+						     extent_flags,
+						     store_descriptor_index,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+							 "%s: unable to append mapping of store descriptor: %d at offset: 0x%08" PRIx64 ".",
+							 function,
+							 store_descriptor_index,
+							 mapping_volume_offset );
+
+							goto on_error;
+						}
+						mapping_offset        += (off64_t) mapping_size;
+						mapping_volume_offset += (off64_t) mapping_size;
+						remaining_size        -= mapping_size;
+					}
+				}
+				store_offset += (off64_t) extent_size;
+			}
+		}
+		locked_store_descriptor = NULL;
+
+		if( libvshadow_store_descriptor_release_chain_for_read(
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read locks of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+
+		offsets = NULL;
+	}
+	if( block_table != NULL )
+	{
+		memory_free(
+		 block_table );
+
+		block_table = NULL;
+	}
+	if( internal_block_map->number_of_mappings > 1 )
+	{
+		qsort(
+		 internal_block_map->mappings,
+		 (size_t) internal_block_map->number_of_mappings,
+		 sizeof( libvshadow_block_mapping_t ),
+		 &libvshadow_block_map_compare_mappings );
+	}
+	/* The mappings are grouped by the 16 KiB (physical) block they are stored in
+	 */
+	for( mapping_index = 0;
+	     mapping_index < internal_block_map->number_of_mappings;
+	     mapping_index++ )
+	{
+		mapping_offset = internal_block_map->mappings[ mapping_index ].offset;
+
+		if( ( mapping_index == 0 )
+		 || ( ( mapping_offset / 0x4000 ) != ( block_offset / 0x4000 ) ) )
+		{
+			block_offset = mapping_offset;
+
+			number_of_physical_blocks++;
+		}
+	}
+	if( number_of_physical_blocks > 0 )
+	{
+		internal_block_map->physical_blocks = (libvshadow_physical_block_t *) memory_allocate(
+		                                                                       sizeof( libvshadow_physical_block_t ) * number_of_physical_blocks );
+
+		if( internal_block_map->physical_blocks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create physical blocks.",
+			 function );
+
+			goto on_error;
+		}
+		for( mapping_index = 0;
+		     mapping_index < internal_block_map->number_of_mappings;
+		     mapping_index++ )
+		{
+			mapping_offset     = internal_block_map->mappings[ mapping_index ].offset;
+			mapping_end_offset = mapping_offset + internal_block_map->mappings[ mapping_index ].size;
+
+			if( ( physical_block == NULL )
+			 || ( ( mapping_offset / 0x4000 ) != ( physical_block->offset / 0x4000 ) ) )
+			{
+				physical_block = &( internal_block_map->physical_blocks[ internal_block_map->number_of_physical_blocks ] );
+
+				physical_block->offset             = mapping_offset;
+				physical_block->mapping_index      = mapping_index;
+				physical_block->number_of_mappings = 0;
+
+				internal_block_map->number_of_physical_blocks += 1;
+
+				block_end_offset = mapping_end_offset;
+			}
+			else if( mapping_end_offset > block_end_offset )
+			{
+				block_end_offset = mapping_end_offset;
+			}
+			physical_block->size                = (size64_t) ( block_end_offset - physical_block->offset );
+			physical_block->number_of_mappings += 1;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( locked_store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_release_chain_for_read(
+		 locked_store_descriptor,
+		 NULL );
+	}
+	if( internal_block_map->physical_blocks != NULL )
+	{
+		memory_free(
+		 internal_block_map->physical_blocks );
+
+		internal_block_map->physical_blocks = NULL;
+	}
+	internal_block_map->number_of_physical_blocks = 0;
+
+	if( internal_block_map->mappings != NULL )
+	{
+		memory_free(
+		 internal_block_map->mappings );
+
+		internal_block_map->mappings = NULL;
+	}
+	internal_block_map->number_of_mappings         = 0;
+	internal_block_map->maximum_number_of_mappings = 0;
+
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	if( block_table != NULL )
+	{
+		memory_free(
+		 block_table );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of physical blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_get_number_of_physical_blocks(
+     libvshadow_block_map_t *block_map,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_get_number_of_physical_blocks";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( number_of_physical_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of physical blocks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_physical_blocks = internal_block_map->number_of_physical_blocks;
+
+	return( 1 );
+}
+
+/* Retrieves a specific physical block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_get_physical_block_by_index(
+     libvshadow_block_map_t *block_map,
+     int physical_block_index,
+     off64_t *offset,
+     size64_t *size,
+     int *number_of_mappings,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	libvshadow_physical_block_t *physical_block         = NULL;
+	static char *function                               = "libvshadow_block_map_get_physical_block_by_index";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( ( physical_block_index < 0 )
+	 || ( physical_block_index >= internal_block_map->number_of_physical_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_mappings == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mappings.",
+		 function );
+
+		return( -1 );
+	}
+	physical_block = &( internal_block_map->physical_blocks[ physical_block_index ] );
+
+	*offset             = physical_block->offset;
+	*size               = physical_block->size;
+	*number_of_mappings = physical_block->number_of_mappings;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the physical block whose range contains a specific offset
+ * The physical blocks are sorted by offset and do not overlap, hence the
+ * physical block is looked up using a binary search
+ * Returns 1 if successful, 0 if no physical block contains the offset or -1 on error
+ */
+int libvshadow_internal_block_map_find_physical_block(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     int *physical_block_index,
+     libcerror_error_t **error )
+{
+	libvshadow_physical_block_t *physical_block = NULL;
+	static char *function                       = "libvshadow_internal_block_map_find_physical_block";
+	int lower_index                             = 0;
+	int middle_index                            = 0;
+	int upper_index                             = 0;
+
+	if( internal_block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the last physical block that starts at or before the offset
+	 */
+	upper_index = internal_block_map->number_of_physical_blocks;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( internal_block_map->physical_blocks[ middle_index ].offset <= offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	if( lower_index == 0 )
+	{
+		return( 0 );
+	}
+	physical_block = &( internal_block_map->physical_blocks[ lower_index - 1 ] );
+
+	if( (size64_t) ( offset - physical_block->offset ) >= physical_block->size )
+	{
+		return( 0 );
+	}
+	*physical_block_index = lower_index - 1;
+
+	return( 1 );
+}
+
+/* Retrieves a specific mapping that contains a specific offset
+ * The mapping index is relative to the mappings that contain the offset and
+ * a negative mapping index only determines the number of these mappings
+ * Returns 1 if successful, 0 if no such mapping exists or -1 on error
+ */
+int libvshadow_internal_block_map_get_mapping_at_offset(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     int mapping_index,
+     int *number_of_mappings,
+     libvshadow_block_mapping_t **mapping,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *block_mapping   = NULL;
+	libvshadow_physical_block_t *physical_block = NULL;
+	static char *function                       = "libvshadow_internal_block_map_get_mapping_at_offset";
+	int block_mapping_index                     = 0;
+	int physical_block_index                    = 0;
+	int result                                  = 0;
+
+	if( number_of_mappings == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mappings.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapping.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_mappings = 0;
+	*mapping            = NULL;
+
+	result = libvshadow_internal_block_map_find_physical_block(
+	          internal_block_map,
+	          offset,
+	          &physical_block_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find physical block at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	physical_block = &( internal_block_map->physical_blocks[ physical_block_index ] );
+
+	/* A physical block contains at most 16 KiB of mappings, which can leave
+	 * gaps in between, hence only the mappings that contain the offset count
+	 */
+	for( block_mapping_index = 0;
+	     block_mapping_index < physical_block->number_of_mappings;
+	     block_mapping_index++ )
+	{
+		block_mapping = &( internal_block_map->mappings[ physical_block->mapping_index + block_mapping_index ] );
+
+		if( block_mapping->offset > offset )
+		{
+			break;
+		}
+		if( (size64_t) ( offset - block_mapping->offset ) >= (size64_t) block_mapping->size )
+		{
+			continue;
+		}
+		if( *number_of_mappings == mapping_index )
+		{
+			*mapping = block_mapping;
+		}
+		*number_of_mappings += 1;
+	}
+	if( ( *number_of_mappings == 0 )
+	 || ( ( mapping_index >= 0 )
+	  && ( *mapping == NULL ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the physical block that contains a specific offset
+ * The offset is only contained if a mapping of the physical block contains it
+ * Returns 1 if successful, 0 if no physical block contains the offset or -1 on error
+ */
+int libvshadow_block_map_get_physical_block_index_at_offset(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int *physical_block_index,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *mapping                 = NULL;
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_get_physical_block_index_at_offset";
+	int number_of_mappings                              = 0;
+	int result                                          = 0;
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( physical_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical block index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_internal_block_map_get_mapping_at_offset(
+	          internal_block_map,
+	          offset,
+	          -1,
+	          &number_of_mappings,
+	          &mapping,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mappings at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libvshadow_internal_block_map_find_physical_block(
+	          internal_block_map,
+	          offset,
+	          physical_block_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find physical block at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of mappings that contain a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_get_number_of_mappings_at_offset(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int *number_of_mappings,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *mapping                 = NULL;
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_get_number_of_mappings_at_offset";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( libvshadow_internal_block_map_get_mapping_at_offset(
+	     internal_block_map,
+	     offset,
+	     -1,
+	     number_of_mappings,
+	     &mapping,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mappings at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the store index and volume offset of a specific mapping that contains a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_get_mapping_at_offset_by_index(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int mapping_index,
+     int *store_index,
+     off64_t *volume_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *mapping                 = NULL;
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	static char *function                               = "libvshadow_block_map_get_mapping_at_offset_by_index";
+	int number_of_mappings                              = 0;
+	int result                                          = 0;
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( mapping_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapping index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_internal_block_map_get_mapping_at_offset(
+	          internal_block_map,
+	          offset,
+	          mapping_index,
+	          &number_of_mappings,
+	          &mapping,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapping: %d at offset: 0x%08" PRIx64 ".",
+		 function,
+		 mapping_index,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapping index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*store_index   = mapping->store_index;
+	*volume_offset = mapping->volume_offset + ( offset - mapping->offset );
+
+	return( 1 );
+}
+
+/* Retrieves a specific mapping of a specific physical block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_map_get_mapping_by_index(
+     libvshadow_block_map_t *block_map,
+     int physical_block_index,
+     int mapping_index,
+     int *store_index,
+     off64_t *volume_offset,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error )
+{
+	libvshadow_block_mapping_t *mapping                 = NULL;
+	libvshadow_internal_block_map_t *internal_block_map = NULL;
+	libvshadow_physical_block_t *physical_block         = NULL;
+	static char *function                               = "libvshadow_block_map_get_mapping_by_index";
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_block_map = (libvshadow_internal_block_map_t *) block_map;
+
+	if( ( physical_block_index < 0 )
+	 || ( physical_block_index >= internal_block_map->number_of_physical_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	physical_block = &( internal_block_map->physical_blocks[ physical_block_index ] );
+
+	if( ( mapping_index < 0 )
+	 || ( mapping_index >= physical_block->number_of_mappings ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapping index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	mapping = &( internal_block_map->mappings[ physical_block->mapping_index + mapping_index ] );
+
+	*store_index   = mapping->store_index;
+	*volume_offset = mapping->volume_offset;
+	*offset        = mapping->offset;
+	*size          = (size64_t) mapping->size;
+	*flags         = mapping->flags;
+
+	return( 1 );
+}
+
@@ -0,0 +1,213 @@
+/*
+ * Block map functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_INTERNAL_BLOCK_MAP_H )
+#define _LIBVSHADOW_INTERNAL_BLOCK_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_extern.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_mapping libvshadow_block_mapping_t;
+
+struct libvshadow_block_mapping
+{
+	/* The (physical) offset
+	 */
+	off64_t offset;
+
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The size
+	 */
+	uint32_t size;
+
+	/* The (extent) flags
+	 */
+	uint32_t flags;
+
+	/* The store index
+	 */
+	int store_index;
+};
+
+typedef struct libvshadow_physical_block libvshadow_physical_block_t;
+
+struct libvshadow_physical_block
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The index of the first mapping
+	 */
+	int mapping_index;
+
+	/* The number of mappings
+	 */
+	int number_of_mappings;
+};
+
+typedef struct libvshadow_internal_block_map libvshadow_internal_block_map_t;
+
+struct libvshadow_internal_block_map
+{
+	/* The mappings
+	 * sorted by (physical) offset, store index and volume offset
+	 */
+	libvshadow_block_mapping_t *mappings;
+
+	/* The number of mappings
+	 */
+	int number_of_mappings;
+
+	/* The maximum number of mappings
+	 */
+	int maximum_number_of_mappings;
+
+	/* The physical blocks
+	 * sorted by offset
+	 */
+	libvshadow_physical_block_t *physical_blocks;
+
+	/* The number of physical blocks
+	 */
+	int number_of_physical_blocks;
+};
+
+int libvshadow_block_map_initialize(
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_free(
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error );
+
+int libvshadow_block_map_compare_offsets(
+     const void *first_offset,
+     const void *second_offset );
+
+int libvshadow_block_map_compare_mappings(
+     const void *first_mapping,
+     const void *second_mapping );
+
+int libvshadow_block_map_append_mapping(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     off64_t volume_offset,
+     uint32_t size,
+     uint32_t flags,
+     int store_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_map_read_store_descriptors(
+     libvshadow_block_map_t *block_map,
+     libcdata_array_t *store_descriptors_array,
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_block_map_find_physical_block(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     int *physical_block_index,
+     libcerror_error_t **error );
+
+int libvshadow_internal_block_map_get_mapping_at_offset(
+     libvshadow_internal_block_map_t *internal_block_map,
+     off64_t offset,
+     int mapping_index,
+     int *number_of_mappings,
+     libvshadow_block_mapping_t **mapping,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_number_of_physical_blocks(
+     libvshadow_block_map_t *block_map,
+     int *number_of_physical_blocks,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_physical_block_by_index(
+     libvshadow_block_map_t *block_map,
+     int physical_block_index,
+     off64_t *offset,
+     size64_t *size,
+     int *number_of_mappings,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_physical_block_index_at_offset(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int *physical_block_index,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_number_of_mappings_at_offset(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int *number_of_mappings,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_mapping_at_offset_by_index(
+     libvshadow_block_map_t *block_map,
+     off64_t offset,
+     int mapping_index,
+     int *store_index,
+     off64_t *volume_offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_block_map_get_mapping_by_index(
+     libvshadow_block_map_t *block_map,
+     int physical_block_index,
+     int mapping_index,
+     int *store_index,
+     off64_t *volume_offset,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_INTERNAL_BLOCK_MAP_H ) */
+
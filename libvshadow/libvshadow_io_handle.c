@@ -33,6 +33,7 @@
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store_descriptor.h"
 
 #include "vshadow_catalog.h"
@@ -103,6 +104,19 @@ int libvshadow_io_handle_initialize(
 
 		goto on_error;
 	}
+	if( libvshadow_statistics_initialize(
+	     &( ( *io_handle )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
 	( *io_handle )->block_size = 0x4000;
 
 	return( 1 );
@@ -126,6 +140,7 @@ int libvshadow_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_io_handle_free";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -140,12 +155,25 @@ int libvshadow_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+		if( libvshadow_statistics_free(
+		     &( ( *io_handle )->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
 		*io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clears the IO handle
@@ -155,7 +183,18 @@ int libvshadow_io_handle_clear(
      libvshadow_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_io_handle_clear";
+	libvshadow_statistics_t *statistics = NULL;
+	intptr_t *io_callback_user_data     = NULL;
+	static char *function               = "libvshadow_io_handle_clear";
+
+	void (*io_callback)(
+	       int event_type,
+	       int store_index,
+	       off64_t offset,
+	       size64_t size,
+	       uint32_t record_type,
+	       uint64_t latency,
+	       intptr_t *user_data ) = NULL;
 
 	if( io_handle == NULL )
 	{
@@ -168,6 +207,12 @@ int libvshadow_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The statistics and the IO callback are retained
+	 */
+	statistics            = io_handle->statistics;
+	io_callback           = io_handle->io_callback;
+	io_callback_user_data = io_handle->io_callback_user_data;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -182,8 +227,66 @@ int libvshadow_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->block_size = 0x4000;
+	io_handle->statistics            = statistics;
+	io_handle->io_callback           = io_callback;
+	io_handle->io_callback_user_data = io_callback_user_data;
+	io_handle->block_size            = 0x4000;
+
+	if( libvshadow_statistics_clear(
+	     io_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+
+	return( 1 );
+}
+
+/* Notifies the IO callback of an IO event
+ * The latency is in microseconds
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_notify_io_event(
+     libvshadow_io_handle_t *io_handle,
+     int event_type,
+     int store_index,
+     off64_t offset,
+     size64_t size,
+     uint32_t record_type,
+     uint64_t latency,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_notify_io_event";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
 
+		return( -1 );
+	}
+	if( io_handle->io_callback != NULL )
+	{
+		io_handle->io_callback(
+		 event_type,
+		 store_index,
+		 offset,
+		 size,
+		 record_type,
+		 latency,
+		 io_handle->io_callback_user_data );
+	}
 	return( 1 );
 }
 
@@ -422,6 +525,8 @@ int libvshadow_io_handle_read_volume_header(
 
 	static char *function = "libvshadow_io_handle_read_volume_header";
 	ssize_t read_count    = 0;
+	uint64_t current_time = 0;
+	uint64_t start_time   = 0;
 
 	if( io_handle == NULL )
 	{
@@ -444,6 +549,22 @@ int libvshadow_io_handle_read_volume_header(
 		 file_offset );
 	}
 #endif
+	if( io_handle->io_callback != NULL )
+	{
+		if( libvshadow_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( libbfio_handle_seek_offset(
 	     file_io_handle,
 	     file_offset,
@@ -477,6 +598,56 @@ int libvshadow_io_handle_read_volume_header(
 
 		return( -1 );
 	}
+	if( libvshadow_statistics_add_value(
+	     io_handle->statistics,
+	     LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->io_callback != NULL )
+	{
+		if( libvshadow_statistics_get_current_time(
+		     &current_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current time.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_io_handle_notify_io_event(
+		     io_handle,
+		     LIBVSHADOW_IO_EVENT_TYPE_METADATA_BLOCK_READ,
+		     -1,
+		     file_offset,
+		     (size64_t) sizeof( vshadow_volume_header_t ),
+		     LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER,
+		     current_time - start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify IO event.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( libvshadow_io_handle_read_volume_header_data(
 	     io_handle,
 	     (uint8_t *) &volume_header,
@@ -777,6 +948,8 @@ int libvshadow_io_handle_read_catalog(
 	size_t catalog_block_size                            = 0;
 	ssize_t read_count                                   = 0;
 	uint64_t catalog_entry_type                          = 0;
+	uint64_t current_time                                = 0;
+	uint64_t start_time                                  = 0;
 	int result                                           = 0;
 	int store_descriptor_index                           = 0;
 
@@ -830,6 +1003,22 @@ int libvshadow_io_handle_read_catalog(
 			 file_offset );
 		}
 #endif
+		if( io_handle->io_callback != NULL )
+		{
+			if( libvshadow_statistics_get_current_time(
+			     &start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start time.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libbfio_handle_seek_offset(
 		     file_io_handle,
 		     file_offset,
@@ -863,6 +1052,56 @@ int libvshadow_io_handle_read_catalog(
 
 			goto on_error;
 		}
+		if( libvshadow_statistics_add_value(
+		     io_handle->statistics,
+		     LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( io_handle->io_callback != NULL )
+		{
+			if( libvshadow_statistics_get_current_time(
+			     &current_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve current time.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvshadow_io_handle_notify_io_event(
+			     io_handle,
+			     LIBVSHADOW_IO_EVENT_TYPE_METADATA_BLOCK_READ,
+			     -1,
+			     file_offset,
+			     (size64_t) catalog_block_size,
+			     LIBVSHADOW_RECORD_TYPE_CATALOG,
+			     current_time - start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to notify IO event.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libvshadow_io_handle_read_catalog_header_data(
 		     io_handle,
 		     catalog_block_data,
@@ -900,6 +1139,7 @@ int libvshadow_io_handle_read_catalog(
 
 					goto on_error;
 				}
+				store_descriptor->io_handle = io_handle;
 			}
 			result = libvshadow_store_descriptor_read_catalog_entry(
 			          store_descriptor,
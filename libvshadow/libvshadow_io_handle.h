@@ -28,6 +28,7 @@
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
+#include "libvshadow_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -43,6 +44,25 @@ struct libvshadow_io_handle
 	 */
 	size_t block_size;
 
+	/* The statistics of the volume metadata
+	 */
+	libvshadow_statistics_t *statistics;
+
+	/* The IO callback function
+	 */
+	void (*io_callback)(
+	       int event_type,
+	       int store_index,
+	       off64_t offset,
+	       size64_t size,
+	       uint32_t record_type,
+	       uint64_t latency,
+	       intptr_t *user_data );
+
+	/* The IO callback user data
+	 */
+	intptr_t *io_callback_user_data;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -60,6 +80,16 @@ int libvshadow_io_handle_clear(
      libvshadow_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libvshadow_io_handle_notify_io_event(
+     libvshadow_io_handle_t *io_handle,
+     int event_type,
+     int store_index,
+     off64_t offset,
+     size64_t size,
+     uint32_t record_type,
+     uint64_t latency,
+     libcerror_error_t **error );
+
 int libvshadow_io_handle_read_ntfs_volume_header(
      libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
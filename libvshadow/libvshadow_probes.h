@@ -0,0 +1,78 @@
+/*
+ * The USDT (SystemTap) static probes
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_PROBES_H )
+#define _LIBVSHADOW_PROBES_H
+
+#include <common.h>
+
+/* The probes are only available when build with --enable-usdt-probes
+ * and otherwise do not generate any code. The probes of the libvshadow
+ * provider are:
+ *
+ * store__read__start( store index, offset, size )
+ * store__read__done( store index, offset, read count )
+ * physical__read__start( store index, offset, size )
+ * physical__read__done( store index, offset, read count )
+ * store__block__read__start( offset, size )
+ * store__block__read__done( offset, record type )
+ * block__descriptors__load__start( store index )
+ * block__descriptors__load__done( store index, number of metadata blocks read )
+ * volume__open__start()
+ * volume__header__done( catalog offset )
+ * volume__catalog__done( number of stores )
+ * volume__open__done( number of stores )
+ *
+ * The probes are used as: LIBVSHADOW_PROBE2( name, argument1, argument2 )
+ * without a trailing semicolon
+ */
+#if defined( HAVE_USDT_PROBES ) && defined( HAVE_SYS_SDT_H )
+#include <sys/sdt.h>
+
+#define LIBVSHADOW_PROBE0( name ) \
+	DTRACE_PROBE( libvshadow, name );
+
+#define LIBVSHADOW_PROBE1( name, argument1 ) \
+	DTRACE_PROBE1( libvshadow, name, argument1 );
+
+#define LIBVSHADOW_PROBE2( name, argument1, argument2 ) \
+	DTRACE_PROBE2( libvshadow, name, argument1, argument2 );
+
+#define LIBVSHADOW_PROBE3( name, argument1, argument2, argument3 ) \
+	DTRACE_PROBE3( libvshadow, name, argument1, argument2, argument3 );
+
+#else
+#define LIBVSHADOW_PROBE0( name ) \
+	/* name */
+
+#define LIBVSHADOW_PROBE1( name, argument1 ) \
+	/* name */
+
+#define LIBVSHADOW_PROBE2( name, argument1, argument2 ) \
+	/* name */
+
+#define LIBVSHADOW_PROBE3( name, argument1, argument2, argument3 ) \
+	/* name */
+
+#endif /* defined( HAVE_USDT_PROBES ) && defined( HAVE_SYS_SDT_H ) */
+
+#endif /* !defined( _LIBVSHADOW_PROBES_H ) */
+
@@ -0,0 +1,88 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_STATISTICS_H )
+#define _LIBVSHADOW_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_statistics libvshadow_statistics_t;
+
+struct libvshadow_statistics
+{
+	/* The values
+	 */
+	uint64_t values[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvshadow_statistics_initialize(
+     libvshadow_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_free(
+     libvshadow_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_clear(
+     libvshadow_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_add_value(
+     libvshadow_statistics_t *statistics,
+     int value_index,
+     uint64_t value,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_add_values(
+     libvshadow_statistics_t *statistics,
+     const uint64_t *values,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_get_values(
+     libvshadow_statistics_t *statistics,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+int libvshadow_statistics_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_STATISTICS_H ) */
+
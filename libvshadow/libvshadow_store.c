@@ -31,6 +31,8 @@
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_probes.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
 #include "libvshadow_volume.h"
@@ -287,19 +289,21 @@ int libvshadow_store_has_in_volume_data(
 	return( result );
 }
 
-/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
+/* Reads (store) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * This function does not use or change the current offset
+ * This function is not multi-thread safe acquire read lock before call
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
+ssize_t libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
          void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
 	libvshadow_store_descriptor_t *store_descriptor = NULL;
-	static char *function                           = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	static char *function                           = "libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle";
 	ssize_t read_count                              = 0;
 
 	if( internal_store == NULL )
@@ -324,13 +328,13 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_store->current_offset < 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid store - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
@@ -339,13 +343,13 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 	{
 		return( 0 );
 	}
-	if( (size64_t) internal_store->current_offset >= internal_store->internal_volume->size )
+	if( (size64_t) offset >= internal_store->internal_volume->size )
 	{
 		return( 0 );
 	}
-	if( (size64_t) ( internal_store->current_offset + buffer_size ) > internal_store->internal_volume->size )
+	if( (size64_t) ( offset + buffer_size ) > internal_store->internal_volume->size )
 	{
-		buffer_size = (size_t) ( internal_store->internal_volume->size - internal_store->current_offset );
+		buffer_size = (size_t) ( internal_store->internal_volume->size - offset );
 	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_store->internal_volume->store_descriptors_array,
@@ -363,15 +367,27 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
+	LIBVSHADOW_PROBE3(
+	 store__read__start,
+	 internal_store->store_descriptor_index,
+	 offset,
+	 buffer_size )
+
 	read_count = libvshadow_store_descriptor_read_buffer(
 		      store_descriptor,
 		      file_io_handle,
 		      (uint8_t *) buffer,
 		      buffer_size,
-		      internal_store->current_offset,
+		      offset,
 		      store_descriptor,
 		      error );
 
+	LIBVSHADOW_PROBE3(
+	 store__read__done,
+	 internal_store->store_descriptor_index,
+	 offset,
+	 read_count )
+
 	if( read_count != (ssize_t) buffer_size )
 	{
 		libcerror_error_set(
@@ -384,6 +400,64 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
+	return( read_count );
+}
+
+/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+		      internal_store,
+		      file_io_handle,
+		      buffer,
+		      buffer_size,
+		      internal_store->current_offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
 	internal_store->current_offset += read_count;
 
 	return( read_count );
@@ -645,6 +719,90 @@ on_error:
 	return( -1 );
 }
 
+/* Reads (store) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * This function does not use or change the current offset, hence it only
+ * acquires the read lock. Reads using different file IO handles, that refer
+ * to the same volume data, can run concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_read_buffer_at_offset_from_file_io_handle";
+	ssize_t read_count                          = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+		      internal_store,
+		      file_io_handle,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
 /* Seeks a certain offset of the (store) data
  * This function is not multi-thread safe acquire write lock before call
  * Returns the offset if seek is successful or -1 on error
@@ -1520,3 +1678,375 @@ int libvshadow_store_get_block_by_index(
 	return( 1 );
 }
 
+/* Retrieves the block table
+ * The block table contains an entry of LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE bytes per block,
+ * in the same order as the blocks. An entry consists of the 64-bit original offset,
+ * relative offset and offset, followed by the 32-bit flags and bitmap, all stored
+ * in little-endian. The block table size must be at least the number of blocks
+ * multiplied by LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_block_table(
+     libvshadow_store_t *store,
+     uint8_t *block_table,
+     size_t block_table_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_block_table";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_block_table(
+	     store_descriptor,
+	     internal_store->file_io_handle,
+	     block_table,
+	     block_table_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block table from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the extent at a specific offset
+ * The extent offset contains the offset of the (store) data relative to the start of the volume
+ * The extent size contains the number of bytes, starting at the offset, that are stored
+ * contiguously at the extent offset
+ * Returns 1 if successful, 0 if the offset is beyond the size of the (store) data or -1 on error
+ */
+int libvshadow_store_get_extent_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_extent_at_offset";
+	int result                                  = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	result = libvshadow_store_get_extent_at_offset_from_file_io_handle(
+	          store,
+	          internal_store->file_io_handle,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the extent at a specific offset using a Basic File IO (bfio) handle
+ * The file IO handle is used to read the block descriptors that were not read before
+ * Returns 1 if successful, 0 if the offset is beyond the size of the (store) data or -1 on error
+ */
+int libvshadow_store_get_extent_at_offset_from_file_io_handle(
+     libvshadow_store_t *store,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_extent_at_offset_from_file_io_handle";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_store->internal_volume->size )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_extent_at_offset(
+	     store_descriptor,
+	     file_io_handle,
+	     offset,
+	     store_descriptor,
+	     extent_offset,
+	     extent_size,
+	     extent_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: 0x%08" PRIx64 " from store descriptor: %d.",
+		 function,
+		 offset,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( *extent_size > ( internal_store->internal_volume->size - (size64_t) offset ) )
+	{
+		*extent_size = internal_store->internal_volume->size - (size64_t) offset;
+	}
+	return( 1 );
+}
+
+/* Retrieves the statistics
+ * The statistics are indexed by the LIBVSHADOW_STATISTIC definitions
+ * Reads are attributed to the store they were requested from, including the data
+ * read on behalf of the store from the next (more recent) stores. The metadata
+ * blocks read and load time are attributed to the store that was loaded, note
+ * that reading from a store also loads the block descriptors of the next stores
+ * If number of statistics is smaller than LIBVSHADOW_NUMBER_OF_STATISTICS only
+ * the first number of statistics are retrieved, additional statistics are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_statistics(
+     libvshadow_store_t *store,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error )
+{
+	uint64_t values[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_statistics";
+	int value_index                                 = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_statistics < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of statistics value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_statistics_get_values(
+	     store_descriptor->statistics,
+	     values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < number_of_statistics;
+	     value_index++ )
+	{
+		if( value_index < LIBVSHADOW_NUMBER_OF_STATISTICS )
+		{
+			statistics[ value_index ] = values[ value_index ];
+		}
+		else
+		{
+			statistics[ value_index ] = 0;
+		}
+	}
+	return( 1 );
+}
+
@@ -85,6 +85,14 @@ int libvshadow_store_has_in_volume_data(
      libvshadow_store_t *store,
      libcerror_error_t **error );
 
+ssize_t libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
@@ -115,6 +123,15 @@ ssize_t libvshadow_store_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 off64_t libvshadow_internal_store_seek_offset(
          libvshadow_internal_store_t *internal_store,
          off64_t offset,
@@ -192,6 +209,39 @@ int libvshadow_store_get_block_by_index(
      libvshadow_block_t **block,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_block_table(
+     libvshadow_store_t *store,
+     uint8_t *block_table,
+     size_t block_table_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_extent_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_extent_at_offset_from_file_io_handle(
+     libvshadow_store_t *store,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_statistics(
+     libvshadow_store_t *store,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -25,11 +25,14 @@
 #include <types.h>
 
 #include "libvshadow_debug.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libfguid.h"
-#include "libvshadow_io_handle.h"
+#include "libvshadow_probes.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store_block.h"
 
 #include "vshadow_store.h"
@@ -174,16 +177,20 @@ int libvshadow_store_block_free(
 }
 
 /* Reads the store block
+ * The IO handle is optional and used to notify the IO callback
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_store_block_read(
      libvshadow_store_block_t *store_block,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_store_block_read";
 	ssize_t read_count    = 0;
+	uint64_t current_time = 0;
+	uint64_t start_time   = 0;
 
 	if( store_block == NULL )
 	{
@@ -217,6 +224,28 @@ int libvshadow_store_block_read(
 		 file_offset );
 	}
 #endif
+	if( ( io_handle != NULL )
+	 && ( io_handle->io_callback != NULL ) )
+	{
+		if( libvshadow_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	LIBVSHADOW_PROBE2(
+	 store__block__read__start,
+	 file_offset,
+	 store_block->data_size )
+
 	if( libbfio_handle_seek_offset(
 	     file_io_handle,
 	     file_offset,
@@ -265,6 +294,47 @@ int libvshadow_store_block_read(
 
 		return( -1 );
 	}
+	LIBVSHADOW_PROBE2(
+	 store__block__read__done,
+	 file_offset,
+	 store_block->record_type )
+
+	if( ( io_handle != NULL )
+	 && ( io_handle->io_callback != NULL ) )
+	{
+		if( libvshadow_statistics_get_current_time(
+		     &current_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current time.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_io_handle_notify_io_event(
+		     io_handle,
+		     LIBVSHADOW_IO_EVENT_TYPE_METADATA_BLOCK_READ,
+		     -1,
+		     file_offset,
+		     (size64_t) store_block->data_size,
+		     store_block->record_type,
+		     current_time - start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify IO event.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
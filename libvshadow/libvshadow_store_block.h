@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcerror.h"
 
@@ -76,6 +77,7 @@ int libvshadow_store_block_free(
 
 int libvshadow_store_block_read(
      libvshadow_store_block_t *store_block,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcerror_error_t **error );
@@ -19,6 +19,7 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -37,6 +38,8 @@
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
 #include "libvshadow_libuna.h"
+#include "libvshadow_probes.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store_block.h"
 #include "libvshadow_store_descriptor.h"
 
@@ -174,6 +177,19 @@ int libvshadow_store_descriptor_initialize(
 
 		goto on_error;
 	}
+	if( libvshadow_statistics_initialize(
+	     &( ( *store_descriptor )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( ( *store_descriptor )->read_write_lock ),
@@ -194,6 +210,19 @@ int libvshadow_store_descriptor_initialize(
 on_error:
 	if( *store_descriptor != NULL )
 	{
+		if( ( *store_descriptor )->statistics != NULL )
+		{
+			libvshadow_statistics_free(
+			 &( ( *store_descriptor )->statistics ),
+			 NULL );
+		}
+		if( ( *store_descriptor )->previous_block_offset_list != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *store_descriptor )->previous_block_offset_list ),
+			 NULL,
+			 NULL );
+		}
 		if( ( *store_descriptor )->block_offset_list != NULL )
 		{
 			libcdata_range_list_free(
@@ -348,6 +377,19 @@ int libvshadow_store_descriptor_free(
 
 			result = -1;
 		}
+		if( libvshadow_statistics_free(
+		     &( ( *store_descriptor )->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *store_descriptor );
 
@@ -891,6 +933,7 @@ int libvshadow_store_descriptor_read_store_header(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     store_descriptor->io_handle,
 	     file_io_handle,
 	     store_descriptor->store_header_offset,
 	     error ) == -1 )
@@ -905,6 +948,21 @@ int libvshadow_store_descriptor_read_store_header(
 
 		goto on_error;
 	}
+	if( libvshadow_statistics_add_value(
+	     store_descriptor->statistics,
+	     LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( store_block->record_type != LIBVSHADOW_RECORD_TYPE_STORE_HEADER )
 	{
 		libcerror_error_set(
@@ -1331,6 +1389,7 @@ int libvshadow_store_descriptor_read_store_bitmap(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     store_descriptor->io_handle,
 	     file_io_handle,
 	     file_offset,
 	     error ) == -1 )
@@ -1559,6 +1618,7 @@ int libvshadow_store_descriptor_read_store_block_list(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     store_descriptor->io_handle,
 	     file_io_handle,
 	     file_offset,
 	     error ) == -1 )
@@ -1766,6 +1826,7 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     store_descriptor->io_handle,
 	     file_io_handle,
 	     file_offset,
 	     error ) == -1 )
@@ -1895,9 +1956,13 @@ int libvshadow_store_descriptor_read_block_descriptors(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
+	uint64_t statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
 	static char *function      = "libvshadow_store_descriptor_read_block_descriptors";
 	off64_t bitmap_offset      = 0;
 	off64_t store_block_offset = 0;
+	uint64_t current_time      = 0;
+	uint64_t start_time        = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -1927,6 +1992,37 @@ int libvshadow_store_descriptor_read_block_descriptors(
 #endif
 	if( store_descriptor->block_descriptors_read == 0 )
 	{
+		if( memory_set(
+		     statistics,
+		     0,
+		     sizeof( uint64_t ) * LIBVSHADOW_NUMBER_OF_STATISTICS ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			goto on_error;
+		}
+		LIBVSHADOW_PROBE1(
+		 block__descriptors__load__start,
+		 store_descriptor->index )
+
 		bitmap_offset      = 0;
 		store_block_offset = store_descriptor->store_bitmap_offset;
 
@@ -1950,6 +2046,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 				goto on_error;
 			}
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] += 1;
 		}
 		bitmap_offset      = 0;
 		store_block_offset = store_descriptor->store_previous_bitmap_offset;
@@ -1974,6 +2071,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 				goto on_error;
 			}
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] += 1;
 		}
 		store_block_offset = store_descriptor->store_block_list_offset;
 
@@ -1995,6 +2093,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 				goto on_error;
 			}
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] += 1;
 		}
 		store_block_offset = store_descriptor->store_block_range_list_offset;
 
@@ -2016,8 +2115,92 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 				goto on_error;
 			}
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] += 1;
+		}
+		if( libvshadow_statistics_get_current_time(
+		     &current_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current time.",
+			 function );
+
+			goto on_error;
+		}
+		if( current_time > start_time )
+		{
+			statistics[ LIBVSHADOW_STATISTIC_LOAD_TIME ] = current_time - start_time;
+		}
+		if( libvshadow_statistics_add_values(
+		     store_descriptor->statistics,
+		     statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
 		}
 		store_descriptor->block_descriptors_read = 1;
+
+		LIBVSHADOW_PROBE2(
+		 block__descriptors__load__done,
+		 store_descriptor->index,
+		 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] )
+
+		if( ( store_descriptor->io_handle != NULL )
+		 && ( store_descriptor->io_handle->io_callback != NULL ) )
+		{
+			if( libvshadow_io_handle_notify_io_event(
+			     store_descriptor->io_handle,
+			     LIBVSHADOW_IO_EVENT_TYPE_CACHE_MISS,
+			     store_descriptor->index,
+			     0,
+			     0,
+			     0,
+			     statistics[ LIBVSHADOW_STATISTIC_LOAD_TIME ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to notify IO event.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else if( ( store_descriptor->io_handle != NULL )
+	      && ( store_descriptor->io_handle->io_callback != NULL ) )
+	{
+		if( libvshadow_io_handle_notify_io_event(
+		     store_descriptor->io_handle,
+		     LIBVSHADOW_IO_EVENT_TYPE_CACHE_HIT,
+		     store_descriptor->index,
+		     0,
+		     0,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify IO event.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2046,42 +2229,36 @@ on_error:
 }
 
 /* Reads data at the specified offset into a buffer
+ * The location of every range of data is resolved using the block descriptors
+ * and consecutive ranges stored contiguously in the volume are read at once
+ * The statistics of the read, including those of the reads forwarded to the
+ * next store descriptors, are added to the statistics values
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_store_descriptor_read_buffer(
+ssize_t libvshadow_store_descriptor_read_buffer_with_statistics(
          libvshadow_store_descriptor_t *store_descriptor,
          libbfio_handle_t *file_io_handle,
          uint8_t *buffer,
          size_t buffer_size,
          off64_t offset,
          libvshadow_store_descriptor_t *active_store_descriptor,
+         uint64_t *statistics,
          libcerror_error_t **error )
 {
-	libcdata_tree_node_t *tree_node                         = NULL;
-	libvshadow_block_descriptor_t *block_descriptor         = NULL;
-	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
-	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
-	static char *function                                   = "libvshadow_store_descriptor_read_buffer";
-	intptr_t *value                                         = NULL;
-	off64_t block_descriptor_offset                         = 0;
-	off64_t block_offset                                    = 0;
-	off64_t block_range_offset                              = 0;
-	off64_t overlay_block_offset                            = 0;
-	off64_t previous_block_range_offset                     = 0;
-	size64_t block_range_size                               = 0;
-	size64_t previous_block_range_size                      = 0;
-	size_t buffer_offset                                    = 0;
-	size_t block_size                                       = 0;
-	size_t read_size                                        = 0;
-	ssize_t read_count                                      = 0;
-	uint32_t overlay_bitmap                                 = 0;
-	uint32_t relative_block_offset                          = 0;
-	uint8_t bit_count                                       = 0;
-	int in_block_descriptor_list                            = 0;
-	int in_current_bitmap                                   = 0;
-	int in_previous_bitmap                                  = 0;
-	int in_reverse_block_descriptor_list                    = 0;
-	int result                                              = 0;
+	static char *function        = "libvshadow_store_descriptor_read_buffer_with_statistics";
+	off64_t location_offset      = 0;
+	off64_t pending_read_offset  = 0;
+	size_t buffer_offset         = 0;
+	size_t location_size         = 0;
+	size_t pending_buffer_offset = 0;
+	size_t pending_read_size     = 0;
+	size_t read_size             = 0;
+	ssize_t read_count           = 0;
+	uint64_t current_time        = 0;
+	uint64_t start_time          = 0;
+	uint8_t location_flags       = 0;
+	int location_type            = 0;
+	int notify_io_events         = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -2116,6 +2293,29 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 
 		return( -1 );
 	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only the bytes requested from the active store are counted
+	 * reads that are forwarded to the next store descriptor are not
+	 */
+	if( store_descriptor == active_store_descriptor )
+	{
+		statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_REQUESTED ] += (uint64_t) buffer_size;
+	}
+	if( ( store_descriptor->io_handle != NULL )
+	 && ( store_descriptor->io_handle->io_callback != NULL ) )
+	{
+		notify_io_events = 1;
+	}
 	/* This function will acquire the write lock
 	 */
 	if( libvshadow_store_descriptor_read_block_descriptors(
@@ -2159,571 +2359,1925 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 #endif
 	while( buffer_size > 0 )
 	{
-		block_offset          = offset;
-		relative_block_offset = (uint32_t) (offset % 0x4000);
-		block_size            = 0x4000 - relative_block_offset;
+		if( libvshadow_store_descriptor_get_block_location_at_offset(
+		     store_descriptor,
+		     offset,
+		     active_store_descriptor,
+		     &location_offset,
+		     &location_size,
+		     &location_type,
+		     &location_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block location at offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		if( location_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid block location size value out of bounds.",
+			 function );
 
+			goto on_error;
+		}
+		if( buffer_size > location_size )
+		{
+			read_size = location_size;
+		}
+		else
+		{
+			read_size = buffer_size;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "%s: store: %02d block offset: 0x%08" PRIx64 "\n",
+			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd ", location type: %d, location offset: 0x%08" PRIx64 "\n",
 			 function,
 			 store_descriptor->index,
-			 block_offset );
+			 offset,
+			 offset + read_size,
+			 read_size,
+			 location_type,
+			 location_offset );
 		}
 #endif
-		in_block_descriptor_list         = 0;
-		in_reverse_block_descriptor_list = 0;
-		in_current_bitmap                = 0;
-		in_previous_bitmap               = 0;
+		/* Data stored in the volume directly following the pending read is added to it
+		 */
+		if( ( pending_read_size > 0 )
+		 && ( ( ( location_type != LIBVSHADOW_BLOCK_LOCATION_TYPE_CURRENT_VOLUME )
+		   &&   ( location_type != LIBVSHADOW_BLOCK_LOCATION_TYPE_STORE_DATA ) )
+		  || ( location_offset != (off64_t) ( pending_read_offset + pending_read_size ) ) ) )
+		{
+			if( notify_io_events != 0 )
+			{
+				if( libvshadow_statistics_get_current_time(
+				     &start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve start time.",
+					 function );
 
-		result = libcdata_btree_get_value_by_value(
-		          store_descriptor->forward_block_descriptors_tree,
-		          (intptr_t *) &block_offset,
-		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
-		          &tree_node,
-		          (intptr_t **) &block_descriptor,
-		          error );
+					goto on_error;
+				}
+			}
+			LIBVSHADOW_PROBE3(
+			 physical__read__start,
+			 active_store_descriptor->index,
+			 pending_read_offset,
+			 pending_read_size )
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
-			 function,
-			 block_offset );
+			if( libbfio_handle_seek_offset(
+			     file_io_handle,
+			     pending_read_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek block offset: %" PRIi64 ".",
+				 function,
+				 pending_read_offset );
 
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			if( block_descriptor == NULL )
+				goto on_error;
+			}
+			read_count = libbfio_handle_read_buffer(
+				      file_io_handle,
+				      &( buffer[ pending_buffer_offset ] ),
+				      pending_read_size,
+				      error );
+
+			LIBVSHADOW_PROBE3(
+			 physical__read__done,
+			 active_store_descriptor->index,
+			 pending_read_offset,
+			 read_count )
+
+			if( read_count != (ssize_t) pending_read_size )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing block descriptor.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from file IO handle.",
 				 function );
 
 				goto on_error;
 			}
-			in_block_descriptor_list = 1;
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ] += (uint64_t) pending_read_size;
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_READS ]      += 1;
 
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			{
-				block_descriptor_offset = block_descriptor->relative_offset;
-			}
-			else
-			{
-				block_descriptor_offset = block_descriptor->offset;
-			}
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-			{
-				overlay_block_descriptor = block_descriptor;
-			}
-			else
-			{
-				overlay_block_descriptor = block_descriptor->overlay;
-			}
-			if( overlay_block_descriptor != NULL )
+			if( notify_io_events != 0 )
 			{
-				if( store_descriptor->index != active_store_descriptor->index )
+				if( libvshadow_statistics_get_current_time(
+				     &current_time,
+				     error ) != 1 )
 				{
-					if( block_descriptor == overlay_block_descriptor )
-					{
-						block_descriptor         = NULL;
-						in_block_descriptor_list = 0;
-					}
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve current time.",
+					 function );
+
+					goto on_error;
 				}
-				else
-				{
-					overlay_block_offset = overlay_block_descriptor->original_offset;
-					overlay_bitmap       = overlay_block_descriptor->bitmap;
-
-					bit_count = 32;
-
-					while( overlay_block_offset < block_offset )
-					{
-						overlay_bitmap >>= 1;
-
-						overlay_block_offset += 512;
-
-						bit_count--;
-
-						if( bit_count == 0 )
-						{
-							break;
-						}
-					}
-					if( ( overlay_bitmap & 0x00000001UL ) != 0 )
-					{
-						block_descriptor_offset = overlay_block_descriptor->offset;
-						block_descriptor        = overlay_block_descriptor;
-
-						block_size = 0;
-
-						while( ( overlay_bitmap & 0x00000001UL ) != 0 )
-						{
-							overlay_bitmap >>= 1;
-
-							block_size += 512;
-
-							bit_count--;
-
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-					else
-					{
-						if( block_descriptor == overlay_block_descriptor )
-						{
-							block_descriptor         = NULL;
-							in_block_descriptor_list = 0;
-						}
-						block_size = 0;
-
-						while( ( overlay_bitmap & 0x00000001UL ) == 0 )
-						{
-							overlay_bitmap >>= 1;
-
-							block_size += 512;
-
-							bit_count--;
-
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-				}
-			}
-		}
-		if( in_block_descriptor_list == 0 )
-		{
-			/* Only the most recent store seems to bother checking the current bitmap
-			 */
-			if( ( store_descriptor->next_store_descriptor == NULL )
-			 && ( store_descriptor->index == active_store_descriptor->index ) )
-			{
-				if( store_descriptor->reverse_block_descriptors_tree == NULL )
+				if( libvshadow_io_handle_notify_io_event(
+				     store_descriptor->io_handle,
+				     LIBVSHADOW_IO_EVENT_TYPE_PHYSICAL_READ,
+				     active_store_descriptor->index,
+				     pending_read_offset,
+				     (size64_t) pending_read_size,
+				     0,
+				     current_time - start_time,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid store descriptor - missing reverse block descriptors tree.",
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to notify IO event.",
 					 function );
 
 					goto on_error;
 				}
-				result = libcdata_btree_get_value_by_value(
-					  store_descriptor->reverse_block_descriptors_tree,
-					  (intptr_t *) &block_offset,
-					  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_relative_offset_value,
-					  &tree_node,
-					  (intptr_t **) &reverse_block_descriptor,
-					  error );
+			}
 
-				if( result == -1 )
+			pending_read_size = 0;
+		}
+		if( ( location_flags & LIBVSHADOW_BLOCK_LOCATION_FLAG_IS_OVERLAY ) != 0 )
+		{
+			statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_OVERLAY_READS ] += 1;
+		}
+		switch( location_type )
+		{
+			case LIBVSHADOW_BLOCK_LOCATION_TYPE_CURRENT_VOLUME:
+			case LIBVSHADOW_BLOCK_LOCATION_TYPE_STORE_DATA:
+				if( pending_read_size == 0 )
+				{
+					pending_read_offset   = location_offset;
+					pending_buffer_offset = buffer_offset;
+				}
+				pending_read_size += read_size;
+
+				break;
+
+			case LIBVSHADOW_BLOCK_LOCATION_TYPE_NEXT_STORE:
+				read_count = libvshadow_store_descriptor_read_buffer_with_statistics(
+					      store_descriptor->next_store_descriptor,
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      location_offset,
+					      active_store_descriptor,
+					      statistics,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve reverse block descriptor from root node.",
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from next store descriptor.",
 					 function );
 
 					goto on_error;
 				}
-				in_reverse_block_descriptor_list = result;
+				statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_FORWARDER_HOPS ] += 1;
 
-				result = libcdata_range_list_get_range_at_offset(
-					  store_descriptor->block_offset_list,
-					  (uint64_t) block_offset,
-					  (uint64_t *) &block_range_offset,
-					  (uint64_t *) &block_range_size,
-					  &value,
-					  error );
+				break;
 
-				if( result == -1 )
+			case LIBVSHADOW_BLOCK_LOCATION_TYPE_ZERO:
+				if( memory_set(
+				     &( buffer[ buffer_offset ] ),
+				     0,
+				     read_size ) == NULL )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
-					 function,
-					 offset );
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer.",
+					 function );
 
 					goto on_error;
 				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				else if( result != 0 )
-				{
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-						 function,
-						 store_descriptor->index,
-						 block_range_offset,
-						 block_range_offset + block_range_size,
-						 block_range_size );
-					}
-				}
-#endif
-				in_current_bitmap = result;
+				statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_ZERO_FILLED_BYTES ] += (uint64_t) read_size;
 
-				if( store_descriptor->store_previous_bitmap_offset != 0 )
+				if( notify_io_events != 0 )
 				{
-					result = libcdata_range_list_get_range_at_offset(
-						  store_descriptor->previous_block_offset_list,
-						  (uint64_t) block_offset,
-						  (uint64_t *) &previous_block_range_offset,
-						  (uint64_t *) &previous_block_range_size,
-						  &value,
-						  error );
-
-					if( result == -1 )
+					if( libvshadow_io_handle_notify_io_event(
+					     store_descriptor->io_handle,
+					     LIBVSHADOW_IO_EVENT_TYPE_ZERO_FILL,
+					     active_store_descriptor->index,
+					     offset,
+					     (size64_t) read_size,
+					     0,
+					     0,
+					     error ) != 1 )
 					{
 						libcerror_error_set(
 						 error,
 						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
-						 function,
-						 offset );
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to notify IO event.",
+						 function );
 
 						goto on_error;
 					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					else if( result != 0 )
-					{
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-							 function,
-							 store_descriptor->index,
-							 previous_block_range_offset,
-							 previous_block_range_offset + previous_block_range_size,
-							 previous_block_range_size );
-						}
-					}
-#endif
-					in_previous_bitmap = result;
-				}
-				else
-				{
-					in_previous_bitmap = 1;
 				}
-			}
-		}
-		block_descriptor_offset += relative_block_offset;
 
-		if( buffer_size > block_size )
-		{
-			read_size = block_size;
+				break;
+
+			default:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported block location type: %d.",
+				 function,
+				 location_type );
+
+				goto on_error;
 		}
-		else
+		offset        += read_size;
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+	}
+	if( pending_read_size > 0 )
+	{
+		if( notify_io_events != 0 )
 		{
-			read_size = buffer_size;
+			if( libvshadow_statistics_get_current_time(
+			     &start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start time.",
+				 function );
+
+				goto on_error;
+			}
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		LIBVSHADOW_PROBE3(
+		 physical__read__start,
+		 active_store_descriptor->index,
+		 pending_read_offset,
+		 pending_read_size )
+
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     pending_read_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
-			libcnotify_printf(
-			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek block offset: %" PRIi64 ".",
 			 function,
-			 store_descriptor->index,
-			 block_offset,
-			 block_offset + block_size,
-			 block_size );
+			 pending_read_offset );
 
-			if( block_descriptor != NULL )
-			{
-				libcnotify_printf(
-				 ", flags: 0x%08" PRIx32 "",
-				 block_descriptor->flags );
-			}
-			libcnotify_printf(
-			 "\n" );
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+			      file_io_handle,
+			      &( buffer[ pending_buffer_offset ] ),
+			      pending_read_size,
+			      error );
+
+		LIBVSHADOW_PROBE3(
+		 physical__read__done,
+		 active_store_descriptor->index,
+		 pending_read_offset,
+		 read_count )
+
+		if( read_count != (ssize_t) pending_read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from file IO handle.",
+			 function );
 
-			if( in_block_descriptor_list != 0 )
+			goto on_error;
+		}
+		statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ] += (uint64_t) pending_read_size;
+		statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_READS ]      += 1;
+
+		if( notify_io_events != 0 )
+		{
+			if( libvshadow_statistics_get_current_time(
+			     &current_time,
+			     error ) != 1 )
 			{
-				libcnotify_printf(
-				 "\tIn block list\n" );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve current time.",
+				 function );
+
+				goto on_error;
 			}
-			if( block_descriptor != NULL )
+			if( libvshadow_io_handle_notify_io_event(
+			     store_descriptor->io_handle,
+			     LIBVSHADOW_IO_EVENT_TYPE_PHYSICAL_READ,
+			     active_store_descriptor->index,
+			     pending_read_offset,
+			     (size64_t) pending_read_size,
+			     0,
+			     current_time - start_time,
+			     error ) != 1 )
 			{
-				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-				{
-					libcnotify_printf(
-					 "\tIs overlay\n" );
-				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to notify IO event.",
+				 function );
+
+				goto on_error;
 			}
-			if( in_reverse_block_descriptor_list != 0 )
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads data at the specified offset into a buffer
+ * The statistics are accumulated over the reads forwarded to the next store
+ * descriptors and are added to the statistics of the active store once
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libcerror_error_t **error )
+{
+	uint64_t statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
+	static char *function = "libvshadow_store_descriptor_read_buffer";
+	ssize_t read_count    = 0;
+
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     statistics,
+	     0,
+	     sizeof( uint64_t ) * LIBVSHADOW_NUMBER_OF_STATISTICS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvshadow_store_descriptor_read_buffer_with_statistics(
+	              store_descriptor,
+	              file_io_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              active_store_descriptor,
+	              statistics,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The statistics are attributed to the active store
+	 */
+	if( libvshadow_statistics_add_values(
+	     active_store_descriptor->statistics,
+	     statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads data at the specified offset into a buffer
+ * This is the reference implementation of libvshadow_store_descriptor_read_buffer
+ * that resolves and reads the data block by block, it is kept to verify
+ * the data read by libvshadow_store_descriptor_read_buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer_reference(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libcerror_error_t **error )
+{
+	libcdata_tree_node_t *tree_node                         = NULL;
+	libvshadow_block_descriptor_t *block_descriptor         = NULL;
+	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
+	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_read_buffer_reference";
+	intptr_t *value                                         = NULL;
+	off64_t block_descriptor_offset                         = 0;
+	off64_t block_offset                                    = 0;
+	off64_t block_range_offset                              = 0;
+	off64_t overlay_block_offset                            = 0;
+	off64_t previous_block_range_offset                     = 0;
+	size64_t block_range_size                               = 0;
+	size64_t previous_block_range_size                      = 0;
+	size_t buffer_offset                                    = 0;
+	size_t block_size                                       = 0;
+	size_t read_size                                        = 0;
+	ssize_t read_count                                      = 0;
+	uint32_t overlay_bitmap                                 = 0;
+	uint32_t relative_block_offset                          = 0;
+	uint8_t bit_count                                       = 0;
+	int in_block_descriptor_list                            = 0;
+	int in_current_bitmap                                   = 0;
+	int in_previous_bitmap                                  = 0;
+	int in_reverse_block_descriptor_list                    = 0;
+	int result                                              = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the write lock
+	 */
+	if( libvshadow_store_descriptor_read_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: store: %02d requested offset: 0x%08" PRIx64 "\n",
+		 function,
+		 store_descriptor->index,
+		 offset );
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		block_offset          = offset;
+		relative_block_offset = (uint32_t) (offset % 0x4000);
+		block_size            = 0x4000 - relative_block_offset;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d block offset: 0x%08" PRIx64 "\n",
+			 function,
+			 store_descriptor->index,
+			 block_offset );
+		}
+#endif
+		in_block_descriptor_list         = 0;
+		in_reverse_block_descriptor_list = 0;
+		in_current_bitmap                = 0;
+		in_previous_bitmap               = 0;
+
+		result = libcdata_btree_get_value_by_value(
+		          store_descriptor->forward_block_descriptors_tree,
+		          (intptr_t *) &block_offset,
+		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
+		          &tree_node,
+		          (intptr_t **) &block_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
+			 function,
+			 block_offset );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( block_descriptor == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing block descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			in_block_descriptor_list = 1;
+
+			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+			{
+				block_descriptor_offset = block_descriptor->relative_offset;
+			}
+			else
+			{
+				block_descriptor_offset = block_descriptor->offset;
+			}
+			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+			{
+				overlay_block_descriptor = block_descriptor;
+			}
+			else
+			{
+				overlay_block_descriptor = block_descriptor->overlay;
+			}
+			if( overlay_block_descriptor != NULL )
+			{
+				if( store_descriptor->index != active_store_descriptor->index )
+				{
+					if( block_descriptor == overlay_block_descriptor )
+					{
+						block_descriptor         = NULL;
+						in_block_descriptor_list = 0;
+					}
+				}
+				else
+				{
+					overlay_block_offset = overlay_block_descriptor->original_offset;
+					overlay_bitmap       = overlay_block_descriptor->bitmap;
+
+					bit_count = 32;
+
+					while( ( overlay_block_offset + 512 ) <= block_offset )
+					{
+						overlay_bitmap >>= 1;
+
+						overlay_block_offset += 512;
+
+						bit_count--;
+
+						if( bit_count == 0 )
+						{
+							break;
+						}
+					}
+					if( ( overlay_bitmap & 0x00000001UL ) != 0 )
+					{
+						block_descriptor_offset = overlay_block_descriptor->offset;
+						block_descriptor        = overlay_block_descriptor;
+
+						block_size = 0;
+
+						while( ( overlay_bitmap & 0x00000001UL ) != 0 )
+						{
+							overlay_bitmap >>= 1;
+
+							block_size += 512;
+
+							bit_count--;
+
+							if( bit_count == 0 )
+							{
+								break;
+							}
+						}
+					}
+					else
+					{
+						if( block_descriptor == overlay_block_descriptor )
+						{
+							block_descriptor         = NULL;
+							in_block_descriptor_list = 0;
+						}
+						block_size = 0;
+
+						while( ( overlay_bitmap & 0x00000001UL ) == 0 )
+						{
+							overlay_bitmap >>= 1;
+
+							block_size += 512;
+
+							bit_count--;
+
+							if( bit_count == 0 )
+							{
+								break;
+							}
+						}
+					}
+					/* The offset is not necessarily sector aligned
+					 */
+					block_size -= (size_t) ( block_offset - overlay_block_offset );
+				}
+			}
+		}
+		if( in_block_descriptor_list == 0 )
+		{
+			/* Only the most recent store seems to bother checking the current bitmap
+			 */
+			if( ( store_descriptor->next_store_descriptor == NULL )
+			 && ( store_descriptor->index == active_store_descriptor->index ) )
+			{
+				if( store_descriptor->reverse_block_descriptors_tree == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid store descriptor - missing reverse block descriptors tree.",
+					 function );
+
+					goto on_error;
+				}
+				result = libcdata_btree_get_value_by_value(
+					  store_descriptor->reverse_block_descriptors_tree,
+					  (intptr_t *) &block_offset,
+					  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_relative_offset_value,
+					  &tree_node,
+					  (intptr_t **) &reverse_block_descriptor,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve reverse block descriptor from root node.",
+					 function );
+
+					goto on_error;
+				}
+				in_reverse_block_descriptor_list = result;
+
+				result = libcdata_range_list_get_range_at_offset(
+					  store_descriptor->block_offset_list,
+					  (uint64_t) block_offset,
+					  (uint64_t *) &block_range_offset,
+					  (uint64_t *) &block_range_size,
+					  &value,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				else if( result != 0 )
+				{
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+						 function,
+						 store_descriptor->index,
+						 block_range_offset,
+						 block_range_offset + block_range_size,
+						 block_range_size );
+					}
+				}
+#endif
+				in_current_bitmap = result;
+
+				if( store_descriptor->store_previous_bitmap_offset != 0 )
+				{
+					result = libcdata_range_list_get_range_at_offset(
+						  store_descriptor->previous_block_offset_list,
+						  (uint64_t) block_offset,
+						  (uint64_t *) &previous_block_range_offset,
+						  (uint64_t *) &previous_block_range_size,
+						  &value,
+						  error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
+						 function,
+						 offset );
+
+						goto on_error;
+					}
+#if defined( HAVE_DEBUG_OUTPUT )
+					else if( result != 0 )
+					{
+						if( libcnotify_verbose != 0 )
+						{
+							libcnotify_printf(
+							 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+							 function,
+							 store_descriptor->index,
+							 previous_block_range_offset,
+							 previous_block_range_offset + previous_block_range_size,
+							 previous_block_range_size );
+						}
+					}
+#endif
+					in_previous_bitmap = result;
+				}
+				else
+				{
+					in_previous_bitmap = 1;
+				}
+			}
+		}
+		block_descriptor_offset += relative_block_offset;
+
+		if( buffer_size > block_size )
+		{
+			read_size = block_size;
+		}
+		else
+		{
+			read_size = buffer_size;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
+			 function,
+			 store_descriptor->index,
+			 block_offset,
+			 block_offset + block_size,
+			 block_size );
+
+			if( block_descriptor != NULL )
+			{
+				libcnotify_printf(
+				 ", flags: 0x%08" PRIx32 "",
+				 block_descriptor->flags );
+			}
+			libcnotify_printf(
+			 "\n" );
+
+			if( in_block_descriptor_list != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn block list\n" );
+			}
+			if( block_descriptor != NULL )
+			{
+				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+				{
+					libcnotify_printf(
+					 "\tIs overlay\n" );
+				}
+			}
+			if( in_reverse_block_descriptor_list != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn reverse block list\n" );
+			}
+			if( in_current_bitmap != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn current bitmap\n" );
+			}
+			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
+			 && ( in_previous_bitmap != 0 ) )
+			{
+				libcnotify_printf(
+				 "\tIn previous bitmap\n" );
+			}
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		if( in_block_descriptor_list != 0 )
+		{
+			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+			 && ( store_descriptor->next_store_descriptor != NULL ) )
 			{
-				libcnotify_printf(
-				 "\tIn reverse block list\n" );
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
+					 function,
+					 store_descriptor->index,
+					 block_descriptor_offset );
+				}
+#endif
+				read_count = libvshadow_store_descriptor_read_buffer_reference(
+					      store_descriptor->next_store_descriptor,
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      block_descriptor_offset,
+					      active_store_descriptor,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from next store descriptor.",
+					 function );
+
+					goto on_error;
+				}
 			}
-			if( in_current_bitmap != 0 )
+			else
 			{
-				libcnotify_printf(
-				 "\tIn current bitmap\n" );
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
+					 function,
+					 store_descriptor->index,
+					 block_descriptor_offset );
+				}
+#endif
+				if( libbfio_handle_seek_offset(
+				     file_io_handle,
+				     block_descriptor_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek block offset: %" PRIi64 ".",
+					 function,
+					 block_descriptor_offset );
+
+					goto on_error;
+				}
+				read_count = libbfio_handle_read_buffer(
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from file IO handle.",
+					 function );
+
+					goto on_error;
+				}
 			}
-			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
-			 && ( in_previous_bitmap != 0 ) )
+		}
+		else
+		{
+			/* Check if the next store defines the block
+			 */
+			if( store_descriptor->next_store_descriptor != NULL )
 			{
-				libcnotify_printf(
-				 "\tIn previous bitmap\n" );
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
+					 function,
+					 store_descriptor->index,
+					 block_offset );
+				}
+#endif
+				read_count = libvshadow_store_descriptor_read_buffer_reference(
+					      store_descriptor->next_store_descriptor,
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      block_offset,
+					      active_store_descriptor,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from next store descriptor.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else if( ( in_reverse_block_descriptor_list == 0 )
+			      && ( in_current_bitmap != 0 )
+			      && ( in_previous_bitmap != 0 ) )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d filling block with zero bytes\n",
+					 function,
+					 store_descriptor->index,
+					 block_offset,
+					 read_size );
+				}
+#endif
+				if( memory_set(
+				     &( buffer[ buffer_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer.",
+					 function );
+
+					goto on_error;
+				}
+				read_count = (ssize_t) read_size;
+			}
+			else
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
+					 function,
+					 store_descriptor->index,
+					 block_offset );
+				}
+#endif
+				if( libbfio_handle_seek_offset(
+				     file_io_handle,
+				     block_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek block offset: %" PRIi64 ".",
+					 function,
+					 block_offset );
+
+					goto on_error;
+				}
+				read_count = libbfio_handle_read_buffer(
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from file IO handle.",
+					 function );
+
+					goto on_error;
+				}
 			}
+		}
+		offset        += read_count;
+		buffer_offset += read_count;
+		buffer_size   -= read_count;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
 			libcnotify_printf(
 			 "\n" );
 		}
-#endif
-		if( in_block_descriptor_list != 0 )
+#endif
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the location of the data of the block at the specified offset
+ * The location size contains the number of bytes, starting at the offset,
+ * that are stored at the location
+ * The location flags indicate if the data is stored in an overlay block
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_location_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *location_offset,
+     size_t *location_size,
+     int *location_type,
+     uint8_t *location_flags,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *tree_node                         = NULL;
+	libvshadow_block_descriptor_t *block_descriptor         = NULL;
+	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
+	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_get_block_location_at_offset";
+	intptr_t *value                                         = NULL;
+	off64_t block_descriptor_offset                         = 0;
+	off64_t block_range_offset                              = 0;
+	off64_t overlay_block_offset                            = 0;
+	size64_t block_range_size                               = 0;
+	size_t block_size                                       = 0;
+	uint32_t overlay_bitmap                                 = 0;
+	uint32_t relative_block_offset                          = 0;
+	uint8_t bit_count                                       = 0;
+	int in_block_descriptor_list                            = 0;
+	int in_current_bitmap                                   = 0;
+	int in_previous_bitmap                                  = 0;
+	int in_reverse_block_descriptor_list                    = 0;
+	int result                                              = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( location_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid location offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( location_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid location size.",
+		 function );
+
+		return( -1 );
+	}
+	if( location_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid location type.",
+		 function );
+
+		return( -1 );
+	}
+	if( location_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid location flags.",
+		 function );
+
+		return( -1 );
+	}
+	relative_block_offset = (uint32_t) ( offset % 0x4000 );
+	block_size            = 0x4000 - relative_block_offset;
+
+	*location_flags = 0;
+
+	/* The lookups below mirror those in libvshadow_store_descriptor_read_buffer_reference
+	 */
+	result = libcdata_btree_get_value_by_value(
+	          store_descriptor->forward_block_descriptors_tree,
+	          (intptr_t *) &offset,
+	          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
+	          &tree_node,
+	          (intptr_t **) &block_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( block_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing block descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		in_block_descriptor_list = 1;
+
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 		{
-			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			 && ( store_descriptor->next_store_descriptor != NULL ) )
+			block_descriptor_offset = block_descriptor->relative_offset;
+		}
+		else
+		{
+			block_descriptor_offset = block_descriptor->offset;
+		}
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+		{
+			overlay_block_descriptor = block_descriptor;
+		}
+		else
+		{
+			overlay_block_descriptor = block_descriptor->overlay;
+		}
+		if( overlay_block_descriptor != NULL )
+		{
+			if( store_descriptor->index != active_store_descriptor->index )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_descriptor_offset,
-					      active_store_descriptor,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
+				if( block_descriptor == overlay_block_descriptor )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
-
-					goto on_error;
+					block_descriptor         = NULL;
+					in_block_descriptor_list = 0;
 				}
 			}
 			else
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
+				overlay_block_offset = overlay_block_descriptor->original_offset;
+				overlay_bitmap       = overlay_block_descriptor->bitmap;
+
+				bit_count = 32;
+
+				while( ( overlay_block_offset + 512 ) <= offset )
 				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
+					overlay_bitmap >>= 1;
+
+					overlay_block_offset += 512;
+
+					bit_count--;
+
+					if( bit_count == 0 )
+					{
+						break;
+					}
 				}
-#endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_descriptor_offset,
-				     SEEK_SET,
-				     error ) == -1 )
+				if( ( overlay_bitmap & 0x00000001UL ) != 0 )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_descriptor_offset );
+					block_descriptor_offset = overlay_block_descriptor->offset;
+					block_descriptor        = overlay_block_descriptor;
 
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
+					*location_flags |= LIBVSHADOW_BLOCK_LOCATION_FLAG_IS_OVERLAY;
 
-				if( read_count != (ssize_t) read_size )
+					block_size = 0;
+
+					while( ( overlay_bitmap & 0x00000001UL ) != 0 )
+					{
+						overlay_bitmap >>= 1;
+
+						block_size += 512;
+
+						bit_count--;
+
+						if( bit_count == 0 )
+						{
+							break;
+						}
+					}
+				}
+				else
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
+					if( block_descriptor == overlay_block_descriptor )
+					{
+						block_descriptor         = NULL;
+						in_block_descriptor_list = 0;
+					}
+					block_size = 0;
 
-					goto on_error;
+					while( ( overlay_bitmap & 0x00000001UL ) == 0 )
+					{
+						overlay_bitmap >>= 1;
+
+						block_size += 512;
+
+						bit_count--;
+
+						if( bit_count == 0 )
+						{
+							break;
+						}
+					}
 				}
+				/* The offset is not necessarily sector aligned
+				 */
+				block_size -= (size_t) ( offset - overlay_block_offset );
 			}
 		}
+	}
+	if( in_block_descriptor_list != 0 )
+	{
+		*location_offset = block_descriptor_offset + relative_block_offset;
+
+		if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+		 && ( store_descriptor->next_store_descriptor != NULL ) )
+		{
+			*location_type = LIBVSHADOW_BLOCK_LOCATION_TYPE_NEXT_STORE;
+		}
+		else if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+		{
+			*location_type = LIBVSHADOW_BLOCK_LOCATION_TYPE_CURRENT_VOLUME;
+		}
 		else
 		{
-			/* Check if the next store defines the block
-			 */
-			if( store_descriptor->next_store_descriptor != NULL )
+			*location_type = LIBVSHADOW_BLOCK_LOCATION_TYPE_STORE_DATA;
+		}
+	}
+	else if( store_descriptor->next_store_descriptor != NULL )
+	{
+		*location_offset = offset;
+		*location_type   = LIBVSHADOW_BLOCK_LOCATION_TYPE_NEXT_STORE;
+	}
+	else
+	{
+		/* Only the most recent store seems to bother checking the current bitmap
+		 */
+		if( store_descriptor->index == active_store_descriptor->index )
+		{
+			if( store_descriptor->reverse_block_descriptors_tree == NULL )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_offset,
-					      active_store_descriptor,
-					      error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid store descriptor - missing reverse block descriptors tree.",
+				 function );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
+				return( -1 );
+			}
+			in_reverse_block_descriptor_list = libcdata_btree_get_value_by_value(
+			                                    store_descriptor->reverse_block_descriptors_tree,
+			                                    (intptr_t *) &offset,
+			                                    (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_relative_offset_value,
+			                                    &tree_node,
+			                                    (intptr_t **) &reverse_block_descriptor,
+			                                    error );
+
+			if( in_reverse_block_descriptor_list == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve reverse block descriptor from root node.",
+				 function );
+
+				return( -1 );
+			}
+			in_current_bitmap = libcdata_range_list_get_range_at_offset(
+			                     store_descriptor->block_offset_list,
+			                     (uint64_t) offset,
+			                     (uint64_t *) &block_range_offset,
+			                     (uint64_t *) &block_range_size,
+			                     &value,
+			                     error );
+
+			if( in_current_bitmap == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
+				 function,
+				 offset );
 
-					goto on_error;
-				}
+				return( -1 );
 			}
-			else if( ( in_reverse_block_descriptor_list == 0 )
-			      && ( in_current_bitmap != 0 )
-			      && ( in_previous_bitmap != 0 ) )
+			if( store_descriptor->store_previous_bitmap_offset != 0 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d filling block with zero bytes\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset,
-					 read_size );
-				}
-#endif
-				if( memory_set(
-				     &( buffer[ buffer_offset ] ),
-				     0,
-				     read_size ) == NULL )
+				in_previous_bitmap = libcdata_range_list_get_range_at_offset(
+				                      store_descriptor->previous_block_offset_list,
+				                      (uint64_t) offset,
+				                      (uint64_t *) &block_range_offset,
+				                      (uint64_t *) &block_range_size,
+				                      &value,
+				                      error );
+
+				if( in_previous_bitmap == -1 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear buffer.",
-					 function );
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
+					 function,
+					 offset );
 
-					goto on_error;
+					return( -1 );
 				}
-				read_count = (ssize_t) read_size;
 			}
 			else
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
+				in_previous_bitmap = 1;
+			}
+		}
+		if( ( in_reverse_block_descriptor_list == 0 )
+		 && ( in_current_bitmap != 0 )
+		 && ( in_previous_bitmap != 0 ) )
+		{
+			*location_offset = 0;
+			*location_type   = LIBVSHADOW_BLOCK_LOCATION_TYPE_ZERO;
+		}
+		else
+		{
+			*location_offset = offset;
+			*location_type   = LIBVSHADOW_BLOCK_LOCATION_TYPE_CURRENT_VOLUME;
+		}
+	}
+	*location_size = block_size;
+
+	return( 1 );
+}
+
+/* Reads the block descriptors of the store descriptor and its next store descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_read_chain_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_read_chain_block_descriptors";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* A next store descriptor without in-volume store data ends the chain
+	 */
+	while( ( store_descriptor != NULL )
+	    && ( store_descriptor->has_in_volume_store_data != 0 ) )
+	{
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_block_descriptors(
+		     store_descriptor,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block descriptors of store: %02d.",
+			 function,
+			 store_descriptor->index );
+
+			return( -1 );
+		}
+		store_descriptor = store_descriptor->next_store_descriptor;
+	}
+	return( 1 );
+}
+
+/* Grabs the read locks of the store descriptor and its next store descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_grab_chain_for_read(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function                                = "libvshadow_store_descriptor_grab_chain_for_read";
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libvshadow_store_descriptor_t *next_store_descriptor = NULL;
 #endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_offset );
 
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	for( next_store_descriptor = store_descriptor;
+	     next_store_descriptor != NULL;
+	     next_store_descriptor = next_store_descriptor->next_store_descriptor )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     next_store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+on_error:
+	while( store_descriptor != next_store_descriptor )
+	{
+		libcthreads_read_write_lock_release_for_read(
+		 store_descriptor->read_write_lock,
+		 NULL );
+
+		store_descriptor = store_descriptor->next_store_descriptor;
+	}
+	return( -1 );
+#endif
+}
+
+/* Releases the read locks of the store descriptor and its next store descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_release_chain_for_read(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_release_chain_for_read";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	while( store_descriptor != NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			result = -1;
+		}
+		store_descriptor = store_descriptor->next_store_descriptor;
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent at the specified offset
+ * The extent is followed through the next store descriptors until the store
+ * data, the current volume data or a sparse (zero filled) range is found
+ * This function is not multi-thread safe the block descriptors of the chain
+ * must have been read and their read locks must be held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_chain_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvshadow_store_descriptor_get_chain_extent_at_offset";
+	off64_t location_offset = 0;
+	size_t location_size    = 0;
+	size_t maximum_size     = 0;
+	uint8_t location_flags  = 0;
+	int location_type       = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( store_descriptor->has_in_volume_store_data == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid store descriptor - missing in-volume store data.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_store_descriptor_get_block_location_at_offset(
+		     store_descriptor,
+		     offset,
+		     active_store_descriptor,
+		     &location_offset,
+		     &location_size,
+		     &location_type,
+		     &location_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %02d block location at offset: 0x%08" PRIx64 ".",
+			 function,
+			 store_descriptor->index,
+			 offset );
+
+			return( -1 );
+		}
+		if( ( maximum_size == 0 )
+		 || ( location_size < maximum_size ) )
+		{
+			maximum_size = location_size;
+		}
+		if( location_type != LIBVSHADOW_BLOCK_LOCATION_TYPE_NEXT_STORE )
+		{
+			break;
+		}
+		offset           = location_offset;
+		store_descriptor = store_descriptor->next_store_descriptor;
+	}
+	while( store_descriptor != NULL );
+
+	switch( location_type )
+	{
+		case LIBVSHADOW_BLOCK_LOCATION_TYPE_CURRENT_VOLUME:
+			*extent_offset = location_offset;
+			*extent_flags  = 0;
+			break;
+
+		case LIBVSHADOW_BLOCK_LOCATION_TYPE_STORE_DATA:
+			*extent_offset = location_offset;
+			*extent_flags  = LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA;
+			break;
+
+		case LIBVSHADOW_BLOCK_LOCATION_TYPE_ZERO:
+			*extent_offset = 0;
+			*extent_flags  = LIBVSHADOW_EXTENT_FLAG_IS_SPARSE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported block location type: %d.",
+			 function,
+			 location_type );
+
+			return( -1 );
+	}
+	*extent_size = (size64_t) maximum_size;
+
+	return( 1 );
+}
+
+/* Retrieves the extent at the specified offset
+ * The extent is followed through the next store descriptors until the store
+ * data, the current volume data or a sparse (zero filled) range is found
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_extent_at_offset";
+	int result            = 0;
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
+	if( libvshadow_store_descriptor_read_chain_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
 
-					goto on_error;
-				}
-			}
-		}
-		offset        += read_count;
-		buffer_offset += read_count;
-		buffer_size   -= read_count;
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_grab_chain_for_read(
+	     store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read locks.",
+		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "\n" );
-		}
-#endif
+		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     store_descriptor->read_write_lock,
+	result = libvshadow_store_descriptor_get_chain_extent_at_offset(
+	          store_descriptor,
+	          offset,
+	          active_store_descriptor,
+	          extent_offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( libvshadow_store_descriptor_release_chain_for_read(
+	     store_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read locks.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( (ssize_t) buffer_offset );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
 
-on_error:
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 store_descriptor->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Retrieves the volume size
@@ -3415,3 +4969,233 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 	return( result );
 }
 
+/* Retrieves the block table
+ * The block table contains an entry of LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE bytes per block
+ * descriptor, in the same order as the block descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_table(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *block_table,
+     size_t block_table_size,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *list_element           = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_store_descriptor_get_block_table";
+	size_t block_table_offset                       = 0;
+	int block_index                                 = 0;
+	int number_of_blocks                            = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_table_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block table size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the write lock
+	 */
+	if( libvshadow_store_descriptor_read_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_list_get_number_of_elements(
+	     store_descriptor->block_descriptors_list,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( (size_t) number_of_blocks * LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE ) > block_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid block table size value too small.",
+		 function );
+
+		goto on_error;
+	}
+	/* The list is walked element by element since retrieving
+	 * the block descriptors by index is linear per block
+	 */
+	if( libcdata_list_get_first_element(
+	     store_descriptor->block_descriptors_list,
+	     &list_element,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first block descriptor list element.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( libcdata_list_element_get_value(
+		     list_element,
+		     (intptr_t **) &block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( block_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing block descriptor: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_table[ block_table_offset ] ),
+		 (uint64_t) block_descriptor->original_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_table[ block_table_offset + 8 ] ),
+		 (uint64_t) block_descriptor->relative_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_table[ block_table_offset + 16 ] ),
+		 (uint64_t) block_descriptor->offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_table[ block_table_offset + 24 ] ),
+		 block_descriptor->flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_table[ block_table_offset + 28 ] ),
+		 block_descriptor->bitmap );
+
+		block_table_offset += LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE;
+
+		if( libcdata_list_element_get_next_element(
+		     list_element,
+		     &list_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next block descriptor list element.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
@@ -26,10 +26,12 @@
 #include <types.h>
 
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -122,6 +124,10 @@ struct libvshadow_store_descriptor
 	 */
 	libcdata_range_list_t *previous_block_offset_list;
 
+	/* The IO handle
+	 */
+	libvshadow_io_handle_t *io_handle;
+
 	/* The previous store descriptor in the read chain
 	 */
 	libvshadow_store_descriptor_t *previous_store_descriptor;
@@ -142,6 +148,10 @@ struct libvshadow_store_descriptor
 	 */
 	uint8_t block_descriptors_read;
 
+	/* The read statistics
+	 */
+	libvshadow_statistics_t *statistics;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -211,6 +221,16 @@ int libvshadow_store_descriptor_read_block_descriptors(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+ssize_t libvshadow_store_descriptor_read_buffer_with_statistics(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         uint64_t *statistics,
+         libcerror_error_t **error );
+
 ssize_t libvshadow_store_descriptor_read_buffer(
          libvshadow_store_descriptor_t *store_descriptor,
          libbfio_handle_t *file_io_handle,
@@ -220,6 +240,57 @@ ssize_t libvshadow_store_descriptor_read_buffer(
          libvshadow_store_descriptor_t *active_store_descriptor,
          libcerror_error_t **error );
 
+ssize_t libvshadow_store_descriptor_read_buffer_reference(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_store_descriptor_t *active_store_descriptor,
+         libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_location_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *location_offset,
+     size_t *location_size,
+     int *location_type,
+     uint8_t *location_flags,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_read_chain_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_grab_chain_for_read(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_release_chain_for_read(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_chain_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_get_volume_size(
      libvshadow_store_descriptor_t *store_descriptor,
      size64_t *volume_size,
@@ -266,6 +337,13 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
      libvshadow_block_descriptor_t **block_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_get_block_table(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *block_table,
+     size_t block_table_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -35,11 +35,13 @@
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libvshadow_block {}	libvshadow_block_t;
+typedef struct libvshadow_block_map {}	libvshadow_block_map_t;
 typedef struct libvshadow_store {}	libvshadow_store_t;
 typedef struct libvshadow_volume {}	libvshadow_volume_t;
 
 #else
 typedef intptr_t libvshadow_block_t;
+typedef intptr_t libvshadow_block_map_t;
 typedef intptr_t libvshadow_store_t;
 typedef intptr_t libvshadow_volume_t;
 
@@ -25,6 +25,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libvshadow_block_map.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
 #include "libvshadow_io_handle.h"
@@ -33,6 +34,8 @@
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_probes.h"
+#include "libvshadow_statistics.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
 #include "libvshadow_volume.h"
@@ -950,6 +953,8 @@ int libvshadow_volume_open_read(
 	libvshadow_store_descriptor_t *store_descriptor      = NULL;
 	static char *function                                = "libvshadow_volume_open_read";
 	off64_t catalog_offset                               = 0;
+	uint64_t current_time                                = 0;
+	uint64_t start_time                                  = 0;
 	int number_of_store_descriptors                      = 0;
 	int store_descriptor_index                           = 0;
 
@@ -990,6 +995,22 @@ int libvshadow_volume_open_read(
 		return( -1 );
 	}
 #endif
+	if( libvshadow_statistics_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	LIBVSHADOW_PROBE0(
+	 volume__open__start )
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1035,6 +1056,10 @@ int libvshadow_volume_open_read(
 
 		goto on_error;
 	}
+	LIBVSHADOW_PROBE1(
+	 volume__header__done,
+	 catalog_offset )
+
 	if( catalog_offset > 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1075,6 +1100,10 @@ int libvshadow_volume_open_read(
 
 			goto on_error;
 		}
+		LIBVSHADOW_PROBE1(
+		 volume__catalog__done,
+		 number_of_store_descriptors )
+
 		for( store_descriptor_index = 0;
 		     store_descriptor_index < number_of_store_descriptors;
 		     store_descriptor_index++ )
@@ -1146,6 +1175,41 @@ int libvshadow_volume_open_read(
 			store_descriptor = NULL;
 		}
 	}
+	if( libvshadow_statistics_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	LIBVSHADOW_PROBE1(
+	 volume__open__done,
+	 number_of_store_descriptors )
+
+	if( current_time > start_time )
+	{
+		if( libvshadow_statistics_add_value(
+		     internal_volume->io_handle->statistics,
+		     LIBVSHADOW_STATISTIC_LOAD_TIME,
+		     current_time - start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -1520,3 +1584,433 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the statistics
+ * The statistics are indexed by the LIBVSHADOW_STATISTIC definitions and
+ * contain the sum of the statistics of the volume metadata and of all stores
+ * If number of statistics is smaller than LIBVSHADOW_NUMBER_OF_STATISTICS only
+ * the first number of statistics are retrieved, additional statistics are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error )
+{
+	uint64_t store_values[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+	uint64_t values[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_get_statistics";
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+	int value_index                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_statistics < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of statistics value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_statistics_get_values(
+	     internal_volume->io_handle->statistics,
+	     values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( store_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_statistics_get_values(
+		     store_descriptor->statistics,
+		     store_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		for( value_index = 0;
+		     value_index < LIBVSHADOW_NUMBER_OF_STATISTICS;
+		     value_index++ )
+		{
+			values[ value_index ] += store_values[ value_index ];
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( value_index = 0;
+	     value_index < number_of_statistics;
+	     value_index++ )
+	{
+		if( value_index < LIBVSHADOW_NUMBER_OF_STATISTICS )
+		{
+			statistics[ value_index ] = values[ value_index ];
+		}
+		else
+		{
+			statistics[ value_index ] = 0;
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the block map
+ * The block map contains the unique physical blocks that the stores map to,
+ * other than the current volume data at the same offset and sparse data
+ * Reading the block map reads the block descriptors of all the stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_block_map(
+     libvshadow_volume_t *volume,
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_block_map";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( block_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_block_map_initialize(
+	     block_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_map_read_store_descriptors(
+	     *block_map,
+	     internal_volume->store_descriptors_array,
+	     internal_volume->file_io_handle,
+	     internal_volume->size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block map.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libvshadow_block_map_free(
+		 block_map,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *block_map != NULL )
+	{
+		libvshadow_block_map_free(
+		 block_map,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the IO callback
+ * The IO callback is called for every physical read, metadata block read,
+ * zero fill and block descriptors cache hit or miss, refer to the
+ * LIBVSHADOW_IO_EVENT_TYPE definitions
+ * The callback can be called from multiple threads at the same time and
+ * should be set before the volume is opened or read from
+ * Use NULL to unset the IO callback
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_io_callback(
+     libvshadow_volume_t *volume,
+     void (*io_callback)(
+            int event_type,
+            int store_index,
+            off64_t offset,
+            size64_t size,
+            uint32_t record_type,
+            uint64_t latency,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_io_callback";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->io_callback           = io_callback;
+	internal_volume->io_handle->io_callback_user_data = user_data;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -149,6 +149,33 @@ int libvshadow_volume_get_store_identifier(
      size_t size,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *statistics,
+     int number_of_statistics,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_block_map(
+     libvshadow_volume_t *volume,
+     libvshadow_block_map_t **block_map,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_io_callback(
+     libvshadow_volume_t *volume,
+     void (*io_callback)(
+            int event_type,
+            int store_index,
+            off64_t offset,
+            size64_t size,
+            uint32_t record_type,
+            uint64_t latency,
+            intptr_t *user_data ),
+     intptr_t *user_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
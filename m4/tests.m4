@@ -21,3 +21,79 @@ AC_DEFUN([AX_TESTS_CHECK_LOCAL],
   ])
 ])
 
+
+dnl Function to detect if the library and tests should be build with ThreadSanitizer
+AC_DEFUN([AX_TESTS_CHECK_ENABLE_THREAD_SANITIZER],
+  [AX_COMMON_ARG_ENABLE(
+    [thread-sanitizer],
+    [thread_sanitizer],
+    [build with ThreadSanitizer to detect data races in the multi-threading tests],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_thread_sanitizer" != xno],
+    [ac_tests_thread_sanitizer_cflags="$CFLAGS"
+    ac_tests_thread_sanitizer_ldflags="$LDFLAGS"
+
+    CFLAGS="$CFLAGS -fsanitize=thread -fno-omit-frame-pointer -g"
+    LDFLAGS="$LDFLAGS -fsanitize=thread"
+
+    AC_MSG_CHECKING(
+      [whether $CC supports -fsanitize=thread])
+
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[]],
+        [[]])],
+      [AC_MSG_RESULT(
+        [yes])
+      ac_cv_enable_thread_sanitizer=yes],
+      [AC_MSG_RESULT(
+        [no])
+      CFLAGS="$ac_tests_thread_sanitizer_cflags"
+      LDFLAGS="$ac_tests_thread_sanitizer_ldflags"
+
+      AC_MSG_FAILURE(
+        [ThreadSanitizer is not supported by $CC],
+        [1])
+    ])
+  ])
+])
+
+
+dnl Function to detect if the SHA-256 block function of the tools can be tested
+dnl using the SHA extensions
+AC_DEFUN([AX_TESTS_CHECK_SHA256_INTRINSICS],
+  [ac_tests_sha256_intrinsics_cflags="$CFLAGS"
+
+  CFLAGS="$CFLAGS -msha -msse4.1 -mssse3"
+
+  AC_MSG_CHECKING(
+    [whether $CC supports the SHA extensions])
+
+  AC_COMPILE_IFELSE(
+    [AC_LANG_PROGRAM(
+      [[#include <immintrin.h>]],
+      [[__m128i value = _mm_setzero_si128();
+value = _mm_sha256rnds2_epu32( value, value, value );
+return( _mm_cvtsi128_si32( value ) ); ]])],
+    [AC_MSG_RESULT(
+      [yes])
+    ac_cv_tests_sha256_intrinsics=yes],
+    [AC_MSG_RESULT(
+      [no])
+    ac_cv_tests_sha256_intrinsics=no])
+
+  CFLAGS="$ac_tests_sha256_intrinsics_cflags"
+
+  AS_IF(
+    [test "x$ac_cv_tests_sha256_intrinsics" = xyes],
+    [AC_SUBST(
+      [TESTS_SHA256_INTRINSICS_CFLAGS],
+      ["-msha -msse4.1 -mssse3"])
+  ])
+
+  AM_CONDITIONAL(
+    HAVE_TESTS_SHA256_INTRINSICS,
+    [test "x$ac_cv_tests_sha256_intrinsics" = xyes])
+])
@@ -30,6 +30,7 @@
 #include "pyvshadow.h"
 #include "pyvshadow_block.h"
 #include "pyvshadow_block_flags.h"
+#include "pyvshadow_block_table.h"
 #include "pyvshadow_blocks.h"
 #include "pyvshadow_error.h"
 #include "pyvshadow_file_object_io_handle.h"
@@ -84,9 +85,10 @@ PyMethodDef pyvshadow_module_methods[] = {
 	{ "open_file_object",
 	  (PyCFunction) pyvshadow_volume_new_open_file_object,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "open_file_object(file_object, mode='r') -> Object\n"
+	  "open_file_object(file_object, mode='r', read_ahead_size=65536) -> Object\n"
 	  "\n"
-	  "Opens a volume using a file-like object." },
+	  "Opens a volume using a file-like object.\n"
+	  "Small reads are served from read-ahead data that is read from the file-like object in aligned blocks of read_ahead_size, which must be a multiple of 512, 0 disables read-ahead." },
 
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
@@ -345,9 +347,12 @@ PyObject *pyvshadow_check_volume_signature_file_object(
 	{
 		return( NULL );
 	}
+	/* The signature check reads a single sector hence read-ahead is not used
+	 */
 	if( pyvshadow_file_object_initialize(
 	     &file_io_handle,
 	     file_object,
+	     0,
 	     &error ) != 1 )
 	{
 		pyvshadow_error_raise(
@@ -459,6 +464,7 @@ PyMODINIT_FUNC initpyvshadow(
 	PyObject *module                      = NULL;
 	PyTypeObject *block_type_object       = NULL;
 	PyTypeObject *block_flags_type_object = NULL;
+	PyTypeObject *block_table_type_object = NULL;
 	PyTypeObject *blocks_type_object      = NULL;
 	PyTypeObject *store_type_object       = NULL;
 	PyTypeObject *stores_type_object      = NULL;
@@ -574,6 +580,25 @@ PyMODINIT_FUNC initpyvshadow(
 	 "_blocks",
 	 (PyObject *) blocks_type_object );
 
+	/* Setup the block table type object
+	 */
+	pyvshadow_block_table_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyvshadow_block_table_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyvshadow_block_table_type_object );
+
+	block_table_type_object = &pyvshadow_block_table_type_object;
+
+	PyModule_AddObject(
+	 module,
+	 "block_table",
+	 (PyObject *) block_table_type_object );
+
 	/* Setup the block type object
 	 */
 	pyvshadow_block_type_object.tp_new = PyType_GenericNew;
@@ -0,0 +1,440 @@
+/*
+ * Python object definition of the block table
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyvshadow_block_table.h"
+#include "pyvshadow_libvshadow.h"
+#include "pyvshadow_python.h"
+
+/* The format of a block table entry as defined by the struct module syntax
+ * which allows numpy to map the block table to a structured array
+ */
+static char *pyvshadow_block_table_entry_format = "T{<q:original_offset:<q:relative_offset:<q:offset:<I:flags:<I:bitmap:}";
+
+PySequenceMethods pyvshadow_block_table_sequence_methods = {
+	/* sq_length */
+	(lenfunc) pyvshadow_block_table_len,
+	/* sq_concat */
+	0,
+	/* sq_repeat */
+	0,
+	/* sq_item */
+	0,
+	/* sq_slice */
+	0,
+	/* sq_ass_item */
+	0,
+	/* sq_ass_slice */
+	0,
+	/* sq_contains */
+	0,
+	/* sq_inplace_concat */
+	0,
+	/* sq_inplace_repeat */
+	0
+};
+
+PyBufferProcs pyvshadow_block_table_buffer_procs = {
+#if PY_MAJOR_VERSION < 3
+	/* bf_getreadbuffer */
+	0,
+	/* bf_getwritebuffer */
+	0,
+	/* bf_getsegcount */
+	0,
+	/* bf_getcharbuffer */
+	0,
+#endif
+	/* bf_getbuffer */
+	(getbufferproc) pyvshadow_block_table_getbuffer,
+	/* bf_releasebuffer */
+	0
+};
+
+PyTypeObject pyvshadow_block_table_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyvshadow.block_table",
+	/* tp_basicsize */
+	sizeof( pyvshadow_block_table_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyvshadow_block_table_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	&pyvshadow_block_table_sequence_methods,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	&pyvshadow_block_table_buffer_procs,
+	/* tp_flags */
+#if PY_MAJOR_VERSION >= 3
+	Py_TPFLAGS_DEFAULT,
+#else
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER,
+#endif
+	/* tp_doc */
+	"pyvshadow block table object (wraps the block descriptors of a store)\n"
+	"\n"
+	"The block table supports the buffer protocol. Every entry contains the original offset,\n"
+	"relative offset, offset, flags and bitmap of a block, e.g. numpy.asarray(block_table)\n"
+	"returns a structured array that refers to the block table without copying the data.",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	0,
+	/* tp_iternext */
+	0,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyvshadow_block_table_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new block table object
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_block_table_new(
+           int number_of_entries )
+{
+	pyvshadow_block_table_t *pyvshadow_block_table = NULL;
+	static char *function                          = "pyvshadow_block_table_new";
+	size_t data_size                               = 0;
+
+	if( number_of_entries < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of entries value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( (size_t) number_of_entries > ( (size_t) PY_SSIZE_T_MAX / LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of entries value exceeds maximum.",
+		 function );
+
+		return( NULL );
+	}
+	data_size = (size_t) number_of_entries * LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE;
+
+	pyvshadow_block_table = PyObject_New(
+	                         struct pyvshadow_block_table,
+	                         &pyvshadow_block_table_type_object );
+
+	if( pyvshadow_block_table == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize block table.",
+		 function );
+
+		goto on_error;
+	}
+	if( pyvshadow_block_table_init(
+	     pyvshadow_block_table ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize block table.",
+		 function );
+
+		goto on_error;
+	}
+	/* Allocate at least 1 byte so that an empty block table
+	 * still provides a valid buffer
+	 */
+	pyvshadow_block_table->data = (uint8_t *) PyMem_Malloc(
+	                                           ( data_size > 0 ) ? data_size : 1 );
+
+	if( pyvshadow_block_table->data == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create block table data.",
+		 function );
+
+		goto on_error;
+	}
+	pyvshadow_block_table->data_size         = (Py_ssize_t) data_size;
+	pyvshadow_block_table->number_of_entries = (Py_ssize_t) number_of_entries;
+
+	return( (PyObject *) pyvshadow_block_table );
+
+on_error:
+	if( pyvshadow_block_table != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) pyvshadow_block_table );
+	}
+	return( NULL );
+}
+
+/* Intializes a block table object
+ * Returns 0 if successful or -1 on error
+ */
+int pyvshadow_block_table_init(
+     pyvshadow_block_table_t *pyvshadow_block_table )
+{
+	static char *function = "pyvshadow_block_table_init";
+
+	if( pyvshadow_block_table == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the block table values are initialized
+	 */
+	pyvshadow_block_table->data              = NULL;
+	pyvshadow_block_table->data_size         = 0;
+	pyvshadow_block_table->number_of_entries = 0;
+	pyvshadow_block_table->entry_size        = (Py_ssize_t) LIBVSHADOW_BLOCK_TABLE_ENTRY_SIZE;
+	pyvshadow_block_table->byte_size         = 1;
+
+	return( 0 );
+}
+
+/* Frees a block table object
+ */
+void pyvshadow_block_table_free(
+      pyvshadow_block_table_t *pyvshadow_block_table )
+{
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pyvshadow_block_table_free";
+
+	if( pyvshadow_block_table == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid block table.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pyvshadow_block_table );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pyvshadow_block_table->data != NULL )
+	{
+		PyMem_Free(
+		 pyvshadow_block_table->data );
+
+		pyvshadow_block_table->data = NULL;
+	}
+	ob_type->tp_free(
+	 (PyObject*) pyvshadow_block_table );
+}
+
+/* The block table len() function
+ */
+Py_ssize_t pyvshadow_block_table_len(
+            pyvshadow_block_table_t *pyvshadow_block_table )
+{
+	static char *function = "pyvshadow_block_table_len";
+
+	if( pyvshadow_block_table == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	return( pyvshadow_block_table->number_of_entries );
+}
+
+/* The block table get buffer function
+ * The buffer is read-only and refers to the block table data
+ * Returns 0 if successful or -1 on error
+ */
+int pyvshadow_block_table_getbuffer(
+     pyvshadow_block_table_t *pyvshadow_block_table,
+     Py_buffer *view,
+     int flags )
+{
+	static char *function = "pyvshadow_block_table_getbuffer";
+
+	if( pyvshadow_block_table == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid block table.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvshadow_block_table->data == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid block table - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & PyBUF_WRITABLE ) == PyBUF_WRITABLE )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: block table is read-only.",
+		 function );
+
+		return( -1 );
+	}
+	if( view == NULL )
+	{
+		return( 0 );
+	}
+	view->buf        = (void *) pyvshadow_block_table->data;
+	view->len        = pyvshadow_block_table->data_size;
+	view->readonly   = 1;
+	view->ndim       = 1;
+	view->suboffsets = NULL;
+	view->internal   = NULL;
+
+	/* Without a format the consumer expects unsigned bytes
+	 */
+	if( ( flags & PyBUF_FORMAT ) == PyBUF_FORMAT )
+	{
+		view->format   = pyvshadow_block_table_entry_format;
+		view->itemsize = pyvshadow_block_table->entry_size;
+		view->shape    = &( pyvshadow_block_table->number_of_entries );
+		view->strides  = &( pyvshadow_block_table->entry_size );
+	}
+	else
+	{
+		view->format   = NULL;
+		view->itemsize = pyvshadow_block_table->byte_size;
+		view->shape    = &( pyvshadow_block_table->data_size );
+		view->strides  = &( pyvshadow_block_table->byte_size );
+	}
+	if( ( flags & PyBUF_ND ) != PyBUF_ND )
+	{
+		view->shape = NULL;
+	}
+	if( ( flags & PyBUF_STRIDES ) != PyBUF_STRIDES )
+	{
+		view->strides = NULL;
+	}
+	view->obj = (PyObject *) pyvshadow_block_table;
+
+	Py_IncRef(
+	 view->obj );
+
+	return( 0 );
+}
+
@@ -0,0 +1,88 @@
+/*
+ * Python object definition of the block table
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYVSHADOW_BLOCK_TABLE_H )
+#define _PYVSHADOW_BLOCK_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyvshadow_libvshadow.h"
+#include "pyvshadow_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pyvshadow_block_table pyvshadow_block_table_t;
+
+struct pyvshadow_block_table
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The block table data
+	 */
+	uint8_t *data;
+
+	/* The block table data size
+	 */
+	Py_ssize_t data_size;
+
+	/* The number of entries
+	 */
+	Py_ssize_t number_of_entries;
+
+	/* The entry size
+	 */
+	Py_ssize_t entry_size;
+
+	/* The byte size, used as stride of the unformatted buffer view
+	 */
+	Py_ssize_t byte_size;
+};
+
+extern PyTypeObject pyvshadow_block_table_type_object;
+
+PyObject *pyvshadow_block_table_new(
+           int number_of_entries );
+
+int pyvshadow_block_table_init(
+     pyvshadow_block_table_t *pyvshadow_block_table );
+
+void pyvshadow_block_table_free(
+      pyvshadow_block_table_t *pyvshadow_block_table );
+
+Py_ssize_t pyvshadow_block_table_len(
+            pyvshadow_block_table_t *pyvshadow_block_table );
+
+int pyvshadow_block_table_getbuffer(
+     pyvshadow_block_table_t *pyvshadow_block_table,
+     Py_buffer *view,
+     int flags );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYVSHADOW_BLOCK_TABLE_H ) */
+
@@ -102,7 +102,8 @@ int pyvshadow_file_object_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *file_object_io_handle )->file_object = file_object;
+	( *file_object_io_handle )->file_object  = file_object;
+	( *file_object_io_handle )->has_readinto = -1;
 
 	Py_IncRef(
 	 ( *file_object_io_handle )->file_object );
@@ -126,6 +127,7 @@ on_error:
 int pyvshadow_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	pyvshadow_file_object_io_handle_t *file_object_io_handle = NULL;
@@ -167,6 +169,20 @@ int pyvshadow_file_object_initialize(
 
 		goto on_error;
 	}
+	if( pyvshadow_file_object_io_handle_set_read_ahead_size(
+	     file_object_io_handle,
+	     read_ahead_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read-ahead size.",
+		 function );
+
+		goto on_error;
+	}
 	if( libbfio_handle_initialize(
 	     handle,
 	     (intptr_t *) file_object_io_handle,
@@ -204,6 +220,67 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the read-ahead size
+ * The read-ahead data is read in blocks of the read-ahead size that are aligned
+ * to the read-ahead size, a read-ahead size of 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_file_object_io_handle_set_read_ahead_size(
+     pyvshadow_file_object_io_handle_t *file_object_io_handle,
+     size_t read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_file_object_io_handle_set_read_ahead_size";
+
+	if( file_object_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_object_io_handle->read_ahead_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file object IO handle - read-ahead data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_ahead_size % 512 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported read-ahead size value not a multiple of 512.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_size > (size_t) PYVSHADOW_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	file_object_io_handle->read_ahead_size = read_ahead_size;
+
+	return( 1 );
+}
+
 /* Frees a file object IO handle
  * Returns 1 if succesful or -1 on error
  */
@@ -232,6 +309,11 @@ int pyvshadow_file_object_io_handle_free(
 		Py_DecRef(
 		 ( *file_object_io_handle )->file_object );
 
+		if( ( *file_object_io_handle )->read_ahead_data != NULL )
+		{
+			PyMem_Free(
+			 ( *file_object_io_handle )->read_ahead_data );
+		}
 		PyGILState_Release(
 		 gil_state );
 
@@ -306,6 +388,11 @@ int pyvshadow_file_object_io_handle_clone(
 
 		return( -1 );
 	}
+	/* The clone has its own read-ahead data, the file object is shared
+	 */
+	( *destination_file_object_io_handle )->read_ahead_size = source_file_object_io_handle->read_ahead_size;
+	( *destination_file_object_io_handle )->has_readinto    = source_file_object_io_handle->has_readinto;
+
 	return( 1 );
 }
 
@@ -366,7 +453,9 @@ int pyvshadow_file_object_io_handle_open(
 	}
 	/* No need to do anything here, because the file object is already open
 	 */
-	file_object_io_handle->access_flags = access_flags;
+	file_object_io_handle->access_flags         = access_flags;
+	file_object_io_handle->current_offset       = 0;
+	file_object_io_handle->read_ahead_data_size = 0;
 
 	return( 1 );
 }
@@ -404,7 +493,8 @@ int pyvshadow_file_object_io_handle_close(
 	}
 	/* Do not close the file object, have Python deal with it
 	 */
-	file_object_io_handle->access_flags = 0;
+	file_object_io_handle->access_flags         = 0;
+	file_object_io_handle->read_ahead_data_size = 0;
 
 	return( 0 );
 }
@@ -613,18 +703,223 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a buffer from the file object IO handle
+#if PY_MAJOR_VERSION >= 3
+
+/* Reads a buffer from the file object using its readinto method
+ * This avoids creating an intermediate binary string object
+ * Make sure to hold the GIL state before calling this function
  * Returns the number of bytes read if successful, or -1 on error
  */
-ssize_t pyvshadow_file_object_io_handle_read(
+ssize_t pyvshadow_file_object_read_buffer_into(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	PyObject *memory_view    = NULL;
+	PyObject *method_name    = NULL;
+	PyObject *method_result  = NULL;
+	PyObject *release_result = NULL;
+	static char *function    = "pyvshadow_file_object_read_buffer_into";
+	int64_t read_count       = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	memory_view = PyMemoryView_FromMemory(
+	               (char *) buffer,
+	               (Py_ssize_t) size,
+	               PyBUF_WRITE );
+
+	if( memory_view == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory view.",
+		 function );
+
+		goto on_error;
+	}
+	method_name = PyUnicode_FromString(
+	               "readinto" );
+
+	PyErr_Clear();
+
+	method_result = PyObject_CallMethodObjArgs(
+	                 file_object,
+	                 method_name,
+	                 memory_view,
+	                 NULL );
+
+	if( PyErr_Occurred() )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file object.",
+		 function );
+
+		goto on_error;
+	}
+	if( method_result == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing method result.",
+		 function );
+
+		goto on_error;
+	}
+	/* A non-blocking file object returns None if no data is available
+	 */
+	if( method_result == Py_None )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported method result value: None.",
+		 function );
+
+		goto on_error;
+	}
+	if( pyvshadow_integer_signed_copy_to_64bit(
+	     method_result,
+	     &read_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to convert method result into read count.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( read_count < 0 )
+	 || ( (uint64_t) read_count > (uint64_t) size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read count value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Release the memory view so that a reference retained by the file object
+	 * can no longer access the buffer
+	 */
+	release_result = PyObject_CallMethod(
+	                  memory_view,
+	                  "release",
+	                  NULL );
+
+	if( release_result != NULL )
+	{
+		Py_DecRef(
+		 release_result );
+	}
+	PyErr_Clear();
+
+	Py_DecRef(
+	 method_result );
+
+	Py_DecRef(
+	 method_name );
+
+	Py_DecRef(
+	 memory_view );
+
+	return( (ssize_t) read_count );
+
+on_error:
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( method_name != NULL )
+	{
+		Py_DecRef(
+		 method_name );
+	}
+	if( memory_view != NULL )
+	{
+		release_result = PyObject_CallMethod(
+		                  memory_view,
+		                  "release",
+		                  NULL );
+
+		if( release_result != NULL )
+		{
+			Py_DecRef(
+			 release_result );
+		}
+		Py_DecRef(
+		 memory_view );
+	}
+	return( -1 );
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+/* Reads a buffer at a specific offset from the file object of the file object IO handle
+ * The file object is always positioned before reading, since clones share the file object
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_io_handle_read_from_file_object(
          pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         off64_t offset,
          uint8_t *buffer,
          size_t size,
          libcerror_error_t **error )
 {
-	static char *function      = "pyvshadow_file_object_io_handle_read";
-	PyGILState_STATE gil_state = 0;
-	ssize_t read_count         = 0;
+	static char *function = "pyvshadow_file_object_io_handle_read_from_file_object";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -637,8 +932,62 @@ ssize_t pyvshadow_file_object_io_handle_read(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
+	if( pyvshadow_file_object_seek_offset(
+	     file_object_io_handle->file_object,
+	     offset,
+	     SEEK_SET,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file object.",
+		 function,
+		 offset,
+		 offset );
 
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	if( file_object_io_handle->has_readinto == -1 )
+	{
+		file_object_io_handle->has_readinto = PyObject_HasAttrString(
+		                                       file_object_io_handle->file_object,
+		                                       "readinto" );
+	}
+	if( file_object_io_handle->has_readinto != 0 )
+	{
+		/* readinto can return less data than requested for unbuffered file objects
+		 */
+		while( buffer_offset < size )
+		{
+			read_count = pyvshadow_file_object_read_buffer_into(
+			              file_object_io_handle->file_object,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read into buffer from file object.",
+				 function );
+
+				return( -1 );
+			}
+			if( read_count == 0 )
+			{
+				break;
+			}
+			buffer_offset += (size_t) read_count;
+		}
+		return( (ssize_t) buffer_offset );
+	}
+#endif
 	read_count = pyvshadow_file_object_read_buffer(
 	              file_object_io_handle->file_object,
 	              buffer,
@@ -654,12 +1003,177 @@ ssize_t pyvshadow_file_object_io_handle_read(
 		 "%s: unable to read from file object.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads a buffer from the file object IO handle
+ * Small reads are served from the read-ahead data, which is read in aligned
+ * blocks of the read-ahead size, reads of at least the read-ahead size bypass it
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_io_handle_read(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function      = "pyvshadow_file_object_io_handle_read";
+	size_t buffer_offset       = 0;
+	size_t data_offset         = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	PyGILState_STATE gil_state = 0;
+
+	if( file_object_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	gil_state = PyGILState_Ensure();
+
+	if( ( file_object_io_handle->read_ahead_size > 0 )
+	 && ( file_object_io_handle->read_ahead_data == NULL ) )
+	{
+		file_object_io_handle->read_ahead_data = (uint8_t *) PyMem_Malloc(
+		                                                      file_object_io_handle->read_ahead_size );
+
+		if( file_object_io_handle->read_ahead_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read-ahead data.",
+			 function );
+
+			goto on_error;
+		}
+		file_object_io_handle->read_ahead_data_size = 0;
+	}
+	while( buffer_offset < size )
+	{
+		if( ( file_object_io_handle->read_ahead_data_size > 0 )
+		 && ( file_object_io_handle->current_offset >= file_object_io_handle->read_ahead_offset )
+		 && ( file_object_io_handle->current_offset < ( file_object_io_handle->read_ahead_offset + (off64_t) file_object_io_handle->read_ahead_data_size ) ) )
+		{
+			data_offset = (size_t) ( file_object_io_handle->current_offset - file_object_io_handle->read_ahead_offset );
+			read_size   = file_object_io_handle->read_ahead_data_size - data_offset;
+
+			if( read_size > ( size - buffer_offset ) )
+			{
+				read_size = size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( file_object_io_handle->read_ahead_data[ data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy read-ahead data to buffer.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += read_size;
+			file_object_io_handle->current_offset += (off64_t) read_size;
+
+			continue;
+		}
+		read_size = size - buffer_offset;
+
+		if( read_size >= file_object_io_handle->read_ahead_size )
+		{
+			read_count = pyvshadow_file_object_io_handle_read_from_file_object(
+			              file_object_io_handle,
+			              file_object_io_handle->current_offset,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file object.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += (size_t) read_count;
+			file_object_io_handle->current_offset += (off64_t) read_count;
+
+			break;
+		}
+		file_object_io_handle->read_ahead_offset    = file_object_io_handle->current_offset
+		                                            - ( file_object_io_handle->current_offset % (off64_t) file_object_io_handle->read_ahead_size );
+		file_object_io_handle->read_ahead_data_size = 0;
+
+		read_count = pyvshadow_file_object_io_handle_read_from_file_object(
+		              file_object_io_handle,
+		              file_object_io_handle->read_ahead_offset,
+		              file_object_io_handle->read_ahead_data,
+		              file_object_io_handle->read_ahead_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read read-ahead data from file object.",
+			 function );
+
+			goto on_error;
+		}
+		file_object_io_handle->read_ahead_data_size = (size_t) read_count;
+
+		/* Stop at the end of the file object
+		 */
+		if( file_object_io_handle->current_offset >= ( file_object_io_handle->read_ahead_offset + (off64_t) read_count ) )
+		{
+			break;
+		}
 	}
 	PyGILState_Release(
 	 gil_state );
 
-	return( read_count );
+	return( (ssize_t) buffer_offset );
 
 on_error:
 	PyGILState_Release(
@@ -1130,6 +1644,8 @@ on_error:
 }
 
 /* Seeks a certain offset within the file object IO handle
+ * The file object itself is only positioned when data is read from it,
+ * the GIL is held to serialize the offset with reads of other threads
  * Returns the offset if the seek is successful or -1 on error
  */
 off64_t pyvshadow_file_object_io_handle_seek_offset(
@@ -1152,37 +1668,70 @@ off64_t pyvshadow_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
-
-	if( pyvshadow_file_object_seek_offset(
-	     file_object_io_handle->file_object,
-	     offset,
-	     whence,
-	     error ) != 1 )
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek in file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( pyvshadow_file_object_get_offset(
-	     file_object_io_handle->file_object,
-	     &offset,
-	     error ) != 1 )
+	gil_state = PyGILState_Ensure();
+
+	if( whence == SEEK_CUR )
+	{
+		offset += file_object_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( pyvshadow_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     offset,
+		     whence,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( pyvshadow_file_object_get_offset(
+		     file_object_io_handle->file_object,
+		     &offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve current offset in file object.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to retrieve current offset in file object.",
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		goto on_error;
 	}
+	file_object_io_handle->current_offset = offset;
+
 	PyGILState_Release(
 	 gil_state );
 
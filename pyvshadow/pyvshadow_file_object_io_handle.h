@@ -33,6 +33,14 @@
 extern "C" {
 #endif
 
+/* The default read-ahead size, which corresponds to 4 VSS store blocks
+ */
+#define PYVSHADOW_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE	65536
+
+/* The maximum read-ahead size
+ */
+#define PYVSHADOW_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE	( 64 * 1024 * 1024 )
+
 typedef struct pyvshadow_file_object_io_handle pyvshadow_file_object_io_handle_t;
 
 struct pyvshadow_file_object_io_handle
@@ -44,6 +52,32 @@ struct pyvshadow_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The read-ahead size
+	 * a value of 0 disables read-ahead
+	 */
+	size_t read_ahead_size;
+
+	/* The read-ahead data
+	 */
+	uint8_t *read_ahead_data;
+
+	/* The offset of the read-ahead data
+	 */
+	off64_t read_ahead_offset;
+
+	/* The size of the data in the read-ahead data
+	 */
+	size_t read_ahead_data_size;
+
+	/* Value to indicate the file object has a readinto method
+	 * a value of -1 indicates this has not been determined yet
+	 */
+	int has_readinto;
 };
 
 int pyvshadow_file_object_io_handle_initialize(
@@ -54,6 +88,12 @@ int pyvshadow_file_object_io_handle_initialize(
 int pyvshadow_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
+     libcerror_error_t **error );
+
+int pyvshadow_file_object_io_handle_set_read_ahead_size(
+     pyvshadow_file_object_io_handle_t *file_object_io_handle,
+     size_t read_ahead_size,
      libcerror_error_t **error );
 
 int pyvshadow_file_object_io_handle_free(
@@ -80,6 +120,21 @@ ssize_t pyvshadow_file_object_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+#if PY_MAJOR_VERSION >= 3
+ssize_t pyvshadow_file_object_read_buffer_into(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+#endif
+
+ssize_t pyvshadow_file_object_io_handle_read_from_file_object(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t pyvshadow_file_object_io_handle_read(
          pyvshadow_file_object_io_handle_t *file_object_io_handle,
          uint8_t *buffer,
@@ -0,0 +1,816 @@
+/*
+ * Python asynchronous read request functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "pyvshadow_error.h"
+#include "pyvshadow_libbfio.h"
+#include "pyvshadow_libcerror.h"
+#include "pyvshadow_libcthreads.h"
+#include "pyvshadow_libvshadow.h"
+#include "pyvshadow_python.h"
+#include "pyvshadow_read_request.h"
+#include "pyvshadow_store.h"
+#include "pyvshadow_unused.h"
+#include "pyvshadow_volume.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+PyMethodDef pyvshadow_read_request_complete_future_method = {
+	"_complete_future",
+	(PyCFunction) pyvshadow_read_request_complete_future,
+	METH_VARARGS,
+	"_complete_future(future, result, exception) -> None\n"
+	"\n"
+	"Completes the future of a read request, unless it was cancelled." };
+
+/* Creates a read request
+ * Make sure the value read_request is referencing, is set to NULL
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_initialize(
+     pyvshadow_read_request_t **read_request,
+     pyvshadow_store_t *store_object,
+     PyObject *event_loop,
+     PyObject *future,
+     size_t read_size,
+     off64_t read_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_read_request_initialize";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store object.",
+		 function );
+
+		return( -1 );
+	}
+	if( event_loop == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid event loop.",
+		 function );
+
+		return( -1 );
+	}
+	if( future == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid future.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = (pyvshadow_read_request_t *) PyMem_Malloc(
+	                                              sizeof( pyvshadow_read_request_t ) );
+
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_request,
+	     0,
+	     sizeof( pyvshadow_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read request.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data is read directly into the string object, which is not
+	 * accessible to Python code until the read request is completed
+	 */
+#if PY_MAJOR_VERSION >= 3
+	( *read_request )->string_object = PyBytes_FromStringAndSize(
+	                                    NULL,
+	                                    (Py_ssize_t) read_size );
+#else
+	( *read_request )->string_object = PyString_FromStringAndSize(
+	                                    NULL,
+	                                    (Py_ssize_t) read_size );
+#endif
+	if( ( *read_request )->string_object == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create string object.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_request )->store_object = store_object;
+	( *read_request )->event_loop   = event_loop;
+	( *read_request )->future       = future;
+	( *read_request )->read_size    = read_size;
+	( *read_request )->read_offset  = read_offset;
+
+	Py_IncRef(
+	 (PyObject *) ( *read_request )->store_object );
+
+	Py_IncRef(
+	 ( *read_request )->event_loop );
+
+	Py_IncRef(
+	 ( *read_request )->future );
+
+	return( 1 );
+
+on_error:
+	if( *read_request != NULL )
+	{
+		PyMem_Free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read request
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_free(
+     pyvshadow_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_read_request_free";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		if( ( *read_request )->string_object != NULL )
+		{
+			Py_DecRef(
+			 ( *read_request )->string_object );
+		}
+		Py_DecRef(
+		 ( *read_request )->future );
+
+		Py_DecRef(
+		 ( *read_request )->event_loop );
+
+		Py_DecRef(
+		 (PyObject *) ( *read_request )->store_object );
+
+		if( ( *read_request )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *read_request )->error ) );
+		}
+		PyMem_Free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the data of a read request without changing the current offset of the store
+ * The GIL is acquired if needed and released while reading
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_read(
+     pyvshadow_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle  = NULL;
+	pyvshadow_volume_t *volume_object = NULL;
+	char *buffer                      = NULL;
+	static char *function             = "pyvshadow_read_request_read";
+	ssize_t read_count                = 0;
+	PyGILState_STATE gil_state        = 0;
+	int result                        = 0;
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	gil_state = PyGILState_Ensure();
+
+	read_request->read_count = -1;
+
+	volume_object = read_request->store_object->volume_object;
+
+	if( volume_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read request - invalid store object - missing volume object.",
+		 function );
+
+		goto on_error;
+	}
+#if PY_MAJOR_VERSION >= 3
+	buffer = PyBytes_AsString(
+	          read_request->string_object );
+#else
+	buffer = PyString_AsString(
+	          read_request->string_object );
+#endif
+	result = pyvshadow_volume_grab_read_file_io_handle(
+	          volume_object,
+	          &file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab read file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              read_request->store_object->store,
+		              file_io_handle,
+		              (uint8_t *) buffer,
+		              read_request->read_size,
+		              read_request->read_offset,
+		              error );
+
+		Py_END_ALLOW_THREADS
+
+		if( pyvshadow_volume_release_read_file_io_handle(
+		     volume_object,
+		     &file_io_handle,
+		     NULL ) != 1 )
+		{
+			file_io_handle = NULL;
+		}
+	}
+	else if( volume_object->file_io_handle != NULL )
+	{
+		/* The file IO handle of a file-like object requires the GIL,
+		 * hence the GIL is not released and the reads are serialized
+		 */
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              read_request->store_object->store,
+		              volume_object->file_io_handle,
+		              (uint8_t *) buffer,
+		              read_request->read_size,
+		              read_request->read_offset,
+		              error );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count <= -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->read_offset,
+		 read_request->read_offset );
+
+		goto on_error;
+	}
+	read_request->read_count = read_count;
+
+	PyGILState_Release(
+	 gil_state );
+
+	return( 1 );
+
+on_error:
+	PyGILState_Release(
+	 gil_state );
+
+	return( -1 );
+}
+
+/* Completes the future of a read request from the thread of its event loop
+ * with either the data read or an IOError
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_complete(
+     pyvshadow_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	PyObject *exception_object    = NULL;
+	PyObject *exception_traceback = NULL;
+	PyObject *exception_type      = NULL;
+	PyObject *function_object     = NULL;
+	PyObject *method_result       = NULL;
+	PyObject *result_object       = NULL;
+	static char *function         = "pyvshadow_read_request_complete";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request->read_count >= 0 )
+	{
+		/* Need to resize the string here in case read_size was not fully read.
+		 */
+#if PY_MAJOR_VERSION >= 3
+		if( _PyBytes_Resize(
+		     &( read_request->string_object ),
+		     (Py_ssize_t) read_request->read_count ) != 0 )
+#else
+		if( _PyString_Resize(
+		     &( read_request->string_object ),
+		     (Py_ssize_t) read_request->read_count ) != 0 )
+#endif
+		{
+			read_request->string_object = NULL;
+		}
+	}
+	if( ( read_request->read_count >= 0 )
+	 && ( read_request->string_object != NULL ) )
+	{
+		result_object = read_request->string_object;
+
+		Py_IncRef(
+		 result_object );
+	}
+	else
+	{
+		if( read_request->read_count >= 0 )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to resize string object.",
+			 function );
+		}
+		else
+		{
+			pyvshadow_error_raise(
+			 read_request->error,
+			 PyExc_IOError,
+			 "%s: unable to read data.",
+			 function );
+		}
+		PyErr_Fetch(
+		 &exception_type,
+		 &exception_object,
+		 &exception_traceback );
+
+		PyErr_NormalizeException(
+		 &exception_type,
+		 &exception_object,
+		 &exception_traceback );
+
+		Py_IncRef(
+		 Py_None );
+
+		result_object = Py_None;
+	}
+	if( exception_object == NULL )
+	{
+		Py_IncRef(
+		 Py_None );
+
+		exception_object = Py_None;
+	}
+	function_object = PyCFunction_New(
+	                   &pyvshadow_read_request_complete_future_method,
+	                   NULL );
+
+	if( function_object == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create complete future function object.",
+		 function );
+
+		goto on_error;
+	}
+	/* The event loop is not thread-safe hence the future is completed
+	 * by a callback that is scheduled on the thread of the event loop
+	 */
+	method_result = PyObject_CallMethod(
+	                 read_request->event_loop,
+	                 "call_soon_threadsafe",
+	                 "OOOO",
+	                 function_object,
+	                 read_request->future,
+	                 result_object,
+	                 exception_object );
+
+	if( method_result == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to schedule completion of future.",
+		 function );
+
+		goto on_error;
+	}
+	Py_DecRef(
+	 method_result );
+
+	Py_DecRef(
+	 function_object );
+
+	Py_DecRef(
+	 result_object );
+
+	Py_DecRef(
+	 exception_object );
+
+	if( exception_type != NULL )
+	{
+		Py_DecRef(
+		 exception_type );
+	}
+	if( exception_traceback != NULL )
+	{
+		Py_DecRef(
+		 exception_traceback );
+	}
+	return( 1 );
+
+on_error:
+	if( function_object != NULL )
+	{
+		Py_DecRef(
+		 function_object );
+	}
+	Py_DecRef(
+	 result_object );
+
+	Py_DecRef(
+	 exception_object );
+
+	if( exception_type != NULL )
+	{
+		Py_DecRef(
+		 exception_type );
+	}
+	if( exception_traceback != NULL )
+	{
+		Py_DecRef(
+		 exception_traceback );
+	}
+	return( -1 );
+}
+
+/* Submits a read request to the read thread pool of its volume
+ * The thread pool is created if needed and takes over the read request
+ * Without multi-threading support read requests are not supported, since reading
+ * them immediately would block the thread of the event loop
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_submit(
+     pyvshadow_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	pyvshadow_volume_t *volume_object = NULL;
+	static char *function             = "pyvshadow_read_request_submit";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int result                        = 0;
+#endif
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing read request.",
+		 function );
+
+		return( -1 );
+	}
+	volume_object = ( *read_request )->store_object->volume_object;
+
+	if( volume_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read request - invalid store object - missing volume object.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( volume_object->read_thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( volume_object->read_thread_pool ),
+		     NULL,
+		     PYVSHADOW_VOLUME_NUMBER_OF_READ_THREADS,
+		     PYVSHADOW_VOLUME_MAXIMUM_NUMBER_OF_READ_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &pyvshadow_read_request_thread_pool_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The push blocks while the queue is full, hence the GIL is released
+	 * so that the threads can complete the queued read requests
+	 */
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libcthreads_thread_pool_push(
+	          volume_object->read_thread_pool,
+	          (intptr_t *) *read_request,
+	          error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = NULL;
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: read requests require multi-threading support.",
+	 function );
+
+	return( -1 );
+#endif
+	return( 1 );
+}
+
+/* Reads and completes a read request on a thread of the read thread pool
+ * The read request is freed afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_read_request_thread_pool_callback(
+     pyvshadow_read_request_t *read_request,
+     void *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	PyGILState_STATE gil_state = 0;
+	int result                 = 1;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( read_request == NULL )
+	{
+		return( -1 );
+	}
+	/* A read error is passed on to the future
+	 */
+	pyvshadow_read_request_read(
+	 read_request,
+	 &( read_request->error ) );
+
+	gil_state = PyGILState_Ensure();
+
+	/* The future cannot be completed if the event loop was closed
+	 */
+	if( pyvshadow_read_request_complete(
+	     read_request,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	pyvshadow_read_request_free(
+	 &read_request,
+	 NULL );
+
+	PyGILState_Release(
+	 gil_state );
+
+	return( result );
+}
+
+/* Completes a future with a result or an exception, unless the future was cancelled
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_read_request_complete_future(
+           PyObject *self PYVSHADOW_ATTRIBUTE_UNUSED,
+           PyObject *arguments )
+{
+	PyObject *exception_object = NULL;
+	PyObject *future           = NULL;
+	PyObject *method_result    = NULL;
+	PyObject *result_object    = NULL;
+	int result                 = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( self )
+
+	if( PyArg_ParseTuple(
+	     arguments,
+	     "OOO",
+	     &future,
+	     &result_object,
+	     &exception_object ) == 0 )
+	{
+		return( NULL );
+	}
+	method_result = PyObject_CallMethod(
+	                 future,
+	                 "done",
+	                 NULL );
+
+	if( method_result == NULL )
+	{
+		return( NULL );
+	}
+	result = PyObject_IsTrue(
+	          method_result );
+
+	Py_DecRef(
+	 method_result );
+
+	if( result == -1 )
+	{
+		return( NULL );
+	}
+	else if( result == 0 )
+	{
+		if( exception_object != Py_None )
+		{
+			method_result = PyObject_CallMethod(
+			                 future,
+			                 "set_exception",
+			                 "(O)",
+			                 exception_object );
+		}
+		else
+		{
+			method_result = PyObject_CallMethod(
+			                 future,
+			                 "set_result",
+			                 "(O)",
+			                 result_object );
+		}
+		if( method_result == NULL )
+		{
+			return( NULL );
+		}
+		Py_DecRef(
+		 method_result );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
@@ -0,0 +1,113 @@
+/*
+ * Python asynchronous read request functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYVSHADOW_READ_REQUEST_H )
+#define _PYVSHADOW_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyvshadow_libcerror.h"
+#include "pyvshadow_python.h"
+#include "pyvshadow_store.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pyvshadow_read_request pyvshadow_read_request_t;
+
+struct pyvshadow_read_request
+{
+	/* The pyvshadow store object
+	 */
+	pyvshadow_store_t *store_object;
+
+	/* The event loop
+	 */
+	PyObject *event_loop;
+
+	/* The future that is completed with the result of the read
+	 */
+	PyObject *future;
+
+	/* The string object that contains the data
+	 */
+	PyObject *string_object;
+
+	/* The read offset
+	 */
+	off64_t read_offset;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The read count
+	 */
+	ssize_t read_count;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+};
+
+extern PyMethodDef pyvshadow_read_request_complete_future_method;
+
+int pyvshadow_read_request_initialize(
+     pyvshadow_read_request_t **read_request,
+     pyvshadow_store_t *store_object,
+     PyObject *event_loop,
+     PyObject *future,
+     size_t read_size,
+     off64_t read_offset,
+     libcerror_error_t **error );
+
+int pyvshadow_read_request_free(
+     pyvshadow_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int pyvshadow_read_request_read(
+     pyvshadow_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int pyvshadow_read_request_complete(
+     pyvshadow_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int pyvshadow_read_request_submit(
+     pyvshadow_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int pyvshadow_read_request_thread_pool_callback(
+     pyvshadow_read_request_t *read_request,
+     void *arguments );
+
+PyObject *pyvshadow_read_request_complete_future(
+           PyObject *self,
+           PyObject *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYVSHADOW_READ_REQUEST_H ) */
+
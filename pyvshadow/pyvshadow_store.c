@@ -27,18 +27,34 @@
 #endif
 
 #include "pyvshadow_block.h"
+#include "pyvshadow_block_table.h"
 #include "pyvshadow_blocks.h"
 #include "pyvshadow_datetime.h"
 #include "pyvshadow_error.h"
 #include "pyvshadow_guid.h"
 #include "pyvshadow_integer.h"
+#include "pyvshadow_libbfio.h"
 #include "pyvshadow_libcerror.h"
 #include "pyvshadow_libvshadow.h"
 #include "pyvshadow_python.h"
+#include "pyvshadow_read_request.h"
 #include "pyvshadow_store.h"
 #include "pyvshadow_unused.h"
 #include "pyvshadow_volume.h"
 
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
 PyMethodDef pyvshadow_store_object_methods[] = {
 
 	/* Functions to access the store data */
@@ -64,6 +80,53 @@ PyMethodDef pyvshadow_store_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of store data at a specific offset." },
 
+	{ "read_buffer_into",
+	  (PyCFunction) pyvshadow_store_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_into(buffer) -> Integer\n"
+	  "\n"
+	  "Reads store data into a writable buffer object, such as a bytearray, and returns the number of bytes read." },
+
+	{ "read_buffer_at_offset_into",
+	  (PyCFunction) pyvshadow_store_read_buffer_at_offset_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_at_offset_into(buffer, offset) -> Integer\n"
+	  "\n"
+	  "Reads store data at a specific offset into a writable buffer object, such as a bytearray, and returns the number of bytes read." },
+
+	{ "pread",
+	  (PyCFunction) pyvshadow_store_pread,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "pread(size, offset) -> String\n"
+	  "\n"
+	  "Reads a buffer of store data at a specific offset without changing the current offset.\n"
+	  "This function can be called from multiple threads. If the volume was opened by filename\n"
+	  "the reads run concurrently, each using its own file handle, and scale with the number\n"
+	  "of threads up to the throughput of the underlying storage. If the volume was opened\n"
+	  "using a file-like object the reads are serialized." },
+
+	{ "read_many",
+	  (PyCFunction) pyvshadow_store_read_many,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_many(ranges) -> List of memoryview objects\n"
+	  "\n"
+	  "Reads multiple ranges of store data, specified as a sequence of (offset, size) tuples,\n"
+	  "without changing the current offset. The ranges are read in offset order with a single\n"
+	  "release of the GIL into one contiguous buffer. The memory views are returned in the order\n"
+	  "of the ranges and are shorter than the size of the range at the end of the store data." },
+
+	{ "read_async",
+	  (PyCFunction) pyvshadow_store_read_async,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_async(size, offset) -> Future\n"
+	  "\n"
+	  "Reads a buffer of store data at a specific offset without changing the current offset\n"
+	  "and returns an asyncio future of the running or current event loop that is completed with the data.\n"
+	  "The reads are queued to a small pool of native threads of the volume, hence many reads\n"
+	  "can be outstanding without using a Python thread per read. Closing the volume waits\n"
+	  "for the outstanding reads to complete. If the module was built without multi-threading\n"
+	  "support the reads are run using pread in the default executor of the event loop." },
+
 	{ "seek_offset",
 	  (PyCFunction) pyvshadow_store_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -87,6 +150,13 @@ PyMethodDef pyvshadow_store_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of store data." },
 
+	{ "readinto",
+	  (PyCFunction) pyvshadow_store_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "readinto(buffer) -> Integer\n"
+	  "\n"
+	  "Reads store data into a writable buffer object." },
+
 	{ "seek",
 	  (PyCFunction) pyvshadow_store_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -175,6 +245,15 @@ PyMethodDef pyvshadow_store_object_methods[] = {
 	  "\n"
 	  "Retrieves a sequence object of the blocks." },
 
+	{ "get_block_table",
+	  (PyCFunction) pyvshadow_store_get_block_table,
+	  METH_NOARGS,
+	  "get_block_table() -> Object\n"
+	  "\n"
+	  "Retrieves a block table object of the blocks.\n"
+	  "The block table supports the buffer protocol, e.g. numpy.asarray(block_table) returns\n"
+	  "a structured array with the fields: original_offset, relative_offset, offset, flags and bitmap." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -781,19 +860,20 @@ PyObject *pyvshadow_store_read_buffer_at_offset(
 	return( string_object );
 }
 
-/* Seeks a certain offset in the (store) data
+/* Reads (store) data at the current offset into a writable buffer object
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvshadow_store_seek_offset(
+PyObject *pyvshadow_store_read_buffer_into(
            pyvshadow_store_t *pyvshadow_store,
            PyObject *arguments,
            PyObject *keywords )
 {
+	Py_buffer buffer_view;
+
 	libcerror_error_t *error    = NULL;
-	static char *function       = "pyvshadow_store_seek_offset";
-	static char *keyword_list[] = { "offset", "whence", NULL };
-	off64_t offset              = 0;
-	int whence                  = 0;
+	static char *function       = "pyvshadow_store_read_buffer_into";
+	static char *keyword_list[] = { "buffer", NULL };
+	ssize_t read_count          = 0;
 
 	if( pyvshadow_store == NULL )
 	{
@@ -807,29 +887,34 @@ PyObject *pyvshadow_store_seek_offset(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "L|i",
+	     "w*",
 	     keyword_list,
-	     &offset,
-	     &whence ) == 0 )
+	     &buffer_view ) == 0 )
 	{
 		return( NULL );
 	}
+	/* The buffer view keeps the buffer object from being resized
+	 * while the GIL is released
+	 */
 	Py_BEGIN_ALLOW_THREADS
 
-	offset = libvshadow_store_seek_offset(
-	          pyvshadow_store->store,
-	          offset,
-	          whence,
-	          &error );
+	read_count = libvshadow_store_read_buffer(
+	              pyvshadow_store->store,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              &error );
 
 	Py_END_ALLOW_THREADS
 
- 	if( offset == -1 )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyvshadow_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to seek offset.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -837,51 +922,77 @@ PyObject *pyvshadow_store_seek_offset(
 
 		return( NULL );
 	}
-	Py_IncRef(
-	 Py_None );
-
-	return( Py_None );
+	return( pyvshadow_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Retrieves the current offset in the (store) data
+/* Reads (store) data at a specific offset into a writable buffer object
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvshadow_store_get_offset(
+PyObject *pyvshadow_store_read_buffer_at_offset_into(
            pyvshadow_store_t *pyvshadow_store,
-           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+           PyObject *arguments,
+           PyObject *keywords )
 {
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvshadow_store_get_offset";
-	off64_t current_offset   = 0;
-	int result               = 0;
+	Py_buffer buffer_view;
 
-	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyvshadow_store_read_buffer_at_offset_into";
+	static char *keyword_list[] = { "buffer", "offset", NULL };
+	off64_t read_offset         = 0;
+	ssize_t read_count          = 0;
 
 	if( pyvshadow_store == NULL )
 	{
 		PyErr_Format(
 		 PyExc_TypeError,
-		 "%s: invalid store.",
+		 "%s: invalid pyvshadow store.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "w*L",
+	     keyword_list,
+	     &buffer_view,
+	     &read_offset ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
 		 function );
 
+		PyBuffer_Release(
+		 &buffer_view );
+
 		return( NULL );
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvshadow_store_get_offset(
-	          pyvshadow_store->store,
-	          &current_offset,
-	          &error );
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              pyvshadow_store->store,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              (off64_t) read_offset,
+	              &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result != 1 )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyvshadow_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve offset.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -889,165 +1000,1168 @@ PyObject *pyvshadow_store_get_offset(
 
 		return( NULL );
 	}
-	integer_object = pyvshadow_integer_signed_new_from_64bit(
-	                  (int64_t) current_offset );
-
-	return( integer_object );
+	return( pyvshadow_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Retrieves the size
+/* Reads (store) data at a specific offset without changing the current offset
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvshadow_store_get_size(
+PyObject *pyvshadow_store_pread(
            pyvshadow_store_t *pyvshadow_store,
-           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+           PyObject *arguments,
+           PyObject *keywords )
 {
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvshadow_store_get_size";
-	size64_t size            = 0;
-	int result               = 0;
-
-	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	PyObject *string_object          = NULL;
+	static char *function            = "pyvshadow_store_pread";
+	static char *keyword_list[]      = { "size", "offset", NULL };
+	char *buffer                     = NULL;
+	off64_t read_offset              = 0;
+	ssize_t read_count               = 0;
+	int read_size                    = 0;
+	int result                       = 0;
 
 	if( pyvshadow_store == NULL )
 	{
 		PyErr_Format(
 		 PyExc_TypeError,
-		 "%s: invalid store.",
+		 "%s: invalid pyvshadow store.",
 		 function );
 
 		return( NULL );
 	}
-	Py_BEGIN_ALLOW_THREADS
-
-	result = libvshadow_store_get_size(
-	          pyvshadow_store->store,
-	          &size,
-	          &error );
-
-	Py_END_ALLOW_THREADS
-
-	if( result != 1 )
+	if( pyvshadow_store->volume_object == NULL )
 	{
-		pyvshadow_error_raise(
-		 error,
-		 PyExc_IOError,
-		 "%s: failed to retrieve size.",
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid pyvshadow store - missing volume object.",
 		 function );
 
-		libcerror_error_free(
-		 &error );
-
 		return( NULL );
 	}
-	integer_object = pyvshadow_integer_unsigned_new_from_64bit(
-	                  (uint64_t) size );
-
-	return( integer_object );
-}
-
-/* Retrieves the volume size as stored in the store information
- * Returns a Python object if successful or NULL on error
- */
-PyObject *pyvshadow_store_get_volume_size(
-           pyvshadow_store_t *pyvshadow_store,
-           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
-{
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvshadow_store_get_volume_size";
-	size64_t volume_size     = 0;
-	int result               = 0;
-
-	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "iL",
+	     keyword_list,
+	     &read_size,
+	     &read_offset ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_size < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read size value less than zero.",
+		 function );
 
-	if( pyvshadow_store == NULL )
+		return( NULL );
+	}
+	if( read_offset < 0 )
 	{
 		PyErr_Format(
-		 PyExc_TypeError,
-		 "%s: invalid store.",
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
 		 function );
 
 		return( NULL );
 	}
-	Py_BEGIN_ALLOW_THREADS
+#if PY_MAJOR_VERSION >= 3
+	string_object = PyBytes_FromStringAndSize(
+	                 NULL,
+	                 read_size );
 
-	result = libvshadow_store_get_volume_size(
-	          pyvshadow_store->store,
-	          &volume_size,
-	          &error );
+	buffer = PyBytes_AsString(
+	          string_object );
+#else
+	string_object = PyString_FromStringAndSize(
+	                 NULL,
+	                 read_size );
 
-	Py_END_ALLOW_THREADS
+	buffer = PyString_AsString(
+	          string_object );
+#endif
+	if( buffer == NULL )
+	{
+		goto on_error;
+	}
+	result = pyvshadow_volume_grab_read_file_io_handle(
+	          pyvshadow_store->volume_object,
+	          &file_io_handle,
+	          &error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		pyvshadow_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: failed to retrieve volume size.",
+		 "%s: unable to grab read file IO handle.",
 		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		return( NULL );
+		goto on_error;
 	}
-	integer_object = pyvshadow_integer_unsigned_new_from_64bit(
-	                  (uint64_t) volume_size );
-
-	return( integer_object );
-}
-
-/* Retrieves the identifier
- * Returns a Python object if successful or NULL on error
- */
-PyObject *pyvshadow_store_get_identifier(
-           pyvshadow_store_t *pyvshadow_store,
-           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
-{
-	uint8_t guid_data[ 16 ];
-
-	libcerror_error_t *error = NULL;
-	PyObject *string_object  = NULL;
-	static char *function    = "pyvshadow_store_get_identifier";
-	int result               = 0;
-
-	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
-
-	if( pyvshadow_store == NULL )
+	else if( result != 0 )
+	{
+		/* The read only acquires the read lock of the store
+		 * and uses a file IO handle that is not shared
+		 */
+		Py_BEGIN_ALLOW_THREADS
+
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              pyvshadow_store->store,
+		              file_io_handle,
+		              (uint8_t *) buffer,
+		              (size_t) read_size,
+		              (off64_t) read_offset,
+		              &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( pyvshadow_volume_release_read_file_io_handle(
+		     pyvshadow_store->volume_object,
+		     &file_io_handle,
+		     NULL ) != 1 )
+		{
+			file_io_handle = NULL;
+		}
+	}
+	else if( pyvshadow_store->volume_object->file_io_handle != NULL )
+	{
+		/* The file IO handle of a file-like object requires the GIL,
+		 * hence the GIL is not released and the reads are serialized
+		 */
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              pyvshadow_store->store,
+		              pyvshadow_store->volume_object->file_io_handle,
+		              (uint8_t *) buffer,
+		              (size_t) read_size,
+		              (off64_t) read_offset,
+		              &error );
+	}
+	else
 	{
 		PyErr_Format(
-		 PyExc_TypeError,
-		 "%s: invalid store.",
+		 PyExc_IOError,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
-		return( NULL );
+		goto on_error;
 	}
-	Py_BEGIN_ALLOW_THREADS
-
-	result = libvshadow_store_get_identifier(
-	          pyvshadow_store->store,
-	          guid_data,
-	          16,
-	          &error );
-
-	Py_END_ALLOW_THREADS
-
-	if( result != 1 )
+	if( read_count <= -1 )
 	{
 		pyvshadow_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve identifier.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		return( NULL );
+		goto on_error;
 	}
-	string_object = pyvshadow_string_new_from_guid(
+	/* Need to resize the string here in case read_size was not fully read.
+	 */
+#if PY_MAJOR_VERSION >= 3
+	if( _PyBytes_Resize(
+	     &string_object,
+	     (Py_ssize_t) read_count ) != 0 )
+#else
+	if( _PyString_Resize(
+	     &string_object,
+	     (Py_ssize_t) read_count ) != 0 )
+#endif
+	{
+		goto on_error;
+	}
+	return( string_object );
+
+on_error:
+	if( string_object != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) string_object );
+	}
+	return( NULL );
+}
+
+/* Compares the offsets of two read ranges
+ * Returns -1 if the first range is before the second, 0 if equal or 1 if after
+ */
+int pyvshadow_store_read_range_compare(
+     const void *first_range,
+     const void *second_range )
+{
+	const pyvshadow_store_read_range_t *first  = (const pyvshadow_store_read_range_t *) first_range;
+	const pyvshadow_store_read_range_t *second = (const pyvshadow_store_read_range_t *) second_range;
+
+	if( first->offset < second->offset )
+	{
+		return( -1 );
+	}
+	else if( first->offset > second->offset )
+	{
+		return( 1 );
+	}
+	/* Keep the sort stable with respect to the argument sequence
+	 */
+	if( first->index < second->index )
+	{
+		return( -1 );
+	}
+	else if( first->index > second->index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the ranges into the buffer
+ * The ranges must be sorted by offset and their buffer offsets must follow that order,
+ * consecutive ranges that are contiguous in the store data are read at once
+ * Does not require the GIL unless the file IO handle uses a file-like object
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_store_read_ranges(
+     libvshadow_store_t *store,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *buffer,
+     pyvshadow_store_read_range_t *ranges,
+     Py_ssize_t number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function     = "pyvshadow_store_read_ranges";
+	size_t read_size          = 0;
+	size_t remaining_count    = 0;
+	ssize_t read_count        = 0;
+	Py_ssize_t first_index    = 0;
+	Py_ssize_t last_index     = 0;
+	Py_ssize_t range_index    = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ranges.",
+		 function );
+
+		return( -1 );
+	}
+	while( first_index < number_of_ranges )
+	{
+		read_size  = ranges[ first_index ].size;
+		last_index = first_index + 1;
+
+		while( ( last_index < number_of_ranges )
+		    && ( ranges[ last_index ].offset == ( ranges[ last_index - 1 ].offset + (off64_t) ranges[ last_index - 1 ].size ) ) )
+		{
+			read_size += ranges[ last_index ].size;
+
+			last_index++;
+		}
+		read_count = 0;
+
+		if( read_size > 0 )
+		{
+			read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+			              store,
+			              file_io_handle,
+			              &( buffer[ ranges[ first_index ].buffer_offset ] ),
+			              read_size,
+			              ranges[ first_index ].offset,
+			              error );
+
+			if( read_count <= -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read range: %" PRIzd " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 (ssize_t) ranges[ first_index ].index,
+				 ranges[ first_index ].offset,
+				 ranges[ first_index ].offset );
+
+				return( -1 );
+			}
+		}
+		/* Distribute the data read over the ranges, the last ranges
+		 * can be partially read or not at all at the end of the store data
+		 */
+		remaining_count = (size_t) read_count;
+
+		for( range_index = first_index;
+		     range_index < last_index;
+		     range_index++ )
+		{
+			if( remaining_count < ranges[ range_index ].size )
+			{
+				ranges[ range_index ].read_count = remaining_count;
+			}
+			else
+			{
+				ranges[ range_index ].read_count = ranges[ range_index ].size;
+			}
+			remaining_count -= ranges[ range_index ].read_count;
+		}
+		first_index = last_index;
+	}
+	return( 1 );
+}
+
+/* Reads multiple ranges of (store) data without changing the current offset
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_read_many(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libcerror_error_t *error              = NULL;
+	pyvshadow_store_read_range_t *ranges  = NULL;
+	PyObject *list_object                 = NULL;
+	PyObject *memory_view                 = NULL;
+	PyObject *range_object                = NULL;
+	PyObject *ranges_object               = NULL;
+	PyObject *sequence_object             = NULL;
+	PyObject *slice_object                = NULL;
+	PyObject *string_object               = NULL;
+	static char *function                 = "pyvshadow_store_read_many";
+	static char *keyword_list[]           = { "ranges", NULL };
+	char *buffer                          = NULL;
+	off64_t range_offset                  = 0;
+	size_t buffer_size                    = 0;
+	Py_ssize_t number_of_ranges           = 0;
+	Py_ssize_t range_index                = 0;
+	int range_size                        = 0;
+	int result                            = 0;
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyvshadow store.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyvshadow_store->volume_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid pyvshadow store - missing volume object.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &ranges_object ) == 0 )
+	{
+		return( NULL );
+	}
+	sequence_object = PySequence_Fast(
+	                   ranges_object,
+	                   "ranges must be a sequence of (offset, size) tuples" );
+
+	if( sequence_object == NULL )
+	{
+		return( NULL );
+	}
+	number_of_ranges = PySequence_Fast_GET_SIZE(
+	                    sequence_object );
+
+	list_object = PyList_New(
+	               number_of_ranges );
+
+	if( list_object == NULL )
+	{
+		goto on_error;
+	}
+	if( number_of_ranges == 0 )
+	{
+		Py_DecRef(
+		 sequence_object );
+
+		return( list_object );
+	}
+	if( (size_t) number_of_ranges > ( (size_t) SSIZE_MAX / sizeof( pyvshadow_store_read_range_t ) ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of ranges value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	ranges = (pyvshadow_store_read_range_t *) PyMem_Malloc(
+	                                           sizeof( pyvshadow_store_read_range_t ) * number_of_ranges );
+
+	if( ranges == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create ranges.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		range_object = PySequence_Fast_GET_ITEM(
+		                sequence_object,
+		                range_index );
+
+		if( PyTuple_Check(
+		     range_object ) == 0 )
+		{
+			PyErr_Format(
+			 PyExc_TypeError,
+			 "%s: invalid range: %zd value not a tuple.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( PyArg_ParseTuple(
+		     range_object,
+		     "Li",
+		     &range_offset,
+		     &range_size ) == 0 )
+		{
+			goto on_error;
+		}
+		if( range_offset < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %zd offset value less than zero.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( range_size < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %zd size value less than zero.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		ranges[ range_index ].index      = range_index;
+		ranges[ range_index ].offset     = range_offset;
+		ranges[ range_index ].size       = (size_t) range_size;
+		ranges[ range_index ].read_count = 0;
+	}
+	/* Lay out the buffer in offset order, so that ranges that are contiguous
+	 * in the store data are also contiguous in the buffer and can be read at once
+	 */
+	qsort(
+	 ranges,
+	 (size_t) number_of_ranges,
+	 sizeof( pyvshadow_store_read_range_t ),
+	 pyvshadow_store_read_range_compare );
+
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( ranges[ range_index ].size > ( (size_t) SSIZE_MAX - buffer_size ) )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid total size of ranges value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		ranges[ range_index ].buffer_offset = buffer_size;
+
+		buffer_size += ranges[ range_index ].size;
+	}
+#if PY_MAJOR_VERSION >= 3
+	string_object = PyBytes_FromStringAndSize(
+	                 NULL,
+	                 (Py_ssize_t) buffer_size );
+#else
+	string_object = PyString_FromStringAndSize(
+	                 NULL,
+	                 (Py_ssize_t) buffer_size );
+#endif
+	if( string_object == NULL )
+	{
+		goto on_error;
+	}
+#if PY_MAJOR_VERSION >= 3
+	buffer = PyBytes_AsString(
+	          string_object );
+#else
+	buffer = PyString_AsString(
+	          string_object );
+#endif
+	result = pyvshadow_volume_grab_read_file_io_handle(
+	          pyvshadow_store->volume_object,
+	          &file_io_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to grab read file IO handle.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* All the ranges are read with a single release of the GIL
+		 */
+		Py_BEGIN_ALLOW_THREADS
+
+		result = pyvshadow_store_read_ranges(
+		          pyvshadow_store->store,
+		          file_io_handle,
+		          (uint8_t *) buffer,
+		          ranges,
+		          number_of_ranges,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( pyvshadow_volume_release_read_file_io_handle(
+		     pyvshadow_store->volume_object,
+		     &file_io_handle,
+		     NULL ) != 1 )
+		{
+			file_io_handle = NULL;
+		}
+	}
+	else if( pyvshadow_store->volume_object->file_io_handle != NULL )
+	{
+		/* The file IO handle of a file-like object requires the GIL,
+		 * hence the GIL is not released and the reads are serialized
+		 */
+		result = pyvshadow_store_read_ranges(
+		          pyvshadow_store->store,
+		          pyvshadow_store->volume_object->file_io_handle,
+		          (uint8_t *) buffer,
+		          ranges,
+		          number_of_ranges,
+		          &error );
+	}
+	else
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	/* The memory views reference the string object, which is freed
+	 * when the last of them is released
+	 */
+	memory_view = PyMemoryView_FromObject(
+	               string_object );
+
+	if( memory_view == NULL )
+	{
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		slice_object = PySequence_GetSlice(
+		                memory_view,
+		                (Py_ssize_t) ranges[ range_index ].buffer_offset,
+		                (Py_ssize_t) ( ranges[ range_index ].buffer_offset + ranges[ range_index ].read_count ) );
+
+		if( slice_object == NULL )
+		{
+			goto on_error;
+		}
+		/* PyList_SetItem steals the reference to the slice object
+		 */
+		PyList_SetItem(
+		 list_object,
+		 ranges[ range_index ].index,
+		 slice_object );
+	}
+	Py_DecRef(
+	 memory_view );
+
+	Py_DecRef(
+	 string_object );
+
+	PyMem_Free(
+	 ranges );
+
+	Py_DecRef(
+	 sequence_object );
+
+	return( list_object );
+
+on_error:
+	if( memory_view != NULL )
+	{
+		Py_DecRef(
+		 memory_view );
+	}
+	if( string_object != NULL )
+	{
+		Py_DecRef(
+		 string_object );
+	}
+	if( ranges != NULL )
+	{
+		PyMem_Free(
+		 ranges );
+	}
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	Py_DecRef(
+	 sequence_object );
+
+	return( NULL );
+}
+
+/* Reads (store) data at a specific offset asynchronously
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_read_async(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	pyvshadow_read_request_t *read_request = NULL;
+	PyObject *asyncio_module               = NULL;
+	PyObject *event_loop                   = NULL;
+	PyObject *future                       = NULL;
+	PyObject *pread_method                 = NULL;
+	static char *function                  = "pyvshadow_store_read_async";
+	static char *keyword_list[]            = { "size", "offset", NULL };
+	off64_t read_offset                    = 0;
+	int read_size                          = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *error               = NULL;
+#endif
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyvshadow store.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyvshadow_store->volume_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid pyvshadow store - missing volume object.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "iL",
+	     keyword_list,
+	     &read_size,
+	     &read_offset ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_size < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read size value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	asyncio_module = PyImport_ImportModule(
+	                  "asyncio" );
+
+	if( asyncio_module == NULL )
+	{
+		goto on_error;
+	}
+	/* get_running_loop is not available before Python 3.7
+	 */
+	if( PyObject_HasAttrString(
+	     asyncio_module,
+	     "get_running_loop" ) != 0 )
+	{
+		event_loop = PyObject_CallMethod(
+		              asyncio_module,
+		              "get_running_loop",
+		              NULL );
+
+		/* Fall back to the event loop of the current thread when called
+		 * outside a coroutine
+		 */
+		if( ( event_loop == NULL )
+		 && ( PyErr_ExceptionMatches(
+		       PyExc_RuntimeError ) != 0 ) )
+		{
+			PyErr_Clear();
+		}
+	}
+	if( event_loop == NULL )
+	{
+		event_loop = PyObject_CallMethod(
+		              asyncio_module,
+		              "get_event_loop",
+		              NULL );
+	}
+	if( event_loop == NULL )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	future = PyObject_CallMethod(
+	          event_loop,
+	          "create_future",
+	          NULL );
+
+	if( future == NULL )
+	{
+		goto on_error;
+	}
+	if( pyvshadow_read_request_initialize(
+	     &read_request,
+	     pyvshadow_store,
+	     event_loop,
+	     future,
+	     (size_t) read_size,
+	     read_offset,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to initialize read request.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( pyvshadow_read_request_submit(
+	     &read_request,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to submit read request.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+#else
+	/* Without multi-threading support there is no read thread pool, hence
+	 * the read is run by the default executor of the event loop so that it
+	 * does not block the thread of the event loop
+	 */
+	pread_method = PyObject_GetAttrString(
+	                (PyObject *) pyvshadow_store,
+	                "pread" );
+
+	if( pread_method == NULL )
+	{
+		goto on_error;
+	}
+	future = PyObject_CallMethod(
+	          event_loop,
+	          "run_in_executor",
+	          "OOiL",
+	          Py_None,
+	          pread_method,
+	          read_size,
+	          (PY_LONG_LONG) read_offset );
+
+	if( future == NULL )
+	{
+		goto on_error;
+	}
+	Py_DecRef(
+	 pread_method );
+#endif
+	Py_DecRef(
+	 event_loop );
+
+	Py_DecRef(
+	 asyncio_module );
+
+	return( future );
+
+on_error:
+	if( read_request != NULL )
+	{
+		pyvshadow_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	if( future != NULL )
+	{
+		Py_DecRef(
+		 future );
+	}
+	if( pread_method != NULL )
+	{
+		Py_DecRef(
+		 pread_method );
+	}
+	if( event_loop != NULL )
+	{
+		Py_DecRef(
+		 event_loop );
+	}
+	if( asyncio_module != NULL )
+	{
+		Py_DecRef(
+		 asyncio_module );
+	}
+	return( NULL );
+}
+
+/* Seeks a certain offset in the (store) data
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_seek_offset(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyvshadow_store_seek_offset";
+	static char *keyword_list[] = { "offset", "whence", NULL };
+	off64_t offset              = 0;
+	int whence                  = 0;
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyvshadow store.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "L|i",
+	     keyword_list,
+	     &offset,
+	     &whence ) == 0 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	offset = libvshadow_store_seek_offset(
+	          pyvshadow_store->store,
+	          offset,
+	          whence,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+ 	if( offset == -1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to seek offset.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Retrieves the current offset in the (store) data
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_get_offset(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvshadow_store_get_offset";
+	off64_t current_offset   = 0;
+	int result               = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid store.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_offset(
+	          pyvshadow_store->store,
+	          &current_offset,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyvshadow_integer_signed_new_from_64bit(
+	                  (int64_t) current_offset );
+
+	return( integer_object );
+}
+
+/* Retrieves the size
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_get_size(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvshadow_store_get_size";
+	size64_t size            = 0;
+	int result               = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid store.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_size(
+	          pyvshadow_store->store,
+	          &size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: failed to retrieve size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyvshadow_integer_unsigned_new_from_64bit(
+	                  (uint64_t) size );
+
+	return( integer_object );
+}
+
+/* Retrieves the volume size as stored in the store information
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_get_volume_size(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvshadow_store_get_volume_size";
+	size64_t volume_size     = 0;
+	int result               = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid store.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_volume_size(
+	          pyvshadow_store->store,
+	          &volume_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: failed to retrieve volume size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyvshadow_integer_unsigned_new_from_64bit(
+	                  (uint64_t) volume_size );
+
+	return( integer_object );
+}
+
+/* Retrieves the identifier
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_get_identifier(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	uint8_t guid_data[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	PyObject *string_object  = NULL;
+	static char *function    = "pyvshadow_store_get_identifier";
+	int result               = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid store.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_identifier(
+	          pyvshadow_store->store,
+	          guid_data,
+	          16,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	string_object = pyvshadow_string_new_from_guid(
 			 guid_data,
 			 16 );
 
@@ -1338,6 +2452,88 @@ PyObject *pyvshadow_store_get_number_of_blocks(
 	return( integer_object );
 }
 
+/* Retrieves the block table
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvshadow_store_get_block_table(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments PYVSHADOW_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error                       = NULL;
+	pyvshadow_block_table_t *pyvshadow_block_table = NULL;
+	static char *function                          = "pyvshadow_store_get_block_table";
+	int number_of_blocks                           = 0;
+	int result                                     = 0;
+
+	PYVSHADOW_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvshadow_store == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid store.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_number_of_blocks(
+	          pyvshadow_store->store,
+	          &number_of_blocks,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of blocks.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	pyvshadow_block_table = (pyvshadow_block_table_t *) pyvshadow_block_table_new(
+	                                                     number_of_blocks );
+
+	if( pyvshadow_block_table == NULL )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvshadow_store_get_block_table(
+	          pyvshadow_store->store,
+	          pyvshadow_block_table->data,
+	          (size_t) pyvshadow_block_table->data_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve block table.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		Py_DecRef(
+		 (PyObject *) pyvshadow_block_table );
+
+		return( NULL );
+	}
+	return( (PyObject *) pyvshadow_block_table );
+}
+
 /* Retrieves a specific block by index
  * Returns a Python object if successful or NULL on error
  */
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "pyvshadow_libbfio.h"
+#include "pyvshadow_libcerror.h"
 #include "pyvshadow_libvshadow.h"
 #include "pyvshadow_python.h"
 #include "pyvshadow_volume.h"
@@ -50,6 +52,31 @@ struct pyvshadow_store
 	pyvshadow_volume_t *volume_object;
 };
 
+typedef struct pyvshadow_store_read_range pyvshadow_store_read_range_t;
+
+struct pyvshadow_store_read_range
+{
+	/* The index of the range in the argument sequence
+	 */
+	Py_ssize_t index;
+
+	/* The offset of the range in the store data
+	 */
+	off64_t offset;
+
+	/* The size of the range
+	 */
+	size_t size;
+
+	/* The offset of the range in the buffer
+	 */
+	size_t buffer_offset;
+
+	/* The number of bytes read of the range
+	 */
+	size_t read_count;
+};
+
 extern PyMethodDef pyvshadow_store_object_methods[];
 extern PyTypeObject pyvshadow_store_type_object;
 
@@ -77,6 +104,43 @@ PyObject *pyvshadow_store_read_buffer_at_offset(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyvshadow_store_read_buffer_into(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvshadow_store_read_buffer_at_offset_into(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvshadow_store_pread(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords );
+
+int pyvshadow_store_read_range_compare(
+     const void *first_range,
+     const void *second_range );
+
+int pyvshadow_store_read_ranges(
+     libvshadow_store_t *store,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *buffer,
+     pyvshadow_store_read_range_t *ranges,
+     Py_ssize_t number_of_ranges,
+     libcerror_error_t **error );
+
+PyObject *pyvshadow_store_read_many(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvshadow_store_read_async(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyvshadow_store_seek_offset(
            pyvshadow_store_t *pyvshadow_store,
            PyObject *arguments,
@@ -118,6 +182,10 @@ PyObject *pyvshadow_store_get_number_of_blocks(
            pyvshadow_store_t *pyvshadow_store,
            PyObject *arguments );
 
+PyObject *pyvshadow_store_get_block_table(
+           pyvshadow_store_t *pyvshadow_store,
+           PyObject *arguments );
+
 PyObject *pyvshadow_store_get_block_by_index(
            pyvshadow_store_t *pyvshadow_store,
            int block_index );
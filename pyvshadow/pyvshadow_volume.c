@@ -70,9 +70,10 @@ PyMethodDef pyvshadow_volume_object_methods[] = {
 	{ "open_file_object",
 	  (PyCFunction) pyvshadow_volume_open_file_object,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "open_file_object(file_object, mode='r') -> None\n"
+	  "open_file_object(file_object, mode='r', read_ahead_size=65536) -> None\n"
 	  "\n"
-	  "Opens a volume using a file-like object." },
+	  "Opens a volume using a file-like object.\n"
+	  "Small reads are served from read-ahead data that is read from the file-like object in aligned blocks of read_ahead_size, which must be a multiple of 512, 0 disables read-ahead." },
 
 	{ "close",
 	  (PyCFunction) pyvshadow_volume_close,
@@ -326,9 +327,14 @@ int pyvshadow_volume_init(
 
 		return( -1 );
 	}
-	pyvshadow_volume->volume         = NULL;
-	pyvshadow_volume->file_io_handle = NULL;
+	pyvshadow_volume->volume                         = NULL;
+	pyvshadow_volume->file_io_handle                 = NULL;
+	pyvshadow_volume->read_file_io_handle_template   = NULL;
+	pyvshadow_volume->number_of_read_file_io_handles = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	pyvshadow_volume->read_thread_pool = NULL;
+#endif
 	if( libvshadow_volume_initialize(
 	     &( pyvshadow_volume->volume ),
 	     &error ) != 1 )
@@ -396,6 +402,32 @@ void pyvshadow_volume_free(
 
 		return;
 	}
+	if( pyvshadow_volume_join_read_thread_pool(
+	     pyvshadow_volume,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to join read thread pool.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( pyvshadow_volume_free_read_file_io_handles(
+	     pyvshadow_volume,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to free read file IO handles.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+	}
 	Py_BEGIN_ALLOW_THREADS
 
 	result = libvshadow_volume_free(
@@ -556,6 +588,17 @@ PyObject *pyvshadow_volume_open(
 		          &error );
 
 		Py_END_ALLOW_THREADS
+
+		/* Concurrent reads are an optimization, if the template
+		 * cannot be set reads are serialized instead
+		 */
+		if( result == 1 )
+		{
+			pyvshadow_volume_set_read_file_io_handle_template_wide(
+			 pyvshadow_volume,
+			 filename_wide,
+			 NULL );
+		}
 #else
 		utf8_string_object = PyUnicode_AsUTF8String(
 		                      string_object );
@@ -586,6 +629,17 @@ PyObject *pyvshadow_volume_open(
 
 		Py_END_ALLOW_THREADS
 
+		/* Concurrent reads are an optimization, if the template
+		 * cannot be set reads are serialized instead
+		 */
+		if( result == 1 )
+		{
+			pyvshadow_volume_set_read_file_io_handle_template(
+			 pyvshadow_volume,
+			 filename_narrow,
+			 NULL );
+		}
+
 		Py_DecRef(
 		 utf8_string_object );
 #endif
@@ -648,6 +702,17 @@ PyObject *pyvshadow_volume_open(
 
 		Py_END_ALLOW_THREADS
 
+		/* Concurrent reads are an optimization, if the template
+		 * cannot be set reads are serialized instead
+		 */
+		if( result == 1 )
+		{
+			pyvshadow_volume_set_read_file_io_handle_template(
+			 pyvshadow_volume,
+			 filename_narrow,
+			 NULL );
+		}
+
 		if( result != 1 )
 		{
 			pyvshadow_error_raise(
@@ -685,8 +750,9 @@ PyObject *pyvshadow_volume_open_file_object(
 	PyObject *file_object       = NULL;
 	libcerror_error_t *error    = NULL;
 	char *mode                  = NULL;
-	static char *keyword_list[] = { "file_object", "mode", NULL };
+	static char *keyword_list[] = { "file_object", "mode", "read_ahead_size", NULL };
 	static char *function       = "pyvshadow_volume_open_file_object";
+	Py_ssize_t read_ahead_size  = PYVSHADOW_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE;
 	int result                  = 0;
 
 	if( pyvshadow_volume == NULL )
@@ -701,10 +767,11 @@ PyObject *pyvshadow_volume_open_file_object(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "O|s",
+	     "O|sn",
 	     keyword_list,
 	     &file_object,
-	     &mode ) == 0 )
+	     &mode,
+	     &read_ahead_size ) == 0 )
 	{
 		return( NULL );
 	}
@@ -719,9 +786,22 @@ PyObject *pyvshadow_volume_open_file_object(
 
 		return( NULL );
 	}
+	if( ( read_ahead_size < 0 )
+	 || ( read_ahead_size > (Py_ssize_t) PYVSHADOW_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE )
+	 || ( ( read_ahead_size % 512 ) != 0 ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: unsupported read-ahead size: %zd.",
+		 function,
+		 read_ahead_size );
+
+		return( NULL );
+	}
 	if( pyvshadow_file_object_initialize(
 	     &( pyvshadow_volume->file_io_handle ),
 	     file_object,
+	     (size_t) read_ahead_size,
 	     &error ) != 1 )
 	{
 		pyvshadow_error_raise(
@@ -795,6 +875,38 @@ PyObject *pyvshadow_volume_close(
 
 		return( NULL );
 	}
+	/* Wait for the outstanding asynchronous reads to complete
+	 */
+	if( pyvshadow_volume_join_read_thread_pool(
+	     pyvshadow_volume,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to join read thread pool.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	if( pyvshadow_volume_free_read_file_io_handles(
+	     pyvshadow_volume,
+	     &error ) != 1 )
+	{
+		pyvshadow_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to free read file IO handles.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
 	Py_BEGIN_ALLOW_THREADS
 
 	result = libvshadow_volume_close(
@@ -846,6 +958,464 @@ PyObject *pyvshadow_volume_close(
 	return( Py_None );
 }
 
+/* Sets the template of the file IO handles for concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_volume_set_read_file_io_handle_template(
+     pyvshadow_volume_t *pyvshadow_volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "pyvshadow_volume_set_read_file_io_handle_template";
+	size_t filename_length = 0;
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvshadow_volume->read_file_io_handle_template != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - read file IO handle template value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &( pyvshadow_volume->read_file_io_handle_template ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read file IO handle template.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     pyvshadow_volume->read_file_io_handle_template,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in read file IO handle template.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( pyvshadow_volume->read_file_io_handle_template != NULL )
+	{
+		libbfio_handle_free(
+		 &( pyvshadow_volume->read_file_io_handle_template ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Sets the template of the file IO handles for concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_volume_set_read_file_io_handle_template_wide(
+     pyvshadow_volume_t *pyvshadow_volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "pyvshadow_volume_set_read_file_io_handle_template_wide";
+	size_t filename_length = 0;
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvshadow_volume->read_file_io_handle_template != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - read file IO handle template value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &( pyvshadow_volume->read_file_io_handle_template ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read file IO handle template.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     pyvshadow_volume->read_file_io_handle_template,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in read file IO handle template.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( pyvshadow_volume->read_file_io_handle_template != NULL )
+	{
+		libbfio_handle_free(
+		 &( pyvshadow_volume->read_file_io_handle_template ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Frees the file IO handles for concurrent reads and their template
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_volume_free_read_file_io_handles(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_volume_free_read_file_io_handles";
+	int handle_index      = 0;
+	int result            = 1;
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	for( handle_index = 0;
+	     handle_index < pyvshadow_volume->number_of_read_file_io_handles;
+	     handle_index++ )
+	{
+		libbfio_handle_close(
+		 pyvshadow_volume->read_file_io_handles[ handle_index ],
+		 NULL );
+
+		if( libbfio_handle_free(
+		     &( pyvshadow_volume->read_file_io_handles[ handle_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read file IO handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+	}
+	pyvshadow_volume->number_of_read_file_io_handles = 0;
+
+	if( pyvshadow_volume->read_file_io_handle_template != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( pyvshadow_volume->read_file_io_handle_template ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read file IO handle template.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Grabs a file IO handle for a concurrent read
+ * An idle file IO handle is reused, otherwise a new one is created from the template
+ * This function must be called while holding the GIL
+ * Returns 1 if successful, 0 if concurrent reads are not supported or -1 on error
+ */
+int pyvshadow_volume_grab_read_file_io_handle(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *safe_file_io_handle = NULL;
+	static char *function                 = "pyvshadow_volume_grab_read_file_io_handle";
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvshadow_volume->read_file_io_handle_template == NULL )
+	{
+		return( 0 );
+	}
+	if( pyvshadow_volume->number_of_read_file_io_handles > 0 )
+	{
+		pyvshadow_volume->number_of_read_file_io_handles -= 1;
+
+		*file_io_handle = pyvshadow_volume->read_file_io_handles[ pyvshadow_volume->number_of_read_file_io_handles ];
+
+		pyvshadow_volume->read_file_io_handles[ pyvshadow_volume->number_of_read_file_io_handles ] = NULL;
+
+		return( 1 );
+	}
+	if( libbfio_handle_clone(
+	     &safe_file_io_handle,
+	     pyvshadow_volume->read_file_io_handle_template,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     safe_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open read file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	*file_io_handle = safe_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( safe_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &safe_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a file IO handle after a concurrent read
+ * The file IO handle is kept as an idle file IO handle if possible, otherwise it is freed
+ * This function must be called while holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_volume_release_read_file_io_handle(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_volume_release_read_file_io_handle";
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle == NULL )
+	{
+		return( 1 );
+	}
+	/* The template is freed when the volume is closed, file IO handles
+	 * that were in use at that time are freed when they are released
+	 */
+	if( ( pyvshadow_volume->read_file_io_handle_template != NULL )
+	 && ( pyvshadow_volume->number_of_read_file_io_handles < PYVSHADOW_VOLUME_MAXIMUM_NUMBER_OF_READ_FILE_IO_HANDLES ) )
+	{
+		pyvshadow_volume->read_file_io_handles[ pyvshadow_volume->number_of_read_file_io_handles ] = *file_io_handle;
+
+		pyvshadow_volume->number_of_read_file_io_handles += 1;
+
+		*file_io_handle = NULL;
+
+		return( 1 );
+	}
+	libbfio_handle_close(
+	 *file_io_handle,
+	 NULL );
+
+	if( libbfio_handle_free(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the thread pool for asynchronous reads
+ * The outstanding reads are completed before the threads are joined
+ * This function must be called while holding the GIL, which is released while joining
+ * Returns 1 if successful or -1 on error
+ */
+int pyvshadow_volume_join_read_thread_pool(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_volume_join_read_thread_pool";
+	int result            = 1;
+
+	if( pyvshadow_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( pyvshadow_volume->read_thread_pool != NULL )
+	{
+		/* The threads need the GIL to complete the reads
+		 */
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libcthreads_thread_pool_join(
+		          &( pyvshadow_volume->read_thread_pool ),
+		          error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread pool.",
+			 function );
+		}
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the number of stores
  * Returns a Python object if successful or NULL on error
  */
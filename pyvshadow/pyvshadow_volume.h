@@ -26,6 +26,8 @@
 #include <types.h>
 
 #include "pyvshadow_libbfio.h"
+#include "pyvshadow_libcerror.h"
+#include "pyvshadow_libcthreads.h"
 #include "pyvshadow_libvshadow.h"
 #include "pyvshadow_python.h"
 
@@ -33,6 +35,18 @@
 extern "C" {
 #endif
 
+/* The maximum number of idle file IO handles kept for concurrent reads
+ */
+#define PYVSHADOW_VOLUME_MAXIMUM_NUMBER_OF_READ_FILE_IO_HANDLES	16
+
+/* The number of threads of the thread pool for asynchronous reads
+ */
+#define PYVSHADOW_VOLUME_NUMBER_OF_READ_THREADS			4
+
+/* The maximum number of queued asynchronous reads
+ */
+#define PYVSHADOW_VOLUME_MAXIMUM_NUMBER_OF_READ_REQUESTS		4096
+
 typedef struct pyvshadow_volume pyvshadow_volume_t;
 
 struct pyvshadow_volume
@@ -48,6 +62,27 @@ struct pyvshadow_volume
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
+
+	/* The libbfio file IO handle that is cloned to create file IO handles
+	 * for concurrent reads, only set if the volume was opened by filename
+	 */
+	libbfio_handle_t *read_file_io_handle_template;
+
+	/* The idle libbfio file IO handles for concurrent reads
+	 * these are only accessed while holding the GIL
+	 */
+	libbfio_handle_t *read_file_io_handles[ PYVSHADOW_VOLUME_MAXIMUM_NUMBER_OF_READ_FILE_IO_HANDLES ];
+
+	/* The number of idle libbfio file IO handles for concurrent reads
+	 */
+	int number_of_read_file_io_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread pool for asynchronous reads
+	 * it is created when the first asynchronous read is requested
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+#endif
 };
 
 extern PyMethodDef pyvshadow_volume_object_methods[];
@@ -90,6 +125,36 @@ PyObject *pyvshadow_volume_close(
            pyvshadow_volume_t *pyvshadow_volume,
            PyObject *arguments );
 
+int pyvshadow_volume_set_read_file_io_handle_template(
+     pyvshadow_volume_t *pyvshadow_volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int pyvshadow_volume_set_read_file_io_handle_template_wide(
+     pyvshadow_volume_t *pyvshadow_volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+#endif
+
+int pyvshadow_volume_free_read_file_io_handles(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libcerror_error_t **error );
+
+int pyvshadow_volume_grab_read_file_io_handle(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int pyvshadow_volume_release_read_file_io_handle(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int pyvshadow_volume_join_read_thread_pool(
+     pyvshadow_volume_t *pyvshadow_volume,
+     libcerror_error_t **error );
+
 PyObject *pyvshadow_volume_get_number_of_stores(
            pyvshadow_volume_t *pyvshadow_volume,
            PyObject *arguments );
@@ -22,8 +22,17 @@
 
 from __future__ import print_function
 import argparse
+import multiprocessing
 import os
+import struct
 import sys
+import threading
+import time
+
+try:
+  import asyncio
+except ImportError:
+  asyncio = None
 
 import pyvshadow
 
@@ -143,6 +152,149 @@ def pyvshadow_test_read_buffer_at_offset(
   return result
 
 
+def pyvshadow_test_read_buffer_at_offset_into(
+    vshadow_store, input_offset, input_size, expected_offset, expected_size):
+
+  print(
+      ("Testing reading buffer into bytearray at offset: {0:d} and "
+       "size: {1:d}\t").format(input_offset, input_size), end="")
+
+  error_string = ""
+  result = True
+  try:
+    data = bytearray(4096)
+    view = memoryview(data)
+
+    result_size = 0
+    while input_size > 0:
+      read_size = 4096
+      if input_size < read_size:
+        read_size = input_size
+
+      data_size = vshadow_store.read_buffer_at_offset_into(
+          view[:read_size], input_offset)
+
+      if data_size > 0:
+        expected_data = vshadow_store.read_buffer_at_offset(
+            data_size, input_offset)
+        if bytes(data[:data_size]) != expected_data:
+          error_string = "Unexpected data at offset: {0:d}".format(
+              input_offset)
+          result = False
+          break
+
+      input_offset += data_size
+      input_size -= data_size
+      result_size += data_size
+
+      if data_size != read_size:
+        break
+
+    if result and input_offset != expected_offset:
+      error_string = "Unexpected offset: {0:d}".format(input_offset)
+      result = False
+
+    elif result and result_size != expected_size:
+      error_string = "Unexpected read count: {0:d}".format(result_size)
+      result = False
+
+  except Exception as exception:
+    print(str(exception))
+    if expected_offset != -1:
+      result = False
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+
+  if error_string:
+    print(error_string)
+  return result
+
+
+def pyvshadow_test_read_buffer_into(vshadow_store):
+  """Tests reading at the current offset into writable buffers, including
+  a short read at the end of the store and a read-only buffer."""
+  print("Testing reading buffer into bytearray at current offset\t", end="")
+
+  file_size = vshadow_store.get_size()
+  error_string = ""
+
+  # Test: read into a bytearray, the current offset advances
+  read_offset = file_size // 7
+  vshadow_store.seek_offset(read_offset, os.SEEK_SET)
+
+  data = bytearray(4096)
+  data_size = vshadow_store.readinto(data)
+  expected_data = vshadow_store.read_buffer_at_offset(4096, read_offset)
+
+  if data_size != 4096 or bytes(data) != expected_data:
+    error_string = "Unexpected data at offset: {0:d}".format(read_offset)
+
+  elif vshadow_store.get_offset() != read_offset + 4096:
+    error_string = "Unexpected offset: {0:d}".format(
+        vshadow_store.get_offset())
+
+  # Test: read into a memoryview slice, the data outside the slice is unchanged
+  if not error_string:
+    read_offset += 4096
+
+    data = bytearray(8192)
+    data_size = vshadow_store.read_buffer_into(memoryview(data)[1000:3000])
+    expected_data = vshadow_store.read_buffer_at_offset(2000, read_offset)
+
+    if (data_size != 2000 or bytes(data[1000:3000]) != expected_data or
+        data[:1000] != bytearray(1000) or data[3000:] != bytearray(5192)):
+      error_string = "Unexpected data at offset: {0:d}".format(read_offset)
+
+    elif vshadow_store.get_offset() != read_offset + 2000:
+      error_string = "Unexpected offset: {0:d}".format(
+          vshadow_store.get_offset())
+
+  # Test: read beyond the end of the store, only the remaining data is read
+  if not error_string and file_size >= 1024:
+    read_offset = file_size - 1024
+    vshadow_store.seek_offset(read_offset, os.SEEK_SET)
+
+    data = bytearray(4096)
+    data_size = vshadow_store.readinto(data)
+    expected_data = vshadow_store.read_buffer_at_offset(1024, read_offset)
+
+    if data_size != 1024 or bytes(data[:1024]) != expected_data:
+      error_string = "Unexpected read count: {0:d}".format(data_size)
+
+    elif vshadow_store.get_offset() != file_size:
+      error_string = "Unexpected offset: {0:d}".format(
+          vshadow_store.get_offset())
+
+    elif vshadow_store.readinto(data) != 0:
+      error_string = "Unexpected read at end of store"
+
+  # Test: read into a read-only buffer is rejected
+  if not error_string:
+    read_offset = vshadow_store.get_offset()
+    try:
+      vshadow_store.readinto(bytes(16))
+      error_string = "Missing error for read-only buffer"
+    except TypeError:
+      pass
+
+    if not error_string and vshadow_store.get_offset() != read_offset:
+      error_string = "Unexpected offset: {0:d}".format(
+          vshadow_store.get_offset())
+
+  vshadow_store.seek_offset(0, os.SEEK_SET)
+
+  if error_string:
+    print("(FAIL)")
+    print(error_string)
+    return False
+
+  print("(PASS)")
+  return True
+
+
 def pyvshadow_test_read(vshadow_store):
   file_size = vshadow_store.size
 
@@ -222,9 +374,268 @@ def pyvshadow_test_read(vshadow_store):
       (file_size / 7) + (file_size / 2), file_size / 2):
     return False
 
+  # Case 4: test buffer at offset read into a bytearray
+
+  # Test: offset: <file_size / 7> size: <file_size / 2>
+  # Expected result: offset: < ( file_size / 7 ) + ( file_size / 2 ) > size: <file_size / 2>
+  if not pyvshadow_test_read_buffer_at_offset_into(
+      vshadow_store, file_size // 7, file_size // 2,
+      (file_size // 7) + (file_size // 2), file_size // 2):
+    return False
+
   return True
 
 
+def pyvshadow_test_pread_threads(vshadow_stores, number_of_threads):
+  """Tests concurrent positional reads of multiple stores from multiple threads.
+
+  Every thread reads chunks of every store, interleaved with the other threads,
+  and compares them with the data read sequentially beforehand.
+  """
+  print(
+      "Testing concurrent pread of {0:d} stores with {1:d} threads\t".format(
+          len(vshadow_stores), number_of_threads), end="")
+
+  read_size = 65536
+  number_of_chunks = 32
+
+  expected_data = []
+  for vshadow_store in vshadow_stores:
+    offsets = []
+    chunk_offset = 0
+    chunk_step = max(vshadow_store.size // number_of_chunks, read_size)
+    while chunk_offset < vshadow_store.size and len(offsets) < number_of_chunks:
+      offsets.append(chunk_offset)
+      chunk_offset += chunk_step
+
+    expected_data.append([
+        (offset, vshadow_store.read_buffer_at_offset(read_size, offset))
+        for offset in offsets])
+
+  current_offsets = [
+      vshadow_store.get_offset() for vshadow_store in vshadow_stores]
+
+  errors = []
+
+  def read_chunks(thread_index):
+    try:
+      for store_index, vshadow_store in enumerate(vshadow_stores):
+        chunks = expected_data[store_index]
+        for chunk_index in range(thread_index, len(chunks), number_of_threads):
+          offset, data = chunks[chunk_index]
+          if vshadow_store.pread(read_size, offset) != data:
+            errors.append(
+                "Unexpected data in store: {0:d} at offset: {1:d}".format(
+                    store_index, offset))
+            return
+
+    except Exception as exception:
+      errors.append(str(exception))
+
+  threads = [
+      threading.Thread(target=read_chunks, args=(thread_index, ))
+      for thread_index in range(number_of_threads)]
+
+  for thread in threads:
+    thread.start()
+
+  for thread in threads:
+    thread.join()
+
+  # The positional reads must not change the current offset.
+  for store_index, vshadow_store in enumerate(vshadow_stores):
+    if vshadow_store.get_offset() != current_offsets[store_index]:
+      errors.append("Unexpected current offset: {0:d}".format(
+          vshadow_store.get_offset()))
+
+  if errors:
+    print("(FAIL)")
+    print(errors[0])
+    return False
+
+  print("(PASS)")
+  return True
+
+
+def pyvshadow_test_pread_scaling(vshadow_store, number_of_threads):
+  """Tests that positional reads from multiple threads are not serialized.
+
+  The same reads are timed in a single thread and divided over multiple
+  threads, where every concurrent pread uses a file IO handle of its own.
+  The reads of a cached image are bound by the CPU, hence the test is skipped
+  if fewer than 2 CPUs are available.
+  """
+  try:
+    number_of_cpus = multiprocessing.cpu_count()
+  except NotImplementedError:
+    number_of_cpus = 1
+
+  number_of_threads = min(number_of_threads, number_of_cpus)
+
+  print("Testing pread scaling with {0:d} threads\t".format(
+      number_of_threads), end="")
+
+  if number_of_threads < 2:
+    print("(SKIP)")
+    return True
+
+  read_size = 65536
+  read_offsets = list(range(
+      0, max(vshadow_store.size - read_size, 1), read_size))
+
+  def read_at_offsets(offsets):
+    for offset in offsets:
+      vshadow_store.pread(read_size, offset)
+
+  def time_single_thread(offsets):
+    start_time = time.time()
+    read_at_offsets(offsets)
+    return time.time() - start_time
+
+  def time_threads(offsets):
+    threads = [
+        threading.Thread(
+            target=read_at_offsets,
+            args=(offsets[thread_index::number_of_threads], ))
+        for thread_index in range(number_of_threads)]
+
+    start_time = time.time()
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    return time.time() - start_time
+
+  # Repeat the reads until a single thread takes long enough to be timed
+  # and fill the idle file IO handles of the volume beforehand.
+  time_threads(read_offsets)
+  while time_single_thread(read_offsets) < 0.25:
+    read_offsets = read_offsets * 2
+
+  # The best of multiple runs reduces the influence of other processes.
+  single_thread_time = min(
+      time_single_thread(read_offsets) for _ in range(3))
+  threads_time = min(time_threads(read_offsets) for _ in range(3))
+
+  # Serialized reads take at least as long as in a single thread, the tolerance
+  # allows for a speedup far below the number of threads.
+  if threads_time > single_thread_time * 0.8:
+    print("(FAIL)")
+    print((
+        "Reads not concurrent, single thread: {0:.3f} s, {1:d} threads: "
+        "{2:.3f} s").format(
+            single_thread_time, number_of_threads, threads_time))
+    return False
+
+  print("(PASS)")
+  return True
+
+
+def pyvshadow_test_read_many(vshadow_store):
+  """Tests reading multiple ranges, including adjacent, overlapping, empty
+  and beyond the end of the store ranges."""
+  print("Testing read_many\t", end="")
+
+  vshadow_size = vshadow_store.get_size()
+  read_ranges = [
+      (vshadow_size // 2, 4096), (0, 512), (512, 512), (256, 1024), (0, 0),
+      (vshadow_size - 100, 4096), (vshadow_size + 512, 512), (1024, 512)]
+
+  current_offset = vshadow_store.get_offset()
+
+  data_views = vshadow_store.read_many(read_ranges)
+
+  result = len(data_views) == len(read_ranges)
+  for (range_offset, range_size), data_view in zip(read_ranges, data_views):
+    if not result:
+      break
+
+    if range_offset >= vshadow_size:
+      expected_data = b""
+    else:
+      expected_data = vshadow_store.read_buffer_at_offset(
+          range_size, range_offset)
+
+    result = bytes(data_view) == expected_data
+
+  vshadow_store.seek_offset(current_offset, os.SEEK_SET)
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+  return result
+
+
+def pyvshadow_test_get_block_table(vshadow_store):
+  """Tests the block table against the individual block descriptors."""
+  print("Testing get_block_table\t", end="")
+
+  block_table = vshadow_store.get_block_table()
+  block_table_data = bytes(memoryview(block_table).cast("B"))
+
+  result = len(block_table) == vshadow_store.number_of_blocks
+  result = result and len(block_table_data) == len(block_table) * 32
+
+  for block_index, block in enumerate(vshadow_store.blocks):
+    if not result:
+      break
+
+    original_offset, relative_offset, offset = struct.unpack_from(
+        "<qqq", block_table_data, block_index * 32)
+
+    result = (
+        original_offset == block.original_offset and
+        relative_offset == block.relative_offset and
+        offset == block.offset)
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+  return result
+
+
+def pyvshadow_test_read_async(vshadow_stores):
+  """Tests concurrent asynchronous reads of multiple stores from an asyncio
+  event loop and compares them with the data read synchronously."""
+  print("Testing read_async of {0:d} stores\t".format(
+      len(vshadow_stores)), end="")
+
+  read_size = 65536
+  number_of_chunks = 16
+
+  read_requests = []
+  for vshadow_store in vshadow_stores:
+    chunk_step = max(vshadow_store.size // number_of_chunks, read_size)
+    for chunk_offset in range(0, vshadow_store.size, chunk_step):
+      read_requests.append((vshadow_store, chunk_offset))
+
+  event_loop = asyncio.new_event_loop()
+  asyncio.set_event_loop(event_loop)
+  try:
+    futures = [
+        vshadow_store.read_async(read_size, offset)
+        for vshadow_store, offset in read_requests]
+    data_chunks = event_loop.run_until_complete(asyncio.gather(*futures))
+  finally:
+    asyncio.set_event_loop(None)
+    event_loop.close()
+
+  result = len(data_chunks) == len(read_requests)
+  for (vshadow_store, offset), data in zip(read_requests, data_chunks):
+    if not result:
+      break
+
+    result = data == vshadow_store.pread(read_size, offset)
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+  return result
+
+
 def pyvshadow_test_read_file(filename):
   vshadow_volume = pyvshadow.volume()
 
@@ -233,26 +644,54 @@ def pyvshadow_test_read_file(filename):
   result = True
   for vshadow_store in vshadow_volume.stores:
     result = pyvshadow_test_read(vshadow_store)
+    if result:
+      result = pyvshadow_test_read_buffer_into(vshadow_store)
+    if result:
+      result = pyvshadow_test_read_many(vshadow_store)
+    if result:
+      result = pyvshadow_test_get_block_table(vshadow_store)
     if not result:
       break
 
+  if result:
+    result = pyvshadow_test_pread_threads(list(vshadow_volume.stores), 8)
+
+  if result:
+    result = pyvshadow_test_pread_scaling(vshadow_volume.get_store(0), 4)
+
+  if result and asyncio:
+    result = pyvshadow_test_read_async(list(vshadow_volume.stores))
+
   vshadow_volume.close()
 
   return result
 
 
-def pyvshadow_test_read_file_object(filename):
-  file_object = open(filename, "rb")
+def pyvshadow_test_read_file_object(
+    filename, read_ahead_size=None, buffering=-1):
+  file_object = open(filename, "rb", buffering)
   vshadow_volume = pyvshadow.volume()
 
-  vshadow_volume.open_file_object(file_object, "r")
+  if read_ahead_size is None:
+    vshadow_volume.open_file_object(file_object, "r")
+  else:
+    print("Testing read with read-ahead size: {0:d}".format(read_ahead_size))
+    vshadow_volume.open_file_object(
+        file_object, "r", read_ahead_size=read_ahead_size)
 
   result = True
   for vshadow_store in vshadow_volume.stores:
     result = pyvshadow_test_read(vshadow_store)
+    if result:
+      result = pyvshadow_test_read_buffer_into(vshadow_store)
+    if result:
+      result = pyvshadow_test_read_many(vshadow_store)
     if not result:
       break
 
+  if result:
+    result = pyvshadow_test_pread_threads(list(vshadow_volume.stores), 4)
+
   vshadow_volume.close()
 
   return result
@@ -281,6 +720,14 @@ def main():
   if not pyvshadow_test_read_file_object(options.source):
     return False
 
+  if not pyvshadow_test_read_file_object(options.source, read_ahead_size=0):
+    return False
+
+  # An unbuffered file object can return less data from readinto than requested.
+  if not pyvshadow_test_read_file_object(
+      options.source, read_ahead_size=4096, buffering=0):
+    return False
+
   return True
 
 
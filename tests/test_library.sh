@@ -11,8 +11,8 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-LIBRARY_TESTS="block block_descriptor block_range_descriptor error io_handle notify store store_block store_descriptor";
-LIBRARY_TESTS_WITH_INPUT="support volume";
+LIBRARY_TESTS="block block_descriptor block_range_descriptor error io_handle notify store store_block store_concurrent store_descriptor synthetic_volume";
+LIBRARY_TESTS_WITH_INPUT="store_read support volume";
 OPTION_SETS="";
 
 TEST_TOOL_DIRECTORY=".";
@@ -0,0 +1,319 @@
+/*
+ * Generates a synthetic Volume Shadow Snapshot (VSS) image for scale testing
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_getopt.h"
+#include "vshadow_test_image.h"
+#include "vshadow_test_libcerror.h"
+
+/* Copies a decimal string to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_generate_image_copy_from_decimal(
+     const system_character_t *string,
+     uint64_t maximum_value,
+     uint64_t *value_64bit )
+{
+	size_t string_index = 0;
+	uint64_t digit      = 0;
+
+	if( ( string == NULL )
+	 || ( string[ 0 ] == 0 ) )
+	{
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( -1 );
+		}
+		digit = (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( *value_64bit > ( ( maximum_value - digit ) / 10 ) )
+		{
+			return( -1 );
+		}
+		*value_64bit = ( *value_64bit * 10 ) + digit;
+	}
+	return( 1 );
+}
+
+/* Prints the usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadow_test_generate_image to write a synthetic Windows NT Volume\n"
+	                 "Shadow Snapshot (VSS) image with a configurable shape\n\n" );
+
+	fprintf( stream, "Usage: vshadow_test_generate_image [ -b descriptors ] [ -d blocks ]\n"
+	                 "                                   [ -f percentage ] [ -l size ]\n"
+	                 "                                   [ -n stores ] [ -o percentage ]\n"
+	                 "                                   [ -s seed ] [ -hpz ] target\n\n" );
+
+	fprintf( stream, "\ttarget: the target image file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the number of block descriptors per store, the\n"
+	                 "\t        default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_BLOCK_DESCRIPTORS );
+	fprintf( stream, "\t-d:     specify the number of store data blocks per store, the\n"
+	                 "\t        default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORE_DATA_BLOCKS );
+	fprintf( stream, "\t-f:     specify the percentage of forwarder block descriptors, the\n"
+	                 "\t        default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_FORWARDER_PERCENTAGE );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-l:     specify the size of the volume data area in bytes, the\n"
+	                 "\t        default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_VOLUME_DATA_SIZE );
+	fprintf( stream, "\t-n:     specify the number of stores, the default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORES );
+	fprintf( stream, "\t-o:     specify the percentage of overlay block descriptors, the\n"
+	                 "\t        default is %d\n", VSHADOW_TEST_IMAGE_DEFAULT_OVERLAY_PERCENTAGE );
+	fprintf( stream, "\t-p:     do not write the previous store bitmaps\n" );
+	fprintf( stream, "\t-s:     specify the seed of the pseudo random number generator, the\n"
+	                 "\t        default is 1\n" );
+	fprintf( stream, "\t-z:     leave the volume data area sparse\n" );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	vshadow_test_image_options_t options;
+
+	libcerror_error_t *error   = NULL;
+	system_character_t *target = NULL;
+	size64_t volume_size       = 0;
+	uint64_t value_64bit       = 0;
+	system_integer_t option    = 0;
+	int result                 = 0;
+
+	if( vshadow_test_image_options_initialize(
+	     &options,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize image options.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:d:f:hl:n:o:ps:z" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_BLOCK_DESCRIPTORS,
+				          &value_64bit );
+
+				options.number_of_block_descriptors = (uint32_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'd':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          (uint64_t) UINT32_MAX,
+				          &value_64bit );
+
+				options.number_of_store_data_blocks = (uint32_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'f':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          100,
+				          &value_64bit );
+
+				options.forwarder_percentage = (uint8_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'l':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          (uint64_t) INT64_MAX,
+				          &value_64bit );
+
+				options.volume_data_size = (size64_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'n':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES,
+				          &value_64bit );
+
+				options.number_of_stores = (int) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'o':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          100,
+				          &value_64bit );
+
+				options.overlay_percentage = (uint8_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'p':
+				options.write_previous_bitmaps = 0;
+
+				break;
+
+			case (system_integer_t) 's':
+				result = vshadow_test_generate_image_copy_from_decimal(
+				          optarg,
+				          UINT64_MAX,
+				          &value_64bit );
+
+				options.random_seed = value_64bit;
+
+				break;
+
+			case (system_integer_t) 'z':
+				options.fill_volume_data = 0;
+
+				break;
+		}
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported value: %" PRIs_SYSTEM " for option: %" PRIc_SYSTEM ".\n",
+			 optarg,
+			 (system_character_t) option );
+
+			usage_fprint(
+			 stdout );
+
+			return( EXIT_FAILURE );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	if( vshadow_test_image_write(
+	     target,
+	     &options,
+	     &volume_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write image: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Volume size\t\t\t: %" PRIu64 " bytes\n",
+	 volume_size );
+
+	fprintf(
+	 stdout,
+	 "Number of stores\t\t: %d\n",
+	 options.number_of_stores );
+
+	fprintf(
+	 stdout,
+	 "Block descriptors per store\t: %" PRIu32 "\n",
+	 options.number_of_block_descriptors );
+
+	fprintf(
+	 stdout,
+	 "Random seed\t\t\t: %" PRIu64 "\n",
+	 options.random_seed );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1204 @@
+/*
+ * Synthetic Volume Shadow Snapshot (VSS) image functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "vshadow_test_image.h"
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/vshadow_catalog.h"
+#include "../libvshadow/vshadow_store.h"
+#include "../libvshadow/vshadow_volume.h"
+
+/* The layout of a synthetic image is:
+ * the volume data area, which starts with the VSS volume header at offset 0x1e00
+ * the catalog blocks
+ * the blocks of the stores, the most recent store first, where every store consists of:
+ * the store header block, the store bitmap blocks, the previous store bitmap blocks,
+ * the store block list blocks, the store block range list block and the store data blocks
+ *
+ * The original offsets of the block descriptors are within the volume data area.
+ * The forwarder block descriptors of a store refer to the original offsets of
+ * the next (more recent) store, which creates forwarder chains across the stores.
+ */
+
+const uint8_t vshadow_test_image_vss_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
+
+const char *vshadow_test_image_machine_string = "vshadow-test.example.com";
+
+/* Initializes the image options with the default values
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_image_options_initialize(
+     vshadow_test_image_options_t *options,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_image_options_initialize";
+
+	if( options == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid options.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     options,
+	     0,
+	     sizeof( vshadow_test_image_options_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear options.",
+		 function );
+
+		return( -1 );
+	}
+	options->volume_data_size            = VSHADOW_TEST_IMAGE_DEFAULT_VOLUME_DATA_SIZE;
+	options->number_of_stores            = VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORES;
+	options->number_of_block_descriptors = VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_BLOCK_DESCRIPTORS;
+	options->number_of_store_data_blocks = VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORE_DATA_BLOCKS;
+	options->forwarder_percentage        = VSHADOW_TEST_IMAGE_DEFAULT_FORWARDER_PERCENTAGE;
+	options->overlay_percentage          = VSHADOW_TEST_IMAGE_DEFAULT_OVERLAY_PERCENTAGE;
+	options->write_previous_bitmaps      = 1;
+	options->fill_volume_data            = 1;
+	options->random_seed                 = 1;
+
+	return( 1 );
+}
+
+/* Retrieves a pseudo random value
+ * Uses xorshift64* so the same seed always generates the same image
+ */
+uint64_t vshadow_test_image_get_random_value(
+          uint64_t *random_state )
+{
+	uint64_t value_64bit = *random_state;
+
+	value_64bit ^= value_64bit >> 12;
+	value_64bit ^= value_64bit << 25;
+	value_64bit ^= value_64bit >> 27;
+
+	*random_state = value_64bit;
+
+	return( value_64bit * (uint64_t) 0x2545f4914f6cdd1dULL );
+}
+
+/* Fills data with a pattern that is unique for the random seed
+ * Uses splitmix64 so the pattern of a block can be reproduced independently
+ */
+void vshadow_test_image_fill_data(
+      uint8_t *data,
+      size_t data_size,
+      uint64_t random_seed )
+{
+	size_t data_offset   = 0;
+	uint64_t value_64bit = 0;
+
+	while( data_offset < data_size )
+	{
+		random_seed += (uint64_t) 0x9e3779b97f4a7c15ULL;
+
+		value_64bit = random_seed;
+		value_64bit = ( value_64bit ^ ( value_64bit >> 30 ) ) * (uint64_t) 0xbf58476d1ce4e5b9ULL;
+		value_64bit = ( value_64bit ^ ( value_64bit >> 27 ) ) * (uint64_t) 0x94d049bb133111ebULL;
+		value_64bit = value_64bit ^ ( value_64bit >> 31 );
+
+		if( ( data_size - data_offset ) >= 8 )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( data[ data_offset ] ),
+			 value_64bit );
+
+			data_offset += 8;
+		}
+		else
+		{
+			while( data_offset < data_size )
+			{
+				data[ data_offset++ ] = (uint8_t) ( value_64bit & 0xff );
+
+				value_64bit >>= 8;
+			}
+		}
+	}
+}
+
+/* Sets the catalog or store block header
+ * The catalog and store block headers share the same layout
+ */
+void vshadow_test_image_set_block_header(
+      uint8_t *data,
+      uint32_t record_type,
+      off64_t relative_offset,
+      off64_t offset,
+      off64_t next_offset )
+{
+	vshadow_store_block_header_t *block_header = (vshadow_store_block_header_t *) data;
+
+	memory_copy(
+	 block_header->identifier,
+	 vshadow_test_image_vss_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 block_header->version,
+	 (uint32_t) 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 block_header->record_type,
+	 record_type );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 block_header->relative_offset,
+	 (uint64_t) relative_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 block_header->offset,
+	 (uint64_t) offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 block_header->next_offset,
+	 (uint64_t) next_offset );
+}
+
+/* Writes a block at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_image_write_block(
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_image_write_block";
+	ssize_t write_count   = 0;
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a synthetic image
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_image_write(
+     const system_character_t *filename,
+     const vshadow_test_image_options_t *options,
+     size64_t *volume_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle               = NULL;
+	uint64_t *current_original_offsets             = NULL;
+	uint64_t *next_original_offsets                = NULL;
+	uint64_t *swap_original_offsets                = NULL;
+	uint8_t *block_data                            = NULL;
+	uint8_t *entry_data                            = NULL;
+	uint8_t *store_identifiers                     = NULL;
+	static char *function                          = "vshadow_test_image_write";
+	off64_t catalog_offset                         = 0;
+	off64_t store_bitmap_offset                    = 0;
+	off64_t store_block_list_offset                = 0;
+	off64_t store_block_range_list_offset          = 0;
+	off64_t store_data_offset                      = 0;
+	off64_t store_header_offset                    = 0;
+	off64_t store_offset                           = 0;
+	off64_t store_previous_bitmap_offset           = 0;
+	off64_t stores_offset                          = 0;
+	size64_t store_size                            = 0;
+	size_t entry_offset                            = 0;
+	size_t filename_length                         = 0;
+	size_t string_index                            = 0;
+	size_t string_size                             = 0;
+	uint64_t block_offset                          = 0;
+	uint64_t bit_index                             = 0;
+	uint64_t block_descriptor_offset               = 0;
+	uint64_t block_index                           = 0;
+	uint64_t descriptor_index                      = 0;
+	uint64_t next_number_of_original_offsets       = 0;
+	uint64_t number_of_bits_per_bitmap_block       = 0;
+	uint64_t number_of_bitmap_blocks               = 0;
+	uint64_t number_of_block_list_blocks           = 0;
+	uint64_t number_of_blocks_per_store            = 0;
+	uint64_t number_of_catalog_blocks              = 0;
+	uint64_t number_of_entries_per_block_list      = 0;
+	uint64_t number_of_entries_per_catalog_block   = 0;
+	uint64_t number_of_volume_blocks               = 0;
+	uint64_t original_offset                       = 0;
+	uint64_t random_state                          = 0;
+	uint64_t relative_offset                       = 0;
+	uint64_t store_block_offset                    = 0;
+	uint32_t allocation_bitmap                     = 0;
+	uint32_t block_flags                           = 0;
+	uint32_t descriptor_type                       = 0;
+	uint8_t bitmap_index                           = 0;
+	uint8_t machine_string_index                   = 0;
+	int entry_index                                = 0;
+	int store_index                                = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( options == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid options.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( options->number_of_stores <= 0 )
+	 || ( options->number_of_stores > VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid options - number of stores value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( options->number_of_block_descriptors > VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_BLOCK_DESCRIPTORS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid options - number of block descriptors value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( options->number_of_store_data_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid options - number of store data blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (int) options->forwarder_percentage + (int) options->overlay_percentage ) > 100 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid options - forwarder and overlay percentages value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_volume_blocks = options->volume_data_size / VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+	if( number_of_volume_blocks < 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid options - volume data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the layout of the image
+	 */
+	number_of_entries_per_catalog_block = ( VSHADOW_TEST_IMAGE_BLOCK_SIZE - sizeof( vshadow_catalog_header_t ) ) / 128;
+	number_of_catalog_blocks            = ( ( 2 * (uint64_t) options->number_of_stores ) + number_of_entries_per_catalog_block - 1 ) / number_of_entries_per_catalog_block;
+
+	number_of_bits_per_bitmap_block = ( VSHADOW_TEST_IMAGE_BLOCK_SIZE - sizeof( vshadow_store_block_header_t ) ) * 8;
+	number_of_bitmap_blocks         = ( number_of_volume_blocks + number_of_bits_per_bitmap_block - 1 ) / number_of_bits_per_bitmap_block;
+
+	number_of_entries_per_block_list = ( VSHADOW_TEST_IMAGE_BLOCK_SIZE - sizeof( vshadow_store_block_header_t ) ) / sizeof( vshadow_store_block_list_entry_t );
+	number_of_block_list_blocks      = ( (uint64_t) options->number_of_block_descriptors + number_of_entries_per_block_list - 1 ) / number_of_entries_per_block_list;
+
+	if( number_of_block_list_blocks == 0 )
+	{
+		number_of_block_list_blocks = 1;
+	}
+	number_of_blocks_per_store = 1 + number_of_bitmap_blocks + number_of_block_list_blocks + 1 + options->number_of_store_data_blocks;
+
+	if( options->write_previous_bitmaps != 0 )
+	{
+		number_of_blocks_per_store += number_of_bitmap_blocks;
+	}
+	store_size = (size64_t) number_of_blocks_per_store * VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+	catalog_offset = (off64_t) ( number_of_volume_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+	stores_offset  = catalog_offset + (off64_t) ( number_of_catalog_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+	*volume_size   = (size64_t) stores_offset + ( (size64_t) options->number_of_stores * store_size );
+
+	block_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	store_identifiers = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * 16 * options->number_of_stores );
+
+	if( store_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store identifiers.",
+		 function );
+
+		goto on_error;
+	}
+	current_original_offsets = (uint64_t *) memory_allocate(
+	                                         sizeof( uint64_t ) * ( options->number_of_block_descriptors + 1 ) );
+
+	if( current_original_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create current original offsets.",
+		 function );
+
+		goto on_error;
+	}
+	next_original_offsets = (uint64_t *) memory_allocate(
+	                                      sizeof( uint64_t ) * ( options->number_of_block_descriptors + 1 ) );
+
+	if( next_original_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create next original offsets.",
+		 function );
+
+		goto on_error;
+	}
+	random_state = options->random_seed;
+
+	if( random_state == 0 )
+	{
+		random_state = 1;
+	}
+	vshadow_test_image_fill_data(
+	 store_identifiers,
+	 16 * options->number_of_stores,
+	 vshadow_test_image_get_random_value(
+	  &random_state ) );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* Write the volume data area
+	 * the first sector is left empty so it is not mistaken for a NTFS volume header
+	 */
+	for( block_index = 0;
+	     block_index < number_of_volume_blocks;
+	     block_index++ )
+	{
+		block_offset = block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+		if( options->fill_volume_data != 0 )
+		{
+			vshadow_test_image_fill_data(
+			 block_data,
+			 VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+			 options->random_seed + block_offset );
+		}
+		else if( block_index == 0 )
+		{
+			memory_set(
+			 block_data,
+			 0,
+			 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+		}
+		else
+		{
+			continue;
+		}
+		if( block_index == 0 )
+		{
+			memory_set(
+			 block_data,
+			 0,
+			 512 );
+
+			memory_set(
+			 &( block_data[ 0x1e00 ] ),
+			 0,
+			 sizeof( vshadow_volume_header_t ) );
+
+			entry_data = &( block_data[ 0x1e00 ] );
+
+			memory_copy(
+			 ( (vshadow_volume_header_t *) entry_data )->identifier,
+			 vshadow_test_image_vss_identifier,
+			 16 );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (vshadow_volume_header_t *) entry_data )->version,
+			 1 );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (vshadow_volume_header_t *) entry_data )->record_type,
+			 LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (vshadow_volume_header_t *) entry_data )->offset,
+			 (uint64_t) 0x1e00 );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (vshadow_volume_header_t *) entry_data )->catalog_offset,
+			 (uint64_t) catalog_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (vshadow_volume_header_t *) entry_data )->maximum_size,
+			 (uint64_t) options->number_of_stores * store_size );
+
+			vshadow_test_image_fill_data(
+			 ( (vshadow_volume_header_t *) entry_data )->volume_identifier,
+			 16,
+			 vshadow_test_image_get_random_value(
+			  &random_state ) );
+
+			memory_copy(
+			 ( (vshadow_volume_header_t *) entry_data )->store_volume_identifier,
+			 ( (vshadow_volume_header_t *) entry_data )->volume_identifier,
+			 16 );
+		}
+		if( vshadow_test_image_write_block(
+		     file_io_handle,
+		     (off64_t) block_offset,
+		     block_data,
+		     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write volume data block: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+	}
+	/* Write the catalog, the oldest store first
+	 */
+	entry_index = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_catalog_blocks;
+	     block_index++ )
+	{
+		block_offset = (uint64_t) catalog_offset + ( block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		memory_set(
+		 block_data,
+		 0,
+		 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		vshadow_test_image_set_block_header(
+		 block_data,
+		 LIBVSHADOW_RECORD_TYPE_CATALOG,
+		 (off64_t) ( block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE ),
+		 (off64_t) block_offset,
+		 ( ( block_index + 1 ) < number_of_catalog_blocks ) ? (off64_t) ( block_offset + VSHADOW_TEST_IMAGE_BLOCK_SIZE ) : 0 );
+
+		for( entry_offset = sizeof( vshadow_catalog_header_t );
+		     entry_offset < VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+		     entry_offset += 128 )
+		{
+			if( entry_index >= ( 2 * options->number_of_stores ) )
+			{
+				break;
+			}
+			entry_data   = &( block_data[ entry_offset ] );
+			store_index  = entry_index / 2;
+			store_offset = stores_offset + ( (off64_t) ( options->number_of_stores - 1 - store_index ) * (off64_t) store_size );
+
+			memory_copy(
+			 &( entry_data[ 16 ] ),
+			 &( store_identifiers[ store_index * 16 ] ),
+			 16 );
+
+			if( ( entry_index % 2 ) == 0 )
+			{
+				byte_stream_copy_from_uint64_little_endian(
+				 entry_data,
+				 (uint64_t) 2 );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 8 ] ),
+				 *volume_size );
+
+				/* The creation times are 1 hour apart starting at 2015-01-01
+				 */
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 48 ] ),
+				 (uint64_t) 0x01d025a6e6730000ULL + ( (uint64_t) store_index * (uint64_t) 36000000000ULL ) );
+			}
+			else
+			{
+				store_header_offset = store_offset;
+				store_bitmap_offset = store_header_offset + VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+				if( options->write_previous_bitmaps != 0 )
+				{
+					store_previous_bitmap_offset = store_bitmap_offset + (off64_t) ( number_of_bitmap_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+					store_block_list_offset      = store_previous_bitmap_offset + (off64_t) ( number_of_bitmap_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+				}
+				else
+				{
+					store_previous_bitmap_offset = 0;
+					store_block_list_offset      = store_bitmap_offset + (off64_t) ( number_of_bitmap_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+				}
+				store_block_range_list_offset = store_block_list_offset + (off64_t) ( number_of_block_list_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 entry_data,
+				 (uint64_t) 3 );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 8 ] ),
+				 (uint64_t) store_block_list_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 32 ] ),
+				 (uint64_t) store_header_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 40 ] ),
+				 (uint64_t) store_block_range_list_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 48 ] ),
+				 (uint64_t) store_bitmap_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 64 ] ),
+				 (uint64_t) store_size );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 &( entry_data[ 72 ] ),
+				 (uint64_t) store_previous_bitmap_offset );
+			}
+			entry_index++;
+		}
+		if( vshadow_test_image_write_block(
+		     file_io_handle,
+		     (off64_t) block_offset,
+		     block_data,
+		     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write catalog block: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+	}
+	/* Write the stores, the most recent store first so the forwarder block descriptors
+	 * can refer to the original offsets of the next store
+	 */
+	next_number_of_original_offsets = 0;
+
+	for( store_index = options->number_of_stores - 1;
+	     store_index >= 0;
+	     store_index-- )
+	{
+		random_state = options->random_seed ^ ( ( (uint64_t) store_index + 1 ) * (uint64_t) 0x9e3779b97f4a7c15ULL );
+
+		if( random_state == 0 )
+		{
+			random_state = 1;
+		}
+		store_offset      = stores_offset + ( (off64_t) ( options->number_of_stores - 1 - store_index ) * (off64_t) store_size );
+		store_data_offset = store_offset + (off64_t) ( ( number_of_blocks_per_store - options->number_of_store_data_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		/* Write the store header
+		 */
+		memory_set(
+		 block_data,
+		 0,
+		 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		vshadow_test_image_set_block_header(
+		 block_data,
+		 LIBVSHADOW_RECORD_TYPE_STORE_HEADER,
+		 0,
+		 store_offset,
+		 0 );
+
+		entry_data = &( block_data[ sizeof( vshadow_store_header_t ) ] );
+
+		vshadow_test_image_fill_data(
+		 ( (vshadow_store_information_t *) entry_data )->copy_identifier,
+		 16,
+		 vshadow_test_image_get_random_value(
+		  &random_state ) );
+
+		vshadow_test_image_fill_data(
+		 ( (vshadow_store_information_t *) entry_data )->copy_set_identifier,
+		 16,
+		 vshadow_test_image_get_random_value(
+		  &random_state ) );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (vshadow_store_information_t *) entry_data )->attribute_flags,
+		 0x0042000dUL );
+
+		entry_offset = sizeof( vshadow_store_header_t ) + sizeof( vshadow_store_information_t );
+		string_size  = 2 * narrow_string_length( vshadow_test_image_machine_string );
+
+		/* The operating and service machine strings are stored as UTF-16 little-endian
+		 */
+		for( machine_string_index = 0;
+		     machine_string_index < 2;
+		     machine_string_index++ )
+		{
+			byte_stream_copy_from_uint16_little_endian(
+			 &( block_data[ entry_offset ] ),
+			 (uint16_t) string_size );
+
+			entry_offset += 2;
+
+			for( string_index = 0;
+			     string_index < ( string_size / 2 );
+			     string_index++ )
+			{
+				block_data[ entry_offset++ ] = (uint8_t) vshadow_test_image_machine_string[ string_index ];
+				block_data[ entry_offset++ ] = 0;
+			}
+		}
+		if( vshadow_test_image_write_block(
+		     file_io_handle,
+		     store_offset,
+		     block_data,
+		     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write store: %d header.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		/* Write the store bitmap and the previous store bitmap
+		 * a bit that is set marks a volume block that was not in use when the snapshot was created
+		 */
+		store_block_offset = (uint64_t) store_offset + VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+		for( bitmap_index = 0;
+		     bitmap_index < 2;
+		     bitmap_index++ )
+		{
+			if( ( bitmap_index == 1 )
+			 && ( options->write_previous_bitmaps == 0 ) )
+			{
+				break;
+			}
+			for( block_index = 0;
+			     block_index < number_of_bitmap_blocks;
+			     block_index++ )
+			{
+				memory_set(
+				 block_data,
+				 0,
+				 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+				vshadow_test_image_set_block_header(
+				 block_data,
+				 LIBVSHADOW_RECORD_TYPE_STORE_BITMAP,
+				 (off64_t) ( block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE ),
+				 (off64_t) store_block_offset,
+				 ( ( block_index + 1 ) < number_of_bitmap_blocks ) ? (off64_t) ( store_block_offset + VSHADOW_TEST_IMAGE_BLOCK_SIZE ) : 0 );
+
+				vshadow_test_image_fill_data(
+				 &( block_data[ sizeof( vshadow_store_block_header_t ) ] ),
+				 VSHADOW_TEST_IMAGE_BLOCK_SIZE - sizeof( vshadow_store_block_header_t ),
+				 vshadow_test_image_get_random_value(
+				  &random_state ) );
+
+				/* Clear the bits after the last volume block
+				 */
+				for( bit_index = number_of_volume_blocks - ( block_index * number_of_bits_per_bitmap_block );
+				     bit_index < number_of_bits_per_bitmap_block;
+				     bit_index++ )
+				{
+					block_data[ sizeof( vshadow_store_block_header_t ) + ( bit_index / 8 ) ] &= (uint8_t) ~( 1 << ( bit_index % 8 ) );
+				}
+				if( vshadow_test_image_write_block(
+				     file_io_handle,
+				     (off64_t) store_block_offset,
+				     block_data,
+				     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write store: %d bitmap block: %" PRIu64 ".",
+					 function,
+					 store_index,
+					 block_index );
+
+					goto on_error;
+				}
+				store_block_offset += VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+			}
+		}
+		/* Write the store block list
+		 */
+		descriptor_index = 0;
+
+		for( block_index = 0;
+		     block_index < number_of_block_list_blocks;
+		     block_index++ )
+		{
+			memory_set(
+			 block_data,
+			 0,
+			 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+			vshadow_test_image_set_block_header(
+			 block_data,
+			 LIBVSHADOW_RECORD_TYPE_STORE_INDEX,
+			 (off64_t) ( block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE ),
+			 (off64_t) store_block_offset,
+			 ( ( block_index + 1 ) < number_of_block_list_blocks ) ? (off64_t) ( store_block_offset + VSHADOW_TEST_IMAGE_BLOCK_SIZE ) : 0 );
+
+			for( entry_offset = sizeof( vshadow_store_block_header_t );
+			     ( entry_offset + sizeof( vshadow_store_block_list_entry_t ) ) <= VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+			     entry_offset += sizeof( vshadow_store_block_list_entry_t ) )
+			{
+				if( descriptor_index >= options->number_of_block_descriptors )
+				{
+					break;
+				}
+				descriptor_type = (uint32_t) ( vshadow_test_image_get_random_value(
+				                                &random_state ) % 100 );
+
+				original_offset = ( vshadow_test_image_get_random_value(
+				                     &random_state ) % number_of_volume_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+
+				if( descriptor_type < options->forwarder_percentage )
+				{
+					/* The forwarder of the most recent store refers to the volume
+					 */
+					if( next_number_of_original_offsets > 0 )
+					{
+						relative_offset = next_original_offsets[ vshadow_test_image_get_random_value(
+						                                          &random_state ) % next_number_of_original_offsets ];
+					}
+					else
+					{
+						relative_offset = ( vshadow_test_image_get_random_value(
+						                     &random_state ) % number_of_volume_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+					}
+					if( relative_offset == original_offset )
+					{
+						relative_offset = ( ( ( original_offset / VSHADOW_TEST_IMAGE_BLOCK_SIZE ) + 1 ) % number_of_volume_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+					}
+					block_flags       = LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER;
+					block_descriptor_offset       = 0;
+					allocation_bitmap = 0;
+				}
+				else if( descriptor_type < (uint32_t) ( options->forwarder_percentage + options->overlay_percentage ) )
+				{
+					/* Half of the overlays apply to a block that was previously defined in the store
+					 */
+					if( ( descriptor_index > 0 )
+					 && ( ( vshadow_test_image_get_random_value(
+					         &random_state ) & 1 ) != 0 ) )
+					{
+						original_offset = current_original_offsets[ vshadow_test_image_get_random_value(
+						                                             &random_state ) % descriptor_index ];
+					}
+					block_descriptor_offset = (uint64_t) store_data_offset + ( ( vshadow_test_image_get_random_value(
+					                                                  &random_state ) % options->number_of_store_data_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+					allocation_bitmap = (uint32_t) ( vshadow_test_image_get_random_value(
+					                                  &random_state ) >> 32 );
+
+					if( allocation_bitmap == 0 )
+					{
+						allocation_bitmap = 1;
+					}
+					block_flags     = LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY;
+					relative_offset = 1;
+				}
+				else
+				{
+					block_descriptor_offset = (uint64_t) store_data_offset + ( ( vshadow_test_image_get_random_value(
+					                                                  &random_state ) % options->number_of_store_data_blocks ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+					block_flags       = 0;
+					relative_offset   = block_descriptor_offset - (uint64_t) store_offset;
+					allocation_bitmap = 0;
+				}
+				entry_data = &( block_data[ entry_offset ] );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 ( (vshadow_store_block_list_entry_t *) entry_data )->original_offset,
+				 original_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 ( (vshadow_store_block_list_entry_t *) entry_data )->relative_offset,
+				 relative_offset );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 ( (vshadow_store_block_list_entry_t *) entry_data )->offset,
+				 block_descriptor_offset );
+
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (vshadow_store_block_list_entry_t *) entry_data )->flags,
+				 block_flags );
+
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (vshadow_store_block_list_entry_t *) entry_data )->allocation_bitmap,
+				 allocation_bitmap );
+
+				current_original_offsets[ descriptor_index++ ] = original_offset;
+			}
+			if( vshadow_test_image_write_block(
+			     file_io_handle,
+			     (off64_t) store_block_offset,
+			     block_data,
+			     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write store: %d block list block: %" PRIu64 ".",
+				 function,
+				 store_index,
+				 block_index );
+
+				goto on_error;
+			}
+			store_block_offset += VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+		}
+		/* Write the store block range list, the store data blocks form a single range
+		 */
+		memory_set(
+		 block_data,
+		 0,
+		 VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		vshadow_test_image_set_block_header(
+		 block_data,
+		 LIBVSHADOW_RECORD_TYPE_STORE_BLOCK_RANGE,
+		 0,
+		 (off64_t) store_block_offset,
+		 0 );
+
+		entry_data = &( block_data[ sizeof( vshadow_store_block_header_t ) ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (vshadow_store_block_range_list_entry_t *) entry_data )->offset,
+		 (uint64_t) store_data_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (vshadow_store_block_range_list_entry_t *) entry_data )->relative_offset,
+		 (uint64_t) ( store_data_offset - store_offset ) );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (vshadow_store_block_range_list_entry_t *) entry_data )->size,
+		 (uint64_t) options->number_of_store_data_blocks * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+		if( vshadow_test_image_write_block(
+		     file_io_handle,
+		     (off64_t) store_block_offset,
+		     block_data,
+		     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write store: %d block range list.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		/* Write the store data
+		 */
+		for( block_index = 0;
+		     block_index < options->number_of_store_data_blocks;
+		     block_index++ )
+		{
+			block_offset = (uint64_t) store_data_offset + ( block_index * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+			vshadow_test_image_fill_data(
+			 block_data,
+			 VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+			 options->random_seed + block_offset );
+
+			if( vshadow_test_image_write_block(
+			     file_io_handle,
+			     (off64_t) block_offset,
+			     block_data,
+			     VSHADOW_TEST_IMAGE_BLOCK_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write store: %d data block: %" PRIu64 ".",
+				 function,
+				 store_index,
+				 block_index );
+
+				goto on_error;
+			}
+		}
+		swap_original_offsets    = next_original_offsets;
+		next_original_offsets    = current_original_offsets;
+		current_original_offsets = swap_original_offsets;
+
+		next_number_of_original_offsets = descriptor_index;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 next_original_offsets );
+
+	memory_free(
+	 current_original_offsets );
+
+	memory_free(
+	 store_identifiers );
+
+	memory_free(
+	 block_data );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( next_original_offsets != NULL )
+	{
+		memory_free(
+		 next_original_offsets );
+	}
+	if( current_original_offsets != NULL )
+	{
+		memory_free(
+		 current_original_offsets );
+	}
+	if( store_identifiers != NULL )
+	{
+		memory_free(
+		 store_identifiers );
+	}
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	return( -1 );
+}
+
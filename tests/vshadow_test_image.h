@@ -0,0 +1,128 @@
+/*
+ * Synthetic Volume Shadow Snapshot (VSS) image functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VSHADOW_TEST_IMAGE_H )
+#define _VSHADOW_TEST_IMAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define VSHADOW_TEST_IMAGE_BLOCK_SIZE					0x4000
+
+#define VSHADOW_TEST_IMAGE_DEFAULT_VOLUME_DATA_SIZE			( 64 * 1024 * 1024 )
+#define VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORES			4
+#define VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_BLOCK_DESCRIPTORS		1024
+#define VSHADOW_TEST_IMAGE_DEFAULT_NUMBER_OF_STORE_DATA_BLOCKS		64
+#define VSHADOW_TEST_IMAGE_DEFAULT_FORWARDER_PERCENTAGE			10
+#define VSHADOW_TEST_IMAGE_DEFAULT_OVERLAY_PERCENTAGE			10
+
+#define VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES			512
+#define VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_BLOCK_DESCRIPTORS		( 64 * 1024 * 1024 )
+
+typedef struct vshadow_test_image_options vshadow_test_image_options_t;
+
+struct vshadow_test_image_options
+{
+	/* The size of the volume data area
+	 * the VSS metadata and the store data are stored after this area
+	 */
+	size64_t volume_data_size;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The number of block descriptors per store
+	 */
+	uint32_t number_of_block_descriptors;
+
+	/* The number of store data blocks per store
+	 * the block descriptors share these blocks
+	 */
+	uint32_t number_of_store_data_blocks;
+
+	/* The percentage of block descriptors that are forwarders
+	 */
+	uint8_t forwarder_percentage;
+
+	/* The percentage of block descriptors that are overlays
+	 */
+	uint8_t overlay_percentage;
+
+	/* Value to indicate the previous store bitmaps should be written
+	 */
+	uint8_t write_previous_bitmaps;
+
+	/* Value to indicate the volume data area should be filled
+	 * otherwise the area is left sparse
+	 */
+	uint8_t fill_volume_data;
+
+	/* The seed of the pseudo random number generator
+	 */
+	uint64_t random_seed;
+};
+
+int vshadow_test_image_options_initialize(
+     vshadow_test_image_options_t *options,
+     libcerror_error_t **error );
+
+uint64_t vshadow_test_image_get_random_value(
+          uint64_t *random_state );
+
+void vshadow_test_image_fill_data(
+      uint8_t *data,
+      size_t data_size,
+      uint64_t random_seed );
+
+void vshadow_test_image_set_block_header(
+      uint8_t *data,
+      uint32_t record_type,
+      off64_t relative_offset,
+      off64_t offset,
+      off64_t next_offset );
+
+int vshadow_test_image_write_block(
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int vshadow_test_image_write(
+     const system_character_t *filename,
+     const vshadow_test_image_options_t *options,
+     size64_t *volume_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VSHADOW_TEST_IMAGE_H ) */
+
@@ -21,12 +21,14 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "vshadow_test_image.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libvshadow.h"
 #include "vshadow_test_macros.h"
@@ -35,6 +37,8 @@
 
 #include "../libvshadow/libvshadow_store.h"
 
+#define VSHADOW_TEST_STORE_FILENAME	"vshadow_test_store.raw"
+
 #if defined( __GNUC__ ) && defined( TODO )
 
 /* Tests the libvshadow_store_initialize function
@@ -256,6 +260,703 @@ on_error:
 	return( 0 );
 }
 
+/* Retrieves the values of a block, of which the original offset is not used by other blocks, with specific flags
+ * Returns 1 if successful, 0 if no such block was found or -1 on error
+ */
+int vshadow_test_store_get_unique_block(
+     libvshadow_store_t *store,
+     uint32_t block_flags,
+     off64_t *original_offset,
+     off64_t *offset,
+     uint32_t *bitmap,
+     libcerror_error_t **error )
+{
+	libvshadow_block_t *block       = NULL;
+	static char *function           = "vshadow_test_store_get_unique_block";
+	off64_t compare_original_offset = 0;
+	off64_t relative_offset         = 0;
+	uint32_t flags                  = 0;
+	int block_index                 = 0;
+	int compare_block_index         = 0;
+	int number_of_blocks            = 0;
+
+	if( libvshadow_store_get_number_of_blocks(
+	     store,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( libvshadow_store_get_block_by_index(
+		     store,
+		     block_index,
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( libvshadow_block_get_values(
+		     block,
+		     original_offset,
+		     &relative_offset,
+		     offset,
+		     &flags,
+		     bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %d values.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( libvshadow_block_free(
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( flags != block_flags )
+		{
+			continue;
+		}
+		for( compare_block_index = 0;
+		     compare_block_index < number_of_blocks;
+		     compare_block_index++ )
+		{
+			if( compare_block_index == block_index )
+			{
+				continue;
+			}
+			if( libvshadow_store_get_block_by_index(
+			     store,
+			     compare_block_index,
+			     &block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block: %d.",
+				 function,
+				 compare_block_index );
+
+				goto on_error;
+			}
+			if( libvshadow_block_get_original_offset(
+			     block,
+			     &compare_original_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block: %d original offset.",
+				 function,
+				 compare_block_index );
+
+				goto on_error;
+			}
+			if( libvshadow_block_free(
+			     &block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free block: %d.",
+				 function,
+				 compare_block_index );
+
+				goto on_error;
+			}
+			if( compare_original_offset == *original_offset )
+			{
+				break;
+			}
+		}
+		if( compare_block_index >= number_of_blocks )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+
+on_error:
+	if( block != NULL )
+	{
+		libvshadow_block_free(
+		 &block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if a block of the store uses a specific original offset
+ * Returns 1 if a block uses the original offset, 0 if not or -1 on error
+ */
+int vshadow_test_store_has_block_at_original_offset(
+     libvshadow_store_t *store,
+     off64_t original_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_block_t *block     = NULL;
+	static char *function         = "vshadow_test_store_has_block_at_original_offset";
+	off64_t block_original_offset = 0;
+	int block_index               = 0;
+	int number_of_blocks          = 0;
+
+	if( libvshadow_store_get_number_of_blocks(
+	     store,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( libvshadow_store_get_block_by_index(
+		     store,
+		     block_index,
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( libvshadow_block_get_original_offset(
+		     block,
+		     &block_original_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %d original offset.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( libvshadow_block_free(
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( block_original_offset == original_offset )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+
+on_error:
+	if( block != NULL )
+	{
+		libvshadow_block_free(
+		 &block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libvshadow_store_get_extent_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_get_extent_at_offset(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error         = NULL;
+	libvshadow_store_t *store        = NULL;
+	size64_t extent_size             = 0;
+	size64_t volume_size             = 0;
+	off64_t block_offset             = 0;
+	off64_t extent_offset            = 0;
+	off64_t offset                   = 0;
+	off64_t original_offset          = 0;
+	uint32_t bitmap                  = 0;
+	uint32_t extent_flags            = 0;
+	int number_of_current_extents    = 0;
+	int number_of_sectors            = 0;
+	int number_of_sparse_extents     = 0;
+	int number_of_stores             = 0;
+	int result                       = 0;
+	int sector_index                 = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_stores",
+	 number_of_stores,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Only the most recent store refers to zero filled (sparse) blocks
+	 */
+	result = libvshadow_volume_get_store(
+	          volume,
+	          number_of_stores - 1,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_get_volume_size(
+	          store,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* Test an offset in a block stored in the store data
+	 */
+	result = vshadow_test_store_get_unique_block(
+	          store,
+	          0,
+	          &original_offset,
+	          &block_offset,
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          original_offset + 0x1234,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) ( block_offset + 0x1234 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) ( 0x4000 - 0x1234 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA );
+
+	/* Test an offset that is not sector aligned in an allocated sector of an overlay block
+	 */
+	result = vshadow_test_store_get_unique_block(
+	          store,
+	          LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY,
+	          &original_offset,
+	          &block_offset,
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT32(
+	 "bitmap",
+	 (int32_t) bitmap,
+	 0 );
+
+	while( ( bitmap & 0x00000001UL ) == 0 )
+	{
+		bitmap >>= 1;
+
+		sector_index++;
+	}
+	while( ( bitmap & 0x00000001UL ) != 0 )
+	{
+		bitmap >>= 1;
+
+		number_of_sectors++;
+	}
+	offset = original_offset + ( sector_index * 512 ) + 100;
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          offset,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) ( block_offset + ( sector_index * 512 ) + 100 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) ( ( number_of_sectors * 512 ) - 100 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA );
+
+	/* Test offsets in blocks without a block descriptor, which are either
+	 * stored in the current volume or zero filled (sparse)
+	 */
+	for( block_offset = 0;
+	     (size64_t) block_offset < volume_size;
+	     block_offset += 0x4000 )
+	{
+		result = vshadow_test_store_has_block_at_original_offset(
+		          store,
+		          block_offset,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			continue;
+		}
+		result = libvshadow_store_get_extent_at_offset(
+		          store,
+		          block_offset + 0x0800,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "extent_size",
+		 (uint64_t) extent_size,
+		 (uint64_t) ( 0x4000 - 0x0800 ) );
+
+		if( extent_flags == 0 )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT64(
+			 "extent_offset",
+			 (int64_t) extent_offset,
+			 (int64_t) ( block_offset + 0x0800 ) );
+
+			number_of_current_extents++;
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+			 "extent_flags",
+			 extent_flags,
+			 LIBVSHADOW_EXTENT_FLAG_IS_SPARSE );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT64(
+			 "extent_offset",
+			 (int64_t) extent_offset,
+			 (int64_t) 0 );
+
+			number_of_sparse_extents++;
+		}
+	}
+	VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_current_extents",
+	 number_of_current_extents,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_sparse_extents",
+	 number_of_sparse_extents,
+	 0 );
+
+	/* Test an offset beyond the volume size
+	 */
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          (off64_t) volume_size,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_extent_at_offset(
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          -1,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          0,
+	          NULL,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          0,
+	          &extent_offset,
+	          NULL,
+	          &extent_flags,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -268,6 +969,13 @@ int main(
      char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
 #endif
 {
+	vshadow_test_image_options_t options;
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	size64_t volume_size        = 0;
+	int result                  = 0;
+
 	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
 	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
 
@@ -302,12 +1010,135 @@ int main(
 	/* TODO add tests for libvshadow_store_get_attribute_flags */
 	/* TODO add tests for libvshadow_store_get_number_of_blocks */
 	/* TODO add tests for libvshadow_store_get_block_by_index */
-
 #endif /* defined( __GNUC__ ) */
 
+	/* Initialize test
+	 * a synthetic volume provides store data, overlay, current volume and sparse blocks
+	 */
+	result = vshadow_test_image_options_initialize(
+	          &options,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	options.volume_data_size            = 4 * 1024 * 1024;
+	options.number_of_stores            = 2;
+	options.number_of_block_descriptors = 128;
+	options.number_of_store_data_blocks = 16;
+	options.forwarder_percentage        = 20;
+	options.overlay_percentage          = 30;
+
+	result = vshadow_test_image_write(
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_FILENAME ),
+	          &options,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_FILENAME ),
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#else
+	result = libvshadow_volume_open(
+	          volume,
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_FILENAME ),
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_get_extent_at_offset",
+	 vshadow_test_store_get_extent_at_offset,
+	 volume );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 VSHADOW_TEST_STORE_FILENAME );
+
 	return( EXIT_SUCCESS );
 
 on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	remove(
+	 VSHADOW_TEST_STORE_FILENAME );
+
 	return( EXIT_FAILURE );
 }
 
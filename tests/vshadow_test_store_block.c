@@ -396,6 +396,7 @@ int vshadow_test_store_block_read(
 	 */
 	result = libvshadow_store_block_read(
 	          store_block,
+	          NULL,
 	          file_io_handle,
 	          0,
 	          &error );
@@ -414,6 +415,7 @@ int vshadow_test_store_block_read(
 	/* Test error cases
 	 */
 	result = libvshadow_store_block_read(
+	          NULL,
 	          NULL,
 	          file_io_handle,
 	          0,
@@ -434,6 +436,7 @@ int vshadow_test_store_block_read(
 	result = libvshadow_store_block_read(
 	          store_block,
 	          NULL,
+	          NULL,
 	          0,
 	          &error );
 
@@ -451,6 +454,7 @@ int vshadow_test_store_block_read(
 
 	result = libvshadow_store_block_read(
 	          store_block,
+	          NULL,
 	          file_io_handle,
 	          -1,
 	          &error );
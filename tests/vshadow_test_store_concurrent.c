@@ -0,0 +1,985 @@
+/*
+ * Library store concurrent read test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_image.h"
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libcthreads.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#define VSHADOW_TEST_STORE_CONCURRENT_FILENAME			"vshadow_test_store_concurrent.raw"
+#define VSHADOW_TEST_STORE_CONCURRENT_MAXIMUM_READ_SIZE		( 64 * 1024 )
+#define VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READS		256
+#define VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS		8
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct vshadow_test_store_concurrent_reader vshadow_test_store_concurrent_reader_t;
+
+struct vshadow_test_store_concurrent_reader
+{
+	/* The stores, shared by all readers
+	 */
+	libvshadow_store_t **stores;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The index of the store to read or -1 to read all stores
+	 */
+	int store_index;
+
+	/* The data of the stores read by a single thread
+	 */
+	uint8_t **reference_data;
+
+	/* The size of the data of a store
+	 */
+	size64_t data_size;
+
+	/* The file IO handle of the reader
+	 * if NULL the current offset of the store is used
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The state of the pseudo random number generator
+	 */
+	uint64_t random_state;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The result, 1 if all reads matched the reference data,
+	 * 0 if not or -1 on error
+	 */
+	int result;
+};
+
+typedef struct vshadow_test_store_concurrent_loader vshadow_test_store_concurrent_loader_t;
+
+struct vshadow_test_store_concurrent_loader
+{
+	/* The stores, shared with the readers
+	 */
+	libvshadow_store_t **stores;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The result, 1 if successful or -1 on error
+	 */
+	int result;
+};
+
+/* Opens a volume
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_concurrent_open_volume(
+     libvshadow_volume_t **volume,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadow_test_store_concurrent_open_volume";
+
+	if( libvshadow_volume_initialize(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize volume.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvshadow_volume_open_wide(
+	     *volume,
+	     _SYSTEM_STRING( VSHADOW_TEST_STORE_CONCURRENT_FILENAME ),
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvshadow_volume_open(
+	     *volume,
+	     VSHADOW_TEST_STORE_CONCURRENT_FILENAME,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *volume != NULL )
+	{
+		libvshadow_volume_free(
+		 volume,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a file IO handle of a reader
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_concurrent_open_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function  = "vshadow_test_store_concurrent_open_file_io_handle";
+	size_t filename_length = 0;
+
+	if( libbfio_file_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	filename_length = system_string_length(
+	                   _SYSTEM_STRING( VSHADOW_TEST_STORE_CONCURRENT_FILENAME ) );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     *file_io_handle,
+	     _SYSTEM_STRING( VSHADOW_TEST_STORE_CONCURRENT_FILENAME ),
+	     filename_length + 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     *file_io_handle,
+	     VSHADOW_TEST_STORE_CONCURRENT_FILENAME,
+	     filename_length + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads pseudo random ranges of the stores and compares them with the reference data
+ * This function is run by the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_concurrent_reader_run(
+     vshadow_test_store_concurrent_reader_t *reader )
+{
+	libcerror_error_t *error = NULL;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	off64_t read_offset      = 0;
+	uint64_t random_value    = 0;
+	int read_index           = 0;
+	int store_index          = 0;
+
+	reader->result = 1;
+
+	for( read_index = 0;
+	     read_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READS;
+	     read_index++ )
+	{
+		random_value = vshadow_test_image_get_random_value(
+		                &( reader->random_state ) );
+
+		store_index = reader->store_index;
+
+		if( store_index == -1 )
+		{
+			store_index = (int) ( random_value % reader->number_of_stores );
+		}
+		random_value = vshadow_test_image_get_random_value(
+		                &( reader->random_state ) );
+
+		read_offset = (off64_t) ( random_value % reader->data_size );
+
+		/* Mix block, sector and byte aligned offsets
+		 */
+		switch( random_value >> 62 )
+		{
+			case 0:
+				read_offset -= read_offset % VSHADOW_TEST_IMAGE_BLOCK_SIZE;
+				break;
+
+			case 1:
+				read_offset -= read_offset % 512;
+				break;
+		}
+		random_value = vshadow_test_image_get_random_value(
+		                &( reader->random_state ) );
+
+		read_size = 1 + (size_t) ( random_value % VSHADOW_TEST_STORE_CONCURRENT_MAXIMUM_READ_SIZE );
+
+		if( (size64_t) read_size > ( reader->data_size - read_offset ) )
+		{
+			read_size = (size_t) ( reader->data_size - read_offset );
+		}
+		if( reader->file_io_handle != NULL )
+		{
+			read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+			              reader->stores[ store_index ],
+			              reader->file_io_handle,
+			              reader->buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+		}
+		else
+		{
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              reader->stores[ store_index ],
+			              reader->buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+		}
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read store: %d at offset: %" PRIi64 " of size: %" PRIzd ".\n",
+			 store_index,
+			 read_offset,
+			 read_size );
+
+			reader->result = -1;
+
+			break;
+		}
+		if( memory_compare(
+		     reader->buffer,
+		     &( ( reader->reference_data[ store_index ] )[ read_offset ] ),
+		     read_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Data of store: %d at offset: %" PRIi64 " of size: %" PRIzd " does not match single-threaded read.\n",
+			 store_index,
+			 read_offset,
+			 read_size );
+
+			reader->result = 0;
+
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( reader->result );
+}
+
+/* Triggers loading the block descriptors of the stores, newest store first
+ * This function is run by the loader thread
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_concurrent_loader_run(
+     vshadow_test_store_concurrent_loader_t *loader )
+{
+	libcerror_error_t *error  = NULL;
+	libvshadow_block_t *block = NULL;
+	int number_of_blocks      = 0;
+	int store_index           = 0;
+
+	loader->result = 1;
+
+	for( store_index = loader->number_of_stores - 1;
+	     store_index >= 0;
+	     store_index-- )
+	{
+		if( libvshadow_store_get_number_of_blocks(
+		     loader->stores[ store_index ],
+		     &number_of_blocks,
+		     &error ) != 1 )
+		{
+			loader->result = -1;
+
+			break;
+		}
+		if( number_of_blocks == 0 )
+		{
+			continue;
+		}
+		if( libvshadow_store_get_block_by_index(
+		     loader->stores[ store_index ],
+		     number_of_blocks - 1,
+		     &block,
+		     &error ) != 1 )
+		{
+			loader->result = -1;
+
+			break;
+		}
+		if( libvshadow_block_free(
+		     &block,
+		     &error ) != 1 )
+		{
+			loader->result = -1;
+
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( loader->result );
+}
+
+/* Tests reading the stores of a synthetic volume from multiple threads
+ * The data read is compared with the data read by a single thread
+ * If use_file_io_handles is set every reader uses a file IO handle of its own,
+ * where half of the readers read the first store and the other half all stores,
+ * while a separate thread triggers loading the block descriptors of the stores.
+ * Otherwise all readers read the first store using the current offset of the store
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_concurrent_read(
+     const vshadow_test_image_options_t *options,
+     int use_file_io_handles )
+{
+	vshadow_test_store_concurrent_loader_t loader;
+	vshadow_test_store_concurrent_reader_t readers[ VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS ];
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_store_t **stores = NULL;
+	libvshadow_volume_t *volume = NULL;
+	uint8_t **reference_data    = NULL;
+	size64_t volume_size        = 0;
+	size_t read_size            = 0;
+	ssize_t read_count          = 0;
+	off64_t read_offset         = 0;
+	int number_of_stores        = 0;
+	int reader_index            = 0;
+	int result                  = 0;
+	int store_index             = 0;
+
+	memory_set(
+	 &loader,
+	 0,
+	 sizeof( vshadow_test_store_concurrent_loader_t ) );
+
+	memory_set(
+	 readers,
+	 0,
+	 sizeof( vshadow_test_store_concurrent_reader_t ) * VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS );
+
+	/* Initialize test
+	 */
+	result = vshadow_test_image_write(
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_CONCURRENT_FILENAME ),
+	          options,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_stores = options->number_of_stores;
+
+	stores = (libvshadow_store_t **) memory_allocate(
+	                                  sizeof( libvshadow_store_t * ) * number_of_stores );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "stores",
+	 stores );
+
+	memory_set(
+	 stores,
+	 0,
+	 sizeof( libvshadow_store_t * ) * number_of_stores );
+
+	reference_data = (uint8_t **) memory_allocate(
+	                               sizeof( uint8_t * ) * number_of_stores );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_data",
+	 reference_data );
+
+	memory_set(
+	 reference_data,
+	 0,
+	 sizeof( uint8_t * ) * number_of_stores );
+
+	/* Read the data of the stores from a single thread
+	 */
+	result = vshadow_test_store_concurrent_open_volume(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		reference_data[ store_index ] = (uint8_t *) memory_allocate(
+		                                             sizeof( uint8_t ) * (size_t) volume_size );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_data[ store_index ]",
+		 reference_data[ store_index ] );
+
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &( stores[ store_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( read_offset = 0;
+		     read_offset < (off64_t) volume_size;
+		     read_offset += read_count )
+		{
+			read_size = VSHADOW_TEST_STORE_CONCURRENT_MAXIMUM_READ_SIZE;
+
+			if( (size64_t) read_size > ( volume_size - read_offset ) )
+			{
+				read_size = (size_t) ( volume_size - read_offset );
+			}
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              stores[ store_index ],
+			              &( ( reference_data[ store_index ] )[ read_offset ] ),
+			              read_size,
+			              read_offset,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libvshadow_store_free(
+		          &( stores[ store_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reopen the volume so that the block descriptors are loaded
+	 * while the stores are read concurrently
+	 */
+	result = vshadow_test_store_concurrent_open_volume(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &( stores[ store_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( reader_index = 0;
+	     reader_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS;
+	     reader_index++ )
+	{
+		readers[ reader_index ].stores           = stores;
+		readers[ reader_index ].number_of_stores = number_of_stores;
+		readers[ reader_index ].reference_data   = reference_data;
+		readers[ reader_index ].data_size        = volume_size;
+		readers[ reader_index ].random_state     = options->random_seed + reader_index;
+
+		if( ( use_file_io_handles != 0 )
+		 && ( ( reader_index % 2 ) != 0 ) )
+		{
+			readers[ reader_index ].store_index = -1;
+		}
+		readers[ reader_index ].buffer = (uint8_t *) memory_allocate(
+		                                              sizeof( uint8_t ) * VSHADOW_TEST_STORE_CONCURRENT_MAXIMUM_READ_SIZE );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "readers[ reader_index ].buffer",
+		 readers[ reader_index ].buffer );
+
+		if( use_file_io_handles != 0 )
+		{
+			result = vshadow_test_store_concurrent_open_file_io_handle(
+			          &( readers[ reader_index ].file_io_handle ),
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	loader.stores           = stores;
+	loader.number_of_stores = number_of_stores;
+
+	/* Test concurrent reads
+	 */
+	for( reader_index = 0;
+	     reader_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS;
+	     reader_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( readers[ reader_index ].thread ),
+		          NULL,
+		          (int (*)(void *)) &vshadow_test_store_concurrent_reader_run,
+		          (void *) &( readers[ reader_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The loader uses the file IO handle of the volume which is not
+	 * safe to share with readers that use the current offset of a store
+	 */
+	if( use_file_io_handles != 0 )
+	{
+		result = libcthreads_thread_create(
+		          &( loader.thread ),
+		          NULL,
+		          (int (*)(void *)) &vshadow_test_store_concurrent_loader_run,
+		          (void *) &loader,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_join(
+		          &( loader.thread ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "loader.result",
+		 loader.result,
+		 1 );
+	}
+	for( reader_index = 0;
+	     reader_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS;
+	     reader_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( readers[ reader_index ].thread ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "readers[ reader_index ].result",
+		 readers[ reader_index ].result,
+		 1 );
+	}
+	/* Clean up
+	 */
+	for( reader_index = 0;
+	     reader_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS;
+	     reader_index++ )
+	{
+		if( readers[ reader_index ].file_io_handle != NULL )
+		{
+			result = libbfio_handle_free(
+			          &( readers[ reader_index ].file_io_handle ),
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		memory_free(
+		 readers[ reader_index ].buffer );
+
+		readers[ reader_index ].buffer = NULL;
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_store_free(
+		          &( stores[ store_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		memory_free(
+		 reference_data[ store_index ] );
+	}
+	memory_free(
+	 reference_data );
+
+	memory_free(
+	 stores );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 VSHADOW_TEST_STORE_CONCURRENT_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( loader.thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &( loader.thread ),
+		 NULL );
+	}
+	for( reader_index = 0;
+	     reader_index < VSHADOW_TEST_STORE_CONCURRENT_NUMBER_OF_READERS;
+	     reader_index++ )
+	{
+		if( readers[ reader_index ].thread != NULL )
+		{
+			libcthreads_thread_join(
+			 &( readers[ reader_index ].thread ),
+			 NULL );
+		}
+		if( readers[ reader_index ].file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( readers[ reader_index ].file_io_handle ),
+			 NULL );
+		}
+		if( readers[ reader_index ].buffer != NULL )
+		{
+			memory_free(
+			 readers[ reader_index ].buffer );
+		}
+	}
+	if( stores != NULL )
+	{
+		for( store_index = 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			if( stores[ store_index ] != NULL )
+			{
+				libvshadow_store_free(
+				 &( stores[ store_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 stores );
+	}
+	if( reference_data != NULL )
+	{
+		for( store_index = 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			if( reference_data[ store_index ] != NULL )
+			{
+				memory_free(
+				 reference_data[ store_index ] );
+			}
+		}
+		memory_free(
+		 reference_data );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	remove(
+	 VSHADOW_TEST_STORE_CONCURRENT_FILENAME );
+
+	return( 0 );
+}
+
+/* Tests reading the stores from multiple threads using file IO handles of their own
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_concurrent_read_with_file_io_handles(
+     const vshadow_test_image_options_t *options )
+{
+	return( vshadow_test_store_concurrent_read(
+	         options,
+	         1 ) );
+}
+
+/* Tests reading the same store from multiple threads using the current offset of the store
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_concurrent_read_with_current_offset(
+     const vshadow_test_image_options_t *options )
+{
+	return( vshadow_test_store_concurrent_read(
+	         options,
+	         0 ) );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	vshadow_test_image_options_t options;
+#endif
+
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( vshadow_test_image_options_initialize(
+	     &options,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Forwarders and overlays so that reads of a store depend
+	 * on the block descriptors of the newer stores
+	 */
+	options.volume_data_size            = 2 * 1024 * 1024;
+	options.number_of_stores            = 4;
+	options.number_of_block_descriptors = 256;
+	options.number_of_store_data_blocks = 32;
+	options.forwarder_percentage        = 25;
+	options.overlay_percentage          = 25;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_read_buffer_at_offset_from_file_io_handle_concurrent",
+	 vshadow_test_store_concurrent_read_with_file_io_handles,
+	 &options );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_read_buffer_at_offset_concurrent",
+	 vshadow_test_store_concurrent_read_with_current_offset,
+	 &options );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+
+#else
+	return( EXIT_SUCCESS );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,1066 @@
+/*
+ * Library store read differential test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_getopt.h"
+#include "vshadow_test_image.h"
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcdata.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_store_descriptor.h"
+#include "../libvshadow/libvshadow_volume.h"
+
+#define VSHADOW_TEST_STORE_READ_FILENAME		"vshadow_test_store_read.raw"
+#define VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE	( 256 * 1024 )
+#define VSHADOW_TEST_STORE_READ_NUMBER_OF_READS		1024
+
+#if defined( __GNUC__ )
+
+/* Prints the block descriptor state of the block at the specified offset
+ * The state is printed for every store the block is resolved through
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_store_read_print_block_state(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *tree_node                 = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "vshadow_test_store_read_print_block_state";
+	intptr_t *value                                 = NULL;
+	off64_t location_offset                         = 0;
+	size64_t range_size                             = 0;
+	size_t location_size                            = 0;
+	uint64_t range_offset                           = 0;
+	uint8_t location_flags                          = 0;
+	int location_type                               = 0;
+	int result                                      = 0;
+
+	while( store_descriptor != NULL )
+	{
+		fprintf(
+		 stdout,
+		 "\tstore: %02d offset: 0x%08" PRIx64 "\n",
+		 store_descriptor->index,
+		 offset );
+
+		result = libcdata_btree_get_value_by_value(
+		          store_descriptor->forward_block_descriptors_tree,
+		          (intptr_t *) &offset,
+		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
+		          &tree_node,
+		          (intptr_t **) &block_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor for offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result != 0 )
+		      && ( block_descriptor != NULL ) )
+		{
+			fprintf(
+			 stdout,
+			 "\t\tblock descriptor: original offset: 0x%08" PRIx64 ", relative offset: 0x%08" PRIx64 ", offset: 0x%08" PRIx64 ", flags: 0x%08" PRIx32 ", bitmap: 0x%08" PRIx32 "\n",
+			 block_descriptor->original_offset,
+			 block_descriptor->relative_offset,
+			 block_descriptor->offset,
+			 block_descriptor->flags,
+			 block_descriptor->bitmap );
+
+			if( block_descriptor->overlay != NULL )
+			{
+				fprintf(
+				 stdout,
+				 "\t\toverlay block descriptor: original offset: 0x%08" PRIx64 ", offset: 0x%08" PRIx64 ", flags: 0x%08" PRIx32 ", bitmap: 0x%08" PRIx32 "\n",
+				 block_descriptor->overlay->original_offset,
+				 block_descriptor->overlay->offset,
+				 block_descriptor->overlay->flags,
+				 block_descriptor->overlay->bitmap );
+			}
+		}
+		else
+		{
+			fprintf(
+			 stdout,
+			 "\t\tno block descriptor\n" );
+		}
+		if( store_descriptor->block_offset_list != NULL )
+		{
+			result = libcdata_range_list_get_range_at_offset(
+			          store_descriptor->block_offset_list,
+			          (uint64_t) offset,
+			          &range_offset,
+			          (uint64_t *) &range_size,
+			          &value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			fprintf(
+			 stdout,
+			 "\t\tin current bitmap: %d\n",
+			 result );
+		}
+		if( store_descriptor->previous_block_offset_list != NULL )
+		{
+			result = libcdata_range_list_get_range_at_offset(
+			          store_descriptor->previous_block_offset_list,
+			          (uint64_t) offset,
+			          &range_offset,
+			          (uint64_t *) &range_size,
+			          &value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			fprintf(
+			 stdout,
+			 "\t\tin previous bitmap: %d\n",
+			 result );
+		}
+		if( libvshadow_store_descriptor_get_block_location_at_offset(
+		     store_descriptor,
+		     offset,
+		     active_store_descriptor,
+		     &location_offset,
+		     &location_size,
+		     &location_type,
+		     &location_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block location at offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		fprintf(
+		 stdout,
+		 "\t\tlocation type: %d, flags: 0x%02" PRIx8 ", offset: 0x%08" PRIx64 ", size: %" PRIzd "\n",
+		 location_type,
+		 location_flags,
+		 location_offset,
+		 location_size );
+
+		if( location_type != LIBVSHADOW_BLOCK_LOCATION_TYPE_NEXT_STORE )
+		{
+			break;
+		}
+		offset           = location_offset;
+		store_descriptor = store_descriptor->next_store_descriptor;
+	}
+	return( 1 );
+}
+
+/* Compares the data of the stores read by the optimized and the reference read path
+ * The reads are done at pseudo random offsets with pseudo random sizes
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_compare(
+     libvshadow_volume_t *volume,
+     uint64_t random_seed,
+     int number_of_reads )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	uint8_t *reference_buffer                       = NULL;
+	uint8_t *test_buffer                            = NULL;
+	size_t buffer_index                             = 0;
+	size_t read_size                                = 0;
+	ssize_t read_count                              = 0;
+	off64_t read_offset                             = 0;
+	uint64_t random_state                           = 0;
+	uint64_t random_value                           = 0;
+	int number_of_stores                            = 0;
+	int read_index                                  = 0;
+	int result                                      = 0;
+	int store_index                                 = 0;
+
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	reference_buffer = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_buffer",
+	 reference_buffer );
+
+	test_buffer = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "test_buffer",
+	 test_buffer );
+
+	result = libcdata_array_get_number_of_entries(
+	          internal_volume->store_descriptors_array,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	random_state = random_seed;
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libcdata_array_get_entry_by_index(
+		          internal_volume->store_descriptors_array,
+		          store_index,
+		          (intptr_t **) &store_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store_descriptor",
+		 store_descriptor );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( store_descriptor->has_in_volume_store_data == 0 )
+		{
+			continue;
+		}
+		for( read_index = 0;
+		     read_index < number_of_reads;
+		     read_index++ )
+		{
+			/* Mix block, sector and byte aligned offsets and sizes
+			 */
+			random_value = vshadow_test_image_get_random_value(
+			                &random_state );
+
+			read_offset = (off64_t) ( random_value % internal_volume->size );
+
+			switch( random_value >> 62 )
+			{
+				case 0:
+					read_offset -= read_offset % 0x4000;
+					break;
+
+				case 1:
+					read_offset -= read_offset % 512;
+					break;
+			}
+			random_value = vshadow_test_image_get_random_value(
+			                &random_state );
+
+			switch( random_value >> 62 )
+			{
+				case 0:
+					read_size = 0x4000 * (size_t) ( 1 + ( random_value % ( VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE / 0x4000 ) ) );
+					break;
+
+				case 1:
+					read_size = 512 * (size_t) ( 1 + ( random_value % ( VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE / 512 ) ) );
+					break;
+
+				default:
+					read_size = (size_t) ( 1 + ( random_value % VSHADOW_TEST_STORE_READ_MAXIMUM_READ_SIZE ) );
+					break;
+			}
+			if( (size64_t) read_size > ( internal_volume->size - read_offset ) )
+			{
+				read_size = (size_t) ( internal_volume->size - read_offset );
+			}
+			read_count = libvshadow_store_descriptor_read_buffer_reference(
+			              store_descriptor,
+			              internal_volume->file_io_handle,
+			              reference_buffer,
+			              read_size,
+			              read_offset,
+			              store_descriptor,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_count = libvshadow_store_descriptor_read_buffer(
+			              store_descriptor,
+			              internal_volume->file_io_handle,
+			              test_buffer,
+			              read_size,
+			              read_offset,
+			              store_descriptor,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( memory_compare(
+			     reference_buffer,
+			     test_buffer,
+			     read_size ) == 0 )
+			{
+				continue;
+			}
+			for( buffer_index = 0;
+			     buffer_index < read_size;
+			     buffer_index++ )
+			{
+				if( reference_buffer[ buffer_index ] != test_buffer[ buffer_index ] )
+				{
+					break;
+				}
+			}
+			fprintf(
+			 stdout,
+			 "Store: %02d read at offset: 0x%08" PRIx64 " of size: %" PRIzd " diverges at offset: 0x%08" PRIx64 " (reference: 0x%02" PRIx8 ", read: 0x%02" PRIx8 ")\n",
+			 store_index,
+			 read_offset,
+			 read_size,
+			 read_offset + buffer_index,
+			 reference_buffer[ buffer_index ],
+			 test_buffer[ buffer_index ] );
+
+			result = vshadow_test_store_read_print_block_state(
+			          store_descriptor,
+			          read_offset + buffer_index,
+			          store_descriptor,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 test_buffer );
+
+	memory_free(
+	 reference_buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( test_buffer != NULL )
+	{
+		memory_free(
+		 test_buffer );
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	return( 0 );
+}
+
+/* Compares the data read from the sectors of the overlay block descriptors
+ * with the data of the overlay blocks
+ * The reads start inside the sectors, at an offset that is not sector aligned
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_overlay_sectors(
+     libvshadow_volume_t *volume )
+{
+	uint8_t reference_buffer[ 512 ];
+	uint8_t test_buffer[ 512 ];
+	uint8_t volume_buffer[ 512 ];
+
+	libcdata_tree_node_t *tree_node                         = NULL;
+	libcerror_error_t *error                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor         = NULL;
+	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
+	libvshadow_internal_volume_t *internal_volume           = NULL;
+	libvshadow_store_descriptor_t *store_descriptor         = NULL;
+	size_t location_size                                    = 0;
+	size_t read_size                                        = 0;
+	ssize_t read_count                                      = 0;
+	off64_t location_offset                                 = 0;
+	off64_t original_offset                                 = 0;
+	off64_t read_offset                                     = 0;
+	off64_t seek_offset                                     = 0;
+	uint32_t overlay_bitmap                                 = 0;
+	uint8_t location_flags                                  = 0;
+	int block_descriptor_index                              = 0;
+	int location_type                                       = 0;
+	int number_of_block_descriptors                         = 0;
+	int number_of_sectors                                   = 0;
+	int number_of_stores                                    = 0;
+	int result                                              = 0;
+	int sector_index                                        = 0;
+	int store_index                                         = 0;
+
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	result = libcdata_array_get_number_of_entries(
+	          internal_volume->store_descriptors_array,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libcdata_array_get_entry_by_index(
+		          internal_volume->store_descriptors_array,
+		          store_index,
+		          (intptr_t **) &store_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store_descriptor",
+		 store_descriptor );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( store_descriptor->has_in_volume_store_data == 0 )
+		{
+			continue;
+		}
+		result = libvshadow_store_descriptor_read_block_descriptors(
+		          store_descriptor,
+		          internal_volume->file_io_handle,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_list_get_number_of_elements(
+		          store_descriptor->block_descriptors_list,
+		          &number_of_block_descriptors,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( block_descriptor_index = 0;
+		     block_descriptor_index < number_of_block_descriptors;
+		     block_descriptor_index++ )
+		{
+			result = libcdata_list_get_value_by_index(
+			          store_descriptor->block_descriptors_list,
+			          block_descriptor_index,
+			          (intptr_t **) &block_descriptor,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "block_descriptor",
+			 block_descriptor );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) == 0 )
+			{
+				continue;
+			}
+			original_offset = block_descriptor->original_offset;
+
+			/* The forward block descriptors tree contains the overlay block descriptor
+			 * the overlays of the same block are combined
+			 */
+			result = libcdata_btree_get_value_by_value(
+			          store_descriptor->forward_block_descriptors_tree,
+			          (intptr_t *) &original_offset,
+			          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
+			          &tree_node,
+			          (intptr_t **) &block_descriptor,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "block_descriptor",
+			 block_descriptor );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+			{
+				overlay_block_descriptor = block_descriptor;
+			}
+			else
+			{
+				overlay_block_descriptor = block_descriptor->overlay;
+			}
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "overlay_block_descriptor",
+			 overlay_block_descriptor );
+
+			for( sector_index = 0;
+			     sector_index < 32;
+			     sector_index++ )
+			{
+				overlay_bitmap = overlay_block_descriptor->bitmap >> sector_index;
+
+				if( ( overlay_bitmap & 0x00000001UL ) == 0 )
+				{
+					continue;
+				}
+				read_offset = overlay_block_descriptor->original_offset + ( sector_index * 512 ) + 100;
+				read_size   = 512 - 100;
+
+				seek_offset = libbfio_handle_seek_offset(
+				               internal_volume->file_io_handle,
+				               overlay_block_descriptor->offset + ( sector_index * 512 ) + 100,
+				               SEEK_SET,
+				               &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT64(
+				 "seek_offset",
+				 (int64_t) seek_offset,
+				 (int64_t) ( overlay_block_descriptor->offset + ( sector_index * 512 ) + 100 ) );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				read_count = libbfio_handle_read_buffer(
+				              internal_volume->file_io_handle,
+				              volume_buffer,
+				              read_size,
+				              &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) read_size );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				read_count = libvshadow_store_descriptor_read_buffer_reference(
+				              store_descriptor,
+				              internal_volume->file_io_handle,
+				              reference_buffer,
+				              read_size,
+				              read_offset,
+				              store_descriptor,
+				              &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) read_size );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          reference_buffer,
+				          volume_buffer,
+				          read_size );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				read_count = libvshadow_store_descriptor_read_buffer(
+				              store_descriptor,
+				              internal_volume->file_io_handle,
+				              test_buffer,
+				              read_size,
+				              read_offset,
+				              store_descriptor,
+				              &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) read_size );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          test_buffer,
+				          volume_buffer,
+				          read_size );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				/* The location ends at the end of the allocated sectors
+				 */
+				result = libvshadow_store_descriptor_get_block_location_at_offset(
+				          store_descriptor,
+				          read_offset,
+				          store_descriptor,
+				          &location_offset,
+				          &location_size,
+				          &location_type,
+				          &location_flags,
+				          &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "location_type",
+				 location_type,
+				 LIBVSHADOW_BLOCK_LOCATION_TYPE_STORE_DATA );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT64(
+				 "location_offset",
+				 (int64_t) location_offset,
+				 (int64_t) ( overlay_block_descriptor->offset + ( sector_index * 512 ) + 100 ) );
+
+				VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+				 "location_flags",
+				 (int) ( location_flags & LIBVSHADOW_BLOCK_LOCATION_FLAG_IS_OVERLAY ),
+				 0 );
+
+				number_of_sectors = 0;
+
+				while( ( sector_index + number_of_sectors ) < 32 )
+				{
+					if( ( overlay_bitmap & 0x00000001UL ) == 0 )
+					{
+						break;
+					}
+					overlay_bitmap >>= 1;
+
+					number_of_sectors++;
+				}
+				VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+				 "location_size",
+				 location_size,
+				 (size_t) ( ( number_of_sectors * 512 ) - 100 ) );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the store read paths on a volume
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_source(
+     const system_character_t *source )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#else
+	result = libvshadow_volume_open(
+	          volume,
+	          source,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the read paths
+	 */
+	result = vshadow_test_store_read_compare(
+	          volume,
+	          1,
+	          VSHADOW_TEST_STORE_READ_NUMBER_OF_READS );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vshadow_test_store_read_overlay_sectors(
+	          volume );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the store read paths on a synthetic volume
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_synthetic(
+     const vshadow_test_image_options_t *options )
+{
+	libcerror_error_t *error = NULL;
+	size64_t volume_size     = 0;
+	int result               = 0;
+
+	result = vshadow_test_image_write(
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_READ_FILENAME ),
+	          options,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_store_read_source(
+	          _SYSTEM_STRING( VSHADOW_TEST_STORE_READ_FILENAME ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	remove(
+	 VSHADOW_TEST_STORE_READ_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	remove(
+	 VSHADOW_TEST_STORE_READ_FILENAME );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ )
+	vshadow_test_image_options_t options;
+#endif
+
+	system_character_t *source = NULL;
+	system_integer_t option    = 0;
+
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( __GNUC__ )
+
+	if( source != NULL )
+	{
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_store_descriptor_read_buffer",
+		 vshadow_test_store_read_source,
+		 source );
+	}
+	if( vshadow_test_image_options_initialize(
+	     &options,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Forwarders that chain through multiple stores
+	 */
+	options.volume_data_size            = 8 * 1024 * 1024;
+	options.number_of_stores            = 5;
+	options.number_of_block_descriptors = 256;
+	options.number_of_store_data_blocks = 32;
+	options.forwarder_percentage        = 50;
+	options.overlay_percentage          = 10;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_descriptor_read_buffer_synthetic_forwarders",
+	 vshadow_test_store_read_synthetic,
+	 &options );
+
+	/* Overlays with partial sector bitmaps
+	 */
+	options.number_of_stores            = 3;
+	options.number_of_block_descriptors = 512;
+	options.forwarder_percentage        = 10;
+	options.overlay_percentage          = 50;
+	options.random_seed                 = 2;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_descriptor_read_buffer_synthetic_overlays",
+	 vshadow_test_store_read_synthetic,
+	 &options );
+
+	/* Without previous bitmaps the current bitmap determines the zero filled blocks
+	 */
+	options.number_of_stores            = 2;
+	options.number_of_block_descriptors = 64;
+	options.forwarder_percentage        = 25;
+	options.overlay_percentage          = 25;
+	options.write_previous_bitmaps      = 0;
+	options.random_seed                 = 3;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_store_descriptor_read_buffer_synthetic_without_previous_bitmaps",
+	 vshadow_test_store_read_synthetic,
+	 &options );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1375 @@
+/*
+ * Library synthetic volume test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_image.h"
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#define VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME	"vshadow_test_synthetic_volume.raw"
+#define VSHADOW_TEST_SYNTHETIC_VOLUME_READ_SIZE	65536
+
+typedef struct vshadow_test_synthetic_volume_io_events vshadow_test_synthetic_volume_io_events_t;
+
+struct vshadow_test_synthetic_volume_io_events
+{
+	/* The number of bytes physically read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of zero filled bytes
+	 */
+	uint64_t number_of_zero_filled_bytes;
+
+	/* The number of metadata blocks read
+	 */
+	uint64_t number_of_metadata_blocks_read;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_cache_misses;
+};
+
+/* Counts the IO events of a synthetic volume
+ */
+void vshadow_test_synthetic_volume_io_callback(
+      int event_type,
+      int store_index VSHADOW_TEST_ATTRIBUTE_UNUSED,
+      off64_t offset VSHADOW_TEST_ATTRIBUTE_UNUSED,
+      size64_t size,
+      uint32_t record_type VSHADOW_TEST_ATTRIBUTE_UNUSED,
+      uint64_t latency VSHADOW_TEST_ATTRIBUTE_UNUSED,
+      intptr_t *user_data )
+{
+	vshadow_test_synthetic_volume_io_events_t *io_events = NULL;
+
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( store_index )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( offset )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( record_type )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( latency )
+
+	io_events = (vshadow_test_synthetic_volume_io_events_t *) user_data;
+
+	switch( event_type )
+	{
+		case LIBVSHADOW_IO_EVENT_TYPE_PHYSICAL_READ:
+			io_events->number_of_bytes_read += (uint64_t) size;
+			break;
+
+		case LIBVSHADOW_IO_EVENT_TYPE_ZERO_FILL:
+			io_events->number_of_zero_filled_bytes += (uint64_t) size;
+			break;
+
+		case LIBVSHADOW_IO_EVENT_TYPE_METADATA_BLOCK_READ:
+			io_events->number_of_metadata_blocks_read += 1;
+			break;
+
+		case LIBVSHADOW_IO_EVENT_TYPE_CACHE_MISS:
+			io_events->number_of_cache_misses += 1;
+			break;
+
+		default:
+			break;
+	}
+}
+
+/* Tests writing, opening and reading a synthetic volume
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_synthetic_volume_read(
+     const vshadow_test_image_options_t *options )
+{
+	uint64_t statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS + 1 ];
+
+	vshadow_test_synthetic_volume_io_events_t io_events;
+
+	libcerror_error_t *error          = NULL;
+	libvshadow_store_t *store         = NULL;
+	libvshadow_volume_t *volume       = NULL;
+	uint8_t *buffer                   = NULL;
+	size64_t store_size               = 0;
+	size64_t volume_size              = 0;
+	size_t read_size                  = 0;
+	ssize_t read_count                = 0;
+	off64_t read_offset               = 0;
+	uint64_t creation_time            = 0;
+	uint64_t previous_creation_time   = 0;
+	int number_of_blocks              = 0;
+	int number_of_stores              = 0;
+	int result                        = 0;
+	int store_index                   = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_image_write(
+	          _SYSTEM_STRING( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ),
+	          options,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * VSHADOW_TEST_SYNTHETIC_VOLUME_READ_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( memory_set(
+	     &io_events,
+	     0,
+	     sizeof( vshadow_test_synthetic_volume_io_events_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libvshadow_volume_set_io_callback(
+	          volume,
+	          &vshadow_test_synthetic_volume_io_callback,
+	          (intptr_t *) &io_events,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvshadow_volume_open_wide(
+	          volume,
+	          _SYSTEM_STRING( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ),
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#else
+	result = libvshadow_volume_open(
+	          volume,
+	          VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the volume
+	 */
+	result = libvshadow_volume_get_size(
+	          volume,
+	          &store_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) store_size,
+	 (uint64_t) volume_size );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_stores",
+	 number_of_stores,
+	 options->number_of_stores );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the stores, reading the volume data area resolves
+	 * the forwarder, overlay and bitmap block descriptors
+	 */
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "store",
+		 store );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_size(
+		          store,
+		          &store_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "store_size",
+		 (uint64_t) store_size,
+		 (uint64_t) volume_size );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_creation_time(
+		          store,
+		          &creation_time,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ( creation_time > previous_creation_time );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		previous_creation_time = creation_time;
+
+		result = libvshadow_store_get_number_of_blocks(
+		          store,
+		          &number_of_blocks,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( options->number_of_block_descriptors > 0 )
+		{
+			VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+			 "number_of_blocks",
+			 number_of_blocks,
+			 0 );
+		}
+		for( read_offset = 0;
+		     read_offset < (off64_t) options->volume_data_size;
+		     read_offset += read_count )
+		{
+			read_size = VSHADOW_TEST_SYNTHETIC_VOLUME_READ_SIZE;
+
+			if( (size64_t) read_size > ( options->volume_data_size - read_offset ) )
+			{
+				read_size = (size_t) ( options->volume_data_size - read_offset );
+			}
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              store,
+			              buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		/* Every requested byte is either read from the volume or zero filled
+		 */
+		result = libvshadow_store_get_statistics(
+		          store,
+		          statistics,
+		          LIBVSHADOW_NUMBER_OF_STATISTICS,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_REQUESTED ]",
+		 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_REQUESTED ],
+		 (uint64_t) options->volume_data_size );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ]",
+		 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ],
+		 (uint64_t) options->volume_data_size - statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_ZERO_FILLED_BYTES ] );
+
+		result = ( statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_READS ] <= statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ] );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = ( statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] > 0 );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test the volume statistics, additional statistics are set to 0
+	 */
+	statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ] = 1;
+
+	result = libvshadow_volume_get_statistics(
+	          volume,
+	          statistics,
+	          LIBVSHADOW_NUMBER_OF_STATISTICS + 1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_REQUESTED ]",
+	 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_REQUESTED ],
+	 (uint64_t) number_of_stores * options->volume_data_size );
+
+	/* The volume header, at least one catalog block and the store headers
+	 */
+	result = ( statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] >= (uint64_t) ( number_of_stores + 2 ) );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ]",
+	 statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ],
+	 (uint64_t) 0 );
+
+	/* Test if the IO events match the volume statistics
+	 */
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "io_events.number_of_bytes_read",
+	 io_events.number_of_bytes_read,
+	 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ] );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "io_events.number_of_zero_filled_bytes",
+	 io_events.number_of_zero_filled_bytes,
+	 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_ZERO_FILLED_BYTES ] );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "io_events.number_of_metadata_blocks_read",
+	 io_events.number_of_metadata_blocks_read,
+	 statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ] );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "io_events.number_of_cache_misses",
+	 io_events.number_of_cache_misses,
+	 (uint64_t) number_of_stores );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 buffer );
+
+	remove(
+	 VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	remove(
+	 VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME );
+
+	return( 0 );
+}
+
+/* Tests the block map of a synthetic volume
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_synthetic_volume_block_map(
+     const vshadow_test_image_options_t *options )
+{
+	uint64_t mapped_sizes[ VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES ];
+
+	libbfio_handle_t *file_io_handle  = NULL;
+	libcerror_error_t *error          = NULL;
+	libvshadow_block_map_t *block_map = NULL;
+	libvshadow_store_t *store         = NULL;
+	libvshadow_volume_t *volume       = NULL;
+	uint8_t *block_data               = NULL;
+	uint8_t *store_data               = NULL;
+	size64_t block_size               = 0;
+	size64_t extent_size              = 0;
+	size64_t mapping_size             = 0;
+	size64_t store_size               = 0;
+	size64_t volume_size              = 0;
+	ssize_t read_count                = 0;
+	uint64_t extent_sizes             = 0;
+	uint32_t extent_flags             = 0;
+	uint32_t mapping_flags            = 0;
+	off64_t block_offset              = 0;
+	off64_t extent_offset             = 0;
+	off64_t mapped_end_offset         = 0;
+	off64_t mapping_offset            = 0;
+	off64_t offset_volume_offset      = 0;
+	off64_t previous_block_end_offset = 0;
+	off64_t seek_offset               = 0;
+	off64_t store_offset              = 0;
+	off64_t volume_offset             = 0;
+	int lookup_block_index            = 0;
+	int mapping_index                 = 0;
+	int mapping_store_index           = 0;
+	int number_of_gaps                = 0;
+	int number_of_mappings            = 0;
+	int number_of_offset_mappings     = 0;
+	int number_of_physical_blocks     = 0;
+	int number_of_stores              = 0;
+	int offset_mapping_index          = 0;
+	int offset_store_index            = 0;
+	int physical_block_index          = 0;
+	int result                        = 0;
+	int store_index                   = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_image_write(
+	          _SYSTEM_STRING( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ),
+	          options,
+	          &volume_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	store_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * VSHADOW_TEST_IMAGE_BLOCK_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_data",
+	 store_data );
+
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          _SYSTEM_STRING( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ),
+	          system_string_length( _SYSTEM_STRING( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ) ) + 1,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME,
+	          system_string_length( VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME ) + 1,
+	          &error );
+#endif
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( number_of_stores <= VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	if( memory_set(
+	     mapped_sizes,
+	     0,
+	     sizeof( uint64_t ) * VSHADOW_TEST_IMAGE_MAXIMUM_NUMBER_OF_STORES ) == NULL )
+	{
+		goto on_error;
+	}
+	/* Test the block map
+	 */
+	result = libvshadow_volume_get_block_map(
+	          volume,
+	          &block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_map",
+	 block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_map_get_number_of_physical_blocks(
+	          block_map,
+	          &number_of_physical_blocks,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_physical_blocks",
+	 number_of_physical_blocks,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every mapping contains the same data as the physical block it maps to
+	 */
+	for( physical_block_index = 0;
+	     physical_block_index < number_of_physical_blocks;
+	     physical_block_index++ )
+	{
+		result = libvshadow_block_map_get_physical_block_by_index(
+		          block_map,
+		          physical_block_index,
+		          &block_offset,
+		          &block_size,
+		          &number_of_mappings,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The physical blocks are sorted and do not overlap
+		 */
+		result = ( block_offset >= previous_block_end_offset )
+		      && ( block_size > 0 )
+		      && ( ( block_offset / VSHADOW_TEST_IMAGE_BLOCK_SIZE ) == ( ( block_offset + (off64_t) block_size - 1 ) / VSHADOW_TEST_IMAGE_BLOCK_SIZE ) );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_mappings",
+		 number_of_mappings,
+		 0 );
+
+		/* The offsets in between the physical blocks are not mapped
+		 */
+		if( block_offset > previous_block_end_offset )
+		{
+			result = libvshadow_block_map_get_physical_block_index_at_offset(
+			          block_map,
+			          block_offset - 1,
+			          &lookup_block_index,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		previous_block_end_offset = block_offset + (off64_t) block_size;
+
+		result = libvshadow_block_map_get_physical_block_index_at_offset(
+		          block_map,
+		          previous_block_end_offset - 1,
+		          &lookup_block_index,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "lookup_block_index",
+		 lookup_block_index,
+		 physical_block_index );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		seek_offset = libbfio_handle_seek_offset(
+		               file_io_handle,
+		               block_offset,
+		               SEEK_SET,
+		               &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "seek_offset",
+		 (int64_t) seek_offset,
+		 (int64_t) block_offset );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              block_data,
+		              (size_t) block_size,
+		              &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) block_size );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		mapped_end_offset = block_offset;
+
+		for( mapping_index = 0;
+		     mapping_index < number_of_mappings;
+		     mapping_index++ )
+		{
+			result = libvshadow_block_map_get_mapping_by_index(
+			          block_map,
+			          physical_block_index,
+			          mapping_index,
+			          &mapping_store_index,
+			          &volume_offset,
+			          &mapping_offset,
+			          &mapping_size,
+			          &mapping_flags,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = ( mapping_store_index >= 0 )
+			      && ( mapping_store_index < number_of_stores )
+			      && ( mapping_offset >= block_offset )
+			      && ( ( mapping_offset + (off64_t) mapping_size ) <= previous_block_end_offset );
+
+			VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			mapped_sizes[ mapping_store_index ] += (uint64_t) mapping_size;
+
+			/* An offset in a gap in between the mappings of the physical block is not mapped
+			 */
+			if( mapping_offset > mapped_end_offset )
+			{
+				result = libvshadow_block_map_get_physical_block_index_at_offset(
+				          block_map,
+				          mapped_end_offset,
+				          &lookup_block_index,
+				          &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = libvshadow_block_map_get_number_of_mappings_at_offset(
+				          block_map,
+				          mapped_end_offset,
+				          &number_of_offset_mappings,
+				          &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "number_of_offset_mappings",
+				 number_of_offset_mappings,
+				 0 );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				number_of_gaps++;
+			}
+			if( ( mapping_offset + (off64_t) mapping_size ) > mapped_end_offset )
+			{
+				mapped_end_offset = mapping_offset + (off64_t) mapping_size;
+			}
+			/* The mapping is one of the (store index, volume offset) pairs of its offsets
+			 */
+			result = libvshadow_block_map_get_number_of_mappings_at_offset(
+			          block_map,
+			          mapping_offset + (off64_t) ( mapping_size / 2 ),
+			          &number_of_offset_mappings,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+			 "number_of_offset_mappings",
+			 number_of_offset_mappings,
+			 0 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = 0;
+
+			for( offset_mapping_index = 0;
+			     offset_mapping_index < number_of_offset_mappings;
+			     offset_mapping_index++ )
+			{
+				result = libvshadow_block_map_get_mapping_at_offset_by_index(
+				          block_map,
+				          mapping_offset + (off64_t) ( mapping_size / 2 ),
+				          offset_mapping_index,
+				          &offset_store_index,
+				          &offset_volume_offset,
+				          &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VSHADOW_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = ( offset_store_index == mapping_store_index )
+				      && ( offset_volume_offset == ( volume_offset + (off64_t) ( mapping_size / 2 ) ) );
+
+				if( result != 0 )
+				{
+					break;
+				}
+			}
+			VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			/* Every mapped offset is found in logarithmic time
+			 */
+			result = libvshadow_block_map_get_physical_block_index_at_offset(
+			          block_map,
+			          mapping_offset + (off64_t) ( mapping_size / 2 ),
+			          &lookup_block_index,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "lookup_block_index",
+			 lookup_block_index,
+			 physical_block_index );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libvshadow_volume_get_store(
+			          volume,
+			          mapping_store_index,
+			          &store,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              store,
+			              store_data,
+			              (size_t) mapping_size,
+			              volume_offset,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) mapping_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          store_data,
+			          &( block_data[ mapping_offset - block_offset ] ),
+			          (size_t) mapping_size );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			result = libvshadow_store_free(
+			          &store,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* The overlay block descriptors leave gaps in between the mappings
+	 */
+	if( options->overlay_percentage > 0 )
+	{
+		VSHADOW_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_gaps",
+		 number_of_gaps,
+		 0 );
+	}
+
+	result = libvshadow_block_map_get_physical_block_index_at_offset(
+	          block_map,
+	          previous_block_end_offset,
+	          &lookup_block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every store extent that is not sparse and not stored in the current volume
+	 * at the same offset is mapped
+	 */
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		result = libvshadow_volume_get_store(
+		          volume,
+		          store_index,
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvshadow_store_get_size(
+		          store,
+		          &store_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		extent_sizes = 0;
+
+		for( store_offset = 0;
+		     store_offset < (off64_t) store_size;
+		     store_offset += (off64_t) extent_size )
+		{
+			result = libvshadow_store_get_extent_at_offset(
+			          store,
+			          store_offset,
+			          &extent_offset,
+			          &extent_size,
+			          &extent_flags,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) == 0 )
+			 && ( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) != 0 )
+			  || ( extent_offset != store_offset ) ) )
+			{
+				extent_sizes += (uint64_t) extent_size;
+			}
+		}
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "mapped_sizes[ store_index ]",
+		 mapped_sizes[ store_index ],
+		 extent_sizes );
+
+		result = libvshadow_store_free(
+		          &store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = libvshadow_block_map_free(
+	          &block_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_map",
+	 block_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 store_data );
+
+	memory_free(
+	 block_data );
+
+	remove(
+	 VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( block_map != NULL )
+	{
+		libvshadow_block_map_free(
+		 &block_map,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( store_data != NULL )
+	{
+		memory_free(
+		 store_data );
+	}
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	remove(
+	 VSHADOW_TEST_SYNTHETIC_VOLUME_FILENAME );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	vshadow_test_image_options_t options;
+
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( vshadow_test_image_options_initialize(
+	     &options,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	/* A small volume with a dense mix of forwarder and overlay block descriptors
+	 */
+	options.volume_data_size            = 4 * 1024 * 1024;
+	options.number_of_stores            = 3;
+	options.number_of_block_descriptors = 1000;
+	options.number_of_store_data_blocks = 16;
+	options.forwarder_percentage        = 25;
+	options.overlay_percentage          = 25;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_volume_synthetic_forwarders_and_overlays",
+	 vshadow_test_synthetic_volume_read,
+	 &options );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_volume_synthetic_block_map",
+	 vshadow_test_synthetic_volume_block_map,
+	 &options );
+
+	/* More stores than fit in a single catalog block
+	 */
+	options.volume_data_size            = 1024 * 1024;
+	options.number_of_stores            = 70;
+	options.number_of_block_descriptors = 16;
+	options.number_of_store_data_blocks = 1;
+	options.write_previous_bitmaps      = 0;
+	options.fill_volume_data            = 0;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_volume_synthetic_multiple_catalog_blocks",
+	 vshadow_test_synthetic_volume_read,
+	 &options );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,600 @@
+/*
+ * Tools block_digest functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../vshadowtools/block_digest.h"
+
+#if defined( HAVE_BLOCK_DIGEST_SHA256_INTRINSICS )
+#include <cpuid.h>
+#endif
+
+typedef struct vshadow_test_tools_block_digest_vector vshadow_test_tools_block_digest_vector_t;
+
+struct vshadow_test_tools_block_digest_vector
+{
+	/* The description
+	 */
+	const char *description;
+
+	/* The data
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The expected SHA-256 digest
+	 */
+	uint8_t sha256[ BLOCK_DIGEST_SHA256_SIZE ];
+
+	/* The expected xxHash64 digest
+	 */
+	uint8_t xxh64[ BLOCK_DIGEST_XXH64_SIZE ];
+};
+
+/* A block of zero bytes of the VSS store block size
+ */
+uint8_t vshadow_test_tools_block_digest_zero_block[ 16384 ];
+
+/* The known answers, the SHA-256 digests of "abc" and of the 56-byte message are
+ * those of FIPS 180-2 appendix B, the xxHash64 digests are those of seed 0
+ */
+vshadow_test_tools_block_digest_vector_t vshadow_test_tools_block_digest_vectors[ 4 ] = {
+	{ "empty",
+	  (const uint8_t *) "",
+	  0,
+	  { 0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+	    0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 },
+	  { 0xef, 0x46, 0xdb, 0x37, 0x51, 0xd8, 0xe9, 0x99 } },
+	{ "abc",
+	  (const uint8_t *) "abc",
+	  3,
+	  { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad },
+	  { 0x44, 0xbc, 0x2c, 0xf5, 0xad, 0x77, 0x09, 0x99 } },
+	{ "56-byte message",
+	  (const uint8_t *) "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+	  56,
+	  { 0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+	    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 },
+	  { 0xf0, 0x61, 0x03, 0x77, 0x3e, 0x85, 0x85, 0xdf } },
+	{ "16 KiB zero block",
+	  vshadow_test_tools_block_digest_zero_block,
+	  16384,
+	  { 0x4f, 0xe7, 0xb5, 0x9a, 0xf6, 0xde, 0x3b, 0x66, 0x5b, 0x67, 0x78, 0x8c, 0xc2, 0xf9, 0x98, 0x92,
+	    0xab, 0x82, 0x7e, 0xfa, 0xe3, 0xa4, 0x67, 0x34, 0x2b, 0x3b, 0xb4, 0xe3, 0xbc, 0x8e, 0x5b, 0xfe },
+	  { 0x59, 0x4e, 0xdc, 0x66, 0x33, 0x2c, 0x45, 0xec } }
+};
+
+/* Determines if the SHA-256 block function of the build can run
+ * The SHA extensions variant requires a processor that supports them
+ * Returns 1 if the block function can run or 0 if not
+ */
+int vshadow_test_tools_block_digest_sha256_is_supported(
+     void )
+{
+#if defined( HAVE_BLOCK_DIGEST_SHA256_INTRINSICS )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* The SHA extensions are indicated by bit 29 of EBX
+	 */
+	if( ( ebx & 0x20000000UL ) == 0 )
+	{
+		return( 0 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Tests the block_digest_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_block_digest_get_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t digest_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = block_digest_get_size(
+	          BLOCK_DIGEST_TYPE_SHA256,
+	          &digest_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "digest_size",
+	 digest_size,
+	 (size_t) BLOCK_DIGEST_SHA256_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = block_digest_get_size(
+	          BLOCK_DIGEST_TYPE_XXH64,
+	          &digest_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "digest_size",
+	 digest_size,
+	 (size_t) BLOCK_DIGEST_XXH64_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = block_digest_get_size(
+	          0,
+	          &digest_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = block_digest_get_size(
+	          BLOCK_DIGEST_TYPE_SHA256,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the block_digest_sha256_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_block_digest_sha256_calculate(
+     void )
+{
+	uint8_t digest[ BLOCK_DIGEST_SHA256_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+	int vector_index         = 0;
+
+	/* Test regular cases
+	 */
+	for( vector_index = 0;
+	     vector_index < 4;
+	     vector_index++ )
+	{
+		result = block_digest_sha256_calculate(
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].data,
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].data_size,
+		          digest,
+		          BLOCK_DIGEST_SHA256_SIZE,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          digest,
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].sha256,
+		          BLOCK_DIGEST_SHA256_SIZE );
+
+		if( result != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in SHA-256 digest of: %s\n",
+			 vshadow_test_tools_block_digest_vectors[ vector_index ].description );
+		}
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = block_digest_sha256_calculate(
+	          NULL,
+	          0,
+	          digest,
+	          BLOCK_DIGEST_SHA256_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = block_digest_sha256_calculate(
+	          vshadow_test_tools_block_digest_zero_block,
+	          16384,
+	          NULL,
+	          BLOCK_DIGEST_SHA256_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = block_digest_sha256_calculate(
+	          vshadow_test_tools_block_digest_zero_block,
+	          16384,
+	          digest,
+	          BLOCK_DIGEST_SHA256_SIZE - 1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the block_digest_xxh64_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_block_digest_xxh64_calculate(
+     void )
+{
+	uint8_t digest[ BLOCK_DIGEST_XXH64_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+	int vector_index         = 0;
+
+	/* Test regular cases
+	 */
+	for( vector_index = 0;
+	     vector_index < 4;
+	     vector_index++ )
+	{
+		result = block_digest_xxh64_calculate(
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].data,
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].data_size,
+		          digest,
+		          BLOCK_DIGEST_XXH64_SIZE,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          digest,
+		          vshadow_test_tools_block_digest_vectors[ vector_index ].xxh64,
+		          BLOCK_DIGEST_XXH64_SIZE );
+
+		if( result != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in xxHash64 digest of: %s\n",
+			 vshadow_test_tools_block_digest_vectors[ vector_index ].description );
+		}
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = block_digest_xxh64_calculate(
+	          NULL,
+	          0,
+	          digest,
+	          BLOCK_DIGEST_XXH64_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = block_digest_xxh64_calculate(
+	          vshadow_test_tools_block_digest_zero_block,
+	          16384,
+	          digest,
+	          BLOCK_DIGEST_XXH64_SIZE - 1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the block_digest_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_block_digest_calculate(
+     int digest_type )
+{
+	uint8_t digest[ BLOCK_DIGEST_MAXIMUM_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	const uint8_t *expected  = NULL;
+	size_t digest_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = block_digest_get_size(
+	          digest_type,
+	          &digest_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = block_digest_calculate(
+	          digest_type,
+	          vshadow_test_tools_block_digest_vectors[ 3 ].data,
+	          vshadow_test_tools_block_digest_vectors[ 3 ].data_size,
+	          digest,
+	          digest_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( digest_type == BLOCK_DIGEST_TYPE_SHA256 )
+	{
+		expected = vshadow_test_tools_block_digest_vectors[ 3 ].sha256;
+	}
+	else
+	{
+		expected = vshadow_test_tools_block_digest_vectors[ 3 ].xxh64;
+	}
+	result = memory_compare(
+	          digest,
+	          expected,
+	          digest_size );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = block_digest_calculate(
+	          0,
+	          vshadow_test_tools_block_digest_vectors[ 3 ].data,
+	          vshadow_test_tools_block_digest_vectors[ 3 ].data_size,
+	          digest,
+	          BLOCK_DIGEST_MAXIMUM_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VSHADOW_TEST_RUN(
+	 "block_digest_get_size",
+	 vshadow_test_tools_block_digest_get_size );
+
+	if( vshadow_test_tools_block_digest_sha256_is_supported() != 0 )
+	{
+		VSHADOW_TEST_RUN(
+		 "block_digest_sha256_calculate",
+		 vshadow_test_tools_block_digest_sha256_calculate );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "block_digest_calculate",
+		 vshadow_test_tools_block_digest_calculate,
+		 BLOCK_DIGEST_TYPE_SHA256 );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "Skipping block_digest_sha256_calculate: the SHA extensions are not supported by the processor\n" );
+	}
+	VSHADOW_TEST_RUN(
+	 "block_digest_xxh64_calculate",
+	 vshadow_test_tools_block_digest_xxh64_calculate );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "block_digest_calculate",
+	 vshadow_test_tools_block_digest_calculate,
+	 BLOCK_DIGEST_TYPE_XXH64 );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1267 @@
+/*
+ * Tools qcow2_writer functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libcfile.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_unused.h"
+
+#include "../vshadowtools/qcow2_writer.h"
+
+#define VSHADOW_TEST_QCOW2_FLAG_COPIED	0x8000000000000000ULL
+#define VSHADOW_TEST_QCOW2_FLAG_ZERO	0x0000000000000001ULL
+
+/* The name of the image written by the tests in the current directory
+ */
+const char *vshadow_test_tools_qcow2_writer_filename = "vshadow_test_tools_qcow2_writer.qcow2";
+
+/* The media of the test layout spans 3 level 1 entries, the second level 1
+ * entry has no level 2 table
+ */
+#define VSHADOW_TEST_QCOW2_MEDIA_SIZE		( (size64_t) 3 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES * QCOW2_WRITER_CLUSTER_SIZE )
+
+#define VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS	9
+
+/* Tests the qcow2_writer_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_qcow2_writer_initialize(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	qcow2_writer_t *qcow2_writer = NULL;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = qcow2_writer_initialize(
+	          &qcow2_writer,
+	          VSHADOW_TEST_QCOW2_MEDIA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "qcow2_writer",
+	 qcow2_writer );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->number_of_l1_entries",
+	 qcow2_writer->number_of_l1_entries,
+	 (uint64_t) 3 );
+
+	result = qcow2_writer_free(
+	          &qcow2_writer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "qcow2_writer",
+	 qcow2_writer );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = qcow2_writer_initialize(
+	          NULL,
+	          VSHADOW_TEST_QCOW2_MEDIA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_initialize(
+	          &qcow2_writer,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "qcow2_writer",
+	 qcow2_writer );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( qcow2_writer != NULL )
+	{
+		qcow2_writer_free(
+		 &qcow2_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the qcow2_writer_set_cluster_type function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_qcow2_writer_set_cluster_type(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	qcow2_writer_t *qcow2_writer = NULL;
+	int result                   = 0;
+
+	result = qcow2_writer_initialize(
+	          &qcow2_writer,
+	          VSHADOW_TEST_QCOW2_MEDIA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "qcow2_writer",
+	 qcow2_writer );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          0,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Changing the type of a cluster replaces the previous type
+	 */
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          0,
+	          QCOW2_WRITER_CLUSTER_TYPE_ZERO,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->number_of_data_clusters",
+	 qcow2_writer->number_of_data_clusters,
+	 (uint64_t) 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->number_of_zero_clusters",
+	 qcow2_writer->number_of_zero_clusters,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->number_of_l2_tables",
+	 qcow2_writer->number_of_l2_tables,
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = qcow2_writer_set_cluster_type(
+	          NULL,
+	          0,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          0,
+	          QCOW2_WRITER_CLUSTER_TYPE_UNALLOCATED,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          3 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The cluster types cannot be changed after allocation
+	 */
+	result = qcow2_writer_allocate(
+	          qcow2_writer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          1,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = qcow2_writer_free(
+	          &qcow2_writer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( qcow2_writer != NULL )
+	{
+		qcow2_writer_free(
+		 &qcow2_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the qcow2_writer_write_metadata function
+ * The layout consists of data clusters 0, 5 and 16387 and zero clusters 1 and 16388
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_tools_qcow2_writer_write_metadata(
+     void )
+{
+	uint8_t cluster_references[ VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS ];
+
+	libcerror_error_t *error     = NULL;
+	libcfile_file_t *file        = NULL;
+	qcow2_writer_t *qcow2_writer = NULL;
+	uint8_t *cluster_data        = NULL;
+	uint8_t *image_data          = NULL;
+	uint8_t *l1_table            = NULL;
+	uint8_t *l2_table            = NULL;
+	uint8_t *refcount_block      = NULL;
+	uint64_t cluster_index       = 0;
+	uint64_t l1_index            = 0;
+	uint64_t l2_index            = 0;
+	uint64_t value_64bit         = 0;
+	uint32_t value_32bit         = 0;
+	uint16_t value_16bit         = 0;
+	off64_t cluster_offset       = 0;
+	off64_t l2_table_offset      = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	result = qcow2_writer_initialize(
+	          &qcow2_writer,
+	          VSHADOW_TEST_QCOW2_MEDIA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "qcow2_writer",
+	 qcow2_writer );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          0,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          1,
+	          QCOW2_WRITER_CLUSTER_TYPE_ZERO,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          5,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          ( 2 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + 3,
+	          QCOW2_WRITER_CLUSTER_TYPE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = qcow2_writer_set_cluster_type(
+	          qcow2_writer,
+	          ( 2 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + 4,
+	          QCOW2_WRITER_CLUSTER_TYPE_ZERO,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case of writing the metadata before allocation
+	 */
+	result = qcow2_writer_write_metadata(
+	          qcow2_writer,
+	          NULL,
+	          "image.raw",
+	          9,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_allocate(
+	          qcow2_writer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The image consists of the header, the level 1 table, the refcount table,
+	 * 1 refcount block, 2 level 2 tables and 3 data clusters
+	 */
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->file_size",
+	 qcow2_writer->file_size,
+	 (uint64_t) VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS * QCOW2_WRITER_CLUSTER_SIZE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "qcow2_writer->number_of_refcount_blocks",
+	 qcow2_writer->number_of_refcount_blocks,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "qcow2_writer->data_offset",
+	 (int64_t) qcow2_writer->data_offset,
+	 (int64_t) 6 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	/* Test the data cluster offsets
+	 */
+	result = qcow2_writer_get_cluster_offset(
+	          qcow2_writer,
+	          0,
+	          &cluster_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "cluster_offset",
+	 (int64_t) cluster_offset,
+	 (int64_t) 6 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	result = qcow2_writer_get_cluster_offset(
+	          qcow2_writer,
+	          5,
+	          &cluster_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "cluster_offset",
+	 (int64_t) cluster_offset,
+	 (int64_t) 7 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	result = qcow2_writer_get_cluster_offset(
+	          qcow2_writer,
+	          ( 2 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + 3,
+	          &cluster_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "cluster_offset",
+	 (int64_t) cluster_offset,
+	 (int64_t) 8 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	/* Zero clusters and clusters without a level 2 table have no offset
+	 */
+	result = qcow2_writer_get_cluster_offset(
+	          qcow2_writer,
+	          1,
+	          &cluster_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = qcow2_writer_get_cluster_offset(
+	          qcow2_writer,
+	          QCOW2_WRITER_NUMBER_OF_L2_ENTRIES,
+	          &cluster_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Write the image
+	 */
+	result = libcfile_file_initialize(
+	          &file,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcfile_file_open(
+	          file,
+	          vshadow_test_tools_qcow2_writer_filename,
+	          LIBCFILE_OPEN_READ_WRITE_TRUNCATE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = qcow2_writer_write_metadata(
+	          qcow2_writer,
+	          file,
+	          "image.raw",
+	          9,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cluster_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * QCOW2_WRITER_CLUSTER_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "cluster_data",
+	 cluster_data );
+
+	if( memory_set(
+	     cluster_data,
+	     0x5a,
+	     QCOW2_WRITER_CLUSTER_SIZE ) == NULL )
+	{
+		goto on_error;
+	}
+	result = qcow2_writer_write_cluster(
+	          qcow2_writer,
+	          file,
+	          7 * QCOW2_WRITER_CLUSTER_SIZE,
+	          cluster_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the image back
+	 */
+	image_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS * QCOW2_WRITER_CLUSTER_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "image_data",
+	 image_data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) libcfile_file_seek_offset(
+	            file,
+	            0,
+	            SEEK_SET,
+	            &error ),
+	 (int64_t) 0 );
+
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              image_data,
+	              VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS * QCOW2_WRITER_CLUSTER_SIZE,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS * QCOW2_WRITER_CLUSTER_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file must end at the last data cluster
+	 */
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              cluster_data,
+	              1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the header
+	 */
+	result = memory_compare(
+	          image_data,
+	          "QFI\xfb",
+	          4 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "signature",
+	 result,
+	 0 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 4 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "format_version",
+	 value_32bit,
+	 (uint32_t) 3 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 8 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "backing_filename_offset",
+	 value_64bit,
+	 (uint64_t) 128 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 16 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "backing_filename_size",
+	 value_32bit,
+	 (uint32_t) 9 );
+
+	result = memory_compare(
+	          &( image_data[ 128 ] ),
+	          "image.raw",
+	          9 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "backing_filename",
+	 result,
+	 0 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 20 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_cluster_block_bits",
+	 value_32bit,
+	 (uint32_t) QCOW2_WRITER_CLUSTER_BITS );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 24 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 value_64bit,
+	 (uint64_t) VSHADOW_TEST_QCOW2_MEDIA_SIZE );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 32 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "encryption_method",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 36 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_level1_table_references",
+	 value_32bit,
+	 (uint32_t) 3 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 40 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "level1_table_offset",
+	 value_64bit,
+	 (uint64_t) QCOW2_WRITER_CLUSTER_SIZE );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 48 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "reference_count_table_offset",
+	 value_64bit,
+	 (uint64_t) 2 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 56 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_count_table_clusters",
+	 value_32bit,
+	 (uint32_t) 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 60 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_snapshots",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 72 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "incompatible_feature_flags",
+	 value_64bit,
+	 (uint64_t) 0 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 96 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_count_order",
+	 value_32bit,
+	 (uint32_t) QCOW2_WRITER_REFCOUNT_ORDER );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 100 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "header_size",
+	 value_32bit,
+	 (uint32_t) 104 );
+
+	/* Test the backing format header extension and the end marker
+	 */
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 104 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "extension_type",
+	 value_32bit,
+	 (uint32_t) 0xe2792acaUL );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( image_data[ 108 ] ),
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "extension_data_size",
+	 value_32bit,
+	 (uint32_t) 3 );
+
+	result = memory_compare(
+	          &( image_data[ 112 ] ),
+	          "raw\0\0\0\0\0",
+	          8 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "extension_data",
+	 result,
+	 0 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 120 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "end_of_extensions",
+	 value_64bit,
+	 (uint64_t) 0 );
+
+	/* Keep track of the number of references of every cluster in the image
+	 */
+	if( memory_set(
+	     cluster_references,
+	     0,
+	     sizeof( uint8_t ) * VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS ) == NULL )
+	{
+		goto on_error;
+	}
+	/* The header, the level 1 table, the refcount table and refcount block clusters
+	 */
+	cluster_references[ 0 ] += 1;
+	cluster_references[ 1 ] += 1;
+	cluster_references[ 2 ] += 1;
+
+	/* Test the refcount table
+	 */
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ 2 * QCOW2_WRITER_CLUSTER_SIZE ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "reference_count_table[ 0 ]",
+	 value_64bit,
+	 (uint64_t) 3 * QCOW2_WRITER_CLUSTER_SIZE );
+
+	cluster_references[ value_64bit / QCOW2_WRITER_CLUSTER_SIZE ] += 1;
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( image_data[ ( 2 * QCOW2_WRITER_CLUSTER_SIZE ) + 8 ] ),
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "reference_count_table[ 1 ]",
+	 value_64bit,
+	 (uint64_t) 0 );
+
+	/* Test the level 1 and level 2 tables, the level 2 tables are stored
+	 * in the order of the level 1 entries and are referenced once
+	 */
+	l1_table        = &( image_data[ QCOW2_WRITER_CLUSTER_SIZE ] );
+	l2_table_offset = 4 * QCOW2_WRITER_CLUSTER_SIZE;
+
+	for( l1_index = 0;
+	     l1_index < QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+	     l1_index++ )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 &( l1_table[ l1_index * 8 ] ),
+		 value_64bit );
+
+		if( ( l1_index == 1 )
+		 || ( l1_index > 2 ) )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+			 "level1_table[ l1_index ]",
+			 value_64bit,
+			 (uint64_t) 0 );
+
+			continue;
+		}
+		VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+		 "level1_table[ l1_index ]",
+		 value_64bit,
+		 (uint64_t) ( l2_table_offset | VSHADOW_TEST_QCOW2_FLAG_COPIED ) );
+
+		cluster_references[ l2_table_offset / QCOW2_WRITER_CLUSTER_SIZE ] += 1;
+
+		l2_table = &( image_data[ l2_table_offset ] );
+
+		for( l2_index = 0;
+		     l2_index < QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+		     l2_index++ )
+		{
+			cluster_index = ( l1_index * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + l2_index;
+
+			byte_stream_copy_to_uint64_big_endian(
+			 &( l2_table[ l2_index * 8 ] ),
+			 value_64bit );
+
+			if( ( cluster_index == 0 )
+			 || ( cluster_index == 5 )
+			 || ( cluster_index == ( 2 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + 3 ) )
+			{
+				result = qcow2_writer_get_cluster_offset(
+				          qcow2_writer,
+				          cluster_index,
+				          &cluster_offset,
+				          &error );
+
+				VSHADOW_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+				 "level2_table[ l2_index ]",
+				 value_64bit,
+				 (uint64_t) ( cluster_offset | VSHADOW_TEST_QCOW2_FLAG_COPIED ) );
+
+				cluster_references[ cluster_offset / QCOW2_WRITER_CLUSTER_SIZE ] += 1;
+			}
+			else if( ( cluster_index == 1 )
+			      || ( cluster_index == ( 2 * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) + 4 ) )
+			{
+				VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+				 "level2_table[ l2_index ]",
+				 value_64bit,
+				 (uint64_t) VSHADOW_TEST_QCOW2_FLAG_ZERO );
+			}
+			else
+			{
+				VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+				 "level2_table[ l2_index ]",
+				 value_64bit,
+				 (uint64_t) 0 );
+			}
+		}
+		l2_table_offset += QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	/* Test that every cluster of the image is referenced once and has a refcount of 1
+	 * and that the refcount entries after the end of the image are 0
+	 */
+	refcount_block = &( image_data[ 3 * QCOW2_WRITER_CLUSTER_SIZE ] );
+
+	for( cluster_index = 0;
+	     cluster_index < QCOW2_WRITER_NUMBER_OF_REFCOUNT_ENTRIES;
+	     cluster_index++ )
+	{
+		byte_stream_copy_to_uint16_big_endian(
+		 &( refcount_block[ cluster_index * 2 ] ),
+		 value_16bit );
+
+		if( cluster_index < VSHADOW_TEST_QCOW2_NUMBER_OF_CLUSTERS )
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+			 "cluster_references[ cluster_index ]",
+			 cluster_references[ cluster_index ],
+			 (uint8_t) 1 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_UINT16(
+			 "reference_count",
+			 value_16bit,
+			 (uint16_t) 1 );
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_UINT16(
+			 "reference_count",
+			 value_16bit,
+			 (uint16_t) 0 );
+		}
+	}
+	/* Test the data cluster written by qcow2_writer_write_cluster
+	 */
+	result = memory_compare(
+	          &( image_data[ 7 * QCOW2_WRITER_CLUSTER_SIZE ] ),
+	          cluster_data,
+	          QCOW2_WRITER_CLUSTER_SIZE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "cluster_data",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = qcow2_writer_write_metadata(
+	          NULL,
+	          file,
+	          "image.raw",
+	          9,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_write_metadata(
+	          qcow2_writer,
+	          file,
+	          NULL,
+	          9,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = qcow2_writer_write_metadata(
+	          qcow2_writer,
+	          file,
+	          "image.raw",
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 image_data );
+
+	image_data = NULL;
+
+	memory_free(
+	 cluster_data );
+
+	cluster_data = NULL;
+
+	result = libcfile_file_close(
+	          file,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcfile_file_free(
+	          &file,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcfile_file_remove(
+	          vshadow_test_tools_qcow2_writer_filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = qcow2_writer_free(
+	          &qcow2_writer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( image_data != NULL )
+	{
+		memory_free(
+		 image_data );
+	}
+	if( cluster_data != NULL )
+	{
+		memory_free(
+		 cluster_data );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_close(
+		 file,
+		 NULL );
+		libcfile_file_free(
+		 &file,
+		 NULL );
+		libcfile_file_remove(
+		 vshadow_test_tools_qcow2_writer_filename,
+		 NULL );
+	}
+	if( qcow2_writer != NULL )
+	{
+		qcow2_writer_free(
+		 &qcow2_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VSHADOW_TEST_RUN(
+	 "qcow2_writer_initialize",
+	 vshadow_test_tools_qcow2_writer_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "qcow2_writer_set_cluster_type",
+	 vshadow_test_tools_qcow2_writer_set_cluster_type );
+
+	VSHADOW_TEST_RUN(
+	 "qcow2_writer_write_metadata",
+	 vshadow_test_tools_qcow2_writer_write_metadata );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
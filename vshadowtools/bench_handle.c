@@ -0,0 +1,2049 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "bench_handle.h"
+#include "byte_size_string.h"
+#include "read_statistics.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+extern \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define BENCH_HANDLE_NOTIFY_STREAM		stdout
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a benchmark handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark handle.",
+		 function );
+
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *bench_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *bench_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->block_size             = BENCH_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *bench_handle )->number_of_threads      = 1;
+	( *bench_handle )->access_patterns        = BENCH_HANDLE_ACCESS_PATTERN_ALL;
+	( *bench_handle )->number_of_random_reads = BENCH_HANDLE_DEFAULT_NUMBER_OF_RANDOM_READS;
+	( *bench_handle )->random_seed            = 1;
+	( *bench_handle )->output_format          = BENCH_HANDLE_OUTPUT_FORMAT_TEXT;
+	( *bench_handle )->notify_stream          = BENCH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *bench_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( libvshadow_volume_free(
+		     &( ( *bench_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *bench_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( bench_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     bench_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_volume_offset(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the read block size
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) BENCH_HANDLE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->block_size = (size_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multiple threads not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bench_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the access patterns
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_access_patterns(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_access_patterns";
+	size_t string_length  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_ALL;
+	}
+	else if( ( string_length == 6 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "random" ),
+	            6 ) == 0 ) )
+	{
+		bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_RANDOM;
+	}
+	else if( ( string_length == 10 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "sequential" ),
+	            10 ) == 0 ) )
+	{
+		bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of random reads per store
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_number_of_random_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_random_reads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of random reads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->number_of_random_reads = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of bytes read sequentially per store
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_maximum_sequential_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_maximum_sequential_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine maximum sequential size.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->maximum_sequential_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the seed of the pseudo random number generator
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_random_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_random_seed";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->random_seed = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_output_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_output_format";
+	size_t string_length  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "json" ),
+	       4 ) == 0 ) )
+	{
+		bench_handle->output_format = BENCH_HANDLE_OUTPUT_FORMAT_JSON;
+	}
+	else if( ( string_length == 4 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "text" ),
+	            4 ) == 0 ) )
+	{
+		bench_handle->output_format = BENCH_HANDLE_OUTPUT_FORMAT_TEXT;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported output format.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the benchmark handle
+ * The time it takes to open the volume is stored as the volume open time
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "bench_handle_open_input";
+	size_t filename_length = 0;
+	uint64_t end_time      = 0;
+	uint64_t start_time    = 0;
+	int result             = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     bench_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     bench_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     bench_handle->input_file_io_handle,
+	     bench_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          bench_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( read_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_open_file_io_handle(
+		     bench_handle->input_volume,
+		     bench_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_get_number_of_stores(
+		     bench_handle->input_volume,
+		     &( bench_handle->number_of_stores ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of stores.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_statistics_get_current_time(
+		     &end_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end time.",
+			 function );
+
+			return( -1 );
+		}
+		bench_handle->volume_open_time = end_time - start_time;
+	}
+	return( result );
+}
+
+/* Closes the benchmark handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int bench_handle_close_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_close_input";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     bench_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->number_of_stores = 0;
+
+	return( 0 );
+}
+
+/* Retrieves the next value of the pseudo random number generator of the worker
+ * This uses xorshift64* which is sufficient to spread reads over a store
+ * Returns the pseudo random value
+ */
+uint64_t bench_worker_get_random_value(
+          bench_worker_t *bench_worker )
+{
+	uint64_t random_state = bench_worker->random_state;
+
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+
+	bench_worker->random_state = random_state;
+
+	return( random_state * (uint64_t) 0x2545f4914f6cdd1dULL );
+}
+
+/* Runs a benchmark worker
+ * The sequential reads of the workers are interleaved per block, the random reads
+ * are divided between the workers. A failed read is counted and does not stop the worker
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_run(
+     bench_worker_t *bench_worker )
+{
+	libcerror_error_t *error        = NULL;
+	bench_handle_t *bench_handle    = NULL;
+	static char *function           = "bench_worker_run";
+	size64_t maximum_size           = 0;
+	size64_t number_of_blocks       = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	uint64_t block_index            = 0;
+	uint64_t number_of_reads        = 0;
+	uint64_t read_end_time          = 0;
+	uint64_t read_index             = 0;
+	uint64_t read_start_time        = 0;
+	off64_t read_offset             = 0;
+
+	if( bench_worker == NULL )
+	{
+		return( -1 );
+	}
+	bench_handle = bench_worker->bench_handle;
+
+	bench_worker->result = 1;
+
+	maximum_size = bench_worker->store_size;
+
+	if( bench_worker->access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+	{
+		if( ( bench_handle->maximum_sequential_size != 0 )
+		 && ( bench_handle->maximum_sequential_size < maximum_size ) )
+		{
+			maximum_size = bench_handle->maximum_sequential_size;
+		}
+		number_of_blocks = maximum_size / bench_handle->block_size;
+
+		if( ( maximum_size % bench_handle->block_size ) != 0 )
+		{
+			number_of_blocks++;
+		}
+		block_index = (uint64_t) bench_worker->worker_index;
+	}
+	else
+	{
+		number_of_blocks = maximum_size / bench_handle->block_size;
+
+		if( ( maximum_size % bench_handle->block_size ) != 0 )
+		{
+			number_of_blocks++;
+		}
+		if( number_of_blocks > 0 )
+		{
+			number_of_reads = bench_handle->number_of_random_reads / bench_handle->number_of_threads;
+
+			if( (uint64_t) bench_worker->worker_index < ( bench_handle->number_of_random_reads % bench_handle->number_of_threads ) )
+			{
+				number_of_reads++;
+			}
+		}
+	}
+	while( bench_handle->abort == 0 )
+	{
+		if( bench_worker->access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+		{
+			if( block_index >= number_of_blocks )
+			{
+				break;
+			}
+			read_offset = (off64_t) ( block_index * bench_handle->block_size );
+
+			block_index += (uint64_t) bench_handle->number_of_threads;
+		}
+		else
+		{
+			if( read_index >= number_of_reads )
+			{
+				break;
+			}
+			read_offset = (off64_t) ( ( bench_worker_get_random_value(
+			                             bench_worker ) % number_of_blocks ) * bench_handle->block_size );
+
+			read_index++;
+		}
+		read_size = bench_handle->block_size;
+
+		if( read_size > ( maximum_size - (size64_t) read_offset ) )
+		{
+			read_size = (size_t) ( maximum_size - (size64_t) read_offset );
+		}
+		if( read_statistics_get_current_time(
+		     &read_start_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read start time.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              bench_worker->store,
+		              bench_worker->file_io_handle,
+		              bench_worker->buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_statistics_get_current_time(
+		     &read_end_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read end time.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count != (ssize_t) read_size )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read %" PRIzd " bytes at offset: %" PRIi64 ".\n",
+				 function,
+				 read_size,
+				 read_offset );
+
+				if( error != NULL )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+			}
+			libcerror_error_free(
+			 &error );
+		}
+		if( read_statistics_update(
+		     &( bench_worker->read_statistics ),
+		     read_size,
+		     (uint8_t) ( read_count != (ssize_t) read_size ),
+		     0,
+		     read_end_time - read_start_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update read statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	bench_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Runs an access pattern on a store
+ * Every worker reads using its own file IO handle, so the reads of the workers
+ * do not share a file offset and can run concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_access_pattern(
+     bench_handle_t *bench_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     uint8_t access_pattern,
+     read_statistics_t *read_statistics,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	bench_worker_t *bench_worker  = NULL;
+	bench_worker_t *bench_workers = NULL;
+	static char *function         = "bench_handle_run_access_pattern";
+	size64_t store_size           = 0;
+	uint64_t end_time             = 0;
+	uint64_t start_time           = 0;
+	int result                    = 1;
+	int worker_index              = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->number_of_threads <= 0 )
+	 || ( bench_handle->number_of_threads > BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store size.",
+		 function );
+
+		return( -1 );
+	}
+	bench_workers = (bench_worker_t *) memory_allocate(
+	                                    sizeof( bench_worker_t ) * bench_handle->number_of_threads );
+
+	if( bench_workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     bench_workers,
+	     0,
+	     sizeof( bench_worker_t ) * bench_handle->number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		goto on_error;
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		bench_worker = &( bench_workers[ worker_index ] );
+
+		bench_worker->bench_handle   = bench_handle;
+		bench_worker->store          = store;
+		bench_worker->store_size     = store_size;
+		bench_worker->access_pattern = access_pattern;
+		bench_worker->worker_index   = worker_index;
+
+		/* Give every store and worker its own reproducible sequence, xorshift64* requires a non-zero state
+		 */
+		bench_worker->random_state = bench_handle->random_seed
+		                           ^ ( (uint64_t) ( store_index + 1 ) * (uint64_t) 0x9e3779b97f4a7c15ULL )
+		                           ^ ( (uint64_t) ( worker_index + 1 ) * (uint64_t) 0xbf58476d1ce4e5b9ULL );
+
+		if( bench_worker->random_state == 0 )
+		{
+			bench_worker->random_state = 1;
+		}
+		if( libbfio_handle_clone(
+		     &( bench_worker->file_io_handle ),
+		     bench_handle->input_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     bench_worker->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		bench_worker->buffer = (uint8_t *) memory_allocate(
+		                                    sizeof( uint8_t ) * bench_handle->block_size );
+
+		if( bench_worker->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	if( read_statistics_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( bench_workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &bench_worker_run,
+		     (void *) &( bench_workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( bench_workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#else
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		bench_worker_run(
+		 &( bench_workers[ worker_index ] ) );
+	}
+#endif
+	if( read_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		goto on_error;
+	}
+	*elapsed_time = end_time - start_time;
+
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		bench_worker = &( bench_workers[ worker_index ] );
+
+		if( bench_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+		else if( read_statistics_merge(
+		          read_statistics,
+		          &( bench_worker->read_statistics ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to merge read statistics of worker: %d.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+		libbfio_handle_free(
+		 &( bench_worker->file_io_handle ),
+		 NULL );
+
+		memory_free(
+		 bench_worker->buffer );
+	}
+	memory_free(
+	 bench_workers );
+
+	return( result );
+
+on_error:
+	if( bench_workers != NULL )
+	{
+		/* Make sure the workers that were started stop before their resources are freed
+		 */
+		bench_handle->abort = 1;
+
+		for( worker_index = 0;
+		     worker_index < bench_handle->number_of_threads;
+		     worker_index++ )
+		{
+			bench_worker = &( bench_workers[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( bench_worker->thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( bench_worker->thread ),
+				 NULL );
+			}
+#endif
+			if( bench_worker->file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &( bench_worker->file_io_handle ),
+				 NULL );
+			}
+			if( bench_worker->buffer != NULL )
+			{
+				memory_free(
+				 bench_worker->buffer );
+			}
+		}
+		memory_free(
+		 bench_workers );
+	}
+	return( -1 );
+}
+
+/* Prints the read statistics of an access pattern
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_read_statistics_fprint(
+     bench_handle_t *bench_handle,
+     const char *access_pattern_name,
+     const read_statistics_t *read_statistics,
+     uint64_t elapsed_time,
+     int is_last,
+     libcerror_error_t **error )
+{
+	static char *function      = "bench_handle_read_statistics_fprint";
+	uint64_t average_latency   = 0;
+	uint64_t bytes_per_second  = 0;
+	uint64_t latency_p50       = 0;
+	uint64_t latency_p90       = 0;
+	uint64_t latency_p99       = 0;
+	uint64_t reads_per_second  = 0;
+	int bucket_index           = 0;
+	int is_first_bucket        = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( access_pattern_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access pattern name.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics->number_of_requests > 0 )
+	{
+		average_latency = read_statistics->read_time / read_statistics->number_of_requests;
+
+		if( ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       50,
+		       &latency_p50,
+		       error ) != 1 )
+		 || ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       90,
+		       &latency_p90,
+		       error ) != 1 )
+		 || ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       99,
+		       &latency_p99,
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve latency percentiles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( elapsed_time > 0 )
+	{
+		/* Divide first to prevent the multiplication from overflowing on large stores
+		 */
+		bytes_per_second = ( read_statistics->number_of_bytes / elapsed_time ) * 1000000
+		                 + ( ( read_statistics->number_of_bytes % elapsed_time ) * 1000000 ) / elapsed_time;
+		reads_per_second = ( read_statistics->number_of_requests * 1000000 ) / elapsed_time;
+	}
+	if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "        {\n"
+		 "          \"access_pattern\": \"%s\",\n"
+		 "          \"number_of_reads\": %" PRIu64 ",\n"
+		 "          \"number_of_bytes\": %" PRIu64 ",\n"
+		 "          \"number_of_errors\": %" PRIu64 ",\n"
+		 "          \"elapsed_time_us\": %" PRIu64 ",\n"
+		 "          \"bytes_per_second\": %" PRIu64 ",\n"
+		 "          \"reads_per_second\": %" PRIu64 ",\n"
+		 "          \"average_latency_us\": %" PRIu64 ",\n"
+		 "          \"latency_p50_us\": %" PRIu64 ",\n"
+		 "          \"latency_p90_us\": %" PRIu64 ",\n"
+		 "          \"latency_p99_us\": %" PRIu64 ",\n"
+		 "          \"latency_histogram\": [",
+		 access_pattern_name,
+		 read_statistics->number_of_requests,
+		 read_statistics->number_of_bytes,
+		 read_statistics->number_of_errors,
+		 elapsed_time,
+		 bytes_per_second,
+		 reads_per_second,
+		 average_latency,
+		 latency_p50,
+		 latency_p90,
+		 latency_p99 );
+	}
+	else
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tReads (%s):\n"
+		 "\t\tNumber of reads\t\t: %" PRIu64 "\n"
+		 "\t\tNumber of bytes\t\t: %" PRIu64 "\n"
+		 "\t\tNumber of errors\t: %" PRIu64 "\n"
+		 "\t\tElapsed time\t\t: %" PRIu64 " us\n"
+		 "\t\tThroughput\t\t: %" PRIu64 ".%02" PRIu64 " MiB/s\n"
+		 "\t\tReads per second\t: %" PRIu64 "\n"
+		 "\t\tAverage latency\t\t: %" PRIu64 " us\n"
+		 "\t\tLatency p50\t\t: < %" PRIu64 " us\n"
+		 "\t\tLatency p90\t\t: < %" PRIu64 " us\n"
+		 "\t\tLatency p99\t\t: < %" PRIu64 " us\n"
+		 "\t\tLatency histogram:\n",
+		 access_pattern_name,
+		 read_statistics->number_of_requests,
+		 read_statistics->number_of_bytes,
+		 read_statistics->number_of_errors,
+		 elapsed_time,
+		 bytes_per_second / ( 1024 * 1024 ),
+		 ( ( bytes_per_second % ( 1024 * 1024 ) ) * 100 ) / ( 1024 * 1024 ),
+		 reads_per_second,
+		 average_latency,
+		 latency_p50,
+		 latency_p90,
+		 latency_p99 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS;
+	     bucket_index++ )
+	{
+		if( read_statistics->latency_histogram[ bucket_index ] == 0 )
+		{
+			continue;
+		}
+		if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			fprintf(
+			 bench_handle->notify_stream,
+			 "%s\n"
+			 "            { \"upper_bound_us\": %" PRIu64 ", \"number_of_reads\": %" PRIu64 " }",
+			 ( is_first_bucket != 0 ) ? "" : ",",
+			 (uint64_t) 1 << bucket_index,
+			 read_statistics->latency_histogram[ bucket_index ] );
+		}
+		else
+		{
+			fprintf(
+			 bench_handle->notify_stream,
+			 "\t\t\t< %" PRIu64 " us\t\t: %" PRIu64 "\n",
+			 (uint64_t) 1 << bucket_index,
+			 read_statistics->latency_histogram[ bucket_index ] );
+		}
+		is_first_bucket = 0;
+	}
+	if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "%s]\n"
+		 "        }%s\n",
+		 ( is_first_bucket != 0 ) ? "" : "\n          ",
+		 ( is_last != 0 ) ? "" : "," );
+	}
+	else
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
+/* Runs the benchmark on all the stores
+ * The metadata load time of a store is the time it takes to retrieve the store and
+ * its block descriptors, the first access to a store reads them
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	read_statistics_t read_statistics;
+
+	libvshadow_store_t *store = NULL;
+	static char *function     = "bench_handle_run";
+	size64_t store_size       = 0;
+	uint64_t elapsed_time     = 0;
+	uint64_t end_time         = 0;
+	uint64_t start_time       = 0;
+	uint8_t access_pattern    = 0;
+	int number_of_blocks      = 0;
+	int store_index           = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "{\n"
+		 "  \"volume_open_time_us\": %" PRIu64 ",\n"
+		 "  \"number_of_stores\": %d,\n"
+		 "  \"block_size\": %" PRIzd ",\n"
+		 "  \"number_of_threads\": %d,\n"
+		 "  \"random_seed\": %" PRIu64 ",\n"
+		 "  \"stores\": [",
+		 bench_handle->volume_open_time,
+		 bench_handle->number_of_stores,
+		 bench_handle->block_size,
+		 bench_handle->number_of_threads,
+		 bench_handle->random_seed );
+	}
+	else
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "Volume Shadow Snapshot benchmark:\n"
+		 "\tVolume open time\t: %" PRIu64 " us\n"
+		 "\tNumber of stores\t: %d\n"
+		 "\tBlock size\t\t: %" PRIzd " bytes\n"
+		 "\tNumber of threads\t: %d\n"
+		 "\tRandom seed\t\t: %" PRIu64 "\n"
+		 "\n",
+		 bench_handle->volume_open_time,
+		 bench_handle->number_of_stores,
+		 bench_handle->block_size,
+		 bench_handle->number_of_threads,
+		 bench_handle->random_seed );
+	}
+	for( store_index = 0;
+	     store_index < bench_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		if( read_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_volume_get_store(
+		     bench_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_get_number_of_blocks(
+		     store,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of blocks of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( read_statistics_get_current_time(
+		     &end_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end time.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_store_get_size(
+		     store,
+		     &store_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			fprintf(
+			 bench_handle->notify_stream,
+			 "%s\n"
+			 "    {\n"
+			 "      \"store\": %d,\n"
+			 "      \"size\": %" PRIu64 ",\n"
+			 "      \"number_of_blocks\": %d,\n"
+			 "      \"metadata_load_time_us\": %" PRIu64 ",\n"
+			 "      \"reads\": [\n",
+			 ( store_index == 0 ) ? "" : ",",
+			 store_index + 1,
+			 store_size,
+			 number_of_blocks,
+			 end_time - start_time );
+		}
+		else
+		{
+			fprintf(
+			 bench_handle->notify_stream,
+			 "Store: %d\n"
+			 "\tSize\t\t\t: %" PRIu64 " bytes\n"
+			 "\tNumber of blocks\t: %d\n"
+			 "\tMetadata load time\t: %" PRIu64 " us\n"
+			 "\n",
+			 store_index + 1,
+			 store_size,
+			 number_of_blocks,
+			 end_time - start_time );
+		}
+		for( access_pattern = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+		     access_pattern <= BENCH_HANDLE_ACCESS_PATTERN_RANDOM;
+		     access_pattern <<= 1 )
+		{
+			if( ( bench_handle->access_patterns & access_pattern ) == 0 )
+			{
+				continue;
+			}
+			if( memory_set(
+			     &read_statistics,
+			     0,
+			     sizeof( read_statistics_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear read statistics.",
+				 function );
+
+				goto on_error;
+			}
+			if( bench_handle_run_access_pattern(
+			     bench_handle,
+			     store,
+			     store_index,
+			     access_pattern,
+			     &read_statistics,
+			     &elapsed_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run benchmark on store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			if( bench_handle_read_statistics_fprint(
+			     bench_handle,
+			     ( access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL ) ? "sequential" : "random",
+			     &read_statistics,
+			     elapsed_time,
+			     (int) ( ( bench_handle->access_patterns & ~( ( access_pattern << 1 ) - 1 ) ) == 0 ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print read statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			fprintf(
+			 bench_handle->notify_stream,
+			 "      ]\n"
+			 "    }" );
+		}
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\n"
+		 "  ]\n"
+		 "}\n" );
+	}
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( -1 );
+}
+
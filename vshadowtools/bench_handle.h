@@ -0,0 +1,269 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "read_statistics.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define BENCH_HANDLE_DEFAULT_BLOCK_SIZE			65536
+#define BENCH_HANDLE_DEFAULT_NUMBER_OF_RANDOM_READS	4096
+#define BENCH_HANDLE_MAXIMUM_BLOCK_SIZE			( 64 * 1024 * 1024 )
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
+enum BENCH_HANDLE_ACCESS_PATTERNS
+{
+	BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL		= 0x01,
+	BENCH_HANDLE_ACCESS_PATTERN_RANDOM		= 0x02,
+
+	BENCH_HANDLE_ACCESS_PATTERN_ALL			= 0x03
+};
+
+enum BENCH_HANDLE_OUTPUT_FORMATS
+{
+	BENCH_HANDLE_OUTPUT_FORMAT_JSON			= (int) 'j',
+	BENCH_HANDLE_OUTPUT_FORMAT_TEXT			= (int) 't'
+};
+
+typedef struct bench_handle bench_handle_t;
+
+typedef struct bench_worker bench_worker_t;
+
+struct bench_worker
+{
+	/* The benchmark handle
+	 */
+	bench_handle_t *bench_handle;
+
+	/* The store
+	 */
+	libvshadow_store_t *store;
+
+	/* The store size
+	 */
+	size64_t store_size;
+
+	/* The access pattern
+	 */
+	uint8_t access_pattern;
+
+	/* The worker index
+	 */
+	int worker_index;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The libbfio file IO handle used by the worker
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read statistics
+	 */
+	read_statistics_t read_statistics;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+};
+
+struct bench_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The read block size
+	 */
+	size_t block_size;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The access patterns
+	 */
+	uint8_t access_patterns;
+
+	/* The number of random reads per store
+	 */
+	uint64_t number_of_random_reads;
+
+	/* The maximum number of bytes read sequentially per store, 0 represents the entire store
+	 */
+	size64_t maximum_sequential_size;
+
+	/* The seed of the pseudo random number generator
+	 */
+	uint64_t random_seed;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The time it took to open the volume in microseconds
+	 */
+	uint64_t volume_open_time;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_volume_offset(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_access_patterns(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_random_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_maximum_sequential_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_random_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_output_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_close_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+uint64_t bench_worker_get_random_value(
+          bench_worker_t *bench_worker );
+
+int bench_worker_run(
+     bench_worker_t *bench_worker );
+
+int bench_handle_run_access_pattern(
+     bench_handle_t *bench_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     uint8_t access_pattern,
+     read_statistics_t *read_statistics,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error );
+
+int bench_handle_read_statistics_fprint(
+     bench_handle_t *bench_handle,
+     const char *access_pattern_name,
+     const read_statistics_t *read_statistics,
+     uint64_t elapsed_time,
+     int is_last,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
@@ -0,0 +1,870 @@
+/*
+ * Block cache shared between mount handles
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "block_cache.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+
+/* Creates a block cache
+ * The number of cached blocks is the maximum cache size divided by the block size
+ * Make sure the value block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int block_cache_initialize(
+     block_cache_t **block_cache,
+     size_t block_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function             = "block_cache_initialize";
+	size64_t maximum_number_of_values = 0;
+	int bucket_index                  = 0;
+	int number_of_buckets             = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_values = maximum_cache_size / block_size;
+
+	if( ( maximum_number_of_values == 0 )
+	 || ( maximum_number_of_values > (size64_t) ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_buckets = 1;
+
+	while( number_of_buckets < (int) maximum_number_of_values )
+	{
+		number_of_buckets <<= 1;
+	}
+	*block_cache = memory_allocate_structure(
+	                block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	( *block_cache )->values = (block_cache_value_t *) memory_allocate(
+	                                                    sizeof( block_cache_value_t ) * (size_t) maximum_number_of_values );
+
+	if( ( *block_cache )->values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create values.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_cache )->values,
+	     0,
+	     sizeof( block_cache_value_t ) * (size_t) maximum_number_of_values ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
+
+		goto on_error;
+	}
+	( *block_cache )->buckets = (int *) memory_allocate(
+	                                     sizeof( int ) * (size_t) number_of_buckets );
+
+	if( ( *block_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( bucket_index = 0;
+	     bucket_index < number_of_buckets;
+	     bucket_index++ )
+	{
+		( *block_cache )->buckets[ bucket_index ] = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *block_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *block_cache )->block_size               = block_size;
+	( *block_cache )->maximum_number_of_values = (int) maximum_number_of_values;
+	( *block_cache )->number_of_buckets        = number_of_buckets;
+	( *block_cache )->most_recently_used       = -1;
+	( *block_cache )->least_recently_used      = -1;
+
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *block_cache )->buckets );
+		}
+		if( ( *block_cache )->values != NULL )
+		{
+			memory_free(
+			 ( *block_cache )->values );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int block_cache_free(
+     block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "block_cache_free";
+	int result            = 1;
+	int value_index       = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *block_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( value_index = 0;
+		     value_index < ( *block_cache )->number_of_values;
+		     value_index++ )
+		{
+			if( ( *block_cache )->values[ value_index ].data != NULL )
+			{
+				memory_free(
+				 ( *block_cache )->values[ value_index ].data );
+			}
+		}
+		memory_free(
+		 ( *block_cache )->buckets );
+
+		memory_free(
+		 ( *block_cache )->values );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Determines the bucket index of a block
+ * Returns the bucket index
+ */
+int block_cache_get_bucket_index(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number )
+{
+	uint64_t hash_value = 0;
+
+	hash_value  = (uint64_t) owner;
+	hash_value ^= hash_value >> 4;
+	hash_value *= 31;
+	hash_value += (uint64_t) store_index;
+	hash_value *= 31;
+	hash_value += block_number;
+
+	/* Fibonacci hashing spreads consecutive block numbers over the buckets
+	 */
+	hash_value *= 0x9e3779b97f4a7c15ULL;
+	hash_value >>= 32;
+
+	return( (int) ( hash_value & (uint64_t) ( block_cache->number_of_buckets - 1 ) ) );
+}
+
+/* Finds the index of the value of a block
+ * Returns the value index or -1 if not found
+ */
+int block_cache_find_value(
+     block_cache_t *block_cache,
+     int bucket_index,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number )
+{
+	block_cache_value_t *value = NULL;
+	int value_index            = 0;
+
+	value_index = block_cache->buckets[ bucket_index ];
+
+	while( value_index != -1 )
+	{
+		value = &( block_cache->values[ value_index ] );
+
+		if( ( value->owner == owner )
+		 && ( value->store_index == store_index )
+		 && ( value->block_number == block_number ) )
+		{
+			break;
+		}
+		value_index = value->next_in_bucket;
+	}
+	return( value_index );
+}
+
+/* Removes a value from the most recently used list
+ */
+void block_cache_unlink_used_value(
+      block_cache_t *block_cache,
+      int value_index )
+{
+	block_cache_value_t *value = &( block_cache->values[ value_index ] );
+
+	if( value->previous_used != -1 )
+	{
+		block_cache->values[ value->previous_used ].next_used = value->next_used;
+	}
+	else
+	{
+		block_cache->most_recently_used = value->next_used;
+	}
+	if( value->next_used != -1 )
+	{
+		block_cache->values[ value->next_used ].previous_used = value->previous_used;
+	}
+	else
+	{
+		block_cache->least_recently_used = value->previous_used;
+	}
+	value->previous_used = -1;
+	value->next_used     = -1;
+}
+
+/* Prepends a value to the most recently used list
+ */
+void block_cache_link_used_value(
+      block_cache_t *block_cache,
+      int value_index )
+{
+	block_cache_value_t *value = &( block_cache->values[ value_index ] );
+
+	value->previous_used = -1;
+	value->next_used     = block_cache->most_recently_used;
+
+	if( block_cache->most_recently_used != -1 )
+	{
+		block_cache->values[ block_cache->most_recently_used ].previous_used = value_index;
+	}
+	block_cache->most_recently_used = value_index;
+
+	if( block_cache->least_recently_used == -1 )
+	{
+		block_cache->least_recently_used = value_index;
+	}
+}
+
+/* Removes a value from its hash bucket
+ */
+void block_cache_unlink_bucket_value(
+      block_cache_t *block_cache,
+      int value_index )
+{
+	block_cache_value_t *value = &( block_cache->values[ value_index ] );
+	int bucket_index           = 0;
+	int previous_index         = -1;
+	int search_index           = 0;
+
+	bucket_index = block_cache_get_bucket_index(
+	                block_cache,
+	                value->owner,
+	                value->store_index,
+	                value->block_number );
+
+	search_index = block_cache->buckets[ bucket_index ];
+
+	while( ( search_index != -1 )
+	    && ( search_index != value_index ) )
+	{
+		previous_index = search_index;
+		search_index   = block_cache->values[ search_index ].next_in_bucket;
+	}
+	if( search_index == -1 )
+	{
+		return;
+	}
+	if( previous_index == -1 )
+	{
+		block_cache->buckets[ bucket_index ] = value->next_in_bucket;
+	}
+	else
+	{
+		block_cache->values[ previous_index ].next_in_bucket = value->next_in_bucket;
+	}
+	value->next_in_bucket = -1;
+}
+
+/* Retrieves the data of a block
+ * Returns 1 if successful, 0 if the block is not cached or -1 on error
+ */
+int block_cache_get_block(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	block_cache_value_t *value = NULL;
+	static char *function      = "block_cache_get_block";
+	int bucket_index           = 0;
+	int result                 = 0;
+	int value_index            = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size < block_cache->block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bucket_index = block_cache_get_bucket_index(
+	                block_cache,
+	                owner,
+	                store_index,
+	                block_number );
+
+	value_index = block_cache_find_value(
+	               block_cache,
+	               bucket_index,
+	               owner,
+	               store_index,
+	               block_number );
+
+	if( value_index == -1 )
+	{
+		block_cache->number_of_misses += 1;
+	}
+	else
+	{
+		value = &( block_cache->values[ value_index ] );
+
+		if( memory_copy(
+		     buffer,
+		     value->data,
+		     value->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			*data_size = value->data_size;
+
+			block_cache_unlink_used_value(
+			 block_cache,
+			 value_index );
+
+			block_cache_link_used_value(
+			 block_cache,
+			 value_index );
+
+			block_cache->number_of_hits += 1;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the data of a block
+ * If the cache is full the least recently used block is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int block_cache_set_block(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	block_cache_value_t *value = NULL;
+	static char *function      = "block_cache_set_block";
+	int bucket_index           = 0;
+	int result                 = 1;
+	int value_index            = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > block_cache->block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bucket_index = block_cache_get_bucket_index(
+	                block_cache,
+	                owner,
+	                store_index,
+	                block_number );
+
+	value_index = block_cache_find_value(
+	               block_cache,
+	               bucket_index,
+	               owner,
+	               store_index,
+	               block_number );
+
+	if( value_index != -1 )
+	{
+		/* Another reader cached the same block in the meantime
+		 */
+		block_cache_unlink_used_value(
+		 block_cache,
+		 value_index );
+	}
+	else
+	{
+		if( block_cache->number_of_values < block_cache->maximum_number_of_values )
+		{
+			value_index = block_cache->number_of_values;
+
+			value = &( block_cache->values[ value_index ] );
+
+			value->data = (uint8_t *) memory_allocate(
+			                           sizeof( uint8_t ) * block_cache->block_size );
+
+			if( value->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create block data.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				value->next_in_bucket = -1;
+				value->previous_used  = -1;
+				value->next_used      = -1;
+
+				block_cache->number_of_values += 1;
+			}
+		}
+		else
+		{
+			value_index = block_cache->least_recently_used;
+
+			block_cache_unlink_used_value(
+			 block_cache,
+			 value_index );
+
+			block_cache_unlink_bucket_value(
+			 block_cache,
+			 value_index );
+		}
+		if( result == 1 )
+		{
+			value = &( block_cache->values[ value_index ] );
+
+			value->owner          = owner;
+			value->store_index    = store_index;
+			value->block_number   = block_number;
+			value->next_in_bucket = block_cache->buckets[ bucket_index ];
+
+			block_cache->buckets[ bucket_index ] = value_index;
+		}
+	}
+	if( result == 1 )
+	{
+		value = &( block_cache->values[ value_index ] );
+
+		if( memory_copy(
+		     value->data,
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			/* Make sure the value can never match with incomplete data
+			 */
+			block_cache_unlink_bucket_value(
+			 block_cache,
+			 value_index );
+
+			value->data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			value->data_size = data_size;
+		}
+		block_cache_link_used_value(
+		 block_cache,
+		 value_index );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the statistics of the block cache
+ * Returns 1 if successful or -1 on error
+ */
+int block_cache_get_statistics(
+     block_cache_t *block_cache,
+     int *number_of_blocks,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "block_cache_get_statistics";
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_blocks = block_cache->number_of_values;
+	*number_of_hits   = block_cache->number_of_hits;
+	*number_of_misses = block_cache->number_of_misses;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
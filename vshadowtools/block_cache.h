@@ -0,0 +1,194 @@
+/*
+ * Block cache shared between mount handles
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BLOCK_CACHE_H )
+#define _BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default block size, which corresponds to the VSS store block size
+ */
+#define BLOCK_CACHE_DEFAULT_BLOCK_SIZE		16384
+
+typedef struct block_cache_value block_cache_value_t;
+
+struct block_cache_value
+{
+	/* The owner identifier
+	 */
+	intptr_t owner;
+
+	/* The store index
+	 */
+	int store_index;
+
+	/* The block number
+	 */
+	uint64_t block_number;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The index of the next value in the same hash bucket or -1
+	 */
+	int next_in_bucket;
+
+	/* The index of the previously (more recently) used value or -1
+	 */
+	int previous_used;
+
+	/* The index of the next (less recently) used value or -1
+	 */
+	int next_used;
+};
+
+typedef struct block_cache block_cache_t;
+
+struct block_cache
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The maximum number of cache values
+	 */
+	int maximum_number_of_values;
+
+	/* The number of cache values in use
+	 */
+	int number_of_values;
+
+	/* The cache values
+	 */
+	block_cache_value_t *values;
+
+	/* The hash buckets, containing the index of the first value or -1
+	 */
+	int *buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_buckets;
+
+	/* The index of the most recently used value or -1
+	 */
+	int most_recently_used;
+
+	/* The index of the least recently used value or -1
+	 */
+	int least_recently_used;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 * the cache is shared between the mount handles and their readers
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int block_cache_initialize(
+     block_cache_t **block_cache,
+     size_t block_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int block_cache_free(
+     block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int block_cache_get_bucket_index(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number );
+
+int block_cache_find_value(
+     block_cache_t *block_cache,
+     int bucket_index,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number );
+
+void block_cache_unlink_used_value(
+      block_cache_t *block_cache,
+      int value_index );
+
+void block_cache_link_used_value(
+      block_cache_t *block_cache,
+      int value_index );
+
+void block_cache_unlink_bucket_value(
+      block_cache_t *block_cache,
+      int value_index );
+
+int block_cache_get_block(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int block_cache_set_block(
+     block_cache_t *block_cache,
+     intptr_t owner,
+     int store_index,
+     uint64_t block_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int block_cache_get_statistics(
+     block_cache_t *block_cache,
+     int *number_of_blocks,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BLOCK_CACHE_H ) */
+
@@ -0,0 +1,781 @@
+/*
+ * Block digest functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "block_digest.h"
+#include "vshadowtools_libcerror.h"
+
+#if defined( HAVE_BLOCK_DIGEST_SHA256_INTRINSICS )
+#include <immintrin.h>
+#endif
+
+#define block_digest_rotate_left32( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define block_digest_rotate_right32( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+#define block_digest_rotate_left64( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 64 - ( number_of_bits ) ) ) )
+
+/* The SHA-256 round constants
+ */
+static const uint32_t block_digest_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* The SHA-256 initial hash values
+ */
+static const uint32_t block_digest_sha256_initial_state[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The xxHash64 primes
+ */
+#define BLOCK_DIGEST_XXH64_PRIME1		0x9e3779b185ebca87ULL
+#define BLOCK_DIGEST_XXH64_PRIME2		0xc2b2ae3d27d4eb4fULL
+#define BLOCK_DIGEST_XXH64_PRIME3		0x165667b19e3779f9ULL
+#define BLOCK_DIGEST_XXH64_PRIME4		0x85ebca77c2b2ae63ULL
+#define BLOCK_DIGEST_XXH64_PRIME5		0x27d4eb2f165667c5ULL
+
+#define block_digest_xxh64_round( accumulator, value ) \
+	accumulator += ( value ) * BLOCK_DIGEST_XXH64_PRIME2; \
+	accumulator  = block_digest_rotate_left64( accumulator, 31 ); \
+	accumulator *= BLOCK_DIGEST_XXH64_PRIME1;
+
+/* Retrieves the size of a digest type
+ * Returns 1 if successful or -1 on error
+ */
+int block_digest_get_size(
+     int digest_type,
+     size_t *digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "block_digest_get_size";
+
+	if( digest_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_type )
+	{
+		case BLOCK_DIGEST_TYPE_SHA256:
+			*digest_size = BLOCK_DIGEST_SHA256_SIZE;
+			break;
+
+		case BLOCK_DIGEST_TYPE_XXH64:
+			*digest_size = BLOCK_DIGEST_XXH64_SIZE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the digest of a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int block_digest_calculate(
+     int digest_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "block_digest_calculate";
+	int result            = 0;
+
+	switch( digest_type )
+	{
+		case BLOCK_DIGEST_TYPE_SHA256:
+			result = block_digest_sha256_calculate(
+			          buffer,
+			          buffer_size,
+			          digest,
+			          digest_size,
+			          error );
+			break;
+
+		case BLOCK_DIGEST_TYPE_XXH64:
+			result = block_digest_xxh64_calculate(
+			          buffer,
+			          buffer_size,
+			          digest,
+			          digest_size,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_BLOCK_DIGEST_SHA256_INTRINSICS )
+
+/* Applies the SHA-256 block function to a number of 64-byte blocks
+ * This function uses the SHA extensions, which calculate 2 rounds per instruction
+ * on a state that is stored as ABEF and CDGH
+ */
+void block_digest_sha256_transform(
+      uint32_t *state,
+      const uint8_t *data,
+      size_t number_of_blocks )
+{
+	__m128i message_groups[ 4 ];
+
+	__m128i byte_order_mask = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+	__m128i message         = _mm_setzero_si128();
+	__m128i saved_state0    = _mm_setzero_si128();
+	__m128i saved_state1    = _mm_setzero_si128();
+	__m128i state0          = _mm_setzero_si128();
+	__m128i state1          = _mm_setzero_si128();
+	__m128i temporary       = _mm_setzero_si128();
+	int group_index         = 0;
+
+	temporary = _mm_loadu_si128(
+	             (const __m128i *) &( state[ 0 ] ) );
+	state1    = _mm_loadu_si128(
+	             (const __m128i *) &( state[ 4 ] ) );
+
+	temporary = _mm_shuffle_epi32( temporary, 0xb1 );
+	state1    = _mm_shuffle_epi32( state1, 0x1b );
+	state0    = _mm_alignr_epi8( temporary, state1, 8 );
+	state1    = _mm_blend_epi16( state1, temporary, 0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_state0 = state0;
+		saved_state1 = state1;
+
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			/* The message schedule is calculated 4 words at a time
+			 */
+			if( group_index < 4 )
+			{
+				message_groups[ group_index ] = _mm_shuffle_epi8(
+				                                 _mm_loadu_si128(
+				                                  (const __m128i *) &( data[ group_index * 16 ] ) ),
+				                                 byte_order_mask );
+			}
+			else
+			{
+				message_groups[ group_index % 4 ] = _mm_sha256msg2_epu32(
+				                                     _mm_add_epi32(
+				                                      _mm_sha256msg1_epu32(
+				                                       message_groups[ group_index % 4 ],
+				                                       message_groups[ ( group_index + 1 ) % 4 ] ),
+				                                      _mm_alignr_epi8(
+				                                       message_groups[ ( group_index + 3 ) % 4 ],
+				                                       message_groups[ ( group_index + 2 ) % 4 ],
+				                                       4 ) ),
+				                                     message_groups[ ( group_index + 3 ) % 4 ] );
+			}
+			message = _mm_add_epi32(
+			           message_groups[ group_index % 4 ],
+			           _mm_loadu_si128(
+			            (const __m128i *) &( block_digest_sha256_round_constants[ group_index * 4 ] ) ) );
+
+			state1  = _mm_sha256rnds2_epu32( state1, state0, message );
+			message = _mm_shuffle_epi32( message, 0x0e );
+			state0  = _mm_sha256rnds2_epu32( state0, state1, message );
+		}
+		state0 = _mm_add_epi32( state0, saved_state0 );
+		state1 = _mm_add_epi32( state1, saved_state1 );
+
+		data             += 64;
+		number_of_blocks -= 1;
+	}
+	temporary = _mm_shuffle_epi32( state0, 0x1b );
+	state1    = _mm_shuffle_epi32( state1, 0xb1 );
+	state0    = _mm_blend_epi16( temporary, state1, 0xf0 );
+	state1    = _mm_alignr_epi8( state1, temporary, 8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( state[ 0 ] ),
+	 state0 );
+	_mm_storeu_si128(
+	 (__m128i *) &( state[ 4 ] ),
+	 state1 );
+}
+
+#else
+
+/* Applies the SHA-256 block function to a number of 64-byte blocks
+ */
+void block_digest_sha256_transform(
+      uint32_t *state,
+      const uint8_t *data,
+      size_t number_of_blocks )
+{
+	uint32_t values[ 8 ];
+	uint32_t words[ 64 ];
+
+	uint32_t sigma0     = 0;
+	uint32_t sigma1     = 0;
+	uint32_t temporary1 = 0;
+	uint32_t temporary2 = 0;
+	int value_index     = 0;
+	int word_index      = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		for( word_index = 0;
+		     word_index < 16;
+		     word_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( data[ word_index * 4 ] ),
+			 words[ word_index ] );
+		}
+		for( word_index = 16;
+		     word_index < 64;
+		     word_index++ )
+		{
+			sigma0 = block_digest_rotate_right32( words[ word_index - 15 ], 7 )
+			       ^ block_digest_rotate_right32( words[ word_index - 15 ], 18 )
+			       ^ ( words[ word_index - 15 ] >> 3 );
+
+			sigma1 = block_digest_rotate_right32( words[ word_index - 2 ], 17 )
+			       ^ block_digest_rotate_right32( words[ word_index - 2 ], 19 )
+			       ^ ( words[ word_index - 2 ] >> 10 );
+
+			words[ word_index ] = words[ word_index - 16 ] + sigma0 + words[ word_index - 7 ] + sigma1;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			values[ value_index ] = state[ value_index ];
+		}
+		for( word_index = 0;
+		     word_index < 64;
+		     word_index++ )
+		{
+			sigma1 = block_digest_rotate_right32( values[ 4 ], 6 )
+			       ^ block_digest_rotate_right32( values[ 4 ], 11 )
+			       ^ block_digest_rotate_right32( values[ 4 ], 25 );
+
+			temporary1 = values[ 7 ]
+			           + sigma1
+			           + ( ( values[ 4 ] & values[ 5 ] ) ^ ( ~( values[ 4 ] ) & values[ 6 ] ) )
+			           + block_digest_sha256_round_constants[ word_index ]
+			           + words[ word_index ];
+
+			sigma0 = block_digest_rotate_right32( values[ 0 ], 2 )
+			       ^ block_digest_rotate_right32( values[ 0 ], 13 )
+			       ^ block_digest_rotate_right32( values[ 0 ], 22 );
+
+			temporary2 = sigma0
+			           + ( ( values[ 0 ] & values[ 1 ] ) ^ ( values[ 0 ] & values[ 2 ] ) ^ ( values[ 1 ] & values[ 2 ] ) );
+
+			values[ 7 ] = values[ 6 ];
+			values[ 6 ] = values[ 5 ];
+			values[ 5 ] = values[ 4 ];
+			values[ 4 ] = values[ 3 ] + temporary1;
+			values[ 3 ] = values[ 2 ];
+			values[ 2 ] = values[ 1 ];
+			values[ 1 ] = values[ 0 ];
+			values[ 0 ] = temporary1 + temporary2;
+		}
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			state[ value_index ] += values[ value_index ];
+		}
+		data             += 64;
+		number_of_blocks -= 1;
+	}
+}
+
+#endif /* defined( HAVE_BLOCK_DIGEST_SHA256_INTRINSICS ) */
+
+/* Calculates the SHA-256 of a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int block_digest_sha256_calculate(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	uint8_t last_blocks[ 128 ];
+	uint32_t state[ 8 ];
+
+	static char *function   = "block_digest_sha256_calculate";
+	size_t last_blocks_size = 0;
+	size_t number_of_blocks = 0;
+	size_t remaining_size   = 0;
+	uint64_t number_of_bits = 0;
+	int value_index         = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < BLOCK_DIGEST_SHA256_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		state[ value_index ] = block_digest_sha256_initial_state[ value_index ];
+	}
+	number_of_blocks = buffer_size / 64;
+
+	if( number_of_blocks > 0 )
+	{
+		block_digest_sha256_transform(
+		 state,
+		 buffer,
+		 number_of_blocks );
+	}
+	/* The remaining data is padded with a 1-bit, 0-bits and the 64-bit
+	 * number of bits of the data
+	 */
+	remaining_size = buffer_size % 64;
+
+	if( memory_set(
+	     last_blocks,
+	     0,
+	     128 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear last blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( remaining_size > 0 )
+	{
+		if( memory_copy(
+		     last_blocks,
+		     &( buffer[ number_of_blocks * 64 ] ),
+		     remaining_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy remaining data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	last_blocks[ remaining_size ] = 0x80;
+
+	if( remaining_size < 56 )
+	{
+		last_blocks_size = 64;
+	}
+	else
+	{
+		last_blocks_size = 128;
+	}
+	number_of_bits = (uint64_t) buffer_size * 8;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( last_blocks[ last_blocks_size - 8 ] ),
+	 number_of_bits );
+
+	block_digest_sha256_transform(
+	 state,
+	 last_blocks,
+	 last_blocks_size / 64 );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( digest[ value_index * 4 ] ),
+		 state[ value_index ] );
+	}
+	return( 1 );
+}
+
+/* Calculates the xxHash64 of a buffer with seed 0
+ * The data is processed in 32-byte stripes by 4 independent accumulators
+ * The digest is stored in big-endian, the canonical representation of xxHash
+ * Returns 1 if successful or -1 on error
+ */
+int block_digest_xxh64_calculate(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "block_digest_xxh64_calculate";
+	size_t buffer_offset  = 0;
+	uint64_t accumulator1 = 0;
+	uint64_t accumulator2 = 0;
+	uint64_t accumulator3 = 0;
+	uint64_t accumulator4 = 0;
+	uint64_t hash_value   = 0;
+	uint64_t value_64bit  = 0;
+	uint32_t value_32bit  = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < BLOCK_DIGEST_XXH64_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size >= 32 )
+	{
+		accumulator1 = BLOCK_DIGEST_XXH64_PRIME1 + BLOCK_DIGEST_XXH64_PRIME2;
+		accumulator2 = BLOCK_DIGEST_XXH64_PRIME2;
+		accumulator3 = 0;
+		accumulator4 = 0 - BLOCK_DIGEST_XXH64_PRIME1;
+
+		while( ( buffer_size - buffer_offset ) >= 32 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( buffer[ buffer_offset ] ),
+			 value_64bit );
+
+			block_digest_xxh64_round(
+			 accumulator1,
+			 value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( buffer[ buffer_offset + 8 ] ),
+			 value_64bit );
+
+			block_digest_xxh64_round(
+			 accumulator2,
+			 value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( buffer[ buffer_offset + 16 ] ),
+			 value_64bit );
+
+			block_digest_xxh64_round(
+			 accumulator3,
+			 value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( buffer[ buffer_offset + 24 ] ),
+			 value_64bit );
+
+			block_digest_xxh64_round(
+			 accumulator4,
+			 value_64bit );
+
+			buffer_offset += 32;
+		}
+		hash_value = block_digest_rotate_left64( accumulator1, 1 )
+		           + block_digest_rotate_left64( accumulator2, 7 )
+		           + block_digest_rotate_left64( accumulator3, 12 )
+		           + block_digest_rotate_left64( accumulator4, 18 );
+
+		/* Merge the accumulators into the hash value
+		 */
+		value_64bit = 0;
+
+		block_digest_xxh64_round(
+		 value_64bit,
+		 accumulator1 );
+
+		hash_value ^= value_64bit;
+		hash_value  = ( hash_value * BLOCK_DIGEST_XXH64_PRIME1 ) + BLOCK_DIGEST_XXH64_PRIME4;
+
+		value_64bit = 0;
+
+		block_digest_xxh64_round(
+		 value_64bit,
+		 accumulator2 );
+
+		hash_value ^= value_64bit;
+		hash_value  = ( hash_value * BLOCK_DIGEST_XXH64_PRIME1 ) + BLOCK_DIGEST_XXH64_PRIME4;
+
+		value_64bit = 0;
+
+		block_digest_xxh64_round(
+		 value_64bit,
+		 accumulator3 );
+
+		hash_value ^= value_64bit;
+		hash_value  = ( hash_value * BLOCK_DIGEST_XXH64_PRIME1 ) + BLOCK_DIGEST_XXH64_PRIME4;
+
+		value_64bit = 0;
+
+		block_digest_xxh64_round(
+		 value_64bit,
+		 accumulator4 );
+
+		hash_value ^= value_64bit;
+		hash_value  = ( hash_value * BLOCK_DIGEST_XXH64_PRIME1 ) + BLOCK_DIGEST_XXH64_PRIME4;
+	}
+	else
+	{
+		hash_value = BLOCK_DIGEST_XXH64_PRIME5;
+	}
+	hash_value += (uint64_t) buffer_size;
+
+	while( ( buffer_size - buffer_offset ) >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( buffer[ buffer_offset ] ),
+		 value_64bit );
+
+		accumulator1 = 0;
+
+		block_digest_xxh64_round(
+		 accumulator1,
+		 value_64bit );
+
+		hash_value ^= accumulator1;
+		hash_value  = ( block_digest_rotate_left64( hash_value, 27 ) * BLOCK_DIGEST_XXH64_PRIME1 ) + BLOCK_DIGEST_XXH64_PRIME4;
+
+		buffer_offset += 8;
+	}
+	if( ( buffer_size - buffer_offset ) >= 4 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( buffer[ buffer_offset ] ),
+		 value_32bit );
+
+		hash_value ^= (uint64_t) value_32bit * BLOCK_DIGEST_XXH64_PRIME1;
+		hash_value  = ( block_digest_rotate_left64( hash_value, 23 ) * BLOCK_DIGEST_XXH64_PRIME2 ) + BLOCK_DIGEST_XXH64_PRIME3;
+
+		buffer_offset += 4;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		hash_value ^= (uint64_t) buffer[ buffer_offset ] * BLOCK_DIGEST_XXH64_PRIME5;
+		hash_value  = block_digest_rotate_left64( hash_value, 11 ) * BLOCK_DIGEST_XXH64_PRIME1;
+
+		buffer_offset += 1;
+	}
+	hash_value ^= hash_value >> 33;
+	hash_value *= BLOCK_DIGEST_XXH64_PRIME2;
+	hash_value ^= hash_value >> 29;
+	hash_value *= BLOCK_DIGEST_XXH64_PRIME3;
+	hash_value ^= hash_value >> 32;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 digest,
+	 hash_value );
+
+	return( 1 );
+}
+
+/* Copies a digest to a string of hexadecimal characters
+ * The string size should be at least 2 times the digest size + 1
+ * Returns 1 if successful or -1 on error
+ */
+int block_digest_copy_to_string(
+     const uint8_t *digest,
+     size_t digest_size,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	static const char *hexadecimal_characters = "0123456789abcdef";
+	static char *function                     = "block_digest_copy_to_string";
+	size_t digest_index                       = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size > BLOCK_DIGEST_MAXIMUM_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid digest size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size < ( ( digest_size * 2 ) + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid string size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_index = 0;
+	     digest_index < digest_size;
+	     digest_index++ )
+	{
+		string[ digest_index * 2 ]         = hexadecimal_characters[ digest[ digest_index ] >> 4 ];
+		string[ ( digest_index * 2 ) + 1 ] = hexadecimal_characters[ digest[ digest_index ] & 0x0f ];
+	}
+	string[ digest_size * 2 ] = 0;
+
+	return( 1 );
+}
+
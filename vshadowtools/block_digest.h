@@ -0,0 +1,96 @@
+/*
+ * Block digest functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BLOCK_DIGEST_H )
+#define _BLOCK_DIGEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SHA-256 block function uses the SHA extensions if the compiler targets them,
+ * such as with -msha -msse4.1
+ */
+#if defined( __SHA__ ) && defined( __SSE4_1__ ) && defined( __SSSE3__ )
+#define HAVE_BLOCK_DIGEST_SHA256_INTRINSICS	1
+#endif
+
+#define BLOCK_DIGEST_MAXIMUM_SIZE		32
+
+#define BLOCK_DIGEST_SHA256_SIZE		32
+#define BLOCK_DIGEST_XXH64_SIZE			8
+
+enum BLOCK_DIGEST_TYPES
+{
+	BLOCK_DIGEST_TYPE_SHA256		= (int) 's',
+	BLOCK_DIGEST_TYPE_XXH64			= (int) 'x'
+};
+
+int block_digest_get_size(
+     int digest_type,
+     size_t *digest_size,
+     libcerror_error_t **error );
+
+int block_digest_calculate(
+     int digest_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+void block_digest_sha256_transform(
+      uint32_t *state,
+      const uint8_t *data,
+      size_t number_of_blocks );
+
+int block_digest_sha256_calculate(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int block_digest_xxh64_calculate(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int block_digest_copy_to_string(
+     const uint8_t *digest,
+     size_t digest_size,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BLOCK_DIGEST_H ) */
+
@@ -0,0 +1,4130 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "byte_size_string.h"
+#include "export_handle.h"
+#include "qcow2_writer.h"
+#include "read_statistics.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcpath.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+#include "zero_copy.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define EXPORT_HANDLE_NOTIFY_STREAM		stdout
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                  export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *export_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *export_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *export_handle )->progress_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize progress mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->number_of_threads = EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+#else
+	( *export_handle )->number_of_threads = 1;
+#endif
+	( *export_handle )->block_size     = EXPORT_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *export_handle )->print_progress = 1;
+	( *export_handle )->export_mode    = EXPORT_HANDLE_EXPORT_MODE_COPY;
+	( *export_handle )->output_format  = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
+	( *export_handle )->notify_stream  = EXPORT_HANDLE_NOTIFY_STREAM;
+
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	( *export_handle )->input_descriptor = -1;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_volume != NULL )
+		{
+			libvshadow_volume_free(
+			 &( ( *export_handle )->input_volume ),
+			 NULL );
+		}
+		if( ( *export_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *export_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int output_index      = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->output_filenames != NULL )
+		{
+			for( output_index = 0;
+			     output_index < ( *export_handle )->number_of_outputs;
+			     output_index++ )
+			{
+				if( ( *export_handle )->output_filenames[ output_index ] != NULL )
+				{
+					memory_free(
+					 ( *export_handle )->output_filenames[ output_index ] );
+				}
+			}
+			memory_free(
+			 ( *export_handle )->output_filenames );
+		}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+		if( ( *export_handle )->output_descriptors != NULL )
+		{
+			for( output_index = 0;
+			     output_index < ( *export_handle )->number_of_outputs;
+			     output_index++ )
+			{
+				if( zero_copy_close(
+				     &( ( *export_handle )->output_descriptors[ output_index ] ),
+				     error ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close output descriptor: %d.",
+					 function,
+					 output_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *export_handle )->output_descriptors );
+		}
+		if( zero_copy_close(
+		     &( ( *export_handle )->input_descriptor ),
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input descriptor.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *export_handle )->tasks != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->tasks );
+		}
+		if( ( *export_handle )->segments != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->segments );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *export_handle )->progress_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free progress mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libvshadow_volume_free(
+		     &( ( *export_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *export_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_signal_abort";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( export_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     export_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the physical block size
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_block_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block size must be a multiple of the size of the zero checks
+	 * so that the zero checks of a block are aligned
+	 */
+	if( ( size_value < (uint64_t) EXPORT_HANDLE_ZERO_CHECK_SIZE )
+	 || ( size_value > (uint64_t) EXPORT_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( size_value % EXPORT_HANDLE_ZERO_CHECK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->block_size = (size_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multiple threads not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	export_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the selected stores
+ * The string contains comma separated store numbers or ranges of store numbers,
+ * such as 1,3-5, or all
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_selected_stores(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	uint8_t selected_stores[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ];
+
+	static char *function       = "export_handle_set_selected_stores";
+	size_t string_index         = 0;
+	size_t string_length        = 0;
+	uint64_t first_store_number = 0;
+	uint64_t store_number       = 0;
+	int in_range                = 0;
+	int number_of_digits        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		export_handle->has_selected_stores = 0;
+
+		return( 1 );
+	}
+	if( memory_set(
+	     selected_stores,
+	     0,
+	     sizeof( uint8_t ) * ( EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear selected stores.",
+		 function );
+
+		return( -1 );
+	}
+	/* The terminating end-of-string character is handled as a separator
+	 */
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			if( number_of_digits >= 3 )
+			{
+				break;
+			}
+			store_number *= 10;
+			store_number += (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+			number_of_digits++;
+
+			continue;
+		}
+		if( ( number_of_digits == 0 )
+		 || ( store_number == 0 )
+		 || ( store_number > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+		{
+			break;
+		}
+		if( string[ string_index ] == (system_character_t) '-' )
+		{
+			if( in_range != 0 )
+			{
+				break;
+			}
+			first_store_number = store_number;
+			in_range           = 1;
+		}
+		else if( ( string[ string_index ] == (system_character_t) ',' )
+		      || ( string[ string_index ] == 0 ) )
+		{
+			if( in_range == 0 )
+			{
+				first_store_number = store_number;
+			}
+			else if( first_store_number > store_number )
+			{
+				break;
+			}
+			while( first_store_number <= store_number )
+			{
+				selected_stores[ ( first_store_number - 1 ) / 8 ] |= (uint8_t) ( 1 << ( ( first_store_number - 1 ) % 8 ) );
+
+				first_store_number++;
+			}
+			in_range = 0;
+		}
+		else
+		{
+			break;
+		}
+		store_number     = 0;
+		number_of_digits = 0;
+	}
+	if( string_index <= string_length )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported stores at index: %" PRIzd ".",
+		 function,
+		 string_index );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     export_handle->selected_stores,
+	     selected_stores,
+	     sizeof( uint8_t ) * ( EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy selected stores.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->has_selected_stores = 1;
+
+	return( 1 );
+}
+
+/* Sets the export mode
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_export_mode(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_export_mode";
+	size_t string_length  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 5 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "clone" ),
+	       5 ) == 0 ) )
+	{
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+		export_handle->export_mode = EXPORT_HANDLE_EXPORT_MODE_CLONE;
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: clone export mode is not supported on this platform.",
+		 function );
+
+		return( -1 );
+#endif
+	}
+	else if( ( string_length == 4 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "copy" ),
+	            4 ) == 0 ) )
+	{
+		export_handle->export_mode = EXPORT_HANDLE_EXPORT_MODE_COPY;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported export mode.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_output_format(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_output_format";
+	size_t string_length  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 5 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "qcow2" ),
+	       5 ) == 0 ) )
+	{
+		export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2;
+	}
+	else if( ( string_length == 3 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "raw" ),
+	            3 ) == 0 ) )
+	{
+		export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported output format.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets if the progress should be reported
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_print_progress(
+     export_handle_t *export_handle,
+     uint8_t print_progress,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_print_progress";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->print_progress = print_progress;
+
+	return( 1 );
+}
+
+/* Determines if a store is selected to be exported
+ * Returns 1 if selected or 0 if not
+ */
+int export_handle_store_is_selected(
+     export_handle_t *export_handle,
+     int store_index )
+{
+	if( ( export_handle == NULL )
+	 || ( store_index < 0 )
+	 || ( store_index >= EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+	{
+		return( 0 );
+	}
+	if( export_handle->has_selected_stores == 0 )
+	{
+		return( 1 );
+	}
+	if( ( export_handle->selected_stores[ store_index / 8 ] & ( 1 << ( store_index % 8 ) ) ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Opens the export handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+	int store_index        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     export_handle->input_file_io_handle,
+	     export_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          export_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvshadow_volume_open_file_io_handle(
+	     export_handle->input_volume,
+	     export_handle->input_file_io_handle,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     export_handle->input_volume,
+	     &( export_handle->number_of_stores ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( export_handle->number_of_stores < 0 )
+	 || ( export_handle->number_of_stores > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stores value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure a selected store exists
+	 */
+	for( store_index = export_handle->number_of_stores;
+	     store_index < EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES;
+	     store_index++ )
+	{
+		if( ( export_handle->has_selected_stores != 0 )
+		 && ( export_handle_store_is_selected(
+		       export_handle,
+		       store_index ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid selected store: %d value out of bounds, the volume has %d stores.",
+			 function,
+			 store_index + 1,
+			 export_handle->number_of_stores );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	/* In clone mode the data is cloned directly from the source file
+	 */
+	if( export_handle->export_mode == EXPORT_HANDLE_EXPORT_MODE_CLONE )
+	{
+		if( zero_copy_open(
+		     filename,
+		     &( export_handle->input_descriptor ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	libvshadow_volume_close(
+	 export_handle->input_volume,
+	 NULL );
+
+	export_handle->number_of_stores = 0;
+
+	return( -1 );
+}
+
+/* Closes the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_input";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	if( zero_copy_close(
+	     &( export_handle->input_descriptor ),
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_volume_close(
+	     export_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Creates the output files
+ * Every selected store is exported to a file named vssN in the target path.
+ * The output files are resized to the size of the store before any data is
+ * written so that the ranges that are not written remain sparse
+ * In QCOW2 output format the current volume is exported to a file named base.raw
+ * and every selected store to a file named vssN.qcow2 that uses base.raw as its
+ * backing file. The QCOW2 files are resized when their clusters are allocated
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	system_character_t output_name[ 16 ];
+
+	libcfile_file_t *output_file = NULL;
+	libvshadow_store_t *store    = NULL;
+	static char *function        = "export_handle_open_output";
+	size64_t output_size         = 0;
+	size_t output_filename_size  = 0;
+	size_t target_path_length    = 0;
+	int output_index             = 0;
+	int print_count              = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_filenames != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output filenames value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_stores == 0 )
+	{
+		return( 1 );
+	}
+	target_path_length = system_string_length(
+	                      target_path );
+
+	export_handle->number_of_outputs = export_handle->number_of_stores;
+
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 )
+	{
+		export_handle->number_of_outputs += 1;
+	}
+	export_handle->output_filenames = (system_character_t **) memory_allocate(
+	                                                           sizeof( system_character_t * ) * export_handle->number_of_outputs );
+
+	if( export_handle->output_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->output_filenames,
+	     0,
+	     sizeof( system_character_t * ) * export_handle->number_of_outputs ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output filenames.",
+		 function );
+
+		memory_free(
+		 export_handle->output_filenames );
+
+		export_handle->output_filenames  = NULL;
+		export_handle->number_of_outputs = 0;
+
+		return( -1 );
+	}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	if( export_handle->export_mode == EXPORT_HANDLE_EXPORT_MODE_CLONE )
+	{
+		export_handle->output_descriptors = (int *) memory_allocate(
+		                                             sizeof( int ) * export_handle->number_of_outputs );
+
+		if( export_handle->output_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output descriptors.",
+			 function );
+
+			goto on_error;
+		}
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			export_handle->output_descriptors[ output_index ] = -1;
+		}
+	}
+#endif
+	for( output_index = 0;
+	     output_index < export_handle->number_of_outputs;
+	     output_index++ )
+	{
+		if( output_index == export_handle->number_of_stores )
+		{
+			if( system_string_copy(
+			     output_name,
+			     _SYSTEM_STRING( "base.raw" ),
+			     9 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name of base image.",
+				 function );
+
+				goto on_error;
+			}
+			print_count = 8;
+		}
+		else if( export_handle_store_is_selected(
+		          export_handle,
+		          output_index ) == 0 )
+		{
+			continue;
+		}
+		else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 )
+		{
+			print_count = system_string_sprintf(
+			               output_name,
+			               16,
+			               _SYSTEM_STRING( "vss%d.qcow2" ),
+			               output_index + 1 );
+		}
+		else
+		{
+			print_count = system_string_sprintf(
+			               output_name,
+			               16,
+			               _SYSTEM_STRING( "vss%d" ),
+			               output_index + 1 );
+		}
+		if( ( print_count < 0 )
+		 || ( print_count > 16 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name of output: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &( export_handle->output_filenames[ output_index ] ),
+		     &output_filename_size,
+		     target_path,
+		     target_path_length,
+		     output_name,
+		     (size_t) print_count,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &( export_handle->output_filenames[ output_index ] ),
+		     &output_filename_size,
+		     target_path,
+		     target_path_length,
+		     output_name,
+		     (size_t) print_count,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create filename of output: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+		if( output_index == export_handle->number_of_stores )
+		{
+			if( libvshadow_volume_get_size(
+			     export_handle->input_volume,
+			     &output_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve volume size.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 )
+		{
+			output_size = 0;
+		}
+		else
+		{
+			if( libvshadow_volume_get_store(
+			     export_handle->input_volume,
+			     output_index,
+			     &store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+			if( libvshadow_store_get_size(
+			     store,
+			     &output_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of store: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+			if( libvshadow_store_free(
+			     &store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+		}
+		if( libcfile_file_initialize(
+		     &output_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize output file.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcfile_file_open_wide(
+		     output_file,
+		     export_handle->output_filenames[ output_index ],
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#else
+		if( libcfile_file_open(
+		     output_file,
+		     export_handle->output_filenames[ output_index ],
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->output_filenames[ output_index ] );
+
+			goto on_error;
+		}
+		if( libcfile_file_resize(
+		     output_file,
+		     output_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to resize output file: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->output_filenames[ output_index ] );
+
+			goto on_error;
+		}
+		if( libcfile_file_close(
+		     output_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output file: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->output_filenames[ output_index ] );
+
+			goto on_error;
+		}
+		if( libcfile_file_free(
+		     &output_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output file.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+		if( export_handle->output_descriptors != NULL )
+		{
+			if( zero_copy_open(
+			     export_handle->output_filenames[ output_index ],
+			     &( export_handle->output_descriptors[ output_index ] ),
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open descriptor of output: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+		}
+#endif
+		export_handle->number_of_bytes_exported += output_size;
+	}
+	return( 1 );
+
+on_error:
+	if( output_file != NULL )
+	{
+		libcfile_file_free(
+		 &output_file,
+		 NULL );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( export_handle->output_filenames != NULL )
+	{
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( export_handle->output_filenames[ output_index ] != NULL )
+			{
+				memory_free(
+				 export_handle->output_filenames[ output_index ] );
+			}
+		}
+		memory_free(
+		 export_handle->output_filenames );
+
+		export_handle->output_filenames = NULL;
+	}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	if( export_handle->output_descriptors != NULL )
+	{
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			zero_copy_close(
+			 &( export_handle->output_descriptors[ output_index ] ),
+			 NULL );
+		}
+		memory_free(
+		 export_handle->output_descriptors );
+
+		export_handle->output_descriptors = NULL;
+	}
+#endif
+	export_handle->number_of_outputs        = 0;
+	export_handle->number_of_bytes_exported = 0;
+
+	return( -1 );
+}
+
+/* Appends a segment
+ * The segment is combined with the last segment if it is its continuation
+ * within the same physical block
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_segment(
+     export_handle_t *export_handle,
+     int output_index,
+     off64_t output_offset,
+     off64_t physical_offset,
+     size_t size,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error )
+{
+	export_segment_t *segment  = NULL;
+	export_segment_t *segments = NULL;
+	static char *function      = "export_handle_append_segment";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_segments > 0 )
+	{
+		segment = &( export_handle->segments[ export_handle->number_of_segments - 1 ] );
+
+		if( ( segment->output_index == output_index )
+		 && ( ( segment->output_offset + (off64_t) segment->size ) == output_offset )
+		 && ( ( segment->physical_offset + (off64_t) segment->size ) == physical_offset )
+		 && ( ( segment->physical_offset / (off64_t) export_handle->block_size ) == ( physical_offset / (off64_t) export_handle->block_size ) ) )
+		{
+			segment->size += size;
+
+			return( 1 );
+		}
+	}
+	if( export_handle->number_of_segments >= *maximum_number_of_segments )
+	{
+		if( *maximum_number_of_segments == 0 )
+		{
+			*maximum_number_of_segments = 4096;
+		}
+		else
+		{
+			*maximum_number_of_segments *= 2;
+		}
+		if( *maximum_number_of_segments > (size_t) ( SSIZE_MAX / sizeof( export_segment_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		segments = (export_segment_t *) memory_reallocate(
+		                                 export_handle->segments,
+		                                 sizeof( export_segment_t ) * *maximum_number_of_segments );
+
+		if( segments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		export_handle->segments = segments;
+	}
+	segment = &( export_handle->segments[ export_handle->number_of_segments ] );
+
+	segment->physical_offset = physical_offset;
+	segment->output_offset   = output_offset;
+	segment->size            = size;
+	segment->output_index    = output_index;
+
+	export_handle->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Compares two segments by physical offset, output index and output offset
+ * Returns -1 if the first segment sorts before, 1 if after or 0 if equal
+ */
+int export_handle_compare_segments(
+     const void *first_segment,
+     const void *second_segment )
+{
+	const export_segment_t *first  = (const export_segment_t *) first_segment;
+	const export_segment_t *second = (const export_segment_t *) second_segment;
+
+	if( first->physical_offset != second->physical_offset )
+	{
+		return( ( first->physical_offset < second->physical_offset ) ? -1 : 1 );
+	}
+	if( first->output_index != second->output_index )
+	{
+		return( ( first->output_index < second->output_index ) ? -1 : 1 );
+	}
+	if( first->output_offset != second->output_offset )
+	{
+		return( ( first->output_offset < second->output_offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Appends the segments of a store
+ * The extents of the store are split into segments at the boundaries of the
+ * physical blocks. Sparse extents are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_store_segments(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function    = "export_handle_append_store_segments";
+	size64_t extent_size     = 0;
+	size64_t store_size      = 0;
+	size_t segment_size      = 0;
+	off64_t block_end_offset = 0;
+	off64_t extent_offset    = 0;
+	off64_t store_offset     = 0;
+	uint32_t extent_flags    = 0;
+	int result               = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	while( (size64_t) store_offset < store_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		result = libvshadow_store_get_extent_at_offset(
+		          store,
+		          store_offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent of store: %d at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 store_offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( extent_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent of store: %d at offset: %" PRIi64 " - size value out of bounds.",
+			 function,
+			 store_index,
+			 store_offset );
+
+			return( -1 );
+		}
+		if( extent_size > ( store_size - (size64_t) store_offset ) )
+		{
+			extent_size = store_size - (size64_t) store_offset;
+		}
+		if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			store_offset += (off64_t) extent_size;
+
+			continue;
+		}
+		export_handle->number_of_data_bytes += extent_size;
+
+		while( extent_size > 0 )
+		{
+			block_end_offset = ( ( extent_offset / (off64_t) export_handle->block_size ) + 1 ) * (off64_t) export_handle->block_size;
+
+			segment_size = (size_t) ( block_end_offset - extent_offset );
+
+			if( (size64_t) segment_size > extent_size )
+			{
+				segment_size = (size_t) extent_size;
+			}
+			if( export_handle_append_segment(
+			     export_handle,
+			     store_index,
+			     store_offset,
+			     extent_offset,
+			     segment_size,
+			     maximum_number_of_segments,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment of store: %d at offset: %" PRIi64 ".",
+				 function,
+				 store_index,
+				 store_offset );
+
+				return( -1 );
+			}
+			store_offset  += (off64_t) segment_size;
+			extent_offset += (off64_t) segment_size;
+			extent_size   -= (size64_t) segment_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Appends the segments of a store that is exported as a QCOW2 image
+ * The clusters of the store are classified based on its extents. A cluster that
+ * only contains data of the current volume at the same offset is read from the
+ * backing file and a cluster that is sparse is stored as a zero cluster. Other
+ * clusters are stored in the image. The metadata of the image is written and the
+ * data of the stored clusters is split into segments at the boundaries of the
+ * physical blocks
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_qcow2_segments(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *output_file = NULL;
+	qcow2_writer_t *qcow2_writer = NULL;
+	static char *function        = "export_handle_append_qcow2_segments";
+	size64_t extent_size         = 0;
+	size64_t store_size          = 0;
+	size_t segment_size          = 0;
+	uint64_t cluster_index       = 0;
+	uint64_t number_of_clusters  = 0;
+	off64_t block_end_offset     = 0;
+	off64_t cluster_end_offset   = 0;
+	off64_t cluster_offset       = 0;
+	off64_t extent_offset        = 0;
+	off64_t store_offset         = 0;
+	uint32_t extent_flags        = 0;
+	uint8_t cluster_flags        = 0;
+	int cluster_type             = 0;
+	int result                   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( store_size == 0 )
+	{
+		return( 1 );
+	}
+	if( qcow2_writer_initialize(
+	     &qcow2_writer,
+	     store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize QCOW2 writer of store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	number_of_clusters = ( store_size + QCOW2_WRITER_CLUSTER_SIZE - 1 ) / QCOW2_WRITER_CLUSTER_SIZE;
+
+	for( cluster_index = 0;
+	     cluster_index < number_of_clusters;
+	     cluster_index++ )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		store_offset       = (off64_t) ( cluster_index * QCOW2_WRITER_CLUSTER_SIZE );
+		cluster_end_offset = store_offset + QCOW2_WRITER_CLUSTER_SIZE;
+
+		if( (size64_t) cluster_end_offset > store_size )
+		{
+			cluster_end_offset = (off64_t) store_size;
+		}
+		cluster_flags = 0;
+
+		while( store_offset < cluster_end_offset )
+		{
+			result = libvshadow_store_get_extent_at_offset(
+			          store,
+			          store_offset,
+			          &extent_offset,
+			          &extent_size,
+			          &extent_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent of store: %d at offset: %" PRIi64 ".",
+				 function,
+				 store_index,
+				 store_offset );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			if( extent_size == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid extent of store: %d at offset: %" PRIi64 " - size value out of bounds.",
+				 function,
+				 store_index,
+				 store_offset );
+
+				goto on_error;
+			}
+			if( extent_size > (size64_t) ( cluster_end_offset - store_offset ) )
+			{
+				extent_size = (size64_t) ( cluster_end_offset - store_offset );
+			}
+			/* Data of the current volume at the same offset is not stored in the image
+			 */
+			if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+			{
+				cluster_flags |= EXPORT_HANDLE_CLUSTER_FLAG_HAS_SPARSE_DATA;
+			}
+			else if( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) == 0 )
+			      && ( extent_offset == store_offset ) )
+			{
+				cluster_flags |= EXPORT_HANDLE_CLUSTER_FLAG_HAS_VOLUME_DATA;
+			}
+			else
+			{
+				cluster_flags |= EXPORT_HANDLE_CLUSTER_FLAG_HAS_DELTA_DATA;
+			}
+			store_offset += (off64_t) extent_size;
+		}
+		/* A cluster that contains both sparse data and data of the current volume
+		 * cannot be represented by the backing file or a zero cluster
+		 */
+		if( ( ( cluster_flags & EXPORT_HANDLE_CLUSTER_FLAG_HAS_DELTA_DATA ) != 0 )
+		 || ( cluster_flags == ( EXPORT_HANDLE_CLUSTER_FLAG_HAS_SPARSE_DATA | EXPORT_HANDLE_CLUSTER_FLAG_HAS_VOLUME_DATA ) ) )
+		{
+			cluster_type = QCOW2_WRITER_CLUSTER_TYPE_DATA;
+		}
+		else if( cluster_flags == EXPORT_HANDLE_CLUSTER_FLAG_HAS_SPARSE_DATA )
+		{
+			cluster_type = QCOW2_WRITER_CLUSTER_TYPE_ZERO;
+		}
+		else
+		{
+			continue;
+		}
+		if( qcow2_writer_set_cluster_type(
+		     qcow2_writer,
+		     cluster_index,
+		     cluster_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set type of cluster: %" PRIu64 " of store: %d.",
+			 function,
+			 cluster_index,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->abort != 0 )
+	{
+		if( qcow2_writer_free(
+		     &qcow2_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free QCOW2 writer.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( qcow2_writer_allocate(
+	     qcow2_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to allocate clusters of store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     &output_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize output file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     output_file,
+	     export_handle->output_filenames[ store_index ],
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     output_file,
+	     export_handle->output_filenames[ store_index ],
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+		 function,
+		 export_handle->output_filenames[ store_index ] );
+
+		goto on_error;
+	}
+	if( qcow2_writer_write_metadata(
+	     qcow2_writer,
+	     output_file,
+	     "base.raw",
+	     8,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write QCOW2 metadata to output file: %" PRIs_SYSTEM ".",
+		 function,
+		 export_handle->output_filenames[ store_index ] );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     output_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output file: %" PRIs_SYSTEM ".",
+		 function,
+		 export_handle->output_filenames[ store_index ] );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &output_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free output file.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->number_of_bytes_exported += qcow2_writer->file_size;
+
+	/* Only the extents of the clusters that are stored in the image are exported
+	 */
+	for( cluster_index = 0;
+	     cluster_index < number_of_clusters;
+	     cluster_index++ )
+	{
+		result = qcow2_writer_get_cluster_offset(
+		          qcow2_writer,
+		          cluster_index,
+		          &cluster_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset of cluster: %" PRIu64 " of store: %d.",
+			 function,
+			 cluster_index,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		store_offset       = (off64_t) ( cluster_index * QCOW2_WRITER_CLUSTER_SIZE );
+		cluster_end_offset = store_offset + QCOW2_WRITER_CLUSTER_SIZE;
+
+		if( (size64_t) cluster_end_offset > store_size )
+		{
+			cluster_end_offset = (off64_t) store_size;
+		}
+		while( store_offset < cluster_end_offset )
+		{
+			result = libvshadow_store_get_extent_at_offset(
+			          store,
+			          store_offset,
+			          &extent_offset,
+			          &extent_size,
+			          &extent_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent of store: %d at offset: %" PRIi64 ".",
+				 function,
+				 store_index,
+				 store_offset );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			if( extent_size == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid extent of store: %d at offset: %" PRIi64 " - size value out of bounds.",
+				 function,
+				 store_index,
+				 store_offset );
+
+				goto on_error;
+			}
+			if( extent_size > (size64_t) ( cluster_end_offset - store_offset ) )
+			{
+				extent_size = (size64_t) ( cluster_end_offset - store_offset );
+			}
+			/* Sparse ranges of the cluster remain zero
+			 */
+			if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+			{
+				store_offset += (off64_t) extent_size;
+
+				continue;
+			}
+			export_handle->number_of_data_bytes += extent_size;
+
+			while( extent_size > 0 )
+			{
+				block_end_offset = ( ( extent_offset / (off64_t) export_handle->block_size ) + 1 ) * (off64_t) export_handle->block_size;
+
+				segment_size = (size_t) ( block_end_offset - extent_offset );
+
+				if( (size64_t) segment_size > extent_size )
+				{
+					segment_size = (size_t) extent_size;
+				}
+				if( export_handle_append_segment(
+				     export_handle,
+				     store_index,
+				     cluster_offset + ( store_offset % QCOW2_WRITER_CLUSTER_SIZE ),
+				     extent_offset,
+				     segment_size,
+				     maximum_number_of_segments,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append segment of store: %d at offset: %" PRIi64 ".",
+					 function,
+					 store_index,
+					 store_offset );
+
+					goto on_error;
+				}
+				store_offset  += (off64_t) segment_size;
+				extent_offset += (off64_t) segment_size;
+				extent_size   -= (size64_t) segment_size;
+			}
+		}
+	}
+	if( qcow2_writer_free(
+	     &qcow2_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( output_file != NULL )
+	{
+		libcfile_file_free(
+		 &output_file,
+		 NULL );
+	}
+	if( qcow2_writer != NULL )
+	{
+		qcow2_writer_free(
+		 &qcow2_writer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends the segments of the base image
+ * The base image contains the data of the current volume, which is split into
+ * segments at the boundaries of the physical blocks
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_base_segments(
+     export_handle_t *export_handle,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function    = "export_handle_append_base_segments";
+	size64_t volume_size     = 0;
+	size_t segment_size      = 0;
+	off64_t block_end_offset = 0;
+	off64_t volume_offset    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     export_handle->input_volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->number_of_data_bytes += volume_size;
+
+	while( (size64_t) volume_offset < volume_size )
+	{
+		block_end_offset = ( ( volume_offset / (off64_t) export_handle->block_size ) + 1 ) * (off64_t) export_handle->block_size;
+
+		segment_size = (size_t) ( block_end_offset - volume_offset );
+
+		if( (size64_t) segment_size > ( volume_size - (size64_t) volume_offset ) )
+		{
+			segment_size = (size_t) ( volume_size - (size64_t) volume_offset );
+		}
+		if( export_handle_append_segment(
+		     export_handle,
+		     export_handle->number_of_stores,
+		     volume_offset,
+		     volume_offset,
+		     segment_size,
+		     maximum_number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment of base image at offset: %" PRIi64 ".",
+			 function,
+			 volume_offset );
+
+			return( -1 );
+		}
+		volume_offset += (off64_t) segment_size;
+	}
+	return( 1 );
+}
+
+/* Builds the tasks
+ * The segments of the selected stores, and of the base image in QCOW2 output format,
+ * are sorted by physical offset and every physical block that is referenced by a
+ * segment becomes a task, so that data shared by multiple outputs, such as data of
+ * the current volume, is read only once
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_build_tasks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_segment_t *segment         = NULL;
+	export_task_t *task               = NULL;
+	libvshadow_store_t *store         = NULL;
+	static char *function             = "export_handle_build_tasks";
+	size_t maximum_number_of_segments = 0;
+	size_t segment_index              = 0;
+	off64_t segment_end_offset        = 0;
+	int result                        = 0;
+	int store_index                   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->tasks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - tasks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	for( store_index = 0;
+	     store_index < export_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		if( export_handle_store_is_selected(
+		     export_handle,
+		     store_index ) == 0 )
+		{
+			continue;
+		}
+		if( libvshadow_volume_get_store(
+		     export_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 )
+		{
+			result = export_handle_append_qcow2_segments(
+			          export_handle,
+			          store,
+			          store_index,
+			          &maximum_number_of_segments,
+			          error );
+		}
+		else
+		{
+			result = export_handle_append_store_segments(
+			          export_handle,
+			          store,
+			          store_index,
+			          &maximum_number_of_segments,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segments of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	if( ( export_handle->abort == 0 )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 ) )
+	{
+		if( export_handle_append_base_segments(
+		     export_handle,
+		     &maximum_number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segments of base image.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->number_of_segments == 0 )
+	{
+		return( 1 );
+	}
+	qsort(
+	 export_handle->segments,
+	 export_handle->number_of_segments,
+	 sizeof( export_segment_t ),
+	 &export_handle_compare_segments );
+
+	/* The number of tasks cannot exceed the number of segments
+	 */
+	export_handle->tasks = (export_task_t *) memory_allocate(
+	                                          sizeof( export_task_t ) * export_handle->number_of_segments );
+
+	if( export_handle->tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create tasks.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < export_handle->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( export_handle->segments[ segment_index ] );
+
+		if( ( task == NULL )
+		 || ( ( task->physical_offset / (off64_t) export_handle->block_size ) != ( segment->physical_offset / (off64_t) export_handle->block_size ) ) )
+		{
+			if( task != NULL )
+			{
+				export_handle->number_of_bytes_to_read += task->size;
+			}
+			task = &( export_handle->tasks[ export_handle->number_of_tasks ] );
+
+			task->physical_offset     = segment->physical_offset;
+			task->size                = 0;
+			task->first_segment_index = segment_index;
+			task->number_of_segments  = 0;
+
+			export_handle->number_of_tasks += 1;
+		}
+		segment_end_offset = segment->physical_offset + (off64_t) segment->size;
+
+		if( segment_end_offset > ( task->physical_offset + (off64_t) task->size ) )
+		{
+			task->size = (size_t) ( segment_end_offset - task->physical_offset );
+		}
+		task->number_of_segments += 1;
+	}
+	export_handle->number_of_bytes_to_read += task->size;
+
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( export_handle->tasks != NULL )
+	{
+		memory_free(
+		 export_handle->tasks );
+
+		export_handle->tasks = NULL;
+	}
+	if( export_handle->segments != NULL )
+	{
+		memory_free(
+		 export_handle->segments );
+
+		export_handle->segments = NULL;
+	}
+	export_handle->number_of_segments      = 0;
+	export_handle->number_of_tasks         = 0;
+	export_handle->number_of_data_bytes    = 0;
+	export_handle->number_of_bytes_to_read = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the index of the next task of a worker
+ * A worker takes the tasks of its own range in order. When its range is exhausted
+ * the worker steals the last half of the remaining range of the worker with the most
+ * remaining tasks, so that the tasks of every worker remain physically contiguous
+ * Returns 1 if successful, 0 if no more tasks are available or -1 on error
+ */
+int export_handle_get_task(
+     export_handle_t *export_handle,
+     export_worker_t *export_worker,
+     size_t *task_index,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	export_worker_t *victim_worker = NULL;
+	size_t maximum_remaining       = 0;
+	size_t remaining               = 0;
+	size_t steal_size              = 0;
+	size_t stolen_end_task_index   = 0;
+	int worker_index               = 0;
+#endif
+
+	static char *function          = "export_handle_get_task";
+	int result                     = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( task_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     export_worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex of worker: %d.",
+		 function,
+		 export_worker->worker_index );
+
+		return( -1 );
+	}
+#endif
+	if( export_worker->next_task_index < export_worker->end_task_index )
+	{
+		*task_index = export_worker->next_task_index;
+
+		export_worker->next_task_index += 1;
+
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     export_worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex of worker: %d.",
+		 function,
+		 export_worker->worker_index );
+
+		return( -1 );
+	}
+	/* A worker never holds more than one mutex at a time
+	 */
+	while( ( result == 0 )
+	    && ( export_handle->abort == 0 ) )
+	{
+		victim_worker     = NULL;
+		maximum_remaining = 0;
+
+		for( worker_index = 0;
+		     worker_index < export_handle->number_of_workers;
+		     worker_index++ )
+		{
+			if( worker_index == export_worker->worker_index )
+			{
+				continue;
+			}
+			if( libcthreads_mutex_grab(
+			     export_handle->workers[ worker_index ].mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex of worker: %d.",
+				 function,
+				 worker_index );
+
+				return( -1 );
+			}
+			remaining = export_handle->workers[ worker_index ].end_task_index
+			          - export_handle->workers[ worker_index ].next_task_index;
+
+			if( libcthreads_mutex_release(
+			     export_handle->workers[ worker_index ].mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex of worker: %d.",
+				 function,
+				 worker_index );
+
+				return( -1 );
+			}
+			if( remaining > maximum_remaining )
+			{
+				maximum_remaining = remaining;
+				victim_worker     = &( export_handle->workers[ worker_index ] );
+			}
+		}
+		if( victim_worker == NULL )
+		{
+			break;
+		}
+		if( libcthreads_mutex_grab(
+		     victim_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex of worker: %d.",
+			 function,
+			 victim_worker->worker_index );
+
+			return( -1 );
+		}
+		/* The remaining tasks of the victim could have changed since they were counted
+		 */
+		remaining  = victim_worker->end_task_index - victim_worker->next_task_index;
+		steal_size = ( remaining + 1 ) / 2;
+
+		stolen_end_task_index = victim_worker->end_task_index;
+
+		victim_worker->end_task_index -= steal_size;
+
+		if( libcthreads_mutex_release(
+		     victim_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex of worker: %d.",
+			 function,
+			 victim_worker->worker_index );
+
+			return( -1 );
+		}
+		if( steal_size == 0 )
+		{
+			continue;
+		}
+		if( libcthreads_mutex_grab(
+		     export_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex of worker: %d.",
+			 function,
+			 export_worker->worker_index );
+
+			return( -1 );
+		}
+		*task_index = stolen_end_task_index - steal_size;
+
+		export_worker->next_task_index = *task_index + 1;
+		export_worker->end_task_index  = stolen_end_task_index;
+
+		if( libcthreads_mutex_release(
+		     export_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex of worker: %d.",
+			 function,
+			 export_worker->worker_index );
+
+			return( -1 );
+		}
+		export_worker->number_of_steals += 1;
+
+		result = 1;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+}
+
+/* Updates and prints the progress
+ * The progress is printed at most once every progress interval
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_update_progress(
+     export_handle_t *export_handle,
+     uint64_t number_of_data_bytes,
+     uint64_t number_of_bytes_read,
+     uint64_t number_of_bytes_written,
+     libcerror_error_t **error )
+{
+	static char *function     = "export_handle_update_progress";
+	uint64_t bytes_per_second = 0;
+	uint64_t current_time     = 0;
+	uint64_t elapsed_time     = 0;
+	uint64_t percentage       = 100;
+	int result                = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     export_handle->progress_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab progress mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	export_handle->number_of_data_bytes_exported += number_of_data_bytes;
+	export_handle->number_of_bytes_read          += number_of_bytes_read;
+	export_handle->number_of_bytes_written       += number_of_bytes_written;
+
+	if( ( export_handle->print_progress != 0 )
+	 && ( ( current_time - export_handle->last_progress_time ) >= EXPORT_HANDLE_PROGRESS_INTERVAL ) )
+	{
+		export_handle->last_progress_time = current_time;
+
+		elapsed_time = current_time - export_handle->start_time;
+
+		if( elapsed_time > 0 )
+		{
+			bytes_per_second = ( export_handle->number_of_data_bytes_exported / elapsed_time ) * 1000000
+			                 + ( ( export_handle->number_of_data_bytes_exported % elapsed_time ) * 1000000 ) / elapsed_time;
+		}
+		if( export_handle->number_of_data_bytes > 0 )
+		{
+			percentage = ( export_handle->number_of_data_bytes_exported * 100 ) / export_handle->number_of_data_bytes;
+		}
+		fprintf(
+		 export_handle->notify_stream,
+		 "Status: exported %" PRIu64 " of %" PRIu64 " MiB (%" PRIu64 "%%), read %" PRIu64 " MiB, written %" PRIu64 " MiB at %" PRIu64 ".%02" PRIu64 " MiB/s\n",
+		 export_handle->number_of_data_bytes_exported / ( 1024 * 1024 ),
+		 export_handle->number_of_data_bytes / ( 1024 * 1024 ),
+		 percentage,
+		 export_handle->number_of_bytes_read / ( 1024 * 1024 ),
+		 export_handle->number_of_bytes_written / ( 1024 * 1024 ),
+		 bytes_per_second / ( 1024 * 1024 ),
+		 ( ( bytes_per_second % ( 1024 * 1024 ) ) * 100 ) / ( 1024 * 1024 ) );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     export_handle->progress_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release progress mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+/* Writes the data of a segment to the output file of its store
+ * Ranges of EXPORT_HANDLE_ZERO_CHECK_SIZE that only contain zero bytes are not written
+ * and remain sparse. The buffer contains the data of the segment
+ * Returns the number of bytes written if successful or -1 on error
+ */
+ssize_t export_worker_write_segment(
+         export_worker_t *export_worker,
+         const export_segment_t *segment,
+         const uint8_t *buffer,
+         libcerror_error_t **error )
+{
+	libcfile_file_t *output_file   = NULL;
+	export_handle_t *export_handle = NULL;
+	static char *function          = "export_worker_write_segment";
+	size_t buffer_offset           = 0;
+	size_t check_size              = 0;
+	size_t range_offset            = 0;
+	size_t range_size              = 0;
+	ssize_t total_write_count      = 0;
+	ssize_t write_count            = 0;
+	off64_t output_offset          = 0;
+	int is_zero                    = 0;
+
+	if( export_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle = export_worker->export_handle;
+
+	/* Every worker uses its own output files so that seeking and writing
+	 * do not need to be serialized
+	 */
+	if( export_worker->output_files[ segment->output_index ] == NULL )
+	{
+		if( libcfile_file_initialize(
+		     &output_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize output file.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcfile_file_open_wide(
+		     output_file,
+		     export_handle->output_filenames[ segment->output_index ],
+		     LIBCFILE_OPEN_WRITE,
+		     error ) != 1 )
+#else
+		if( libcfile_file_open(
+		     output_file,
+		     export_handle->output_filenames[ segment->output_index ],
+		     LIBCFILE_OPEN_WRITE,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->output_filenames[ segment->output_index ] );
+
+			goto on_error;
+		}
+		export_worker->output_files[ segment->output_index ] = output_file;
+
+		output_file = NULL;
+	}
+	/* Adjacent ranges that contain data are combined into a single write
+	 */
+	while( buffer_offset <= segment->size )
+	{
+		is_zero = 1;
+
+		if( buffer_offset < segment->size )
+		{
+			/* The zero checks are aligned with the store offset
+			 */
+			check_size = EXPORT_HANDLE_ZERO_CHECK_SIZE
+			           - (size_t) ( ( segment->output_offset + (off64_t) buffer_offset ) % EXPORT_HANDLE_ZERO_CHECK_SIZE );
+
+			if( check_size > ( segment->size - buffer_offset ) )
+			{
+				check_size = segment->size - buffer_offset;
+			}
+			if( buffer[ buffer_offset ] != 0 )
+			{
+				is_zero = 0;
+			}
+			else if( ( check_size > 1 )
+			      && ( memory_compare(
+			            &( buffer[ buffer_offset ] ),
+			            &( buffer[ buffer_offset + 1 ] ),
+			            check_size - 1 ) != 0 ) )
+			{
+				is_zero = 0;
+			}
+		}
+		if( is_zero == 0 )
+		{
+			if( range_size == 0 )
+			{
+				range_offset = buffer_offset;
+			}
+			range_size += check_size;
+		}
+		else if( range_size > 0 )
+		{
+			output_offset = segment->output_offset + (off64_t) range_offset;
+
+			if( libcfile_file_seek_offset(
+			     export_worker->output_files[ segment->output_index ],
+			     output_offset,
+			     SEEK_SET,
+			     error ) != output_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " in output file: %d.",
+				 function,
+				 output_offset,
+				 segment->output_index );
+
+				goto on_error;
+			}
+			write_count = libcfile_file_write_buffer(
+			               export_worker->output_files[ segment->output_index ],
+			               &( buffer[ range_offset ] ),
+			               range_size,
+			               error );
+
+			if( write_count != (ssize_t) range_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write %" PRIzu " bytes at offset: %" PRIi64 " to output file: %d.",
+				 function,
+				 range_size,
+				 output_offset,
+				 segment->output_index );
+
+				goto on_error;
+			}
+			total_write_count += write_count;
+
+			range_size = 0;
+		}
+		if( buffer_offset == segment->size )
+		{
+			break;
+		}
+		buffer_offset += check_size;
+	}
+	return( total_write_count );
+
+on_error:
+	if( output_file != NULL )
+	{
+		libcfile_file_free(
+		 &output_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the physical block of a task into the buffer of the worker
+ * Returns 1 if successful or -1 on error
+ */
+int export_worker_read_task(
+     export_worker_t *export_worker,
+     const export_task_t *task,
+     libcerror_error_t **error )
+{
+	static char *function = "export_worker_read_task";
+	ssize_t read_count    = 0;
+
+	if( export_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     export_worker->file_io_handle,
+	     task->physical_offset,
+	     SEEK_SET,
+	     error ) != task->physical_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek physical offset: %" PRIi64 ".",
+		 function,
+		 task->physical_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              export_worker->file_io_handle,
+	              export_worker->buffer,
+	              task->size,
+	              error );
+
+	if( read_count != (ssize_t) task->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read %" PRIzu " bytes at physical offset: %" PRIi64 ".",
+		 function,
+		 task->size,
+		 task->physical_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Exports a segment without copying its data through the worker
+ * The segment is cloned if the file system supports it, otherwise it is
+ * copied within the kernel. A worker stops trying a method once it is not
+ * supported, since this will be the same for the remaining segments
+ * Returns 1 if successful, 0 if the segment needs to be copied or -1 on error
+ */
+int export_worker_zero_copy_segment(
+     export_worker_t *export_worker,
+     const export_segment_t *segment,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	export_handle_t *export_handle = NULL;
+	off64_t source_offset          = 0;
+	int result                     = 0;
+#endif
+	static char *function          = "export_worker_zero_copy_segment";
+
+	if( export_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	export_handle = export_worker->export_handle;
+
+	if( ( export_handle->input_descriptor == -1 )
+	 || ( export_handle->output_descriptors == NULL ) )
+	{
+		return( 0 );
+	}
+	/* The physical offset is relative to the start of the volume
+	 */
+	source_offset = export_handle->volume_offset + segment->physical_offset;
+
+	if( ( export_worker->use_clone_range != 0 )
+	 && ( ( source_offset % ZERO_COPY_CLONE_ALIGNMENT ) == 0 )
+	 && ( ( segment->output_offset % ZERO_COPY_CLONE_ALIGNMENT ) == 0 )
+	 && ( ( segment->size % ZERO_COPY_CLONE_ALIGNMENT ) == 0 ) )
+	{
+		result = zero_copy_clone_range(
+		          export_handle->input_descriptor,
+		          source_offset,
+		          export_handle->output_descriptors[ segment->output_index ],
+		          segment->output_offset,
+		          (size64_t) segment->size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to clone segment of output: %d at offset: %" PRIi64 ".",
+			 function,
+			 segment->output_index,
+			 segment->output_offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			export_worker->number_of_bytes_cloned += segment->size;
+
+			return( 1 );
+		}
+		export_worker->use_clone_range = 0;
+	}
+	if( export_worker->use_copy_range != 0 )
+	{
+		result = zero_copy_copy_range(
+		          export_handle->input_descriptor,
+		          source_offset,
+		          export_handle->output_descriptors[ segment->output_index ],
+		          segment->output_offset,
+		          (size64_t) segment->size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to copy segment of output: %d at offset: %" PRIi64 ".",
+			 function,
+			 segment->output_index,
+			 segment->output_offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			export_worker->number_of_bytes_copied += segment->size;
+
+			return( 1 );
+		}
+		export_worker->use_copy_range = 0;
+	}
+#endif
+	return( 0 );
+}
+
+/* Runs an export worker
+ * Returns 1 if successful or -1 on error
+ */
+int export_worker_run(
+     export_worker_t *export_worker )
+{
+	libcerror_error_t *error       = NULL;
+	export_handle_t *export_handle = NULL;
+	export_segment_t *segment      = NULL;
+	export_task_t *task            = NULL;
+	static char *function          = "export_worker_run";
+	uint64_t number_of_bytes_read  = 0;
+	uint64_t number_of_data_bytes  = 0;
+	size_t segment_index           = 0;
+	size_t task_index              = 0;
+	ssize_t task_write_count       = 0;
+	ssize_t write_count            = 0;
+	int result                     = 0;
+
+	if( export_worker == NULL )
+	{
+		return( -1 );
+	}
+	export_handle = export_worker->export_handle;
+
+	export_worker->result = 1;
+
+	while( export_handle->abort == 0 )
+	{
+		result = export_handle_get_task(
+		          export_handle,
+		          export_worker,
+		          &task_index,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve task.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		task = &( export_handle->tasks[ task_index ] );
+
+		number_of_bytes_read = 0;
+		number_of_data_bytes = 0;
+		task_write_count     = 0;
+
+		for( segment_index = task->first_segment_index;
+		     segment_index < ( task->first_segment_index + task->number_of_segments );
+		     segment_index++ )
+		{
+			segment = &( export_handle->segments[ segment_index ] );
+
+			number_of_data_bytes += segment->size;
+
+			if( export_handle->export_mode == EXPORT_HANDLE_EXPORT_MODE_CLONE )
+			{
+				result = export_worker_zero_copy_segment(
+				          export_worker,
+				          segment,
+				          &error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to clone segment of output: %d at offset: %" PRIi64 ".",
+					 function,
+					 segment->output_index,
+					 segment->output_offset );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					continue;
+				}
+			}
+			/* The physical block is read at most once per task
+			 */
+			if( number_of_bytes_read == 0 )
+			{
+				if( export_worker_read_task(
+				     export_worker,
+				     task,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read task: %" PRIzu ".",
+					 function,
+					 task_index );
+
+					goto on_error;
+				}
+				number_of_bytes_read = (uint64_t) task->size;
+			}
+			write_count = export_worker_write_segment(
+			               export_worker,
+			               segment,
+			               &( export_worker->buffer[ segment->physical_offset - task->physical_offset ] ),
+			               &error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write segment of output: %d at offset: %" PRIi64 ".",
+				 function,
+				 segment->output_index,
+				 segment->output_offset );
+
+				goto on_error;
+			}
+			task_write_count += write_count;
+		}
+		if( export_handle_update_progress(
+		     export_handle,
+		     number_of_data_bytes,
+		     number_of_bytes_read,
+		     (uint64_t) task_write_count,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update progress.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	/* Make sure the other workers stop since the export is incomplete
+	 */
+	export_handle->abort = 1;
+
+	export_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Exports the selected stores
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_run(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_worker_t *export_worker  = NULL;
+	static char *function           = "export_handle_run";
+	uint64_t bytes_per_second       = 0;
+	uint64_t elapsed_time           = 0;
+	uint64_t end_time               = 0;
+	uint64_t number_of_bytes_cloned = 0;
+	uint64_t number_of_bytes_copied = 0;
+	uint64_t number_of_steals       = 0;
+	size_t tasks_per_worker         = 0;
+	int number_of_exported_stores   = 0;
+	int number_of_workers           = 0;
+	int output_index                = 0;
+	int result                      = -1;
+	int store_index                 = 0;
+	int worker_index                = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->workers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - workers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics_get_current_time(
+	     &( export_handle->start_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->last_progress_time = export_handle->start_time;
+
+	if( export_handle_build_tasks(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build tasks.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_workers = export_handle->number_of_threads;
+
+	if( (size_t) number_of_workers > export_handle->number_of_tasks )
+	{
+		number_of_workers = (int) export_handle->number_of_tasks;
+	}
+	if( number_of_workers == 0 )
+	{
+		number_of_workers = 1;
+	}
+	export_handle->workers = (export_worker_t *) memory_allocate(
+	                                              sizeof( export_worker_t ) * number_of_workers );
+
+	if( export_handle->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->workers,
+	     0,
+	     sizeof( export_worker_t ) * number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 export_handle->workers );
+
+		export_handle->workers = NULL;
+
+		goto on_error;
+	}
+	export_handle->number_of_workers = number_of_workers;
+
+	/* Every worker starts with a contiguous range of the tasks, which are sorted by physical offset
+	 */
+	tasks_per_worker = export_handle->number_of_tasks / number_of_workers;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		export_worker = &( export_handle->workers[ worker_index ] );
+
+		export_worker->export_handle   = export_handle;
+		export_worker->worker_index    = worker_index;
+		export_worker->next_task_index = tasks_per_worker * worker_index;
+		export_worker->end_task_index  = tasks_per_worker * ( worker_index + 1 );
+		export_worker->use_clone_range = 1;
+		export_worker->use_copy_range  = 1;
+
+		if( worker_index == ( number_of_workers - 1 ) )
+		{
+			export_worker->end_task_index = export_handle->number_of_tasks;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( export_worker->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+#endif
+		export_worker->buffer = (uint8_t *) memory_allocate(
+		                                     sizeof( uint8_t ) * export_handle->block_size );
+
+		if( export_worker->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		export_worker->output_files = (libcfile_file_t **) memory_allocate(
+		                                                    sizeof( libcfile_file_t * ) * export_handle->number_of_outputs );
+
+		if( export_worker->output_files == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output files of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     export_worker->output_files,
+		     0,
+		     sizeof( libcfile_file_t * ) * export_handle->number_of_outputs ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear output files of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( export_worker->file_io_handle ),
+		     export_handle->input_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     export_worker->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( export_handle->workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &export_worker_run,
+		     (void *) &( export_handle->workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( export_handle->workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#else
+	export_worker_run(
+	 &( export_handle->workers[ 0 ] ) );
+#endif
+	if( read_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		goto on_error;
+	}
+	elapsed_time = end_time - export_handle->start_time;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		export_worker = &( export_handle->workers[ worker_index ] );
+
+		if( export_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		number_of_steals       += export_worker->number_of_steals;
+		number_of_bytes_cloned += export_worker->number_of_bytes_cloned;
+		number_of_bytes_copied += export_worker->number_of_bytes_copied;
+
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( export_worker->output_files[ output_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcfile_file_close(
+			     export_worker->output_files[ output_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output file: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+		}
+	}
+	for( store_index = 0;
+	     store_index < export_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( export_handle_store_is_selected(
+		     export_handle,
+		     store_index ) != 0 )
+		{
+			number_of_exported_stores++;
+		}
+	}
+	result = 1;
+
+	if( elapsed_time > 0 )
+	{
+		bytes_per_second = ( export_handle->number_of_bytes_exported / elapsed_time ) * 1000000
+		                 + ( ( export_handle->number_of_bytes_exported % elapsed_time ) * 1000000 ) / elapsed_time;
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "\nVolume Shadow Snapshot export:\n"
+	 "\tExport mode\t\t: %s\n"
+	 "\tOutput format\t\t: %s\n"
+	 "\tNumber of stores\t: %d\n"
+	 "\tNumber of threads\t: %d\n"
+	 "\tBlock size\t\t: %" PRIzu "\n"
+	 "\tNumber of tasks\t\t: %" PRIzu "\n"
+	 "\tNumber of steals\t: %" PRIu64 "\n"
+	 "\tBytes exported\t\t: %" PRIu64 "\n"
+	 "\tBytes of data\t\t: %" PRIu64 "\n"
+	 "\tBytes read\t\t: %" PRIu64 "\n"
+	 "\tBytes deduplicated\t: %" PRIu64 "\n"
+	 "\tBytes written\t\t: %" PRIu64 "\n"
+	 "\tBytes cloned\t\t: %" PRIu64 "\n"
+	 "\tBytes copied in kernel\t: %" PRIu64 "\n"
+	 "\tElapsed time\t\t: %" PRIu64 " us\n"
+	 "\tThroughput\t\t: %" PRIu64 ".%02" PRIu64 " MiB/s\n"
+	 "\n",
+	 ( export_handle->export_mode == EXPORT_HANDLE_EXPORT_MODE_CLONE ) ? "clone" : "copy",
+	 ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2 ) ? "qcow2" : "raw",
+	 number_of_exported_stores,
+	 number_of_workers,
+	 export_handle->block_size,
+	 export_handle->number_of_tasks,
+	 number_of_steals,
+	 export_handle->number_of_bytes_exported,
+	 export_handle->number_of_data_bytes,
+	 export_handle->number_of_bytes_read,
+	 ( export_handle->number_of_data_bytes > export_handle->number_of_bytes_to_read ) ? export_handle->number_of_data_bytes - export_handle->number_of_bytes_to_read : 0,
+	 export_handle->number_of_bytes_written,
+	 number_of_bytes_cloned,
+	 number_of_bytes_copied,
+	 elapsed_time,
+	 bytes_per_second / ( 1024 * 1024 ),
+	 ( ( bytes_per_second % ( 1024 * 1024 ) ) * 100 ) / ( 1024 * 1024 ) );
+
+on_error:
+	if( export_handle->workers != NULL )
+	{
+		if( result != 1 )
+		{
+			/* Make sure the workers that were started stop before their resources are freed
+			 */
+			export_handle->abort = 1;
+		}
+		for( worker_index = 0;
+		     worker_index < export_handle->number_of_workers;
+		     worker_index++ )
+		{
+			export_worker = &( export_handle->workers[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( export_worker->thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( export_worker->thread ),
+				 NULL );
+			}
+			if( export_worker->mutex != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( export_worker->mutex ),
+				 NULL );
+			}
+#endif
+			if( export_worker->output_files != NULL )
+			{
+				for( output_index = 0;
+				     output_index < export_handle->number_of_outputs;
+				     output_index++ )
+				{
+					if( export_worker->output_files[ output_index ] != NULL )
+					{
+						libcfile_file_free(
+						 &( export_worker->output_files[ output_index ] ),
+						 NULL );
+					}
+				}
+				memory_free(
+				 export_worker->output_files );
+			}
+			if( export_worker->file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &( export_worker->file_io_handle ),
+				 NULL );
+			}
+			if( export_worker->buffer != NULL )
+			{
+				memory_free(
+				 export_worker->buffer );
+			}
+		}
+		memory_free(
+		 export_handle->workers );
+
+		export_handle->workers           = NULL;
+		export_handle->number_of_workers = 0;
+	}
+	return( result );
+}
+
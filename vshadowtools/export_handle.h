@@ -0,0 +1,476 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+#include "zero_copy.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define EXPORT_HANDLE_DEFAULT_BLOCK_SIZE		( 1024 * 1024 )
+#define EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS		4
+#define EXPORT_HANDLE_MAXIMUM_BLOCK_SIZE		( 64 * 1024 * 1024 )
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES		512
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
+/* The size of the ranges that are checked for zero bytes before they are written
+ */
+#define EXPORT_HANDLE_ZERO_CHECK_SIZE			4096
+
+/* The minimum time between progress updates in microseconds
+ */
+#define EXPORT_HANDLE_PROGRESS_INTERVAL			1000000
+
+enum EXPORT_HANDLE_EXPORT_MODES
+{
+	EXPORT_HANDLE_EXPORT_MODE_CLONE			= (int) 'l',
+	EXPORT_HANDLE_EXPORT_MODE_COPY			= (int) 'c'
+};
+
+enum EXPORT_HANDLE_OUTPUT_FORMATS
+{
+	EXPORT_HANDLE_OUTPUT_FORMAT_QCOW2		= (int) 'q',
+	EXPORT_HANDLE_OUTPUT_FORMAT_RAW			= (int) 'r'
+};
+
+/* The flags of the data that a cluster of a QCOW2 image contains
+ */
+enum EXPORT_HANDLE_CLUSTER_FLAGS
+{
+	EXPORT_HANDLE_CLUSTER_FLAG_HAS_SPARSE_DATA	= 0x01,
+	EXPORT_HANDLE_CLUSTER_FLAG_HAS_VOLUME_DATA	= 0x02,
+	EXPORT_HANDLE_CLUSTER_FLAG_HAS_DELTA_DATA	= 0x04
+};
+
+typedef struct export_segment export_segment_t;
+
+/* A segment is a range of store data that is stored contiguously
+ * within a single physical block of the volume and within its output file
+ */
+struct export_segment
+{
+	/* The physical offset relative to the start of the volume
+	 */
+	off64_t physical_offset;
+
+	/* The offset relative to the start of the output file
+	 */
+	off64_t output_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The output index, the store index or the number of stores for the base image
+	 */
+	int output_index;
+};
+
+typedef struct export_task export_task_t;
+
+/* A task reads a physical block once and writes it to every segment that references it
+ */
+struct export_task
+{
+	/* The physical offset relative to the start of the volume
+	 */
+	off64_t physical_offset;
+
+	/* The number of bytes read
+	 */
+	size_t size;
+
+	/* The index of the first segment
+	 */
+	size_t first_segment_index;
+
+	/* The number of segments
+	 */
+	size_t number_of_segments;
+};
+
+typedef struct export_handle export_handle_t;
+
+typedef struct export_worker export_worker_t;
+
+struct export_worker
+{
+	/* The export handle
+	 */
+	export_handle_t *export_handle;
+
+	/* The worker index
+	 */
+	int worker_index;
+
+	/* The index of the next task
+	 */
+	size_t next_task_index;
+
+	/* The index of the task after the last task
+	 */
+	size_t end_task_index;
+
+	/* The libbfio file IO handle used by the worker
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The output files, per output
+	 */
+	libcfile_file_t **output_files;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The number of tasks stolen from other workers
+	 */
+	uint64_t number_of_steals;
+
+	/* Value to indicate ranges can be cloned
+	 */
+	uint8_t use_clone_range;
+
+	/* Value to indicate ranges can be copied within the kernel
+	 */
+	uint8_t use_copy_range;
+
+	/* The number of bytes cloned
+	 */
+	uint64_t number_of_bytes_cloned;
+
+	/* The number of bytes copied within the kernel
+	 */
+	uint64_t number_of_bytes_copied;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 * protects the next and end task index
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+};
+
+struct export_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The physical block size
+	 */
+	size_t block_size;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* Value to indicate stores were selected
+	 */
+	uint8_t has_selected_stores;
+
+	/* The selected stores, a bit per store
+	 */
+	uint8_t selected_stores[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ];
+
+	/* Value to indicate progress should be reported
+	 */
+	uint8_t print_progress;
+
+	/* The export mode
+	 */
+	int export_mode;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The number of outputs, the number of stores and the base image in QCOW2 output format
+	 */
+	int number_of_outputs;
+
+	/* The output filenames, per output
+	 */
+	system_character_t **output_filenames;
+
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+	/* The input file descriptor, used to clone data
+	 */
+	int input_descriptor;
+
+	/* The output file descriptors, per output, used to clone data
+	 */
+	int *output_descriptors;
+#endif
+
+	/* The segments
+	 */
+	export_segment_t *segments;
+
+	/* The number of segments
+	 */
+	size_t number_of_segments;
+
+	/* The tasks
+	 */
+	export_task_t *tasks;
+
+	/* The number of tasks
+	 */
+	size_t number_of_tasks;
+
+	/* The workers
+	 */
+	export_worker_t *workers;
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The number of bytes exported, the sum of the sizes of the output files
+	 */
+	uint64_t number_of_bytes_exported;
+
+	/* The number of bytes of store data that is not sparse
+	 */
+	uint64_t number_of_data_bytes;
+
+	/* The number of bytes to read from the volume
+	 */
+	uint64_t number_of_bytes_to_read;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The progress mutex
+	 * protects the progress values
+	 */
+	libcthreads_mutex_t *progress_mutex;
+#endif
+
+	/* The number of bytes of store data that was exported
+	 */
+	uint64_t number_of_data_bytes_exported;
+
+	/* The number of bytes read from the volume
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of bytes written
+	 */
+	uint64_t number_of_bytes_written;
+
+	/* The time the export started in microseconds
+	 */
+	uint64_t start_time;
+
+	/* The time the last progress was reported in microseconds
+	 */
+	uint64_t last_progress_time;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_block_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_selected_stores(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_export_mode(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_output_format(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_print_progress(
+     export_handle_t *export_handle,
+     uint8_t print_progress,
+     libcerror_error_t **error );
+
+int export_handle_store_is_selected(
+     export_handle_t *export_handle,
+     int store_index );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int export_handle_append_segment(
+     export_handle_t *export_handle,
+     int output_index,
+     off64_t output_offset,
+     off64_t physical_offset,
+     size_t size,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error );
+
+int export_handle_compare_segments(
+     const void *first_segment,
+     const void *second_segment );
+
+int export_handle_append_store_segments(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error );
+
+int export_handle_append_qcow2_segments(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error );
+
+int export_handle_append_base_segments(
+     export_handle_t *export_handle,
+     size_t *maximum_number_of_segments,
+     libcerror_error_t **error );
+
+int export_handle_build_tasks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_get_task(
+     export_handle_t *export_handle,
+     export_worker_t *export_worker,
+     size_t *task_index,
+     libcerror_error_t **error );
+
+int export_handle_update_progress(
+     export_handle_t *export_handle,
+     uint64_t number_of_data_bytes,
+     uint64_t number_of_bytes_read,
+     uint64_t number_of_bytes_written,
+     libcerror_error_t **error );
+
+ssize_t export_worker_write_segment(
+         export_worker_t *export_worker,
+         const export_segment_t *segment,
+         const uint8_t *buffer,
+         libcerror_error_t **error );
+
+int export_worker_read_task(
+     export_worker_t *export_worker,
+     const export_task_t *task,
+     libcerror_error_t **error );
+
+int export_worker_zero_copy_segment(
+     export_worker_t *export_worker,
+     const export_segment_t *segment,
+     libcerror_error_t **error );
+
+int export_worker_run(
+     export_worker_t *export_worker );
+
+int export_handle_run(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
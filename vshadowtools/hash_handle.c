@@ -0,0 +1,2786 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "block_digest.h"
+#include "hash_handle.h"
+#include "read_statistics.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+extern \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define HASH_HANDLE_OUTPUT_STREAM		stdout
+#define HASH_HANDLE_NOTIFY_STREAM		stderr
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                  hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *hash_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *hash_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *hash_handle )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->number_of_threads = HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+#else
+	( *hash_handle )->number_of_threads = 1;
+#endif
+	( *hash_handle )->digest_type   = BLOCK_DIGEST_TYPE_SHA256;
+	( *hash_handle )->digest_size   = BLOCK_DIGEST_SHA256_SIZE;
+	( *hash_handle )->print_summary = 1;
+	( *hash_handle )->output_stream = HASH_HANDLE_OUTPUT_STREAM;
+	( *hash_handle )->notify_stream = HASH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->input_volume != NULL )
+		{
+			libvshadow_volume_free(
+			 &( ( *hash_handle )->input_volume ),
+			 NULL );
+		}
+		if( ( *hash_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *hash_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->stores != NULL )
+		{
+			for( store_index = 0;
+			     store_index < ( *hash_handle )->number_of_stores;
+			     store_index++ )
+			{
+				if( ( *hash_handle )->stores[ store_index ] != NULL )
+				{
+					libvshadow_store_free(
+					 &( ( *hash_handle )->stores[ store_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *hash_handle )->stores );
+		}
+		if( ( *hash_handle )->digests != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->digests );
+		}
+		if( ( *hash_handle )->sources != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->sources );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *hash_handle )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libvshadow_volume_free(
+		     &( ( *hash_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *hash_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_signal_abort";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( hash_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     hash_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multiple threads not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	hash_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the selected stores
+ * The string contains comma separated store numbers or ranges of store numbers,
+ * such as 1,3-5, or all
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_selected_stores(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	uint8_t selected_stores[ HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ];
+
+	static char *function       = "hash_handle_set_selected_stores";
+	size_t string_index         = 0;
+	size_t string_length        = 0;
+	uint64_t first_store_number = 0;
+	uint64_t store_number       = 0;
+	int in_range                = 0;
+	int number_of_digits        = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		hash_handle->has_selected_stores = 0;
+
+		return( 1 );
+	}
+	if( memory_set(
+	     selected_stores,
+	     0,
+	     sizeof( uint8_t ) * ( HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear selected stores.",
+		 function );
+
+		return( -1 );
+	}
+	/* The terminating end-of-string character is handled as a separator
+	 */
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			if( number_of_digits >= 3 )
+			{
+				break;
+			}
+			store_number *= 10;
+			store_number += (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+			number_of_digits++;
+
+			continue;
+		}
+		if( ( number_of_digits == 0 )
+		 || ( store_number == 0 )
+		 || ( store_number > HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+		{
+			break;
+		}
+		if( string[ string_index ] == (system_character_t) '-' )
+		{
+			if( in_range != 0 )
+			{
+				break;
+			}
+			first_store_number = store_number;
+			in_range           = 1;
+		}
+		else if( ( string[ string_index ] == (system_character_t) ',' )
+		      || ( string[ string_index ] == 0 ) )
+		{
+			if( in_range == 0 )
+			{
+				first_store_number = store_number;
+			}
+			else if( first_store_number > store_number )
+			{
+				break;
+			}
+			while( first_store_number <= store_number )
+			{
+				selected_stores[ ( first_store_number - 1 ) / 8 ] |= (uint8_t) ( 1 << ( ( first_store_number - 1 ) % 8 ) );
+
+				first_store_number++;
+			}
+			in_range = 0;
+		}
+		else
+		{
+			break;
+		}
+		store_number     = 0;
+		number_of_digits = 0;
+	}
+	if( string_index <= string_length )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported stores at index: %" PRIzd ".",
+		 function,
+		 string_index );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     hash_handle->selected_stores,
+	     selected_stores,
+	     sizeof( uint8_t ) * ( HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy selected stores.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->has_selected_stores = 1;
+
+	return( 1 );
+}
+
+/* Sets the digest type
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_digest_type(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_digest_type";
+	size_t string_length  = 0;
+	int digest_type       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 6 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "sha256" ),
+	       6 ) == 0 ) )
+	{
+		digest_type = BLOCK_DIGEST_TYPE_SHA256;
+	}
+	else if( ( string_length == 5 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "xxh64" ),
+	            5 ) == 0 ) )
+	{
+		digest_type = BLOCK_DIGEST_TYPE_XXH64;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_digest_get_size(
+	     digest_type,
+	     &( hash_handle->digest_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve digest size.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->digest_type = digest_type;
+
+	return( 1 );
+}
+
+/* Sets if the summary should be printed
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_print_summary(
+     hash_handle_t *hash_handle,
+     uint8_t print_summary,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_print_summary";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->print_summary = print_summary;
+
+	return( 1 );
+}
+
+/* Determines if a store is selected to be exported
+ * Returns 1 if selected or 0 if not
+ */
+int hash_handle_store_is_selected(
+     hash_handle_t *hash_handle,
+     int store_index )
+{
+	if( ( hash_handle == NULL )
+	 || ( store_index < 0 )
+	 || ( store_index >= HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+	{
+		return( 0 );
+	}
+	if( hash_handle->has_selected_stores == 0 )
+	{
+		return( 1 );
+	}
+	if( ( hash_handle->selected_stores[ store_index / 8 ] & ( 1 << ( store_index % 8 ) ) ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Opens the hash handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "hash_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+	int store_index        = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     hash_handle->input_file_io_handle,
+	     hash_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          hash_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvshadow_volume_open_file_io_handle(
+	     hash_handle->input_volume,
+	     hash_handle->input_file_io_handle,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     hash_handle->input_volume,
+	     &( hash_handle->number_of_stores ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( hash_handle->number_of_stores < 0 )
+	 || ( hash_handle->number_of_stores > HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stores value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure a selected store exists
+	 */
+	for( store_index = hash_handle->number_of_stores;
+	     store_index < HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES;
+	     store_index++ )
+	{
+		if( ( hash_handle->has_selected_stores != 0 )
+		 && ( hash_handle_store_is_selected(
+		       hash_handle,
+		       store_index ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid selected store: %d value out of bounds, the volume has %d stores.",
+			 function,
+			 store_index + 1,
+			 hash_handle->number_of_stores );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	libvshadow_volume_close(
+	 hash_handle->input_volume,
+	 NULL );
+
+	hash_handle->number_of_stores = 0;
+
+	return( -1 );
+}
+
+/* Closes the hash handle
+ * The stores are freed before the input volume is closed
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close_input(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close_input";
+	int store_index       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->stores != NULL )
+	{
+		for( store_index = 0;
+		     store_index < hash_handle->number_of_stores;
+		     store_index++ )
+		{
+			if( hash_handle->stores[ store_index ] == NULL )
+			{
+				continue;
+			}
+			if( libvshadow_store_free(
+			     &( hash_handle->stores[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store: %d.",
+				 function,
+				 store_index );
+
+				return( -1 );
+			}
+		}
+		memory_free(
+		 hash_handle->stores );
+
+		hash_handle->stores = NULL;
+	}
+	if( libvshadow_volume_close(
+	     hash_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Compares two sources by store index, offset and size
+ * The sources of the volume sort before the sources of the stores by physical offset
+ * Returns -1 if the first source sorts before, 1 if after or 0 if equal
+ */
+int hash_handle_compare_sources(
+     const void *first_source,
+     const void *second_source )
+{
+	const hash_source_t *first  = (const hash_source_t *) first_source;
+	const hash_source_t *second = (const hash_source_t *) second_source;
+
+	if( first->store_index != second->store_index )
+	{
+		return( ( first->store_index < second->store_index ) ? -1 : 1 );
+	}
+	if( first->offset != second->offset )
+	{
+		return( ( first->offset < second->offset ) ? -1 : 1 );
+	}
+	if( first->size != second->size )
+	{
+		return( ( first->size < second->size ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the source of a block of a store
+ * The extents of the block determine if the block is sparse, is contained in
+ * a single contiguous range of the volume or needs to be read from the store
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_get_block_source(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     off64_t block_offset,
+     size_t block_size,
+     hash_source_t *source,
+     libcerror_error_t **error )
+{
+	static char *function    = "hash_handle_get_block_source";
+	size64_t extent_size     = 0;
+	off64_t block_end_offset = 0;
+	off64_t extent_offset    = 0;
+	off64_t physical_offset  = 0;
+	off64_t store_offset     = 0;
+	uint32_t extent_flags    = 0;
+	int result               = 0;
+	int source_store_index   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) HASH_HANDLE_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	block_end_offset = block_offset + (off64_t) block_size;
+	store_offset     = block_offset;
+
+	while( store_offset < block_end_offset )
+	{
+		result = libvshadow_store_get_extent_at_offset(
+		          store,
+		          store_offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent of store: %d at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 store_offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			source_store_index = store_index;
+
+			break;
+		}
+		if( extent_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent of store: %d at offset: %" PRIi64 " - size value out of bounds.",
+			 function,
+			 store_index,
+			 store_offset );
+
+			return( -1 );
+		}
+		if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			if( store_offset == block_offset )
+			{
+				source_store_index = HASH_HANDLE_SOURCE_INDEX_ZERO;
+			}
+			else if( source_store_index != HASH_HANDLE_SOURCE_INDEX_ZERO )
+			{
+				source_store_index = store_index;
+
+				break;
+			}
+		}
+		else if( store_offset == block_offset )
+		{
+			source_store_index = HASH_HANDLE_SOURCE_INDEX_VOLUME;
+			physical_offset    = extent_offset;
+		}
+		else if( ( source_store_index != HASH_HANDLE_SOURCE_INDEX_VOLUME )
+		      || ( extent_offset != ( physical_offset + ( store_offset - block_offset ) ) ) )
+		{
+			source_store_index = store_index;
+
+			break;
+		}
+		store_offset += (off64_t) extent_size;
+	}
+	source->size        = (uint32_t) block_size;
+	source->store_index = source_store_index;
+
+	if( source_store_index == HASH_HANDLE_SOURCE_INDEX_ZERO )
+	{
+		source->offset = 0;
+	}
+	else if( source_store_index == HASH_HANDLE_SOURCE_INDEX_VOLUME )
+	{
+		source->offset = physical_offset;
+	}
+	else
+	{
+		source->offset = block_offset;
+	}
+	return( 1 );
+}
+
+/* Retrieves the unique sources of the blocks of a store
+ * The sources are sorted
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_get_store_sources(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     hash_source_t **store_sources,
+     size_t *number_of_store_sources,
+     libcerror_error_t **error )
+{
+	hash_source_t *sources           = NULL;
+	static char *function            = "hash_handle_get_store_sources";
+	size64_t store_size              = 0;
+	size_t block_size                = 0;
+	size_t maximum_number_of_sources = 0;
+	size_t number_of_sources         = 0;
+	size_t source_index              = 0;
+	off64_t block_offset             = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of store sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of store: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	maximum_number_of_sources = (size_t) ( ( store_size + HASH_HANDLE_BLOCK_SIZE - 1 ) / HASH_HANDLE_BLOCK_SIZE );
+
+	if( maximum_number_of_sources > (size_t) ( SSIZE_MAX / sizeof( hash_source_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of sources value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_number_of_sources > 0 )
+	{
+		sources = (hash_source_t *) memory_allocate(
+		                             sizeof( hash_source_t ) * maximum_number_of_sources );
+
+		if( sources == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sources.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( (size64_t) block_offset < store_size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		block_size = HASH_HANDLE_BLOCK_SIZE;
+
+		if( (size64_t) block_size > ( store_size - (size64_t) block_offset ) )
+		{
+			block_size = (size_t) ( store_size - (size64_t) block_offset );
+		}
+		if( hash_handle_get_block_source(
+		     hash_handle,
+		     store,
+		     store_index,
+		     block_offset,
+		     block_size,
+		     &( sources[ number_of_sources ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source of store: %d block at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 block_offset );
+
+			goto on_error;
+		}
+		hash_handle->number_of_blocks           += 1;
+		hash_handle->number_of_bytes_referenced += block_size;
+
+		number_of_sources++;
+
+		block_offset += (off64_t) block_size;
+	}
+	if( number_of_sources > 1 )
+	{
+		qsort(
+		 sources,
+		 number_of_sources,
+		 sizeof( hash_source_t ),
+		 &hash_handle_compare_sources );
+
+		/* Remove the duplicate sources, which are adjacent after sorting
+		 */
+		maximum_number_of_sources = number_of_sources;
+		number_of_sources         = 1;
+
+		for( source_index = 1;
+		     source_index < maximum_number_of_sources;
+		     source_index++ )
+		{
+			if( hash_handle_compare_sources(
+			     &( sources[ number_of_sources - 1 ] ),
+			     &( sources[ source_index ] ) ) != 0 )
+			{
+				sources[ number_of_sources++ ] = sources[ source_index ];
+			}
+		}
+	}
+	*store_sources           = sources;
+	*number_of_store_sources = number_of_sources;
+
+	return( 1 );
+
+on_error:
+	if( sources != NULL )
+	{
+		memory_free(
+		 sources );
+	}
+	return( -1 );
+}
+
+/* Merges the sorted unique sources of a store into the sources
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_merge_sources(
+     hash_handle_t *hash_handle,
+     hash_source_t *store_sources,
+     size_t number_of_store_sources,
+     libcerror_error_t **error )
+{
+	hash_source_t *sources    = NULL;
+	static char *function     = "hash_handle_merge_sources";
+	size_t number_of_sources  = 0;
+	size_t source_index       = 0;
+	size_t store_source_index = 0;
+	int result                = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_sources == 0 )
+	{
+		return( 1 );
+	}
+	if( store_sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_sources > ( (size_t) ( SSIZE_MAX / sizeof( hash_source_t ) ) - hash_handle->number_of_sources ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of sources value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	sources = (hash_source_t *) memory_allocate(
+	                             sizeof( hash_source_t ) * ( hash_handle->number_of_sources + number_of_store_sources ) );
+
+	if( sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sources.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( source_index < hash_handle->number_of_sources )
+	    || ( store_source_index < number_of_store_sources ) )
+	{
+		if( source_index >= hash_handle->number_of_sources )
+		{
+			result = 1;
+		}
+		else if( store_source_index >= number_of_store_sources )
+		{
+			result = -1;
+		}
+		else
+		{
+			result = hash_handle_compare_sources(
+			          &( hash_handle->sources[ source_index ] ),
+			          &( store_sources[ store_source_index ] ) );
+		}
+		if( result <= 0 )
+		{
+			sources[ number_of_sources++ ] = hash_handle->sources[ source_index++ ];
+
+			/* A source that is shared with a previous store is only added once
+			 */
+			if( result == 0 )
+			{
+				store_source_index++;
+			}
+		}
+		else
+		{
+			sources[ number_of_sources++ ] = store_sources[ store_source_index++ ];
+		}
+	}
+	if( hash_handle->sources != NULL )
+	{
+		memory_free(
+		 hash_handle->sources );
+	}
+	hash_handle->sources           = sources;
+	hash_handle->number_of_sources = number_of_sources;
+
+	return( 1 );
+}
+
+/* Builds the unique sources of the blocks of the selected stores
+ * The sources of a store are collected, sorted and merged into the sources so that
+ * a block that is shared by multiple stores is only hashed once
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_build_sources(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	hash_source_t *store_sources   = NULL;
+	static char *function          = "hash_handle_build_sources";
+	size_t number_of_store_sources = 0;
+	size_t source_index            = 0;
+	int store_index                = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->stores != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - stores value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->number_of_stores == 0 )
+	{
+		return( 1 );
+	}
+	hash_handle->stores = (libvshadow_store_t **) memory_allocate(
+	                                               sizeof( libvshadow_store_t * ) * hash_handle->number_of_stores );
+
+	if( hash_handle->stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->stores,
+	     0,
+	     sizeof( libvshadow_store_t * ) * hash_handle->number_of_stores ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stores.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < hash_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		if( hash_handle_store_is_selected(
+		     hash_handle,
+		     store_index ) == 0 )
+		{
+			continue;
+		}
+		if( libvshadow_volume_get_store(
+		     hash_handle->input_volume,
+		     store_index,
+		     &( hash_handle->stores[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( hash_handle_get_store_sources(
+		     hash_handle,
+		     hash_handle->stores[ store_index ],
+		     store_index,
+		     &store_sources,
+		     &number_of_store_sources,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sources of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( hash_handle_merge_sources(
+		     hash_handle,
+		     store_sources,
+		     number_of_store_sources,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to merge sources of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( store_sources != NULL )
+		{
+			memory_free(
+			 store_sources );
+
+			store_sources = NULL;
+		}
+	}
+	for( source_index = 0;
+	     source_index < hash_handle->number_of_sources;
+	     source_index++ )
+	{
+		hash_handle->number_of_bytes_hashed += hash_handle->sources[ source_index ].size;
+	}
+	if( hash_handle->number_of_sources > 0 )
+	{
+		if( hash_handle->number_of_sources > (size_t) ( SSIZE_MAX / hash_handle->digest_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of sources value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		hash_handle->digests = (uint8_t *) memory_allocate(
+		                                    hash_handle->digest_size * hash_handle->number_of_sources );
+
+		if( hash_handle->digests == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create digests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( store_sources != NULL )
+	{
+		memory_free(
+		 store_sources );
+	}
+	if( hash_handle->sources != NULL )
+	{
+		memory_free(
+		 hash_handle->sources );
+
+		hash_handle->sources = NULL;
+	}
+	hash_handle->number_of_sources          = 0;
+	hash_handle->number_of_blocks           = 0;
+	hash_handle->number_of_bytes_referenced = 0;
+	hash_handle->number_of_bytes_hashed     = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the next batch of sources to hash
+ * The sources are handed out in sorted order so that the volume is read mostly sequentially
+ * Returns 1 if successful, 0 if no more sources are available or -1 on error
+ */
+int hash_handle_get_source_batch(
+     hash_handle_t *hash_handle,
+     size_t *source_index,
+     size_t *number_of_sources,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_get_source_batch";
+	size_t batch_size     = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sources.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     hash_handle->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	batch_size = hash_handle->number_of_sources - hash_handle->next_source_index;
+
+	if( batch_size > HASH_HANDLE_SOURCES_PER_BATCH )
+	{
+		batch_size = HASH_HANDLE_SOURCES_PER_BATCH;
+	}
+	*source_index      = hash_handle->next_source_index;
+	*number_of_sources = batch_size;
+
+	hash_handle->next_source_index += batch_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     hash_handle->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( batch_size == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the digest of a source
+ * The digest references the digests of the hash handle and is valid until the hash handle is freed
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int hash_handle_get_source_digest(
+     hash_handle_t *hash_handle,
+     const hash_source_t *source,
+     const uint8_t **digest,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_get_source_digest";
+	size_t first_index    = 0;
+	size_t last_index     = 0;
+	size_t source_index   = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->digests == NULL )
+	{
+		return( 0 );
+	}
+	/* The sources are sorted and unique
+	 */
+	last_index = hash_handle->number_of_sources;
+
+	while( first_index < last_index )
+	{
+		source_index = first_index + ( ( last_index - first_index ) / 2 );
+
+		result = hash_handle_compare_sources(
+		          &( hash_handle->sources[ source_index ] ),
+		          source );
+
+		if( result == 0 )
+		{
+			*digest = &( hash_handle->digests[ source_index * hash_handle->digest_size ] );
+
+			return( 1 );
+		}
+		else if( result < 0 )
+		{
+			first_index = source_index + 1;
+		}
+		else
+		{
+			last_index = source_index;
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the digest of a block of a store
+ * The digest references the digests of the hash handle and is valid until the hash handle is freed
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int hash_handle_get_block_digest(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     off64_t block_offset,
+     const uint8_t **digest,
+     libcerror_error_t **error )
+{
+	hash_source_t source;
+
+	static char *function = "hash_handle_get_block_digest";
+	size64_t store_size   = 0;
+	size_t block_size     = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_offset < 0 )
+	 || ( ( block_offset % HASH_HANDLE_BLOCK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( (size64_t) block_offset >= store_size )
+	{
+		return( 0 );
+	}
+	block_size = HASH_HANDLE_BLOCK_SIZE;
+
+	if( (size64_t) block_size > ( store_size - (size64_t) block_offset ) )
+	{
+		block_size = (size_t) ( store_size - (size64_t) block_offset );
+	}
+	if( hash_handle_get_block_source(
+	     hash_handle,
+	     store,
+	     store_index,
+	     block_offset,
+	     block_size,
+	     &source,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source of store: %d block at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 block_offset );
+
+		return( -1 );
+	}
+	result = hash_handle_get_source_digest(
+	          hash_handle,
+	          &source,
+	          digest,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve digest of store: %d block at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 block_offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads the data of a source into the buffer of the worker
+ * Returns 1 if successful or -1 on error
+ */
+int hash_worker_read_source(
+     hash_worker_t *hash_worker,
+     const hash_source_t *source,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_worker_read_source";
+	ssize_t read_count    = 0;
+
+	if( hash_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( source->size > HASH_HANDLE_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source - size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( source->store_index == HASH_HANDLE_SOURCE_INDEX_ZERO )
+	{
+		if( memory_set(
+		     hash_worker->buffer,
+		     0,
+		     (size_t) source->size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( source->store_index == HASH_HANDLE_SOURCE_INDEX_VOLUME )
+	{
+		if( libbfio_handle_seek_offset(
+		     hash_worker->file_io_handle,
+		     source->offset,
+		     SEEK_SET,
+		     error ) != source->offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek physical offset: %" PRIi64 ".",
+			 function,
+			 source->offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              hash_worker->file_io_handle,
+		              hash_worker->buffer,
+		              (size_t) source->size,
+		              error );
+	}
+	else
+	{
+		if( ( source->store_index < 0 )
+		 || ( source->store_index >= hash_worker->hash_handle->number_of_stores )
+		 || ( hash_worker->hash_handle->stores[ source->store_index ] == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing store: %d.",
+			 function,
+			 source->store_index );
+
+			return( -1 );
+		}
+		/* The store is shared by the workers and read using the file IO handle of the worker
+		 */
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              hash_worker->hash_handle->stores[ source->store_index ],
+		              hash_worker->file_io_handle,
+		              hash_worker->buffer,
+		              (size_t) source->size,
+		              source->offset,
+		              error );
+	}
+	if( read_count != (ssize_t) source->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read %" PRIu32 " bytes of source: %d at offset: %" PRIi64 ".",
+		 function,
+		 source->size,
+		 source->store_index,
+		 source->offset );
+
+		return( -1 );
+	}
+	hash_worker->number_of_bytes_read += source->size;
+
+	return( 1 );
+}
+
+/* Hashes batches of sources until no more sources are available
+ * Returns 1 if successful or -1 on error
+ */
+int hash_worker_run(
+     hash_worker_t *hash_worker )
+{
+	libcerror_error_t *error   = NULL;
+	hash_handle_t *hash_handle = NULL;
+	hash_source_t *source      = NULL;
+	static char *function      = "hash_worker_run";
+	size_t number_of_sources   = 0;
+	size_t source_index        = 0;
+	int result                 = 0;
+
+	if( hash_worker == NULL )
+	{
+		return( -1 );
+	}
+	hash_handle = hash_worker->hash_handle;
+
+	hash_worker->result = 1;
+
+	while( hash_handle->abort == 0 )
+	{
+		result = hash_handle_get_source_batch(
+		          hash_handle,
+		          &source_index,
+		          &number_of_sources,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve batch of sources.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		while( number_of_sources > 0 )
+		{
+			if( hash_handle->abort != 0 )
+			{
+				break;
+			}
+			source = &( hash_handle->sources[ source_index ] );
+
+			if( hash_worker_read_source(
+			     hash_worker,
+			     source,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read source: %" PRIzu ".",
+				 function,
+				 source_index );
+
+				goto on_error;
+			}
+			if( block_digest_calculate(
+			     hash_handle->digest_type,
+			     hash_worker->buffer,
+			     (size_t) source->size,
+			     &( hash_handle->digests[ source_index * hash_handle->digest_size ] ),
+			     hash_handle->digest_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate digest of source: %" PRIzu ".",
+				 function,
+				 source_index );
+
+				goto on_error;
+			}
+			source_index++;
+			number_of_sources--;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	/* Make sure the other workers stop since the digests are incomplete
+	 */
+	hash_handle->abort = 1;
+
+	hash_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Hashes the sources using the workers
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_sources(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	hash_worker_t *hash_worker = NULL;
+	static char *function      = "hash_handle_hash_sources";
+	int number_of_workers      = 0;
+	int result                 = -1;
+	int worker_index           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->workers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - workers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_workers = hash_handle->number_of_threads;
+
+	if( (size_t) number_of_workers > hash_handle->number_of_sources )
+	{
+		number_of_workers = (int) hash_handle->number_of_sources;
+	}
+	if( number_of_workers == 0 )
+	{
+		return( 1 );
+	}
+	hash_handle->workers = (hash_worker_t *) memory_allocate(
+	                                          sizeof( hash_worker_t ) * number_of_workers );
+
+	if( hash_handle->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->workers,
+	     0,
+	     sizeof( hash_worker_t ) * number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 hash_handle->workers );
+
+		hash_handle->workers = NULL;
+
+		goto on_error;
+	}
+	hash_handle->number_of_workers = number_of_workers;
+	hash_handle->next_source_index = 0;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		hash_worker = &( hash_handle->workers[ worker_index ] );
+
+		hash_worker->hash_handle  = hash_handle;
+		hash_worker->worker_index = worker_index;
+
+		hash_worker->buffer = (uint8_t *) memory_allocate(
+		                                   sizeof( uint8_t ) * HASH_HANDLE_BLOCK_SIZE );
+
+		if( hash_worker->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( hash_worker->file_io_handle ),
+		     hash_handle->input_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     hash_worker->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( hash_handle->workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &hash_worker_run,
+		     (void *) &( hash_handle->workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( hash_handle->workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#else
+	hash_worker_run(
+	 &( hash_handle->workers[ 0 ] ) );
+#endif
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		hash_worker = &( hash_handle->workers[ worker_index ] );
+
+		if( hash_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		hash_handle->number_of_bytes_read += hash_worker->number_of_bytes_read;
+	}
+	result = 1;
+
+on_error:
+	if( hash_handle->workers != NULL )
+	{
+		if( result != 1 )
+		{
+			/* Make sure the workers that were started stop before their resources are freed
+			 */
+			hash_handle->abort = 1;
+		}
+		for( worker_index = 0;
+		     worker_index < hash_handle->number_of_workers;
+		     worker_index++ )
+		{
+			hash_worker = &( hash_handle->workers[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( hash_worker->thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( hash_worker->thread ),
+				 NULL );
+			}
+#endif
+			if( hash_worker->file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &( hash_worker->file_io_handle ),
+				 NULL );
+			}
+			if( hash_worker->buffer != NULL )
+			{
+				memory_free(
+				 hash_worker->buffer );
+			}
+		}
+		memory_free(
+		 hash_handle->workers );
+
+		hash_handle->workers           = NULL;
+		hash_handle->number_of_workers = 0;
+	}
+	return( result );
+}
+
+/* Prints the digests of the blocks of a store
+ * Every block is printed as the store number, the offset of the block and its digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_print_store_digests(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     libcerror_error_t **error )
+{
+	char digest_string[ ( 2 * BLOCK_DIGEST_MAXIMUM_SIZE ) + 1 ];
+
+	const uint8_t *digest = NULL;
+	static char *function = "hash_handle_print_store_digests";
+	size64_t store_size   = 0;
+	off64_t block_offset  = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_size(
+	     store,
+	     &store_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	while( (size64_t) block_offset < store_size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		result = hash_handle_get_block_digest(
+		          hash_handle,
+		          store,
+		          store_index,
+		          block_offset,
+		          &digest,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest of store: %d block at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 block_offset );
+
+			return( -1 );
+		}
+		if( block_digest_copy_to_string(
+		     digest,
+		     hash_handle->digest_size,
+		     digest_string,
+		     ( 2 * BLOCK_DIGEST_MAXIMUM_SIZE ) + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy digest to string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->output_stream,
+		 "vss%d\t%" PRIi64 "\t%s\n",
+		 store_index + 1,
+		 block_offset,
+		 digest_string );
+
+		block_offset += HASH_HANDLE_BLOCK_SIZE;
+	}
+	return( 1 );
+}
+
+/* Hashes the blocks of the selected stores and prints their digests
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_run(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "hash_handle_run";
+	uint64_t bytes_per_second   = 0;
+	uint64_t elapsed_time       = 0;
+	uint64_t end_time           = 0;
+	uint64_t start_time         = 0;
+	int number_of_hashed_stores = 0;
+	int store_index             = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_build_sources(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_hash_sources(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to hash sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		return( -1 );
+	}
+	elapsed_time = end_time - start_time;
+
+	for( store_index = 0;
+	     store_index < hash_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		if( hash_handle->stores[ store_index ] == NULL )
+		{
+			continue;
+		}
+		if( hash_handle_print_store_digests(
+		     hash_handle,
+		     hash_handle->stores[ store_index ],
+		     store_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print digests of store: %d.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+		number_of_hashed_stores++;
+	}
+	if( hash_handle->print_summary == 0 )
+	{
+		return( 1 );
+	}
+	/* The throughput is based on the data of the blocks of the stores, which includes
+	 * the data that was not read since it was shared with other blocks
+	 */
+	if( elapsed_time > 0 )
+	{
+		bytes_per_second = ( hash_handle->number_of_bytes_referenced / elapsed_time ) * 1000000
+		                 + ( ( hash_handle->number_of_bytes_referenced % elapsed_time ) * 1000000 ) / elapsed_time;
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\nVolume Shadow Snapshot hash:\n"
+	 "\tDigest type\t\t: %s\n"
+	 "\tNumber of stores\t: %d\n"
+	 "\tNumber of threads\t: %d\n"
+	 "\tBlock size\t\t: %d\n"
+	 "\tNumber of blocks\t: %" PRIu64 "\n"
+	 "\tNumber of sources\t: %" PRIzu "\n"
+	 "\tBytes of blocks\t\t: %" PRIu64 "\n"
+	 "\tBytes hashed\t\t: %" PRIu64 "\n"
+	 "\tBytes read\t\t: %" PRIu64 "\n"
+	 "\tBytes deduplicated\t: %" PRIu64 "\n"
+	 "\tElapsed time\t\t: %" PRIu64 " us\n"
+	 "\tThroughput\t\t: %" PRIu64 ".%02" PRIu64 " MiB/s\n"
+	 "\n",
+	 ( hash_handle->digest_type == BLOCK_DIGEST_TYPE_XXH64 ) ? "xxh64" : "sha256",
+	 number_of_hashed_stores,
+	 hash_handle->number_of_threads,
+	 HASH_HANDLE_BLOCK_SIZE,
+	 hash_handle->number_of_blocks,
+	 hash_handle->number_of_sources,
+	 hash_handle->number_of_bytes_referenced,
+	 hash_handle->number_of_bytes_hashed,
+	 hash_handle->number_of_bytes_read,
+	 hash_handle->number_of_bytes_referenced - hash_handle->number_of_bytes_hashed,
+	 elapsed_time,
+	 bytes_per_second / ( 1024 * 1024 ),
+	 ( ( bytes_per_second % ( 1024 * 1024 ) ) * 100 ) / ( 1024 * 1024 ) );
+
+	return( 1 );
+}
+
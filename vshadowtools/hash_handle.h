@@ -0,0 +1,359 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "block_digest.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the blocks that are hashed, which is the VSS block size
+ */
+#define HASH_HANDLE_BLOCK_SIZE				16384
+
+#define HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS		4
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES		512
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
+/* The number of sources a worker takes at once
+ */
+#define HASH_HANDLE_SOURCES_PER_BATCH			64
+
+/* The store index of a source that is not read from a store
+ */
+enum HASH_HANDLE_SOURCE_INDEXES
+{
+	HASH_HANDLE_SOURCE_INDEX_ZERO			= -2,
+	HASH_HANDLE_SOURCE_INDEX_VOLUME			= -1
+};
+
+typedef struct hash_source hash_source_t;
+
+/* A source is the data of a block of a store, which can be shared by the blocks
+ * of multiple stores. A block that is contained in a single contiguous range of
+ * the volume is identified by its physical offset, a block that is entirely
+ * sparse by its size and any other block by the store and the offset within the store
+ */
+struct hash_source
+{
+	/* The offset, the physical offset relative to the start of the volume
+	 * or the offset relative to the start of the store
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	uint32_t size;
+
+	/* The store index or HASH_HANDLE_SOURCE_INDEX_ZERO or HASH_HANDLE_SOURCE_INDEX_VOLUME
+	 */
+	int store_index;
+};
+
+typedef struct hash_handle hash_handle_t;
+
+typedef struct hash_worker hash_worker_t;
+
+struct hash_worker
+{
+	/* The hash handle
+	 */
+	hash_handle_t *hash_handle;
+
+	/* The worker index
+	 */
+	int worker_index;
+
+	/* The libbfio file IO handle used by the worker
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+};
+
+struct hash_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The digest size
+	 */
+	size_t digest_size;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* Value to indicate stores were selected
+	 */
+	uint8_t has_selected_stores;
+
+	/* The selected stores, a bit per store
+	 */
+	uint8_t selected_stores[ HASH_HANDLE_MAXIMUM_NUMBER_OF_STORES / 8 ];
+
+	/* Value to indicate the summary should be printed
+	 */
+	uint8_t print_summary;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The selected stores, per store, which are shared by the workers
+	 */
+	libvshadow_store_t **stores;
+
+	/* The unique sources, sorted
+	 */
+	hash_source_t *sources;
+
+	/* The number of sources
+	 */
+	size_t number_of_sources;
+
+	/* The digests, per source
+	 */
+	uint8_t *digests;
+
+	/* The index of the next source to hash
+	 */
+	size_t next_source_index;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 * protects the next source index
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* The workers
+	 */
+	hash_worker_t *workers;
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The number of blocks of the selected stores
+	 */
+	uint64_t number_of_blocks;
+
+	/* The number of bytes of the blocks of the selected stores
+	 */
+	uint64_t number_of_bytes_referenced;
+
+	/* The number of bytes of the unique sources
+	 */
+	uint64_t number_of_bytes_hashed;
+
+	/* The number of bytes read from the volume
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The digest output stream
+	 */
+	FILE *output_stream;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_selected_stores(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_digest_type(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_print_summary(
+     hash_handle_t *hash_handle,
+     uint8_t print_summary,
+     libcerror_error_t **error );
+
+int hash_handle_store_is_selected(
+     hash_handle_t *hash_handle,
+     int store_index );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_close_input(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_compare_sources(
+     const void *first_source,
+     const void *second_source );
+
+int hash_handle_get_block_source(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     off64_t block_offset,
+     size_t block_size,
+     hash_source_t *source,
+     libcerror_error_t **error );
+
+int hash_handle_get_store_sources(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     hash_source_t **store_sources,
+     size_t *number_of_store_sources,
+     libcerror_error_t **error );
+
+int hash_handle_merge_sources(
+     hash_handle_t *hash_handle,
+     hash_source_t *store_sources,
+     size_t number_of_store_sources,
+     libcerror_error_t **error );
+
+int hash_handle_build_sources(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_get_source_batch(
+     hash_handle_t *hash_handle,
+     size_t *source_index,
+     size_t *number_of_sources,
+     libcerror_error_t **error );
+
+int hash_handle_get_source_digest(
+     hash_handle_t *hash_handle,
+     const hash_source_t *source,
+     const uint8_t **digest,
+     libcerror_error_t **error );
+
+int hash_handle_get_block_digest(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     off64_t block_offset,
+     const uint8_t **digest,
+     libcerror_error_t **error );
+
+int hash_worker_read_source(
+     hash_worker_t *hash_worker,
+     const hash_source_t *source,
+     libcerror_error_t **error );
+
+int hash_worker_run(
+     hash_worker_t *hash_worker );
+
+int hash_handle_hash_sources(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_print_store_digests(
+     hash_handle_t *hash_handle,
+     libvshadow_store_t *store,
+     int store_index,
+     libcerror_error_t **error );
+
+int hash_handle_run(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
@@ -26,9 +26,13 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "block_cache.h"
 #include "mount_handle.h"
+#include "read_statistics.h"
+#include "read_trace.h"
 #include "vshadowtools_libbfio.h"
 #include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
 #include "vshadowtools_libvshadow.h"
 
 #if !defined( LIBVSHADOW_HAVE_BFIO )
@@ -248,11 +252,32 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *mount_handle )->read_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->input_volume != NULL )
+		{
+			libvshadow_volume_free(
+			 &( ( *mount_handle )->input_volume ),
+			 NULL );
+		}
 		if( ( *mount_handle )->input_file_io_handle != NULL )
 		{
 			libbfio_handle_free(
@@ -332,6 +357,26 @@ int mount_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *mount_handle )->read_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *mount_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *mount_handle )->name );
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -425,6 +470,154 @@ int mount_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the name
+ * The name is used to distinguish the mount handle when multiple volumes are mounted
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_name(
+     mount_handle_t *mount_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_name";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->name != NULL )
+	{
+		memory_free(
+		 mount_handle->name );
+
+		mount_handle->name      = NULL;
+		mount_handle->name_size = 0;
+	}
+	mount_handle->name = system_string_allocate(
+	                      name_length + 1 );
+
+	if( mount_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     mount_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 mount_handle->name );
+
+		mount_handle->name = NULL;
+
+		return( -1 );
+	}
+	mount_handle->name[ name_length ] = 0;
+
+	mount_handle->name_size = name_length + 1;
+
+	return( 1 );
+}
+
+/* Sets the block cache
+ * The block cache is not owned by the mount handle and can be shared with other mount handles
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_block_cache(
+     mount_handle_t *mount_handle,
+     block_cache_t *block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_block_cache";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->block_cache = block_cache;
+
+	return( 1 );
+}
+
+/* Sets the read trace
+ * The read trace is not owned by the mount handle and can be shared with other mount handles
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_read_trace(
+     mount_handle_t *mount_handle,
+     read_trace_t *read_trace,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_read_trace";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->read_trace = read_trace;
+
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
  */
@@ -436,6 +629,7 @@ int mount_handle_open_input(
 	static char *function  = "mount_handle_open";
 	size_t filename_length = 0;
 	int result             = 0;
+	int store_index        = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -563,14 +757,98 @@ int mount_handle_open_input(
 
 			goto on_error;
 		}
+		mount_handle->read_statistics = (read_statistics_t *) memory_allocate(
+		                                                       sizeof( read_statistics_t ) * mount_handle->number_of_inputs );
+
+		if( mount_handle->read_statistics == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     mount_handle->read_statistics,
+		     0,
+		     sizeof( read_statistics_t ) * mount_handle->number_of_inputs ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear read statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_statistics_get_current_time(
+		     &( mount_handle->open_time ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve open time.",
+			 function );
+
+			goto on_error;
+		}
+		/* Retrieve the stores in advance so that they can be read from multiple threads
+		 */
+		for( store_index = 0;
+		     store_index < mount_handle->number_of_inputs;
+		     store_index++ )
+		{
+			if( libvshadow_volume_get_store(
+			     mount_handle->input_volume,
+			     store_index,
+			     &( mount_handle->inputs[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve input: %d from input volume.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+		}
 	}
 	return( result );
 
 on_error:
+	if( mount_handle->read_statistics != NULL )
+	{
+		memory_free(
+		 mount_handle->read_statistics );
+
+		mount_handle->read_statistics = NULL;
+	}
 	if( mount_handle->inputs != NULL )
 	{
+		for( store_index = 0;
+		     store_index < mount_handle->number_of_inputs;
+		     store_index++ )
+		{
+			if( mount_handle->inputs[ store_index ] != NULL )
+			{
+				libvshadow_store_free(
+				 &( mount_handle->inputs[ store_index ] ),
+				 NULL );
+			}
+		}
 		memory_free(
 		 mount_handle->inputs );
+
+		mount_handle->inputs = NULL;
 	}
 	return( -1 );
 }
@@ -623,7 +901,18 @@ int mount_handle_close_input(
 		}
 		memory_free(
 		 mount_handle->inputs );
+
+		mount_handle->inputs = NULL;
+	}
+	if( mount_handle->read_statistics != NULL )
+	{
+		memory_free(
+		 mount_handle->read_statistics );
+
+		mount_handle->read_statistics = NULL;
 	}
+	mount_handle->number_of_inputs = 0;
+
 	if( libvshadow_volume_close(
 	     mount_handle->input_volume,
 	     error ) != 0 )
@@ -792,15 +1081,16 @@ off64_t mount_handle_seek_offset(
 	return( offset );
 }
 
-/* Retrieves the size of the input volume
+/* Retrieves a specific store of the input volume
  * Returns 1 if successful or -1 on error
  */
-int mount_handle_get_size(
+int mount_handle_get_store_by_index(
      mount_handle_t *mount_handle,
-     size64_t *size,
+     int store_index,
+     libvshadow_store_t **store,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_get_size";
+	static char *function = "mount_handle_get_store_by_index";
 
 	if( mount_handle == NULL )
 	{
@@ -813,32 +1103,66 @@ int mount_handle_get_size(
 
 		return( -1 );
 	}
-	if( libvshadow_volume_get_size(
-	     mount_handle->input_volume,
-	     size,
-	     error ) != 1 )
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size from input volume.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
 		 function );
 
 		return( -1 );
 	}
+	if( mount_handle->inputs[ store_index ] == NULL )
+	{
+		if( libvshadow_volume_get_store(
+		     mount_handle->input_volume,
+		     store_index,
+		     &( mount_handle->inputs[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input: %d from input volume.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+	}
+	*store = mount_handle->inputs[ store_index ];
+
 	return( 1 );
 }
 
-/* Retrieves the number of inputs of the input volume
+/* Opens a file IO handle of the input
+ * The file IO handle is a clone of the input file IO handle that can be used
+ * to read the stores concurrently with reads using other file IO handles
+ * Make sure the value file_io_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int mount_handle_get_number_of_inputs(
+int mount_handle_open_file_io_handle(
      mount_handle_t *mount_handle,
-     int *number_of_inputs,
+     libbfio_handle_t **file_io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_get_number_of_inputs";
+	static char *function = "mount_handle_open_file_io_handle";
 
 	if( mount_handle == NULL )
 	{
@@ -851,19 +1175,1919 @@ int mount_handle_get_number_of_inputs(
 
 		return( -1 );
 	}
-	if( number_of_inputs == NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of inputs.",
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	*number_of_inputs = mount_handle->number_of_inputs;
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
 
-	return( 1 );
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     file_io_handle,
+	     mount_handle->input_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Read a buffer at a specific offset from the store of the specified input
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_store_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "mount_handle_read_store_buffer_at_offset";
+	ssize_t read_count        = 0;
+	uint64_t lock_time        = 0;
+	uint64_t read_end_time    = 0;
+	uint64_t read_start_time  = 0;
+
+	if( mount_handle_get_store_by_index(
+	     mount_handle,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( read_statistics_get_current_time(
+	     &lock_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve lock time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( read_statistics_get_current_time(
+	     &read_start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read start time.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_statistics_get_current_time(
+	     &read_end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read end time.",
+		 function );
+
+		goto on_error;
+	}
+	/* The read statistics are protected by the read mutex
+	 */
+	if( read_statistics_update(
+	     &( mount_handle->read_statistics[ store_index ] ),
+	     size,
+	     (uint8_t) ( read_count == -1 ),
+	     read_start_time - lock_time,
+	     read_end_time - read_start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update read statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from input: %d at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mount_handle->read_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Read a buffer at a specific offset from the store of the specified input
+ * using a file IO handle opened with mount_handle_open_file_io_handle
+ * The read does not use the read mutex, hence reads using different file IO
+ * handles can run concurrently. The read is not traced and the read statistics
+ * are not updated
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_store_buffer_at_offset_from_file_io_handle(
+         mount_handle_t *mount_handle,
+         libbfio_handle_t *file_io_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "mount_handle_read_store_buffer_at_offset_from_file_io_handle";
+	ssize_t read_count        = 0;
+
+	if( mount_handle_get_store_by_index(
+	     mount_handle,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+	              store,
+	              file_io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from input: %d at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Read a buffer at a specific offset from the specified input
+ * If a block cache is set reads smaller than the cache block size are read
+ * in blocks via the block cache, larger reads are passed to the library in
+ * a single call and bypass the block cache
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint8_t *block_buffer     = NULL;
+	static char *function     = "mount_handle_read_buffer_at_offset";
+	size_t block_data_offset  = 0;
+	size_t block_data_size    = 0;
+	size_t block_size         = 0;
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	uint64_t block_number     = 0;
+	int result                = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reads are traced as requested, before the block cache lookup,
+	 * hence reads served by the block cache are traced as well
+	 */
+	if( mount_handle->read_trace != NULL )
+	{
+		if( read_trace_append_entry(
+		     mount_handle->read_trace,
+		     store_index,
+		     offset,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to append read trace entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Splitting a large read into cache blocks would issue a library call
+	 * per block, hence only small reads are served via the block cache
+	 */
+	if( ( mount_handle->block_cache == NULL )
+	 || ( size >= mount_handle->block_cache->block_size ) )
+	{
+		return( mount_handle_read_store_buffer_at_offset(
+		         mount_handle,
+		         store_index,
+		         buffer,
+		         size,
+		         offset,
+		         error ) );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	block_size = mount_handle->block_cache->block_size;
+
+	block_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * block_size );
+
+	if( block_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( buffer_offset < size )
+	{
+		block_number      = (uint64_t) offset / block_size;
+		block_data_offset = (size_t) ( (uint64_t) offset % block_size );
+		read_size         = size - buffer_offset;
+
+		if( read_size > ( block_size - block_data_offset ) )
+		{
+			read_size = block_size - block_data_offset;
+		}
+		result = block_cache_get_block(
+		          mount_handle->block_cache,
+		          (intptr_t) mount_handle,
+		          store_index,
+		          block_number,
+		          block_buffer,
+		          block_size,
+		          &block_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %" PRIu64 " from cache.",
+			 function,
+			 block_number );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			read_count = mount_handle_read_store_buffer_at_offset(
+			              mount_handle,
+			              store_index,
+			              block_buffer,
+			              block_size,
+			              (off64_t) ( block_number * block_size ),
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block: %" PRIu64 ".",
+				 function,
+				 block_number );
+
+				goto on_error;
+			}
+			block_data_size = (size_t) read_count;
+
+			if( block_data_size > 0 )
+			{
+				if( block_cache_set_block(
+				     mount_handle->block_cache,
+				     (intptr_t) mount_handle,
+				     store_index,
+				     block_number,
+				     block_buffer,
+				     block_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set block: %" PRIu64 " in cache.",
+					 function,
+					 block_number );
+
+					goto on_error;
+				}
+			}
+		}
+		/* The last block of the volume can be smaller than the block size
+		 */
+		if( block_data_offset >= block_data_size )
+		{
+			break;
+		}
+		if( read_size > ( block_data_size - block_data_offset ) )
+		{
+			read_size = block_data_size - block_data_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( block_buffer[ block_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_offset += read_size;
+		offset        += (off64_t) read_size;
+
+		if( block_data_size < block_size )
+		{
+			break;
+		}
+	}
+	if( block_buffer != NULL )
+	{
+		memory_free(
+		 block_buffer );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( block_buffer != NULL )
+	{
+		memory_free(
+		 block_buffer );
+	}
+	return( -1 );
+}
+
+/* Retrieves the extent at a specific offset of the specified input
+ * Returns 1 if successful, 0 if the offset is beyond the size of the input or -1 on error
+ */
+int mount_handle_get_extent_at_offset(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "mount_handle_get_extent_at_offset";
+	int result                = 0;
+
+	if( mount_handle_get_store_by_index(
+	     mount_handle,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_store_get_extent_at_offset(
+	          store,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent of input: %d at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the extent at a specific offset of the specified input
+ * using a file IO handle opened with mount_handle_open_file_io_handle
+ * The lookup does not use the read mutex
+ * Returns 1 if successful, 0 if the offset is beyond the size of the input or -1 on error
+ */
+int mount_handle_get_extent_at_offset_from_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "mount_handle_get_extent_at_offset_from_file_io_handle";
+	int result                = 0;
+
+	if( mount_handle_get_store_by_index(
+	     mount_handle,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	result = libvshadow_store_get_extent_at_offset_from_file_io_handle(
+	          store,
+	          file_io_handle,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent of input: %d at offset: %" PRIi64 ".",
+		 function,
+		 store_index,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Read a buffer at a specific offset from the delta of the specified input
+ * The delta contains the (store) data of the ranges that differ from the current volume,
+ * the other ranges are filled with zero bytes
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_delta_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_delta_buffer_at_offset";
+	size64_t extent_size  = 0;
+	size_t buffer_offset  = 0;
+	size_t range_size     = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t extent_offset = 0;
+	off64_t range_offset  = 0;
+	uint32_t extent_flags = 0;
+	int is_delta          = 0;
+	int range_is_delta    = 0;
+	int result            = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Adjacent extents of the same kind are combined into a single range
+	 * so that the store data is read with as few reads as possible
+	 */
+	while( buffer_offset < size )
+	{
+		range_offset = offset;
+		range_size   = 0;
+
+		while( buffer_offset < size )
+		{
+			result = mount_handle_get_extent_at_offset(
+			          mount_handle,
+			          store_index,
+			          offset,
+			          &extent_offset,
+			          &extent_size,
+			          &extent_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent of input: %d at offset: %" PRIi64 ".",
+				 function,
+				 store_index,
+				 offset );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			/* Data that is stored in the current volume at the same offset is not part of the delta
+			 */
+			if( ( ( extent_flags & ( LIBVSHADOW_EXTENT_FLAG_IS_SPARSE | LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) ) == 0 )
+			 && ( extent_offset == offset ) )
+			{
+				is_delta = 0;
+			}
+			else
+			{
+				is_delta = 1;
+			}
+			if( ( range_size > 0 )
+			 && ( is_delta != range_is_delta ) )
+			{
+				break;
+			}
+			range_is_delta = is_delta;
+
+			read_size = size - buffer_offset;
+
+			if( (size64_t) read_size > extent_size )
+			{
+				read_size = (size_t) extent_size;
+			}
+			offset        += read_size;
+			buffer_offset += read_size;
+			range_size    += read_size;
+		}
+		if( range_size == 0 )
+		{
+			break;
+		}
+		if( range_is_delta == 0 )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset - range_size ] ),
+			     0,
+			     range_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			read_count = mount_handle_read_buffer_at_offset(
+			              mount_handle,
+			              store_index,
+			              &( buffer[ buffer_offset - range_size ] ),
+			              range_size,
+			              range_offset,
+			              error );
+
+			if( read_count != (ssize_t) range_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from input: %d at offset: %" PRIi64 ".",
+				 function,
+				 store_index,
+				 range_offset );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Appends an extent to an extents string
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_extents_string_append(
+     char **string,
+     size_t *string_size,
+     size_t *string_index,
+     off64_t offset,
+     size64_t size,
+     uint32_t extent_flags,
+     off64_t physical_offset,
+     libcerror_error_t **error )
+{
+	char *reallocation    = NULL;
+	static char *function = "mount_handle_extents_string_append";
+	int print_count       = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string index.",
+		 function );
+
+		return( -1 );
+	}
+	/* A line fits in 128 bytes
+	 */
+	if( ( *string == NULL )
+	 || ( ( *string_size - *string_index ) < 128 ) )
+	{
+		if( *string_size > ( (size_t) SSIZE_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid string size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (char *) memory_reallocate(
+		                         *string,
+		                         sizeof( char ) * ( *string_size * 2 + 4096 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize string.",
+			 function );
+
+			return( -1 );
+		}
+		*string      = reallocation;
+		*string_size = *string_size * 2 + 4096;
+	}
+	if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               &( ( *string )[ *string_index ] ),
+		               *string_size - *string_index,
+		               "%" PRIi64 "\t%" PRIu64 "\tzero\t-\n",
+		               offset,
+		               size );
+	}
+	else
+	{
+		print_count = narrow_string_snprintf(
+		               &( ( *string )[ *string_index ] ),
+		               *string_size - *string_index,
+		               "%" PRIi64 "\t%" PRIu64 "\t%s\t%" PRIi64 "\n",
+		               offset,
+		               size,
+		               ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_STORE_DATA ) != 0 ) ? "store" : "volume",
+		               physical_offset );
+	}
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( *string_size - *string_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print extent.",
+		 function );
+
+		return( -1 );
+	}
+	*string_index += (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Retrieves a string with the extents of the specified input
+ * Every line contains the offset, the size, the source and the physical offset
+ * of an extent separated by tabs. The source is "volume" for data stored in the
+ * current volume, "store" for data stored in the store area and "zero" for sparse
+ * data. The physical offset is relative to the start of the source file or device,
+ * which includes the volume offset. Adjacent extents that are stored contiguously
+ * are combined.
+ * The string must be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_extents_string(
+     mount_handle_t *mount_handle,
+     int store_index,
+     char **string,
+     size_t *string_size,
+     libcerror_error_t **error )
+{
+	char *safe_string             = NULL;
+	static char *function         = "mount_handle_get_extents_string";
+	size64_t extent_size          = 0;
+	size64_t range_size           = 0;
+	size64_t volume_size          = 0;
+	size_t safe_size              = 0;
+	size_t string_index           = 0;
+	off64_t extent_offset         = 0;
+	off64_t offset                = 0;
+	off64_t range_offset          = 0;
+	off64_t range_physical_offset = 0;
+	uint32_t extent_flags         = 0;
+	uint32_t range_flags          = 0;
+	int result                    = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_get_size(
+	     mount_handle,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) offset < volume_size )
+	{
+		result = mount_handle_get_extent_at_offset(
+		          mount_handle,
+		          store_index,
+		          offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent of input: %d at offset: %" PRIi64 ".",
+			 function,
+			 store_index,
+			 offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( extent_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent of input: %d at offset: %" PRIi64 " - size value out of bounds.",
+			 function,
+			 store_index,
+			 offset );
+
+			goto on_error;
+		}
+		if( extent_size > ( volume_size - (size64_t) offset ) )
+		{
+			extent_size = volume_size - (size64_t) offset;
+		}
+		/* Sparse extents are combined regardless of their offset
+		 */
+		if( ( range_size > 0 )
+		 && ( extent_flags == range_flags )
+		 && ( ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		  ||  ( ( range_physical_offset + (off64_t) range_size ) == ( mount_handle->volume_offset + extent_offset ) ) ) )
+		{
+			range_size += extent_size;
+		}
+		else
+		{
+			if( range_size > 0 )
+			{
+				if( mount_handle_extents_string_append(
+				     &safe_string,
+				     &safe_size,
+				     &string_index,
+				     range_offset,
+				     range_size,
+				     range_flags,
+				     range_physical_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to append extent at offset: %" PRIi64 ".",
+					 function,
+					 range_offset );
+
+					goto on_error;
+				}
+			}
+			range_offset          = offset;
+			range_size            = extent_size;
+			range_flags           = extent_flags;
+			range_physical_offset = mount_handle->volume_offset + extent_offset;
+		}
+		offset += (off64_t) extent_size;
+	}
+	if( range_size > 0 )
+	{
+		if( mount_handle_extents_string_append(
+		     &safe_string,
+		     &safe_size,
+		     &string_index,
+		     range_offset,
+		     range_size,
+		     range_flags,
+		     range_physical_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to append extent at offset: %" PRIi64 ".",
+			 function,
+			 range_offset );
+
+			goto on_error;
+		}
+	}
+	if( safe_string == NULL )
+	{
+		/* An empty volume has no extents
+		 */
+		safe_string = narrow_string_allocate(
+		               1 );
+
+		if( safe_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create string.",
+			 function );
+
+			goto on_error;
+		}
+		safe_string[ 0 ] = 0;
+	}
+	*string      = safe_string;
+	*string_size = string_index + 1;
+
+	return( 1 );
+
+on_error:
+	if( safe_string != NULL )
+	{
+		memory_free(
+		 safe_string );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the input volume
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_size(
+     mount_handle_t *mount_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_size";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     mount_handle->input_volume,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of inputs of the input volume
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_number_of_inputs(
+     mount_handle_t *mount_handle,
+     int *number_of_inputs,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_number_of_inputs";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_inputs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of inputs.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_inputs = mount_handle->number_of_inputs;
+
+	return( 1 );
+}
+
+/* Retrieves the read statistics of the specified input
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_read_statistics(
+     mount_handle_t *mount_handle,
+     int store_index,
+     read_statistics_t *read_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_read_statistics";
+	int result            = 1;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     read_statistics,
+	     &( mount_handle->read_statistics[ store_index ] ),
+	     sizeof( read_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy read statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Prints read statistics to a string
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_read_statistics_sprint(
+     const read_statistics_t *read_statistics,
+     char *string,
+     size_t string_size,
+     size_t *string_index,
+     libcerror_error_t **error )
+{
+	static char *function  = "mount_handle_read_statistics_sprint";
+	uint64_t average_size  = 0;
+	uint64_t latency_p50   = 0;
+	uint64_t latency_p99   = 0;
+	int print_count        = 0;
+
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *string_index >= string_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics->number_of_requests > 0 )
+	{
+		average_size = read_statistics->number_of_bytes / read_statistics->number_of_requests;
+	}
+	if( read_statistics_get_latency_percentile(
+	     read_statistics,
+	     50,
+	     &latency_p50,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve latency p50.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics_get_latency_percentile(
+	     read_statistics,
+	     99,
+	     &latency_p99,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve latency p99.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               &( string[ *string_index ] ),
+	               string_size - *string_index,
+	               "\tNumber of read requests\t\t: %" PRIu64 "\n"
+	               "\tNumber of bytes read\t\t: %" PRIu64 "\n"
+	               "\tNumber of read errors\t\t: %" PRIu64 "\n"
+	               "\tAverage read size\t\t: %" PRIu64 " bytes\n"
+	               "\tRead lock wait time\t\t: %" PRIu64 " us\n"
+	               "\tRead time\t\t\t: %" PRIu64 " us\n"
+	               "\tRead latency p50\t\t: < %" PRIu64 " us\n"
+	               "\tRead latency p99\t\t: < %" PRIu64 " us\n"
+	               "\n",
+	               read_statistics->number_of_requests,
+	               read_statistics->number_of_bytes,
+	               read_statistics->number_of_errors,
+	               average_size,
+	               read_statistics->lock_wait_time,
+	               read_statistics->read_time,
+	               latency_p50,
+	               latency_p99 );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( string_size - *string_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*string_index += (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Prints the statistics of a store, as maintained by the library, to a string
+ * The statistics are indexed by the LIBVSHADOW_STATISTIC definitions
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_store_statistics_sprint(
+     const uint64_t *statistics,
+     char *string,
+     size_t string_size,
+     size_t *string_index,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_store_statistics_sprint";
+	int print_count       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *string_index >= string_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               &( string[ *string_index ] ),
+	               string_size - *string_index,
+	               "\tNumber of volume reads\t\t: %" PRIu64 "\n"
+	               "\tNumber of volume bytes read\t: %" PRIu64 "\n"
+	               "\tNumber of zero-filled bytes\t: %" PRIu64 "\n"
+	               "\tNumber of forwarder hops\t: %" PRIu64 "\n"
+	               "\tNumber of overlay reads\t\t: %" PRIu64 "\n"
+	               "\tNumber of metadata blocks read\t: %" PRIu64 "\n"
+	               "\tMetadata load time\t\t: %" PRIu64 " us\n",
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_READS ],
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_BYTES_READ ],
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_ZERO_FILLED_BYTES ],
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_FORWARDER_HOPS ],
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_OVERLAY_READS ],
+	               statistics[ LIBVSHADOW_STATISTIC_NUMBER_OF_METADATA_BLOCKS_READ ],
+	               statistics[ LIBVSHADOW_STATISTIC_LOAD_TIME ] );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( string_size - *string_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print store statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*string_index += (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Retrieves a string with the statistics of the inputs
+ * The string is a snapshot of the statistics at the time of the call
+ * and must be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_statistics_string(
+     mount_handle_t *mount_handle,
+     char **string,
+     size_t *string_size,
+     libcerror_error_t **error )
+{
+	uint64_t store_statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+	uint64_t total_store_statistics[ LIBVSHADOW_NUMBER_OF_STATISTICS ];
+
+	read_statistics_t total_read_statistics;
+	read_statistics_t read_statistics;
+
+	libvshadow_store_t *store = NULL;
+	char *safe_string         = NULL;
+	static char *function     = "mount_handle_get_statistics_string";
+	size_t safe_size          = 0;
+	size_t string_index       = 0;
+	uint64_t current_time     = 0;
+	int print_count           = 0;
+	int statistic_index       = 0;
+	int store_index           = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &total_read_statistics,
+	     0,
+	     sizeof( read_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear total read statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     total_store_statistics,
+	     0,
+	     sizeof( uint64_t ) * LIBVSHADOW_NUMBER_OF_STATISTICS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear total store statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_statistics_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every section fits in 1024 bytes
+	 */
+	safe_size = 1024 * ( (size_t) mount_handle->number_of_inputs + 2 );
+
+	safe_string = narrow_string_allocate(
+	               safe_size );
+
+	if( safe_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create string.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               safe_string,
+	               safe_size,
+	               "Statistics:\n"
+	               "\tUptime\t\t\t\t: %" PRIu64 " seconds\n"
+	               "\tNumber of stores\t\t: %d\n"
+	               "\n",
+	               ( current_time - mount_handle->open_time ) / 1000000,
+	               mount_handle->number_of_inputs );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= safe_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print header.",
+		 function );
+
+		goto on_error;
+	}
+	string_index = (size_t) print_count;
+
+	for( store_index = 0;
+	     store_index < mount_handle->number_of_inputs;
+	     store_index++ )
+	{
+		if( mount_handle_get_read_statistics(
+		     mount_handle,
+		     store_index,
+		     &read_statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read statistics of input: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( read_statistics_merge(
+		     &total_read_statistics,
+		     &read_statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to merge read statistics of input: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( mount_handle_get_store_by_index(
+		     mount_handle,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_get_statistics(
+		     store,
+		     store_statistics,
+		     LIBVSHADOW_NUMBER_OF_STATISTICS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics of input: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		for( statistic_index = 0;
+		     statistic_index < LIBVSHADOW_NUMBER_OF_STATISTICS;
+		     statistic_index++ )
+		{
+			total_store_statistics[ statistic_index ] += store_statistics[ statistic_index ];
+		}
+		print_count = narrow_string_snprintf(
+		               &( safe_string[ string_index ] ),
+		               safe_size - string_index,
+		               "Store: %d (vss%d)\n",
+		               store_index + 1,
+		               store_index + 1 );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( safe_size - string_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to print store: %d header.",
+			 function,
+			 store_index + 1 );
+
+			goto on_error;
+		}
+		string_index += (size_t) print_count;
+
+		if( mount_handle_store_statistics_sprint(
+		     store_statistics,
+		     safe_string,
+		     safe_size,
+		     &string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to print statistics of store: %d.",
+			 function,
+			 store_index + 1 );
+
+			goto on_error;
+		}
+		if( mount_handle_read_statistics_sprint(
+		     &read_statistics,
+		     safe_string,
+		     safe_size,
+		     &string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to print read statistics of store: %d.",
+			 function,
+			 store_index + 1 );
+
+			goto on_error;
+		}
+	}
+	print_count = narrow_string_snprintf(
+	               &( safe_string[ string_index ] ),
+	               safe_size - string_index,
+	               "Total:\n" );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( safe_size - string_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print total header.",
+		 function );
+
+		goto on_error;
+	}
+	string_index += (size_t) print_count;
+
+	if( mount_handle_store_statistics_sprint(
+	     total_store_statistics,
+	     safe_string,
+	     safe_size,
+	     &string_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print total store statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle_read_statistics_sprint(
+	     &total_read_statistics,
+	     safe_string,
+	     safe_size,
+	     &string_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print total read statistics.",
+		 function );
+
+		goto on_error;
+	}
+	*string      = safe_string;
+	*string_size = string_index + 1;
+
+	return( 1 );
+
+on_error:
+	if( safe_string != NULL )
+	{
+		memory_free(
+		 safe_string );
+	}
+	return( -1 );
 }
 
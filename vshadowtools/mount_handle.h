@@ -26,8 +26,12 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "block_cache.h"
+#include "read_statistics.h"
+#include "read_trace.h"
 #include "vshadowtools_libbfio.h"
 #include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
 #include "vshadowtools_libvshadow.h"
 
 #if defined( __cplusplus )
@@ -42,6 +46,14 @@ struct mount_handle
 	 */
 	off64_t volume_offset;
 
+	/* The name
+	 */
+	system_character_t *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
 	/* The libbfio input file IO handle
 	 */
 	libbfio_handle_t *input_file_io_handle;
@@ -58,10 +70,35 @@ struct mount_handle
 	 */
 	int number_of_inputs;
 
+	/* The read statistics of the inputs
+	 */
+	read_statistics_t *read_statistics;
+
+	/* The time the input was opened in microseconds
+	 */
+	uint64_t open_time;
+
+	/* The block cache, which can be shared with other mount handles
+	 */
+	block_cache_t *block_cache;
+
+	/* The read trace, which can be shared with other mount handles
+	 */
+	read_trace_t *read_trace;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read mutex
+	 * the stores share the input file IO handle hence reads are serialized,
+	 * reads using a file IO handle opened with mount_handle_open_file_io_handle
+	 * do not use the read mutex
+	 */
+	libcthreads_mutex_t *read_mutex;
+#endif
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -90,6 +127,22 @@ int mount_handle_set_volume_offset(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_set_name(
+     mount_handle_t *mount_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int mount_handle_set_block_cache(
+     mount_handle_t *mount_handle,
+     block_cache_t *block_cache,
+     libcerror_error_t **error );
+
+int mount_handle_set_read_trace(
+     mount_handle_t *mount_handle,
+     read_trace_t *read_trace,
+     libcerror_error_t **error );
+
 int mount_handle_open_input(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
@@ -113,6 +166,86 @@ off64_t mount_handle_seek_offset(
          int whence,
          libcerror_error_t **error );
 
+int mount_handle_get_store_by_index(
+     mount_handle_t *mount_handle,
+     int store_index,
+     libvshadow_store_t **store,
+     libcerror_error_t **error );
+
+int mount_handle_open_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_store_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t mount_handle_read_store_buffer_at_offset_from_file_io_handle(
+         mount_handle_t *mount_handle,
+         libbfio_handle_t *file_io_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int mount_handle_get_extent_at_offset(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+int mount_handle_get_extent_at_offset_from_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_delta_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int mount_handle_extents_string_append(
+     char **string,
+     size_t *string_size,
+     size_t *string_index,
+     off64_t offset,
+     size64_t size,
+     uint32_t extent_flags,
+     off64_t physical_offset,
+     libcerror_error_t **error );
+
+int mount_handle_get_extents_string(
+     mount_handle_t *mount_handle,
+     int store_index,
+     char **string,
+     size_t *string_size,
+     libcerror_error_t **error );
+
 int mount_handle_get_size(
      mount_handle_t *mount_handle,
      size64_t *size,
@@ -123,6 +256,32 @@ int mount_handle_get_number_of_inputs(
      int *number_of_inputs,
      libcerror_error_t **error );
 
+int mount_handle_get_read_statistics(
+     mount_handle_t *mount_handle,
+     int store_index,
+     read_statistics_t *read_statistics,
+     libcerror_error_t **error );
+
+int mount_handle_read_statistics_sprint(
+     const read_statistics_t *read_statistics,
+     char *string,
+     size_t string_size,
+     size_t *string_index,
+     libcerror_error_t **error );
+
+int mount_handle_store_statistics_sprint(
+     const uint64_t *statistics,
+     char *string,
+     size_t string_size,
+     size_t *string_index,
+     libcerror_error_t **error );
+
+int mount_handle_get_statistics_string(
+     mount_handle_t *mount_handle,
+     char **string,
+     size_t *string_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
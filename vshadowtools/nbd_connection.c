@@ -0,0 +1,2623 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "mount_handle.h"
+#include "nbd_connection.h"
+#include "nbd_definitions.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( MSG_NOSIGNAL )
+#define MSG_NOSIGNAL	0
+#endif
+
+/* Creates a connection
+ * Make sure the value connection is referencing, is set to NULL
+ * The connection takes over the socket descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     mount_handle_t *mount_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid socket descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*connection = memory_allocate_structure(
+	               nbd_connection_t );
+
+	if( *connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear connection.",
+		 function );
+
+		goto on_error;
+	}
+	( *connection )->mount_handle      = mount_handle;
+	( *connection )->socket_descriptor = socket_descriptor;
+	( *connection )->store_index       = -1;
+
+	if( mount_handle_open_file_io_handle(
+	     mount_handle,
+	     &( ( *connection )->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *connection != NULL )
+	{
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a connection
+ * This closes the socket descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		if( ( *connection )->socket_descriptor >= 0 )
+		{
+			if( close(
+			     ( *connection )->socket_descriptor ) != 0 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *connection )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *connection )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *connection )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *connection )->buffer != NULL )
+		{
+			memory_free(
+			 ( *connection )->buffer );
+		}
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( result );
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed by the peer or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = recv(
+		              connection->socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read data from socket.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			if( data_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: connection closed by peer after: %" PRIzd " of %" PRIzd " bytes.",
+			 function,
+			 data_offset,
+			 data_size );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_data(
+     nbd_connection_t *connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		write_count = send(
+		               connection->socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               MSG_NOSIGNAL );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write data to socket.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Resizes the buffer of the connection if it is smaller than the requested size
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_resize_buffer(
+     nbd_connection_t *connection,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_resize_buffer";
+	void *reallocation    = NULL;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size <= connection->buffer_size )
+	{
+		return( 1 );
+	}
+	reallocation = memory_reallocate(
+	                connection->buffer,
+	                buffer_size );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	connection->buffer      = (uint8_t *) reallocation;
+	connection->buffer_size = buffer_size;
+
+	return( 1 );
+}
+
+/* Retrieves the store index of an export by its name
+ * The exports are named vss1 through vssN, an empty name refers to the first store
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_connection_get_export_by_name(
+     nbd_connection_t *connection,
+     const uint8_t *name,
+     size_t name_length,
+     int *store_index,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_get_export_by_name";
+	size_t name_index     = 0;
+	int number_of_inputs  = 0;
+	int export_index      = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_length > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_get_number_of_inputs(
+	     connection->mount_handle,
+	     &number_of_inputs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of inputs.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_length == 0 )
+	{
+		if( number_of_inputs == 0 )
+		{
+			return( 0 );
+		}
+		*store_index = 0;
+
+		return( 1 );
+	}
+	if( ( name_length < 4 )
+	 || ( name_length > 6 ) )
+	{
+		return( 0 );
+	}
+	if( narrow_string_compare(
+	     (char *) name,
+	     "vss",
+	     3 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( name[ 3 ] == (uint8_t) '0' )
+	{
+		return( 0 );
+	}
+	for( name_index = 3;
+	     name_index < name_length;
+	     name_index++ )
+	{
+		if( ( name[ name_index ] < (uint8_t) '0' )
+		 || ( name[ name_index ] > (uint8_t) '9' ) )
+		{
+			return( 0 );
+		}
+		export_index *= 10;
+		export_index += name[ name_index ] - (uint8_t) '0';
+	}
+	if( export_index > number_of_inputs )
+	{
+		return( 0 );
+	}
+	*store_index = export_index - 1;
+
+	return( 1 );
+}
+
+/* Retrieves the transmission flags of the connection
+ * Returns the transmission flags
+ */
+uint16_t nbd_connection_get_transmission_flags(
+          nbd_connection_t *connection )
+{
+	uint16_t transmission_flags = NBD_TRANSMISSION_FLAG_HAS_FLAGS
+	                            | NBD_TRANSMISSION_FLAG_READ_ONLY
+	                            | NBD_TRANSMISSION_FLAG_SEND_FLUSH
+	                            | NBD_TRANSMISSION_FLAG_CAN_MULTI_CONN;
+
+	/* The don't fragment flag is only meaningful with structured replies
+	 */
+	if( ( connection != NULL )
+	 && ( connection->use_structured_replies != 0 ) )
+	{
+		transmission_flags |= NBD_TRANSMISSION_FLAG_SEND_DF;
+	}
+	return( transmission_flags );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_MAGIC_OPTION_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Selects the export of a specific store
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_select_export(
+     nbd_connection_t *connection,
+     int store_index,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "nbd_connection_select_export";
+	size64_t export_size      = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_get_store_by_index(
+	     connection->mount_handle,
+	     store_index,
+	     &store,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_volume_size(
+	     store,
+	     &export_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size of store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	connection->store_index = store_index;
+	connection->export_size = export_size;
+
+	return( 1 );
+}
+
+/* Handles a list option
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_list_option(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t server_data[ 16 ];
+
+	static char *function = "nbd_connection_handle_list_option";
+	int name_length       = 0;
+	int number_of_inputs  = 0;
+	int store_index       = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_get_number_of_inputs(
+	     connection->mount_handle,
+	     &number_of_inputs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of inputs.",
+		 function );
+
+		return( -1 );
+	}
+	for( store_index = 0;
+	     store_index < number_of_inputs;
+	     store_index++ )
+	{
+		name_length = narrow_string_snprintf(
+		               (char *) &( server_data[ 4 ] ),
+		               12,
+		               "vss%d",
+		               store_index + 1 );
+
+		if( ( name_length < 0 )
+		 || ( name_length >= 12 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name of export: %d.",
+			 function,
+			 store_index + 1 );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( server_data[ 0 ] ),
+		 (uint32_t) name_length );
+
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     NBD_OPTION_LIST,
+		     NBD_OPTION_REPLY_SERVER,
+		     server_data,
+		     4 + (size_t) name_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write server reply of export: %d.",
+			 function,
+			 store_index + 1 );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     NBD_OPTION_LIST,
+	     NBD_OPTION_REPLY_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write acknowledge reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles an info or go option
+ * Returns 1 if the export was selected, 0 if not or -1 on error
+ */
+int nbd_connection_handle_info_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t info_data[ 14 ];
+
+	static char *function       = "nbd_connection_handle_info_option";
+	uint32_t name_length        = 0;
+	uint32_t reply_type         = NBD_OPTION_REPLY_ACK;
+	uint16_t number_of_requests = 0;
+	int result                  = 0;
+	int store_index             = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 6 )
+	{
+		reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 name_length );
+
+		if( (size_t) name_length > ( data_size - 6 ) )
+		{
+			reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+		}
+		else
+		{
+			byte_stream_copy_to_uint16_big_endian(
+			 &( data[ 4 + name_length ] ),
+			 number_of_requests );
+
+			/* The information requests are not needed since the export
+			 * and block size information is always provided
+			 */
+			if( ( 6 + (size_t) name_length + ( 2 * (size_t) number_of_requests ) ) != data_size )
+			{
+				reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+			}
+		}
+	}
+	if( reply_type == NBD_OPTION_REPLY_ACK )
+	{
+		result = nbd_connection_get_export_by_name(
+		          connection,
+		          &( data[ 4 ] ),
+		          (size_t) name_length,
+		          &store_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve export.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			reply_type = NBD_OPTION_REPLY_ERROR_UNKNOWN;
+		}
+	}
+	if( reply_type != NBD_OPTION_REPLY_ACK )
+	{
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     option,
+		     reply_type,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write error reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	if( nbd_connection_select_export(
+	     connection,
+	     store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to select export: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 &( info_data[ 0 ] ),
+	 NBD_INFORMATION_EXPORT );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( info_data[ 2 ] ),
+	 connection->export_size );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( info_data[ 10 ] ),
+	 nbd_connection_get_transmission_flags(
+	  connection ) );
+
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_OPTION_REPLY_INFO,
+	     info_data,
+	     12,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write export information reply.",
+		 function );
+
+		return( -1 );
+	}
+	/* The preferred block size matches the size of a store block
+	 */
+	byte_stream_copy_from_uint16_big_endian(
+	 &( info_data[ 0 ] ),
+	 NBD_INFORMATION_BLOCK_SIZE );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( info_data[ 2 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( info_data[ 6 ] ),
+	 0x00004000UL );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( info_data[ 10 ] ),
+	 NBD_MAXIMUM_PAYLOAD_SIZE );
+
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_OPTION_REPLY_INFO,
+	     info_data,
+	     14,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block size information reply.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_OPTION_REPLY_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write acknowledge reply.",
+		 function );
+
+		return( -1 );
+	}
+	if( option != NBD_OPTION_GO )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Handles a list or set meta context option
+ * Only the base:allocation meta context is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t context_data[ 4 + NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ];
+
+	static char *function         = "nbd_connection_handle_meta_context_option";
+	size_t data_offset            = 0;
+	uint32_t name_length          = 0;
+	uint32_t number_of_queries    = 0;
+	uint32_t query_index          = 0;
+	uint32_t query_length         = 0;
+	uint32_t reply_type           = NBD_OPTION_REPLY_ACK;
+	uint8_t use_base_allocation   = 0;
+	int result                    = 0;
+	int store_index               = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( option == NBD_OPTION_SET_META_CONTEXT )
+	 && ( connection->use_structured_replies == 0 ) )
+	{
+		reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+	}
+	else if( data_size < 8 )
+	{
+		reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 name_length );
+
+		if( (size_t) name_length > ( data_size - 8 ) )
+		{
+			reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+		}
+	}
+	if( reply_type == NBD_OPTION_REPLY_ACK )
+	{
+		result = nbd_connection_get_export_by_name(
+		          connection,
+		          &( data[ 4 ] ),
+		          (size_t) name_length,
+		          &store_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve export.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			reply_type = NBD_OPTION_REPLY_ERROR_UNKNOWN;
+		}
+	}
+	if( reply_type == NBD_OPTION_REPLY_ACK )
+	{
+		data_offset = 4 + (size_t) name_length;
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 number_of_queries );
+
+		data_offset += 4;
+
+		/* Listing without queries lists all the supported meta contexts
+		 */
+		if( ( option == NBD_OPTION_LIST_META_CONTEXT )
+		 && ( number_of_queries == 0 ) )
+		{
+			use_base_allocation = 1;
+		}
+		for( query_index = 0;
+		     query_index < number_of_queries;
+		     query_index++ )
+		{
+			if( ( data_size - data_offset ) < 4 )
+			{
+				reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+
+				break;
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 &( data[ data_offset ] ),
+			 query_length );
+
+			data_offset += 4;
+
+			if( (size_t) query_length > ( data_size - data_offset ) )
+			{
+				reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+
+				break;
+			}
+			if( ( query_length == NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH )
+			 && ( memory_compare(
+			       &( data[ data_offset ] ),
+			       NBD_META_CONTEXT_BASE_ALLOCATION,
+			       NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ) == 0 ) )
+			{
+				use_base_allocation = 1;
+			}
+			/* Listing the base namespace lists all its meta contexts
+			 */
+			else if( ( option == NBD_OPTION_LIST_META_CONTEXT )
+			      && ( query_length == 5 )
+			      && ( memory_compare(
+			            &( data[ data_offset ] ),
+			            "base:",
+			            5 ) == 0 ) )
+			{
+				use_base_allocation = 1;
+			}
+			data_offset += (size_t) query_length;
+		}
+		if( data_offset != data_size )
+		{
+			reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+		}
+	}
+	if( reply_type != NBD_OPTION_REPLY_ACK )
+	{
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     option,
+		     reply_type,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write error reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( use_base_allocation != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( context_data[ 0 ] ),
+		 NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER );
+
+		if( memory_copy(
+		     &( context_data[ 4 ] ),
+		     NBD_META_CONTEXT_BASE_ALLOCATION,
+		     NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy meta context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     option,
+		     NBD_OPTION_REPLY_META_CONTEXT,
+		     context_data,
+		     4 + NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write meta context reply.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_OPTION_REPLY_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write acknowledge reply.",
+		 function );
+
+		return( -1 );
+	}
+	if( option == NBD_OPTION_SET_META_CONTEXT )
+	{
+		connection->use_base_allocation = use_base_allocation;
+	}
+	return( 1 );
+}
+
+/* Negotiates the export with the client using the fixed newstyle handshake
+ * Returns 1 if an export was selected, 0 if the client aborted or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t handshake_data[ 18 ];
+	uint8_t export_data[ 134 ];
+	uint8_t option_header[ 16 ];
+	uint8_t option_data[ NBD_MAXIMUM_OPTION_DATA_SIZE ];
+
+	static char *function    = "nbd_connection_negotiate";
+	size_t export_data_size  = 0;
+	uint64_t magic           = 0;
+	uint32_t client_flags    = 0;
+	uint32_t option          = 0;
+	uint32_t option_size     = 0;
+	uint32_t reply_type      = 0;
+	int result               = 0;
+	int store_index          = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 NBD_MAGIC_INITIAL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_HANDSHAKE_FLAG_FIXED_NEWSTYLE | NBD_HANDSHAKE_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_read_data(
+	          connection,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read client flags.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	while( 1 )
+	{
+		result = nbd_connection_read_data(
+		          connection,
+		          option_header,
+		          16,
+		          error );
+
+		if( result == 0 )
+		{
+			return( 0 );
+		}
+		else if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read option header.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_size );
+
+		if( magic != NBD_MAGIC_OPTION )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported option magic: 0x%08" PRIx64 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		if( option_size > NBD_MAXIMUM_OPTION_DATA_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid option: %" PRIu32 " data size value out of bounds.",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+		if( option_size > 0 )
+		{
+			if( nbd_connection_read_data(
+			     connection,
+			     option_data,
+			     (size_t) option_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option: %" PRIu32 " data.",
+				 function,
+				 option );
+
+				return( -1 );
+			}
+		}
+		reply_type = NBD_OPTION_REPLY_ACK;
+
+		switch( option )
+		{
+			case NBD_OPTION_EXPORT_NAME:
+				result = nbd_connection_get_export_by_name(
+				          connection,
+				          option_data,
+				          (size_t) option_size,
+				          &store_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve export.",
+					 function );
+
+					return( -1 );
+				}
+				/* There is no error reply to the export name option,
+				 * an unknown export terminates the session
+				 */
+				else if( result == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: no such export.",
+					 function );
+
+					return( -1 );
+				}
+				result = nbd_connection_select_export(
+				          connection,
+				          store_index,
+				          error );
+
+				break;
+
+			case NBD_OPTION_ABORT:
+				/* The client might already have closed the connection
+				 */
+				nbd_connection_write_option_reply(
+				 connection,
+				 option,
+				 NBD_OPTION_REPLY_ACK,
+				 NULL,
+				 0,
+				 NULL );
+
+				return( 0 );
+
+			case NBD_OPTION_LIST:
+				if( option_size != 0 )
+				{
+					reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+				}
+				else
+				{
+					result = nbd_connection_handle_list_option(
+					          connection,
+					          error );
+				}
+				break;
+
+			case NBD_OPTION_INFO:
+			case NBD_OPTION_GO:
+				result = nbd_connection_handle_info_option(
+				          connection,
+				          option,
+				          option_data,
+				          (size_t) option_size,
+				          error );
+
+				break;
+
+			case NBD_OPTION_STRUCTURED_REPLY:
+				if( option_size != 0 )
+				{
+					reply_type = NBD_OPTION_REPLY_ERROR_INVALID;
+				}
+				else
+				{
+					connection->use_structured_replies = 1;
+
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_OPTION_REPLY_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_OPTION_LIST_META_CONTEXT:
+			case NBD_OPTION_SET_META_CONTEXT:
+				result = nbd_connection_handle_meta_context_option(
+				          connection,
+				          option,
+				          option_data,
+				          (size_t) option_size,
+				          error );
+
+				break;
+
+			default:
+				reply_type = NBD_OPTION_REPLY_ERROR_UNSUPPORTED;
+
+				break;
+		}
+		if( reply_type != NBD_OPTION_REPLY_ACK )
+		{
+			result = nbd_connection_write_option_reply(
+			          connection,
+			          option,
+			          reply_type,
+			          NULL,
+			          0,
+			          error );
+
+			if( result == 1 )
+			{
+				result = 0;
+			}
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle option: %" PRIu32 ".",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+		if( ( option == NBD_OPTION_GO )
+		 && ( result == 1 ) )
+		{
+			break;
+		}
+		if( option == NBD_OPTION_EXPORT_NAME )
+		{
+			break;
+		}
+	}
+	if( option == NBD_OPTION_EXPORT_NAME )
+	{
+		export_data_size = 10;
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( export_data[ 0 ] ),
+		 connection->export_size );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( export_data[ 8 ] ),
+		 nbd_connection_get_transmission_flags(
+		  connection ) );
+
+		if( ( client_flags & NBD_CLIENT_FLAG_NO_ZEROES ) == 0 )
+		{
+			if( memory_set(
+			     &( export_data[ 10 ] ),
+			     0,
+			     124 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear export data.",
+				 function );
+
+				return( -1 );
+			}
+			export_data_size += 124;
+		}
+		if( nbd_connection_write_data(
+		     connection,
+		     export_data,
+		     export_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write export data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a simple reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *connection,
+     uint32_t error_value,
+     uint64_t handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+
+	static char *function = "nbd_connection_write_simple_reply";
+
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_MAGIC_SIMPLE_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 handle );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     reply_header,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a structured reply chunk
+ * The payload consists of the header data followed by the data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *connection,
+     uint16_t flags,
+     uint16_t type,
+     uint64_t handle,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_structured_reply";
+
+	if( ( header_data == NULL )
+	 && ( header_data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( header_data_size > (size_t) UINT32_MAX )
+	 || ( data_size > ( (size_t) UINT32_MAX - header_data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid payload size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_MAGIC_STRUCTURED_REPLY );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 4 ] ),
+	 flags );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 6 ] ),
+	 type );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 handle );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) ( header_data_size + data_size ) );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     header_data,
+		     header_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply payload header.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply payload data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes an error reply
+ * A structured error chunk is written if structured replies were negotiated
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_error_reply(
+     nbd_connection_t *connection,
+     uint32_t error_value,
+     uint64_t handle,
+     libcerror_error_t **error )
+{
+	uint8_t error_data[ 6 ];
+
+	static char *function = "nbd_connection_write_error_reply";
+	int result            = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->use_structured_replies == 0 )
+	{
+		result = nbd_connection_write_simple_reply(
+		          connection,
+		          error_value,
+		          handle,
+		          NULL,
+		          0,
+		          error );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( error_data[ 0 ] ),
+		 error_value );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( error_data[ 4 ] ),
+		 0 );
+
+		result = nbd_connection_write_structured_reply(
+		          connection,
+		          NBD_REPLY_FLAG_DONE,
+		          NBD_REPLY_TYPE_ERROR,
+		          handle,
+		          error_data,
+		          6,
+		          NULL,
+		          0,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write error reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a read request
+ * With structured replies the data is sent in chunks where the sparse ranges are sent as holes,
+ * unless the client requested the data not to be fragmented
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_read_request(
+     nbd_connection_t *connection,
+     uint16_t command_flags,
+     uint64_t handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_header[ 12 ];
+
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "nbd_connection_handle_read_request";
+	size64_t extent_size          = 0;
+	size_t buffer_offset          = 0;
+	size_t range_size             = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t extent_offset         = 0;
+	off64_t range_offset          = 0;
+	uint32_t extent_flags         = 0;
+	int is_sparse                 = 0;
+	int range_is_sparse           = 0;
+	int read_failed               = 0;
+	int result                    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection_resize_buffer(
+	     connection,
+	     (size_t) length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( connection->use_structured_replies == 0 )
+	 || ( ( command_flags & NBD_COMMAND_FLAG_DF ) != 0 ) )
+	{
+		read_count = mount_handle_read_store_buffer_at_offset_from_file_io_handle(
+		              connection->mount_handle,
+		              connection->file_io_handle,
+		              connection->store_index,
+		              connection->buffer,
+		              (size_t) length,
+		              (off64_t) offset,
+		              &read_error );
+
+		if( read_count != (ssize_t) length )
+		{
+			libcerror_error_free(
+			 &read_error );
+
+			return( nbd_connection_write_error_reply(
+			         connection,
+			         NBD_ERROR_IO,
+			         handle,
+			         error ) );
+		}
+		if( connection->use_structured_replies == 0 )
+		{
+			return( nbd_connection_write_simple_reply(
+			         connection,
+			         0,
+			         handle,
+			         connection->buffer,
+			         (size_t) length,
+			         error ) );
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( chunk_header[ 0 ] ),
+		 offset );
+
+		return( nbd_connection_write_structured_reply(
+		         connection,
+		         NBD_REPLY_FLAG_DONE,
+		         NBD_REPLY_TYPE_OFFSET_DATA,
+		         handle,
+		         chunk_header,
+		         8,
+		         connection->buffer,
+		         (size_t) length,
+		         error ) );
+	}
+	/* Adjacent extents that are either sparse or contain data are combined
+	 * into a single chunk
+	 */
+	while( buffer_offset < (size_t) length )
+	{
+		range_offset = (off64_t) offset;
+		range_size   = 0;
+
+		while( buffer_offset < (size_t) length )
+		{
+			result = mount_handle_get_extent_at_offset_from_file_io_handle(
+			          connection->mount_handle,
+			          connection->file_io_handle,
+			          connection->store_index,
+			          (off64_t) offset,
+			          &extent_offset,
+			          &extent_size,
+			          &extent_flags,
+			          &read_error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+			is_sparse = ( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 );
+
+			if( ( range_size > 0 )
+			 && ( is_sparse != range_is_sparse ) )
+			{
+				break;
+			}
+			range_is_sparse = is_sparse;
+
+			read_size = (size_t) length - buffer_offset;
+
+			if( (size64_t) read_size > extent_size )
+			{
+				read_size = (size_t) extent_size;
+			}
+			offset        += read_size;
+			buffer_offset += read_size;
+			range_size    += read_size;
+		}
+		if( ( result != 1 )
+		 && ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( range_is_sparse != 0 )
+		{
+			byte_stream_copy_from_uint64_big_endian(
+			 &( chunk_header[ 0 ] ),
+			 (uint64_t) range_offset );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( chunk_header[ 8 ] ),
+			 (uint32_t) range_size );
+
+			if( nbd_connection_write_structured_reply(
+			     connection,
+			     0,
+			     NBD_REPLY_TYPE_OFFSET_HOLE,
+			     handle,
+			     chunk_header,
+			     12,
+			     NULL,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write hole chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			read_count = mount_handle_read_store_buffer_at_offset_from_file_io_handle(
+			              connection->mount_handle,
+			              connection->file_io_handle,
+			              connection->store_index,
+			              connection->buffer,
+			              range_size,
+			              range_offset,
+			              &read_error );
+
+			if( read_count != (ssize_t) range_size )
+			{
+				read_failed = 1;
+
+				break;
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 &( chunk_header[ 0 ] ),
+			 (uint64_t) range_offset );
+
+			if( nbd_connection_write_structured_reply(
+			     connection,
+			     0,
+			     NBD_REPLY_TYPE_OFFSET_DATA,
+			     handle,
+			     chunk_header,
+			     8,
+			     connection->buffer,
+			     range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( ( read_failed != 0 )
+	 || ( buffer_offset < (size_t) length ) )
+	{
+		libcerror_error_free(
+		 &read_error );
+
+		return( nbd_connection_write_error_reply(
+		         connection,
+		         NBD_ERROR_IO,
+		         handle,
+		         error ) );
+	}
+	return( nbd_connection_write_structured_reply(
+	         connection,
+	         NBD_REPLY_FLAG_DONE,
+	         NBD_REPLY_TYPE_NONE,
+	         handle,
+	         NULL,
+	         0,
+	         NULL,
+	         0,
+	         error ) );
+}
+
+/* Handles a block status request of the base:allocation meta context
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_block_status_request(
+     nbd_connection_t *connection,
+     uint16_t command_flags,
+     uint64_t handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *status_error        = NULL;
+	static char *function                  = "nbd_connection_handle_block_status_request";
+	size64_t extent_size                   = 0;
+	size_t buffer_offset                   = 0;
+	off64_t extent_offset                  = 0;
+	uint32_t descriptor_flags              = 0;
+	uint32_t descriptor_length             = 0;
+	uint32_t extent_flags                  = 0;
+	uint32_t maximum_number_of_descriptors = NBD_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS;
+	uint32_t number_of_descriptors         = 0;
+	uint32_t remaining_length              = length;
+	uint32_t state_flags                   = 0;
+	int result                             = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( command_flags & NBD_COMMAND_FLAG_REQ_ONE ) != 0 )
+	{
+		maximum_number_of_descriptors = 1;
+	}
+	if( nbd_connection_resize_buffer(
+	     connection,
+	     4 + ( 8 * NBD_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 connection->buffer,
+	 NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER );
+
+	buffer_offset = 4;
+
+	/* Adjacent extents with the same state are combined into a single descriptor
+	 */
+	while( remaining_length > 0 )
+	{
+		result = mount_handle_get_extent_at_offset_from_file_io_handle(
+		          connection->mount_handle,
+		          connection->file_io_handle,
+		          connection->store_index,
+		          (off64_t) offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &status_error );
+
+		if( result == -1 )
+		{
+			libcerror_error_free(
+			 &status_error );
+
+			return( nbd_connection_write_error_reply(
+			         connection,
+			         NBD_ERROR_IO,
+			         handle,
+			         error ) );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( ( extent_flags & LIBVSHADOW_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			state_flags = NBD_STATE_HOLE | NBD_STATE_ZERO;
+		}
+		else
+		{
+			state_flags = 0;
+		}
+		if( extent_size > (size64_t) remaining_length )
+		{
+			extent_size = (size64_t) remaining_length;
+		}
+		if( ( descriptor_length > 0 )
+		 && ( state_flags != descriptor_flags ) )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( connection->buffer[ buffer_offset ] ),
+			 descriptor_length );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( connection->buffer[ buffer_offset + 4 ] ),
+			 descriptor_flags );
+
+			buffer_offset         += 8;
+			number_of_descriptors += 1;
+			descriptor_length      = 0;
+
+			if( number_of_descriptors >= maximum_number_of_descriptors )
+			{
+				break;
+			}
+		}
+		descriptor_flags   = state_flags;
+		descriptor_length += (uint32_t) extent_size;
+		remaining_length  -= (uint32_t) extent_size;
+		offset            += extent_size;
+	}
+	if( ( descriptor_length > 0 )
+	 && ( number_of_descriptors < maximum_number_of_descriptors ) )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( connection->buffer[ buffer_offset ] ),
+		 descriptor_length );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( connection->buffer[ buffer_offset + 4 ] ),
+		 descriptor_flags );
+
+		buffer_offset         += 8;
+		number_of_descriptors += 1;
+	}
+	if( number_of_descriptors == 0 )
+	{
+		return( nbd_connection_write_error_reply(
+		         connection,
+		         NBD_ERROR_INVALID,
+		         handle,
+		         error ) );
+	}
+	return( nbd_connection_write_structured_reply(
+	         connection,
+	         NBD_REPLY_FLAG_DONE,
+	         NBD_REPLY_TYPE_BLOCK_STATUS,
+	         handle,
+	         connection->buffer,
+	         buffer_offset,
+	         NULL,
+	         0,
+	         error ) );
+}
+
+/* Handles the requests of the transmission phase until the client disconnects
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_requests(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t request_data[ 28 ];
+
+	static char *function   = "nbd_connection_handle_requests";
+	size_t read_size        = 0;
+	uint64_t handle         = 0;
+	uint64_t offset         = 0;
+	uint32_t error_value    = 0;
+	uint32_t length         = 0;
+	uint32_t magic          = 0;
+	uint16_t command_flags  = 0;
+	uint16_t command_type   = 0;
+	int result              = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->store_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid connection - missing export.",
+		 function );
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+		result = nbd_connection_read_data(
+		          connection,
+		          request_data,
+		          28,
+		          error );
+
+		if( result == 0 )
+		{
+			break;
+		}
+		else if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 4 ] ),
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 6 ] ),
+		 command_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 8 ] ),
+		 handle );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 24 ] ),
+		 length );
+
+		if( magic != NBD_MAGIC_REQUEST )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		if( command_type == NBD_COMMAND_DISCONNECT )
+		{
+			break;
+		}
+		error_value = 0;
+
+		switch( command_type )
+		{
+			case NBD_COMMAND_READ:
+			case NBD_COMMAND_BLOCK_STATUS:
+				if( ( offset > connection->export_size )
+				 || ( (uint64_t) length > ( connection->export_size - offset ) ) )
+				{
+					error_value = NBD_ERROR_INVALID;
+				}
+				else if( length == 0 )
+				{
+					error_value = NBD_ERROR_INVALID;
+				}
+				else if( command_type == NBD_COMMAND_READ )
+				{
+					/* EOVERFLOW is reserved for a read the client requested not to be
+					 * fragmented that does not fit in a single chunk, other reads
+					 * larger than the maximum payload size are invalid
+					 */
+					if( length > NBD_MAXIMUM_PAYLOAD_SIZE )
+					{
+						if( ( connection->use_structured_replies != 0 )
+						 && ( ( command_flags & NBD_COMMAND_FLAG_DF ) != 0 ) )
+						{
+							error_value = NBD_ERROR_OVERFLOW;
+						}
+						else
+						{
+							error_value = NBD_ERROR_INVALID;
+						}
+					}
+				}
+				else if( connection->use_base_allocation == 0 )
+				{
+					error_value = NBD_ERROR_INVALID;
+				}
+				break;
+
+			case NBD_COMMAND_FLUSH:
+				break;
+
+			case NBD_COMMAND_WRITE:
+				/* The payload of the write request is discarded since the exports are read-only
+				 */
+				while( length > 0 )
+				{
+					read_size = (size_t) length;
+
+					if( read_size > sizeof( request_data ) )
+					{
+						read_size = sizeof( request_data );
+					}
+					if( nbd_connection_read_data(
+					     connection,
+					     request_data,
+					     read_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read write request payload.",
+						 function );
+
+						return( -1 );
+					}
+					length -= (uint32_t) read_size;
+				}
+				error_value = NBD_ERROR_PERMISSION;
+
+				break;
+
+			case NBD_COMMAND_TRIM:
+			case NBD_COMMAND_WRITE_ZEROES:
+				error_value = NBD_ERROR_PERMISSION;
+
+				break;
+
+			default:
+				error_value = NBD_ERROR_INVALID;
+
+				break;
+		}
+		if( error_value != 0 )
+		{
+			result = nbd_connection_write_error_reply(
+			          connection,
+			          error_value,
+			          handle,
+			          error );
+		}
+		else if( command_type == NBD_COMMAND_READ )
+		{
+			result = nbd_connection_handle_read_request(
+			          connection,
+			          command_flags,
+			          handle,
+			          offset,
+			          length,
+			          error );
+		}
+		else if( command_type == NBD_COMMAND_BLOCK_STATUS )
+		{
+			result = nbd_connection_handle_block_status_request(
+			          connection,
+			          command_flags,
+			          handle,
+			          offset,
+			          length,
+			          error );
+		}
+		else if( connection->use_structured_replies != 0 )
+		{
+			result = nbd_connection_write_structured_reply(
+			          connection,
+			          NBD_REPLY_FLAG_DONE,
+			          NBD_REPLY_TYPE_NONE,
+			          handle,
+			          NULL,
+			          0,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_connection_write_simple_reply(
+			          connection,
+			          0,
+			          handle,
+			          NULL,
+			          0,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle request: %" PRIu16 ".",
+			 function,
+			 command_type );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
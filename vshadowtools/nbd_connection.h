@@ -0,0 +1,200 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_CONNECTION_H )
+#define _NBD_CONNECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "mount_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct nbd_connection nbd_connection_t;
+
+struct nbd_connection
+{
+	/* The mount handle
+	 */
+	mount_handle_t *mount_handle;
+
+	/* The file IO handle
+	 * every connection reads the input using its own file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The store index of the selected export
+	 */
+	int store_index;
+
+	/* The size of the selected export
+	 */
+	size64_t export_size;
+
+	/* Value to indicate if structured replies were negotiated
+	 */
+	uint8_t use_structured_replies;
+
+	/* Value to indicate if the base:allocation meta context was selected
+	 */
+	uint8_t use_base_allocation;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+};
+
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     mount_handle_t *mount_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_data(
+     nbd_connection_t *connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_resize_buffer(
+     nbd_connection_t *connection,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int nbd_connection_get_export_by_name(
+     nbd_connection_t *connection,
+     const uint8_t *name,
+     size_t name_length,
+     int *store_index,
+     libcerror_error_t **error );
+
+int nbd_connection_select_export(
+     nbd_connection_t *connection,
+     int store_index,
+     libcerror_error_t **error );
+
+uint16_t nbd_connection_get_transmission_flags(
+          nbd_connection_t *connection );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_list_option(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_info_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *connection,
+     uint32_t error_value,
+     uint64_t handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *connection,
+     uint16_t flags,
+     uint16_t type,
+     uint64_t handle,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_error_reply(
+     nbd_connection_t *connection,
+     uint32_t error_value,
+     uint64_t handle,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_read_request(
+     nbd_connection_t *connection,
+     uint16_t command_flags,
+     uint64_t handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_block_status_request(
+     nbd_connection_t *connection,
+     uint16_t command_flags,
+     uint64_t handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_requests(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_CONNECTION_H ) */
+
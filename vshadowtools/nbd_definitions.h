@@ -0,0 +1,184 @@
+/*
+ * Network Block Device (NBD) protocol definitions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_DEFINITIONS_H )
+#define _NBD_DEFINITIONS_H
+
+#include <common.h>
+#include <types.h>
+
+/* The magic values
+ */
+#define NBD_MAGIC_INITIAL				0x4e42444d41474943ULL
+#define NBD_MAGIC_OPTION				0x49484156454f5054ULL
+#define NBD_MAGIC_OPTION_REPLY				0x0003e889045565a9ULL
+#define NBD_MAGIC_REQUEST				0x25609513UL
+#define NBD_MAGIC_SIMPLE_REPLY				0x67446698UL
+#define NBD_MAGIC_STRUCTURED_REPLY			0x668e33efUL
+
+/* The handshake flags
+ */
+enum NBD_HANDSHAKE_FLAGS
+{
+	NBD_HANDSHAKE_FLAG_FIXED_NEWSTYLE		= 0x0001,
+	NBD_HANDSHAKE_FLAG_NO_ZEROES			= 0x0002
+};
+
+/* The client flags
+ */
+enum NBD_CLIENT_FLAGS
+{
+	NBD_CLIENT_FLAG_FIXED_NEWSTYLE			= 0x00000001UL,
+	NBD_CLIENT_FLAG_NO_ZEROES			= 0x00000002UL
+};
+
+/* The transmission flags
+ */
+enum NBD_TRANSMISSION_FLAGS
+{
+	NBD_TRANSMISSION_FLAG_HAS_FLAGS			= 0x0001,
+	NBD_TRANSMISSION_FLAG_READ_ONLY			= 0x0002,
+	NBD_TRANSMISSION_FLAG_SEND_FLUSH		= 0x0004,
+	NBD_TRANSMISSION_FLAG_SEND_DF			= 0x0080,
+	NBD_TRANSMISSION_FLAG_CAN_MULTI_CONN		= 0x0100
+};
+
+/* The option types
+ */
+enum NBD_OPTION_TYPES
+{
+	NBD_OPTION_EXPORT_NAME				= 1,
+	NBD_OPTION_ABORT				= 2,
+	NBD_OPTION_LIST					= 3,
+	NBD_OPTION_STARTTLS				= 5,
+	NBD_OPTION_INFO					= 6,
+	NBD_OPTION_GO					= 7,
+	NBD_OPTION_STRUCTURED_REPLY			= 8,
+	NBD_OPTION_LIST_META_CONTEXT			= 9,
+	NBD_OPTION_SET_META_CONTEXT			= 10
+};
+
+/* The option reply types
+ */
+enum NBD_OPTION_REPLY_TYPES
+{
+	NBD_OPTION_REPLY_ACK				= 1,
+	NBD_OPTION_REPLY_SERVER				= 2,
+	NBD_OPTION_REPLY_INFO				= 3,
+	NBD_OPTION_REPLY_META_CONTEXT			= 4,
+	NBD_OPTION_REPLY_ERROR_UNSUPPORTED		= 0x80000001UL,
+	NBD_OPTION_REPLY_ERROR_POLICY			= 0x80000002UL,
+	NBD_OPTION_REPLY_ERROR_INVALID			= 0x80000003UL,
+	NBD_OPTION_REPLY_ERROR_UNKNOWN			= 0x80000006UL
+};
+
+/* The information types
+ */
+enum NBD_INFORMATION_TYPES
+{
+	NBD_INFORMATION_EXPORT				= 0,
+	NBD_INFORMATION_NAME				= 1,
+	NBD_INFORMATION_DESCRIPTION			= 2,
+	NBD_INFORMATION_BLOCK_SIZE			= 3
+};
+
+/* The command types
+ */
+enum NBD_COMMAND_TYPES
+{
+	NBD_COMMAND_READ				= 0,
+	NBD_COMMAND_WRITE				= 1,
+	NBD_COMMAND_DISCONNECT				= 2,
+	NBD_COMMAND_FLUSH				= 3,
+	NBD_COMMAND_TRIM				= 4,
+	NBD_COMMAND_CACHE				= 5,
+	NBD_COMMAND_WRITE_ZEROES			= 6,
+	NBD_COMMAND_BLOCK_STATUS			= 7
+};
+
+/* The command flags
+ */
+enum NBD_COMMAND_FLAGS
+{
+	NBD_COMMAND_FLAG_FUA				= 0x0001,
+	NBD_COMMAND_FLAG_NO_HOLE			= 0x0002,
+	NBD_COMMAND_FLAG_DF				= 0x0004,
+	NBD_COMMAND_FLAG_REQ_ONE			= 0x0008
+};
+
+/* The structured reply flags
+ */
+enum NBD_REPLY_FLAGS
+{
+	NBD_REPLY_FLAG_DONE				= 0x0001
+};
+
+/* The structured reply types
+ */
+enum NBD_REPLY_TYPES
+{
+	NBD_REPLY_TYPE_NONE				= 0,
+	NBD_REPLY_TYPE_OFFSET_DATA			= 1,
+	NBD_REPLY_TYPE_OFFSET_HOLE			= 2,
+	NBD_REPLY_TYPE_BLOCK_STATUS			= 5,
+	NBD_REPLY_TYPE_ERROR				= 0x8001
+};
+
+/* The base:allocation block status flags
+ */
+enum NBD_STATE_FLAGS
+{
+	NBD_STATE_HOLE					= 0x00000001UL,
+	NBD_STATE_ZERO					= 0x00000002UL
+};
+
+/* The error values
+ */
+enum NBD_ERRORS
+{
+	NBD_ERROR_PERMISSION				= 1,
+	NBD_ERROR_IO					= 5,
+	NBD_ERROR_NO_MEMORY				= 12,
+	NBD_ERROR_INVALID				= 22,
+	NBD_ERROR_OVERFLOW				= 75,
+	NBD_ERROR_NOT_SUPPORTED				= 95
+};
+
+/* The base:allocation meta context name and identifier
+ */
+#define NBD_META_CONTEXT_BASE_ALLOCATION		"base:allocation"
+#define NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH		15
+#define NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER	1
+
+/* The maximum size of option data the server accepts
+ */
+#define NBD_MAXIMUM_OPTION_DATA_SIZE			4096
+
+/* The maximum payload size of a read request
+ */
+#define NBD_MAXIMUM_PAYLOAD_SIZE			( 32 * 1024 * 1024 )
+
+/* The maximum number of block status descriptors per reply
+ */
+#define NBD_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS	1024
+
+#endif /* !defined( _NBD_DEFINITIONS_H ) */
+
@@ -0,0 +1,827 @@
+/*
+ * Network Block Device (NBD) server
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "mount_handle.h"
+#include "nbd_connection.h"
+#include "nbd_server.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+
+/* Creates a NBD server
+ * Make sure the value nbd_server is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_initialize(
+     nbd_server_t **nbd_server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_initialize";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_server = memory_allocate_structure(
+	               nbd_server_t );
+
+	if( *nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_server,
+	     0,
+	     sizeof( nbd_server_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_server )->mount_handle                  = mount_handle;
+	( *nbd_server )->socket_descriptor             = -1;
+	( *nbd_server )->maximum_number_of_connections = 4;
+	( *nbd_server )->notify_stream                 = stderr;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_server != NULL )
+	{
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD server
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_free(
+     nbd_server_t **nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_free";
+	int result            = 1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		if( ( *nbd_server )->socket_descriptor >= 0 )
+		{
+			if( nbd_server_close(
+			     *nbd_server,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close NBD server.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The mount_handle reference is freed elsewhere
+		 */
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD server to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_signal_abort(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_signal_abort";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->abort = 1;
+
+	/* Shutting down the listening socket causes a blocked accept to return
+	 */
+	if( nbd_server->socket_descriptor >= 0 )
+	{
+		shutdown(
+		 nbd_server->socket_descriptor,
+		 SHUT_RDWR );
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of concurrent connections
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_set_maximum_number_of_connections(
+     nbd_server_t *nbd_server,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_set_maximum_number_of_connections";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of connections value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->maximum_number_of_connections = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the NBD server on an Unix domain socket
+ * A stale socket at the path is removed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_open(
+     nbd_server_t *nbd_server,
+     const char *socket_path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+	struct stat file_statistics;
+
+	static char *function = "nbd_server_open";
+	size_t socket_path_length = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor >= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server - socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	socket_path_length = narrow_string_length(
+	                      socket_path );
+
+	if( ( socket_path_length == 0 )
+	 || ( socket_path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		goto on_error;
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( memory_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only remove an existing file if it is a socket
+	 */
+	if( lstat(
+	     socket_path,
+	     &file_statistics ) == 0 )
+	{
+		if( !S_ISSOCK( file_statistics.st_mode ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: socket path: %s already exists and is not a socket.",
+			 function,
+			 socket_path );
+
+			goto on_error;
+		}
+		if( unlink(
+		     socket_path ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove stale socket: %s.",
+			 function,
+			 socket_path );
+
+			goto on_error;
+		}
+	}
+	nbd_server->socket_path = narrow_string_allocate(
+	                           socket_path_length + 1 );
+
+	if( nbd_server->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     nbd_server->socket_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_server->socket_path[ socket_path_length ] = 0;
+
+	nbd_server->socket_path_size = socket_path_length + 1;
+
+	nbd_server->socket_descriptor = socket(
+	                                 AF_UNIX,
+	                                 SOCK_STREAM,
+	                                 0 );
+
+	if( nbd_server->socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( bind(
+	     nbd_server->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to: %s.",
+		 function,
+		 socket_path );
+
+		goto on_error;
+	}
+	if( listen(
+	     nbd_server->socket_descriptor,
+	     nbd_server->maximum_number_of_connections ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		unlink(
+		 socket_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_server->socket_descriptor >= 0 )
+	{
+		close(
+		 nbd_server->socket_descriptor );
+
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path = NULL;
+	}
+	nbd_server->socket_path_size = 0;
+
+	return( -1 );
+}
+
+/* Closes the NBD server and removes the socket
+ * Returns 0 if successful or -1 on error
+ */
+int nbd_server_close(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_close";
+	int result            = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor >= 0 )
+	{
+		if( close(
+		     nbd_server->socket_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		if( unlink(
+		     nbd_server->socket_path ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove socket: %s.",
+			 function,
+			 nbd_server->socket_path );
+
+			result = -1;
+		}
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path      = NULL;
+		nbd_server->socket_path_size = 0;
+	}
+	return( result );
+}
+
+/* Serves a connection
+ * The connection is freed afterwards
+ * Callback function for the connections thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_serve_connection(
+     nbd_connection_t *connection,
+     nbd_server_t *nbd_server )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_server_serve_connection";
+	int result               = 0;
+
+	if( connection == NULL )
+	{
+		return( -1 );
+	}
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	result = nbd_connection_negotiate(
+	          connection,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate connection.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 1 )
+	{
+		if( nbd_connection_handle_requests(
+		     connection,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle requests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( nbd_connection_free(
+	     &connection,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free connection.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		/* A failing connection does not affect the other connections
+		 */
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( connection != NULL )
+	{
+		nbd_connection_free(
+		 &connection,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Runs the NBD server, accepting connections until abort was signalled
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_run(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	nbd_connection_t *connection = NULL;
+	static char *function        = "nbd_server_run";
+	int socket_descriptor        = -1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD server - missing socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_create(
+	     &( nbd_server->connections_thread_pool ),
+	     NULL,
+	     nbd_server->maximum_number_of_connections,
+	     nbd_server->maximum_number_of_connections,
+	     (int (*)(intptr_t *, void *)) &nbd_server_serve_connection,
+	     (void *) nbd_server,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create connections thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	while( nbd_server->abort == 0 )
+	{
+		socket_descriptor = accept(
+		                     nbd_server->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( nbd_server->abort != 0 )
+			{
+				break;
+			}
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			goto on_error;
+		}
+		if( nbd_connection_initialize(
+		     &connection,
+		     nbd_server->mount_handle,
+		     socket_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The push blocks while all connection threads are busy
+		 */
+		if( libcthreads_thread_pool_push(
+		     nbd_server->connections_thread_pool,
+		     (intptr_t *) connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push connection onto thread pool.",
+			 function );
+
+			goto on_error;
+		}
+#else
+		nbd_server_serve_connection(
+		 connection,
+		 nbd_server );
+#endif
+		connection = NULL;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_join(
+	     &( nbd_server->connections_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join connections thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( connection != NULL )
+	{
+		nbd_connection_free(
+		 &connection,
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_server->connections_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( nbd_server->connections_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
@@ -0,0 +1,117 @@
+/*
+ * Network Block Device (NBD) server
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_SERVER_H )
+#define _NBD_SERVER_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "mount_handle.h"
+#include "nbd_connection.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct nbd_server nbd_server_t;
+
+struct nbd_server
+{
+	/* The mount handle
+	 */
+	mount_handle_t *mount_handle;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The socket path
+	 */
+	char *socket_path;
+
+	/* The socket path size
+	 */
+	size_t socket_path_size;
+
+	/* The maximum number of concurrent connections
+	 */
+	int maximum_number_of_connections;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connections thread pool
+	 */
+	libcthreads_thread_pool_t *connections_thread_pool;
+#endif
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int nbd_server_initialize(
+     nbd_server_t **nbd_server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
+int nbd_server_free(
+     nbd_server_t **nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_signal_abort(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_set_maximum_number_of_connections(
+     nbd_server_t *nbd_server,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_server_open(
+     nbd_server_t *nbd_server,
+     const char *socket_path,
+     libcerror_error_t **error );
+
+int nbd_server_close(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_serve_connection(
+     nbd_connection_t *connection,
+     nbd_server_t *nbd_server );
+
+int nbd_server_run(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_SERVER_H ) */
+
@@ -0,0 +1,1038 @@
+/*
+ * QEMU Copy-On-Write (QCOW) version 2 image writer
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "qcow2_writer.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+/* The image is written as version 3 since it supports zero clusters
+ */
+#define QCOW2_WRITER_FORMAT_VERSION		3
+#define QCOW2_WRITER_HEADER_SIZE		104
+
+#define QCOW2_WRITER_EXTENSION_BACKING_FORMAT	0xe2792acaUL
+
+/* Flag to indicate the reference count of the cluster is exactly 1
+ */
+#define QCOW2_WRITER_FLAG_COPIED		0x8000000000000000ULL
+
+/* Flag to indicate the cluster reads as zero bytes
+ */
+#define QCOW2_WRITER_FLAG_ZERO			0x0000000000000001ULL
+
+/* Marker of a data cluster of which the offset has not been allocated
+ */
+#define QCOW2_WRITER_MARKER_DATA		0x0000000000000002ULL
+
+/* Creates a QCOW2 writer
+ * Make sure the value qcow2_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_initialize(
+     qcow2_writer_t **qcow2_writer,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "qcow2_writer_initialize";
+	uint64_t number_of_clusters   = 0;
+	uint64_t number_of_l1_entries = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *qcow2_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid QCOW2 writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_clusters = ( media_size + QCOW2_WRITER_CLUSTER_SIZE - 1 ) / QCOW2_WRITER_CLUSTER_SIZE;
+
+	number_of_l1_entries = ( number_of_clusters + QCOW2_WRITER_NUMBER_OF_L2_ENTRIES - 1 ) / QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+
+	/* The level 1 table size is stored as a 32-bit value
+	 */
+	if( ( number_of_l1_entries == 0 )
+	 || ( number_of_l1_entries > (uint64_t) UINT32_MAX )
+	 || ( number_of_l1_entries > (uint64_t) ( SSIZE_MAX / sizeof( uint64_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*qcow2_writer = memory_allocate_structure(
+	                 qcow2_writer_t );
+
+	if( *qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *qcow2_writer,
+	     0,
+	     sizeof( qcow2_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear QCOW2 writer.",
+		 function );
+
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+
+		return( -1 );
+	}
+	( *qcow2_writer )->l2_tables = (uint64_t **) memory_allocate(
+	                                              sizeof( uint64_t * ) * number_of_l1_entries );
+
+	if( ( *qcow2_writer )->l2_tables == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create level 2 tables.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *qcow2_writer )->l2_tables,
+	     0,
+	     sizeof( uint64_t * ) * number_of_l1_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear level 2 tables.",
+		 function );
+
+		goto on_error;
+	}
+	( *qcow2_writer )->media_size           = media_size;
+	( *qcow2_writer )->number_of_l1_entries = number_of_l1_entries;
+
+	return( 1 );
+
+on_error:
+	if( *qcow2_writer != NULL )
+	{
+		if( ( *qcow2_writer )->l2_tables != NULL )
+		{
+			memory_free(
+			 ( *qcow2_writer )->l2_tables );
+		}
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a QCOW2 writer
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_free(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_free";
+	uint64_t l1_index     = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *qcow2_writer != NULL )
+	{
+		for( l1_index = 0;
+		     l1_index < ( *qcow2_writer )->number_of_l1_entries;
+		     l1_index++ )
+		{
+			if( ( *qcow2_writer )->l2_tables[ l1_index ] != NULL )
+			{
+				memory_free(
+				 ( *qcow2_writer )->l2_tables[ l1_index ] );
+			}
+		}
+		memory_free(
+		 ( *qcow2_writer )->l2_tables );
+
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the type of a cluster
+ * Clusters that are not set are unallocated and are read from the backing file
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_set_cluster_type(
+     qcow2_writer_t *qcow2_writer,
+     uint64_t cluster_index,
+     int cluster_type,
+     libcerror_error_t **error )
+{
+	uint64_t *l2_table    = NULL;
+	static char *function = "qcow2_writer_set_cluster_type";
+	uint64_t l1_index     = 0;
+	uint64_t l2_index     = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->is_allocated != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid QCOW2 writer - clusters already allocated.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cluster_type != QCOW2_WRITER_CLUSTER_TYPE_ZERO )
+	 && ( cluster_type != QCOW2_WRITER_CLUSTER_TYPE_DATA ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cluster type.",
+		 function );
+
+		return( -1 );
+	}
+	l1_index = cluster_index / QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+	l2_index = cluster_index % QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+
+	if( l1_index >= qcow2_writer->number_of_l1_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cluster index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	l2_table = qcow2_writer->l2_tables[ l1_index ];
+
+	if( l2_table == NULL )
+	{
+		l2_table = (uint64_t *) memory_allocate(
+		                         sizeof( uint64_t ) * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES );
+
+		if( l2_table == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create level 2 table.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     l2_table,
+		     0,
+		     sizeof( uint64_t ) * QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear level 2 table.",
+			 function );
+
+			memory_free(
+			 l2_table );
+
+			return( -1 );
+		}
+		qcow2_writer->l2_tables[ l1_index ] = l2_table;
+
+		qcow2_writer->number_of_l2_tables += 1;
+	}
+	if( l2_table[ l2_index ] == QCOW2_WRITER_MARKER_DATA )
+	{
+		qcow2_writer->number_of_data_clusters -= 1;
+	}
+	else if( l2_table[ l2_index ] == QCOW2_WRITER_FLAG_ZERO )
+	{
+		qcow2_writer->number_of_zero_clusters -= 1;
+	}
+	if( cluster_type == QCOW2_WRITER_CLUSTER_TYPE_DATA )
+	{
+		l2_table[ l2_index ] = QCOW2_WRITER_MARKER_DATA;
+
+		qcow2_writer->number_of_data_clusters += 1;
+	}
+	else
+	{
+		l2_table[ l2_index ] = QCOW2_WRITER_FLAG_ZERO;
+
+		qcow2_writer->number_of_zero_clusters += 1;
+	}
+	return( 1 );
+}
+
+/* Allocates the metadata and data clusters
+ * The image consists of the header cluster, the level 1 table, the refcount
+ * table, the refcount blocks, the level 2 tables and the data clusters in
+ * the order of the clusters in the media. Every cluster is referenced once
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_allocate(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error )
+{
+	uint64_t *l2_table                         = NULL;
+	static char *function                      = "qcow2_writer_allocate";
+	uint64_t l1_index                          = 0;
+	uint64_t l2_index                          = 0;
+	uint64_t number_of_clusters                = 0;
+	uint64_t number_of_refcount_blocks         = 0;
+	uint64_t number_of_refcount_table_clusters = 0;
+	off64_t data_cluster_offset                = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->is_allocated != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid QCOW2 writer - clusters already allocated.",
+		 function );
+
+		return( -1 );
+	}
+	qcow2_writer->number_of_l1_table_clusters = ( ( qcow2_writer->number_of_l1_entries * 8 ) + QCOW2_WRITER_CLUSTER_SIZE - 1 ) / QCOW2_WRITER_CLUSTER_SIZE;
+
+	/* The refcount blocks also need to account for the clusters they use themselves
+	 */
+	do
+	{
+		qcow2_writer->number_of_refcount_blocks         = number_of_refcount_blocks;
+		qcow2_writer->number_of_refcount_table_clusters = number_of_refcount_table_clusters;
+
+		number_of_clusters = 1
+		                   + qcow2_writer->number_of_l1_table_clusters
+		                   + qcow2_writer->number_of_refcount_table_clusters
+		                   + qcow2_writer->number_of_refcount_blocks
+		                   + qcow2_writer->number_of_l2_tables
+		                   + qcow2_writer->number_of_data_clusters;
+
+		number_of_refcount_blocks = ( number_of_clusters + QCOW2_WRITER_NUMBER_OF_REFCOUNT_ENTRIES - 1 ) / QCOW2_WRITER_NUMBER_OF_REFCOUNT_ENTRIES;
+
+		number_of_refcount_table_clusters = ( ( number_of_refcount_blocks * 8 ) + QCOW2_WRITER_CLUSTER_SIZE - 1 ) / QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	while( ( number_of_refcount_blocks != qcow2_writer->number_of_refcount_blocks )
+	    || ( number_of_refcount_table_clusters != qcow2_writer->number_of_refcount_table_clusters ) );
+
+	/* The refcount table cluster count is stored as a 32-bit value
+	 */
+	if( qcow2_writer->number_of_refcount_table_clusters > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of refcount table clusters value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	qcow2_writer->l1_table_offset        = (off64_t) QCOW2_WRITER_CLUSTER_SIZE;
+	qcow2_writer->refcount_table_offset  = qcow2_writer->l1_table_offset + (off64_t) ( qcow2_writer->number_of_l1_table_clusters * QCOW2_WRITER_CLUSTER_SIZE );
+	qcow2_writer->refcount_blocks_offset = qcow2_writer->refcount_table_offset + (off64_t) ( qcow2_writer->number_of_refcount_table_clusters * QCOW2_WRITER_CLUSTER_SIZE );
+	qcow2_writer->l2_tables_offset       = qcow2_writer->refcount_blocks_offset + (off64_t) ( qcow2_writer->number_of_refcount_blocks * QCOW2_WRITER_CLUSTER_SIZE );
+	qcow2_writer->data_offset            = qcow2_writer->l2_tables_offset + (off64_t) ( qcow2_writer->number_of_l2_tables * QCOW2_WRITER_CLUSTER_SIZE );
+	qcow2_writer->file_size              = number_of_clusters * QCOW2_WRITER_CLUSTER_SIZE;
+
+	data_cluster_offset = qcow2_writer->data_offset;
+
+	for( l1_index = 0;
+	     l1_index < qcow2_writer->number_of_l1_entries;
+	     l1_index++ )
+	{
+		l2_table = qcow2_writer->l2_tables[ l1_index ];
+
+		if( l2_table == NULL )
+		{
+			continue;
+		}
+		for( l2_index = 0;
+		     l2_index < QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+		     l2_index++ )
+		{
+			if( l2_table[ l2_index ] == QCOW2_WRITER_MARKER_DATA )
+			{
+				l2_table[ l2_index ] = (uint64_t) data_cluster_offset | QCOW2_WRITER_FLAG_COPIED;
+
+				data_cluster_offset += QCOW2_WRITER_CLUSTER_SIZE;
+			}
+		}
+	}
+	qcow2_writer->is_allocated = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the offset of a data cluster in the image
+ * Returns 1 if successful, 0 if the cluster is not a data cluster or -1 on error
+ */
+int qcow2_writer_get_cluster_offset(
+     qcow2_writer_t *qcow2_writer,
+     uint64_t cluster_index,
+     off64_t *cluster_offset,
+     libcerror_error_t **error )
+{
+	uint64_t *l2_table    = NULL;
+	static char *function = "qcow2_writer_get_cluster_offset";
+	uint64_t l1_index     = 0;
+	uint64_t l2_entry     = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->is_allocated == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid QCOW2 writer - clusters not allocated.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster offset.",
+		 function );
+
+		return( -1 );
+	}
+	l1_index = cluster_index / QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+
+	if( l1_index >= qcow2_writer->number_of_l1_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cluster index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	l2_table = qcow2_writer->l2_tables[ l1_index ];
+
+	if( l2_table == NULL )
+	{
+		return( 0 );
+	}
+	l2_entry = l2_table[ cluster_index % QCOW2_WRITER_NUMBER_OF_L2_ENTRIES ];
+
+	if( ( l2_entry & QCOW2_WRITER_FLAG_COPIED ) == 0 )
+	{
+		return( 0 );
+	}
+	*cluster_offset = (off64_t) ( l2_entry & ~QCOW2_WRITER_FLAG_COPIED );
+
+	return( 1 );
+}
+
+/* Writes a cluster at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_cluster(
+     qcow2_writer_t *qcow2_writer,
+     libcfile_file_t *file,
+     off64_t offset,
+     const uint8_t *cluster_data,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_write_cluster";
+	ssize_t write_count   = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     file,
+	     offset,
+	     SEEK_SET,
+	     error ) != offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               cluster_data,
+	               QCOW2_WRITER_CLUSTER_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) QCOW2_WRITER_CLUSTER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write cluster at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the metadata of the image
+ * The file is resized to the size of the image, the data clusters are not written
+ * The backing file is expected to be a raw image
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_metadata(
+     qcow2_writer_t *qcow2_writer,
+     libcfile_file_t *file,
+     const char *backing_filename,
+     size_t backing_filename_length,
+     libcerror_error_t **error )
+{
+	uint8_t *cluster_data         = NULL;
+	uint64_t *l2_table            = NULL;
+	static char *function         = "qcow2_writer_write_metadata";
+	size_t cluster_data_offset    = 0;
+	uint64_t cluster_index        = 0;
+	uint64_t entry_index          = 0;
+	uint64_t l1_index             = 0;
+	uint64_t l2_index             = 0;
+	uint64_t number_of_clusters   = 0;
+	uint64_t refcount_block_index = 0;
+	off64_t l2_table_offset       = 0;
+	off64_t offset                = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->is_allocated == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid QCOW2 writer - clusters not allocated.",
+		 function );
+
+		return( -1 );
+	}
+	if( backing_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid backing filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The header, the header extensions and the backing filename are stored in the first cluster
+	 */
+	if( ( backing_filename_length == 0 )
+	 || ( backing_filename_length > 1023 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid backing filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * QCOW2_WRITER_CLUSTER_SIZE );
+
+	if( cluster_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cluster data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_resize(
+	     file,
+	     qcow2_writer->file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to resize file.",
+		 function );
+
+		goto on_error;
+	}
+	/* Write the header
+	 */
+	if( memory_set(
+	     cluster_data,
+	     0,
+	     QCOW2_WRITER_CLUSTER_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cluster data.",
+		 function );
+
+		goto on_error;
+	}
+	cluster_data[ 0 ] = 'Q';
+	cluster_data[ 1 ] = 'F';
+	cluster_data[ 2 ] = 'I';
+	cluster_data[ 3 ] = 0xfb;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 4 ] ),
+	 QCOW2_WRITER_FORMAT_VERSION );
+
+	/* The backing filename is stored after the backing format header extension and the end marker
+	 */
+	byte_stream_copy_from_uint64_big_endian(
+	 &( cluster_data[ 8 ] ),
+	 (uint64_t) ( QCOW2_WRITER_HEADER_SIZE + 16 + 8 ) );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 16 ] ),
+	 (uint32_t) backing_filename_length );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 20 ] ),
+	 QCOW2_WRITER_CLUSTER_BITS );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( cluster_data[ 24 ] ),
+	 qcow2_writer->media_size );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 36 ] ),
+	 (uint32_t) qcow2_writer->number_of_l1_entries );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( cluster_data[ 40 ] ),
+	 qcow2_writer->l1_table_offset );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( cluster_data[ 48 ] ),
+	 qcow2_writer->refcount_table_offset );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 56 ] ),
+	 (uint32_t) qcow2_writer->number_of_refcount_table_clusters );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 96 ] ),
+	 QCOW2_WRITER_REFCOUNT_ORDER );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ 100 ] ),
+	 QCOW2_WRITER_HEADER_SIZE );
+
+	/* The backing format header extension, the data is padded to a multiple of 8 bytes
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ QCOW2_WRITER_HEADER_SIZE ] ),
+	 QCOW2_WRITER_EXTENSION_BACKING_FORMAT );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cluster_data[ QCOW2_WRITER_HEADER_SIZE + 4 ] ),
+	 3 );
+
+	cluster_data[ QCOW2_WRITER_HEADER_SIZE + 8 ]  = 'r';
+	cluster_data[ QCOW2_WRITER_HEADER_SIZE + 9 ]  = 'a';
+	cluster_data[ QCOW2_WRITER_HEADER_SIZE + 10 ] = 'w';
+
+	/* The end of header extensions marker is 8 bytes of 0
+	 */
+	if( memory_copy(
+	     &( cluster_data[ QCOW2_WRITER_HEADER_SIZE + 16 + 8 ] ),
+	     backing_filename,
+	     backing_filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy backing filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( qcow2_writer_write_cluster(
+	     qcow2_writer,
+	     file,
+	     0,
+	     cluster_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write header.",
+		 function );
+
+		goto on_error;
+	}
+	/* Write the level 1 table, the level 2 tables are stored in the order of the level 1 entries
+	 */
+	offset          = qcow2_writer->l1_table_offset;
+	l2_table_offset = qcow2_writer->l2_tables_offset;
+	l1_index        = 0;
+
+	while( l1_index < qcow2_writer->number_of_l1_entries )
+	{
+		if( memory_set(
+		     cluster_data,
+		     0,
+		     QCOW2_WRITER_CLUSTER_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster data.",
+			 function );
+
+			goto on_error;
+		}
+		for( cluster_data_offset = 0;
+		     cluster_data_offset < QCOW2_WRITER_CLUSTER_SIZE;
+		     cluster_data_offset += 8 )
+		{
+			if( l1_index >= qcow2_writer->number_of_l1_entries )
+			{
+				break;
+			}
+			if( qcow2_writer->l2_tables[ l1_index ] != NULL )
+			{
+				byte_stream_copy_from_uint64_big_endian(
+				 &( cluster_data[ cluster_data_offset ] ),
+				 (uint64_t) l2_table_offset | QCOW2_WRITER_FLAG_COPIED );
+
+				l2_table_offset += QCOW2_WRITER_CLUSTER_SIZE;
+			}
+			l1_index++;
+		}
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     file,
+		     offset,
+		     cluster_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write level 1 table.",
+			 function );
+
+			goto on_error;
+		}
+		offset += QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	/* Write the refcount table
+	 */
+	offset               = qcow2_writer->refcount_table_offset;
+	refcount_block_index = 0;
+
+	while( refcount_block_index < qcow2_writer->number_of_refcount_blocks )
+	{
+		if( memory_set(
+		     cluster_data,
+		     0,
+		     QCOW2_WRITER_CLUSTER_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster data.",
+			 function );
+
+			goto on_error;
+		}
+		for( cluster_data_offset = 0;
+		     cluster_data_offset < QCOW2_WRITER_CLUSTER_SIZE;
+		     cluster_data_offset += 8 )
+		{
+			if( refcount_block_index >= qcow2_writer->number_of_refcount_blocks )
+			{
+				break;
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 &( cluster_data[ cluster_data_offset ] ),
+			 qcow2_writer->refcount_blocks_offset + (off64_t) ( refcount_block_index * QCOW2_WRITER_CLUSTER_SIZE ) );
+
+			refcount_block_index++;
+		}
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     file,
+		     offset,
+		     cluster_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write refcount table.",
+			 function );
+
+			goto on_error;
+		}
+		offset += QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	/* Write the refcount blocks, every cluster of the image is referenced once
+	 */
+	number_of_clusters = qcow2_writer->file_size / QCOW2_WRITER_CLUSTER_SIZE;
+	cluster_index      = 0;
+
+	for( refcount_block_index = 0;
+	     refcount_block_index < qcow2_writer->number_of_refcount_blocks;
+	     refcount_block_index++ )
+	{
+		if( memory_set(
+		     cluster_data,
+		     0,
+		     QCOW2_WRITER_CLUSTER_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster data.",
+			 function );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < QCOW2_WRITER_NUMBER_OF_REFCOUNT_ENTRIES;
+		     entry_index++ )
+		{
+			if( cluster_index >= number_of_clusters )
+			{
+				break;
+			}
+			byte_stream_copy_from_uint16_big_endian(
+			 &( cluster_data[ entry_index * 2 ] ),
+			 1 );
+
+			cluster_index++;
+		}
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     file,
+		     offset,
+		     cluster_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write refcount block: %" PRIu64 ".",
+			 function,
+			 refcount_block_index );
+
+			goto on_error;
+		}
+		offset += QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	/* Write the level 2 tables
+	 */
+	for( l1_index = 0;
+	     l1_index < qcow2_writer->number_of_l1_entries;
+	     l1_index++ )
+	{
+		l2_table = qcow2_writer->l2_tables[ l1_index ];
+
+		if( l2_table == NULL )
+		{
+			continue;
+		}
+		for( l2_index = 0;
+		     l2_index < QCOW2_WRITER_NUMBER_OF_L2_ENTRIES;
+		     l2_index++ )
+		{
+			byte_stream_copy_from_uint64_big_endian(
+			 &( cluster_data[ l2_index * 8 ] ),
+			 l2_table[ l2_index ] );
+		}
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     file,
+		     offset,
+		     cluster_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write level 2 table: %" PRIu64 ".",
+			 function,
+			 l1_index );
+
+			goto on_error;
+		}
+		offset += QCOW2_WRITER_CLUSTER_SIZE;
+	}
+	memory_free(
+	 cluster_data );
+
+	return( 1 );
+
+on_error:
+	if( cluster_data != NULL )
+	{
+		memory_free(
+		 cluster_data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,167 @@
+/*
+ * QEMU Copy-On-Write (QCOW) version 2 image writer
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _QCOW2_WRITER_H )
+#define _QCOW2_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define QCOW2_WRITER_CLUSTER_BITS			16
+#define QCOW2_WRITER_CLUSTER_SIZE			( 1 << QCOW2_WRITER_CLUSTER_BITS )
+
+/* The number of entries in a level 2 table
+ */
+#define QCOW2_WRITER_NUMBER_OF_L2_ENTRIES		( QCOW2_WRITER_CLUSTER_SIZE / 8 )
+
+/* The refcounts are 16-bit values
+ */
+#define QCOW2_WRITER_REFCOUNT_ORDER			4
+#define QCOW2_WRITER_NUMBER_OF_REFCOUNT_ENTRIES		( QCOW2_WRITER_CLUSTER_SIZE / 2 )
+
+enum QCOW2_WRITER_CLUSTER_TYPES
+{
+	QCOW2_WRITER_CLUSTER_TYPE_UNALLOCATED		= 0,
+	QCOW2_WRITER_CLUSTER_TYPE_ZERO			= 1,
+	QCOW2_WRITER_CLUSTER_TYPE_DATA			= 2
+};
+
+typedef struct qcow2_writer qcow2_writer_t;
+
+struct qcow2_writer
+{
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of level 1 table entries
+	 */
+	uint64_t number_of_l1_entries;
+
+	/* The level 2 tables, per level 1 table entry, NULL if not allocated
+	 */
+	uint64_t **l2_tables;
+
+	/* The number of level 2 tables
+	 */
+	uint64_t number_of_l2_tables;
+
+	/* The number of data clusters
+	 */
+	uint64_t number_of_data_clusters;
+
+	/* The number of zero clusters
+	 */
+	uint64_t number_of_zero_clusters;
+
+	/* The number of level 1 table clusters
+	 */
+	uint64_t number_of_l1_table_clusters;
+
+	/* The number of refcount table clusters
+	 */
+	uint64_t number_of_refcount_table_clusters;
+
+	/* The number of refcount blocks
+	 */
+	uint64_t number_of_refcount_blocks;
+
+	/* The level 1 table offset
+	 */
+	off64_t l1_table_offset;
+
+	/* The refcount table offset
+	 */
+	off64_t refcount_table_offset;
+
+	/* The offset of the first refcount block
+	 */
+	off64_t refcount_blocks_offset;
+
+	/* The offset of the first level 2 table
+	 */
+	off64_t l2_tables_offset;
+
+	/* The offset of the first data cluster
+	 */
+	off64_t data_offset;
+
+	/* The file size
+	 */
+	size64_t file_size;
+
+	/* Value to indicate the clusters have been allocated
+	 */
+	uint8_t is_allocated;
+};
+
+int qcow2_writer_initialize(
+     qcow2_writer_t **qcow2_writer,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+int qcow2_writer_free(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_set_cluster_type(
+     qcow2_writer_t *qcow2_writer,
+     uint64_t cluster_index,
+     int cluster_type,
+     libcerror_error_t **error );
+
+int qcow2_writer_allocate(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_get_cluster_offset(
+     qcow2_writer_t *qcow2_writer,
+     uint64_t cluster_index,
+     off64_t *cluster_offset,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_cluster(
+     qcow2_writer_t *qcow2_writer,
+     libcfile_file_t *file,
+     off64_t offset,
+     const uint8_t *cluster_data,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_metadata(
+     qcow2_writer_t *qcow2_writer,
+     libcfile_file_t *file,
+     const char *backing_filename,
+     size_t backing_filename_length,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _QCOW2_WRITER_H ) */
+
@@ -0,0 +1,285 @@
+/*
+ * Read statistics
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "read_statistics.h"
+#include "vshadowtools_libcerror.h"
+
+/* Retrieves the current time of a monotonic clock in microseconds
+ * Returns 1 if successful or -1 on error
+ */
+int read_statistics_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+#endif
+
+	static char *function = "read_statistics_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000 ) + ( (uint64_t) time_value.tv_nsec / 1000 );
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000 ) + (uint64_t) time_value.tv_usec;
+
+#else
+	/* Without a clock the latencies are not measured
+	 */
+	*current_time = 0;
+#endif
+	return( 1 );
+}
+
+/* Updates the read statistics with a read request
+ * This function is not multi-thread safe, the caller must serialize updates
+ * Returns 1 if successful or -1 on error
+ */
+int read_statistics_update(
+     read_statistics_t *read_statistics,
+     size_t read_size,
+     uint8_t read_failed,
+     uint64_t lock_wait_time,
+     uint64_t read_time,
+     libcerror_error_t **error )
+{
+	static char *function = "read_statistics_update";
+	uint64_t latency      = 0;
+	int bucket_index      = 0;
+
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	read_statistics->number_of_requests += 1;
+	read_statistics->number_of_bytes    += (uint64_t) read_size;
+	read_statistics->lock_wait_time     += lock_wait_time;
+	read_statistics->read_time          += read_time;
+
+	if( read_failed != 0 )
+	{
+		read_statistics->number_of_errors += 1;
+	}
+	/* The latency includes the time spent waiting for the read lock
+	 */
+	latency = lock_wait_time + read_time;
+
+	while( ( latency > 0 )
+	    && ( bucket_index < ( READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS - 1 ) ) )
+	{
+		latency >>= 1;
+
+		bucket_index++;
+	}
+	read_statistics->latency_histogram[ bucket_index ] += 1;
+
+	return( 1 );
+}
+
+/* Merges read statistics into other read statistics
+ * Returns 1 if successful or -1 on error
+ */
+int read_statistics_merge(
+     read_statistics_t *read_statistics,
+     const read_statistics_t *source_read_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "read_statistics_merge";
+	int bucket_index      = 0;
+
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	read_statistics->number_of_requests += source_read_statistics->number_of_requests;
+	read_statistics->number_of_bytes    += source_read_statistics->number_of_bytes;
+	read_statistics->number_of_errors   += source_read_statistics->number_of_errors;
+	read_statistics->lock_wait_time     += source_read_statistics->lock_wait_time;
+	read_statistics->read_time          += source_read_statistics->read_time;
+
+	for( bucket_index = 0;
+	     bucket_index < READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS;
+	     bucket_index++ )
+	{
+		read_statistics->latency_histogram[ bucket_index ] += source_read_statistics->latency_histogram[ bucket_index ];
+	}
+	return( 1 );
+}
+
+/* Retrieves a read latency percentile
+ * The latency is the upper bound of the histogram bucket that contains the percentile
+ * Returns 1 if successful, 0 if no reads were recorded or -1 on error
+ */
+int read_statistics_get_latency_percentile(
+     const read_statistics_t *read_statistics,
+     uint8_t percentile,
+     uint64_t *latency,
+     libcerror_error_t **error )
+{
+	static char *function       = "read_statistics_get_latency_percentile";
+	uint64_t number_of_requests = 0;
+	uint64_t threshold          = 0;
+	int bucket_index            = 0;
+
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( percentile == 0 )
+	 || ( percentile > 100 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid percentile value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( latency == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latency.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics->number_of_requests == 0 )
+	{
+		return( 0 );
+	}
+	/* Determine the number of requests, rounded up, that are within the percentile
+	 */
+	threshold = ( ( read_statistics->number_of_requests * percentile ) + 99 ) / 100;
+
+	for( bucket_index = 0;
+	     bucket_index < READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS;
+	     bucket_index++ )
+	{
+		number_of_requests += read_statistics->latency_histogram[ bucket_index ];
+
+		if( number_of_requests >= threshold )
+		{
+			break;
+		}
+	}
+	if( bucket_index >= READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS )
+	{
+		bucket_index = READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS - 1;
+	}
+	*latency = (uint64_t) 1 << bucket_index;
+
+	return( 1 );
+}
+
@@ -0,0 +1,96 @@
+/*
+ * Read statistics
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _READ_STATISTICS_H )
+#define _READ_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of latency histogram buckets
+ * bucket N contains the reads with a latency smaller than 2^N microseconds
+ */
+#define READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS	32
+
+typedef struct read_statistics read_statistics_t;
+
+struct read_statistics
+{
+	/* The number of read requests
+	 */
+	uint64_t number_of_requests;
+
+	/* The number of bytes requested
+	 */
+	uint64_t number_of_bytes;
+
+	/* The number of failed read requests
+	 */
+	uint64_t number_of_errors;
+
+	/* The time spent waiting for the read lock in microseconds
+	 */
+	uint64_t lock_wait_time;
+
+	/* The time spent reading in microseconds
+	 */
+	uint64_t read_time;
+
+	/* The read latency histogram
+	 */
+	uint64_t latency_histogram[ READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS ];
+};
+
+int read_statistics_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error );
+
+int read_statistics_update(
+     read_statistics_t *read_statistics,
+     size_t read_size,
+     uint8_t read_failed,
+     uint64_t lock_wait_time,
+     uint64_t read_time,
+     libcerror_error_t **error );
+
+int read_statistics_merge(
+     read_statistics_t *read_statistics,
+     const read_statistics_t *source_read_statistics,
+     libcerror_error_t **error );
+
+int read_statistics_get_latency_percentile(
+     const read_statistics_t *read_statistics,
+     uint8_t percentile,
+     uint64_t *latency,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _READ_STATISTICS_H ) */
+
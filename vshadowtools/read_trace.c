@@ -0,0 +1,964 @@
+/*
+ * Read trace
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#include "read_statistics.h"
+#include "read_trace.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+
+/* Creates a read trace
+ * Make sure the value read_trace is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_initialize(
+     read_trace_t **read_trace,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_initialize";
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_trace != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read trace value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*read_trace = memory_allocate_structure(
+	               read_trace_t );
+
+	if( *read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_trace,
+	     0,
+	     sizeof( read_trace_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read trace.",
+		 function );
+
+		memory_free(
+		 *read_trace );
+
+		*read_trace = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_trace )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *read_trace != NULL )
+	{
+		memory_free(
+		 *read_trace );
+
+		*read_trace = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read trace
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_free(
+     read_trace_t **read_trace,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_free";
+	int result            = 1;
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_trace != NULL )
+	{
+		if( ( *read_trace )->stream != NULL )
+		{
+			if( read_trace_close(
+			     *read_trace,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close read trace.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *read_trace )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_trace );
+
+		*read_trace = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file stream of the read trace
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_open_stream(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     const system_character_t *mode,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_open_stream";
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_trace->stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read trace - stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	read_trace->stream = file_stream_open_wide(
+	                      filename,
+	                      mode );
+#else
+	read_trace->stream = file_stream_open(
+	                      filename,
+	                      mode );
+#endif
+	if( read_trace->stream == NULL )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open read trace: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	read_trace->number_of_entries = 0;
+	read_trace->line_number       = 0;
+
+	return( 1 );
+}
+
+/* Opens a read trace for writing
+ * An existing read trace is overwritten
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_open_write(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_open_write";
+
+	if( read_trace_open_stream(
+	     read_trace,
+	     filename,
+	     _SYSTEM_STRING( "w" ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open read trace for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( fprintf(
+	     read_trace->stream,
+	     "%s",
+	     READ_TRACE_HEADER ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write header.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_statistics_get_current_time(
+	     &( read_trace->start_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 read_trace->stream );
+
+	read_trace->stream = NULL;
+
+	return( -1 );
+}
+
+/* Opens a read trace for reading
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_open_read(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	char line[ READ_TRACE_MAXIMUM_LINE_SIZE ];
+
+	static char *function = "read_trace_open_read";
+	size_t header_length  = 0;
+
+	if( read_trace_open_stream(
+	     read_trace,
+	     filename,
+	     _SYSTEM_STRING( "r" ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open read trace for reading.",
+		 function );
+
+		return( -1 );
+	}
+	header_length = narrow_string_length(
+	                 READ_TRACE_HEADER );
+
+	if( ( file_stream_get_string(
+	       read_trace->stream,
+	       line,
+	       READ_TRACE_MAXIMUM_LINE_SIZE ) == NULL )
+	 || ( narrow_string_length(
+	       line ) != header_length )
+	 || ( narrow_string_compare(
+	       line,
+	       READ_TRACE_HEADER,
+	       header_length ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported read trace header.",
+		 function );
+
+		goto on_error;
+	}
+	read_trace->line_number = 1;
+
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 read_trace->stream );
+
+	read_trace->stream = NULL;
+
+	return( -1 );
+}
+
+/* Closes a read trace
+ * Returns the 0 if succesful or -1 on error
+ */
+int read_trace_close(
+     read_trace_t *read_trace,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_close";
+	int result            = 0;
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_trace->stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read trace - missing stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_stream_close(
+	     read_trace->stream ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close stream.",
+		 function );
+
+		result = -1;
+	}
+	read_trace->stream = NULL;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && ( defined( WINAPI ) || defined( HAVE_PTHREAD_H ) )
+	if( read_trace->thread_identifiers != NULL )
+	{
+		memory_free(
+		 read_trace->thread_identifiers );
+
+		read_trace->thread_identifiers = NULL;
+	}
+	read_trace->number_of_thread_identifiers = 0;
+#endif
+	return( result );
+}
+
+/* Retrieves the index of the calling thread
+ * Threads are numbered in order of their first read, without multi-thread support the index is 0
+ * The caller must hold the mutex
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_get_thread_index(
+     read_trace_t *read_trace,
+     int *thread_index,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && ( defined( WINAPI ) || defined( HAVE_PTHREAD_H ) )
+	read_trace_thread_identifier_t *thread_identifiers = NULL;
+	read_trace_thread_identifier_t thread_identifier;
+
+	int identifier_index                               = 0;
+#endif
+
+	static char *function                              = "read_trace_get_thread_index";
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && ( defined( WINAPI ) || defined( HAVE_PTHREAD_H ) )
+#if defined( WINAPI )
+	thread_identifier = GetCurrentThreadId();
+#else
+	thread_identifier = pthread_self();
+#endif
+	for( identifier_index = 0;
+	     identifier_index < read_trace->number_of_thread_identifiers;
+	     identifier_index++ )
+	{
+#if defined( WINAPI )
+		if( read_trace->thread_identifiers[ identifier_index ] == thread_identifier )
+#else
+		if( pthread_equal(
+		     read_trace->thread_identifiers[ identifier_index ],
+		     thread_identifier ) != 0 )
+#endif
+		{
+			*thread_index = identifier_index;
+
+			return( 1 );
+		}
+	}
+	/* The number of threads serving reads is small hence the array is grown per thread
+	 */
+	thread_identifiers = (read_trace_thread_identifier_t *) memory_reallocate(
+	                                                         read_trace->thread_identifiers,
+	                                                         sizeof( read_trace_thread_identifier_t ) * ( read_trace->number_of_thread_identifiers + 1 ) );
+
+	if( thread_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize thread identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	read_trace->thread_identifiers = thread_identifiers;
+
+	read_trace->thread_identifiers[ read_trace->number_of_thread_identifiers ] = thread_identifier;
+
+	*thread_index = read_trace->number_of_thread_identifiers;
+
+	read_trace->number_of_thread_identifiers += 1;
+#else
+	*thread_index = 0;
+#endif
+	return( 1 );
+}
+
+/* Appends an entry to the read trace
+ * The timestamp and thread index are determined by the read trace
+ * This function is multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_append_entry(
+     read_trace_t *read_trace,
+     int store_index,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_append_entry";
+	uint64_t current_time = 0;
+	int thread_index      = 0;
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_trace->stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read trace - missing stream.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The timestamp is determined while holding the mutex
+	 * so that the timestamps in the trace are in ascending order
+	 */
+	if( read_statistics_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_trace_get_thread_index(
+	     read_trace,
+	     &thread_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve thread index.",
+		 function );
+
+		goto on_error;
+	}
+	if( current_time < read_trace->start_time )
+	{
+		current_time = read_trace->start_time;
+	}
+	if( fprintf(
+	     read_trace->stream,
+	     "%" PRIu64 " %d %d %" PRIi64 " %" PRIzu "\n",
+	     current_time - read_trace->start_time,
+	     thread_index,
+	     store_index,
+	     offset,
+	     size ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write entry.",
+		 function );
+
+		goto on_error;
+	}
+	read_trace->number_of_entries += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_trace->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 read_trace->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Copies a decimal value from a field of a read trace line
+ * The string index is moved past the field and the whitespace that follows it
+ * Returns 1 if successful or -1 on error
+ */
+int read_trace_copy_field_from_64_bit_in_decimal(
+     const char *line,
+     size_t line_length,
+     size_t *line_index,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "read_trace_copy_field_from_64_bit_in_decimal";
+	size_t safe_index     = 0;
+	size_t start_index    = 0;
+	uint64_t digit        = 0;
+
+	if( line == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line index.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	safe_index   = *line_index;
+	start_index  = safe_index;
+	*value_64bit = 0;
+
+	while( safe_index < line_length )
+	{
+		if( ( line[ safe_index ] < '0' )
+		 || ( line[ safe_index ] > '9' ) )
+		{
+			break;
+		}
+		digit = (uint64_t) ( line[ safe_index ] - '0' );
+
+		if( *value_64bit > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+		*value_64bit += digit;
+
+		safe_index++;
+	}
+	if( safe_index == start_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( safe_index < line_length )
+	 && ( line[ safe_index ] != ' ' )
+	 && ( line[ safe_index ] != '\t' )
+	 && ( line[ safe_index ] != '\r' )
+	 && ( line[ safe_index ] != '\n' ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported character in value.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( safe_index < line_length )
+	    && ( ( line[ safe_index ] == ' ' )
+	     ||  ( line[ safe_index ] == '\t' ) ) )
+	{
+		safe_index++;
+	}
+	*line_index = safe_index;
+
+	return( 1 );
+}
+
+/* Reads the next entry from the read trace
+ * Empty lines and lines starting with # are skipped
+ * Returns 1 if successful, 0 if no more entries are available or -1 on error
+ */
+int read_trace_read_entry(
+     read_trace_t *read_trace,
+     read_trace_entry_t *entry,
+     libcerror_error_t **error )
+{
+	char line[ READ_TRACE_MAXIMUM_LINE_SIZE ];
+
+	uint64_t values[ 5 ];
+
+	static char *function = "read_trace_read_entry";
+	size_t line_index     = 0;
+	size_t line_length    = 0;
+	int value_index       = 0;
+
+	if( read_trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_trace->stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read trace - missing stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( file_stream_get_string(
+		     read_trace->stream,
+		     line,
+		     READ_TRACE_MAXIMUM_LINE_SIZE ) == NULL )
+		{
+			if( file_stream_at_end(
+			     read_trace->stream ) != 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line: %" PRIu64 ".",
+			 function,
+			 read_trace->line_number + 1 );
+
+			return( -1 );
+		}
+		read_trace->line_number += 1;
+
+		line_length = narrow_string_length(
+		               line );
+
+		if( ( line_length > 0 )
+		 && ( line[ line_length - 1 ] != '\n' )
+		 && ( file_stream_at_end(
+		       read_trace->stream ) == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: line: %" PRIu64 " exceeds maximum size.",
+			 function,
+			 read_trace->line_number );
+
+			return( -1 );
+		}
+		line_index = 0;
+
+		while( ( line_index < line_length )
+		    && ( ( line[ line_index ] == ' ' )
+		     ||  ( line[ line_index ] == '\t' ) ) )
+		{
+			line_index++;
+		}
+	}
+	while( ( line_index >= line_length )
+	    || ( line[ line_index ] == '#' )
+	    || ( line[ line_index ] == '\r' )
+	    || ( line[ line_index ] == '\n' ) );
+
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		if( read_trace_copy_field_from_64_bit_in_decimal(
+		     line,
+		     line_length,
+		     &line_index,
+		     &( values[ value_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve field: %d of line: %" PRIu64 ".",
+			 function,
+			 value_index,
+			 read_trace->line_number );
+
+			return( -1 );
+		}
+	}
+	if( ( line_index < line_length )
+	 && ( line[ line_index ] != '\r' )
+	 && ( line[ line_index ] != '\n' ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported trailing data in line: %" PRIu64 ".",
+		 function,
+		 read_trace->line_number );
+
+		return( -1 );
+	}
+	if( ( values[ 1 ] > (uint64_t) INT_MAX )
+	 || ( values[ 2 ] > (uint64_t) INT_MAX )
+	 || ( values[ 3 ] > (uint64_t) INT64_MAX )
+	 || ( values[ 4 ] > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: value out of bounds in line: %" PRIu64 ".",
+		 function,
+		 read_trace->line_number );
+
+		return( -1 );
+	}
+	entry->timestamp    = values[ 0 ];
+	entry->thread_index = (int) values[ 1 ];
+	entry->store_index  = (int) values[ 2 ];
+	entry->offset       = (off64_t) values[ 3 ];
+	entry->size         = (size_t) values[ 4 ];
+
+	read_trace->number_of_entries += 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,179 @@
+/*
+ * Read trace
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _READ_TRACE_H )
+#define _READ_TRACE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( WINAPI ) && defined( HAVE_PTHREAD_H )
+#include <pthread.h>
+#endif
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The read trace is a text file with a header line followed by a line per read:
+ * timestamp thread store offset size
+ *
+ * The timestamp is the number of microseconds since the trace was opened
+ * and the thread is the index of the thread that issued the read, in order
+ * of the first read of the thread
+ */
+#define READ_TRACE_HEADER		"# vshadow read trace version 1\n"
+
+#define READ_TRACE_MAXIMUM_LINE_SIZE	128
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+typedef DWORD read_trace_thread_identifier_t;
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+typedef pthread_t read_trace_thread_identifier_t;
+
+#endif
+
+typedef struct read_trace_entry read_trace_entry_t;
+
+struct read_trace_entry
+{
+	/* The timestamp in microseconds since the trace was opened
+	 */
+	uint64_t timestamp;
+
+	/* The thread index
+	 */
+	int thread_index;
+
+	/* The store index
+	 */
+	int store_index;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+};
+
+typedef struct read_trace read_trace_t;
+
+struct read_trace
+{
+	/* The trace file stream
+	 */
+	FILE *stream;
+
+	/* The time the trace was opened in microseconds
+	 */
+	uint64_t start_time;
+
+	/* The number of entries written or read
+	 */
+	uint64_t number_of_entries;
+
+	/* The line number, used for error reporting
+	 */
+	uint64_t line_number;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && ( defined( WINAPI ) || defined( HAVE_PTHREAD_H ) )
+	/* The identifiers of the threads that issued reads
+	 */
+	read_trace_thread_identifier_t *thread_identifiers;
+
+	/* The number of thread identifiers
+	 */
+	int number_of_thread_identifiers;
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 * serializes the threads that append entries
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int read_trace_initialize(
+     read_trace_t **read_trace,
+     libcerror_error_t **error );
+
+int read_trace_free(
+     read_trace_t **read_trace,
+     libcerror_error_t **error );
+
+int read_trace_open_stream(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     const system_character_t *mode,
+     libcerror_error_t **error );
+
+int read_trace_open_write(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int read_trace_open_read(
+     read_trace_t *read_trace,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int read_trace_close(
+     read_trace_t *read_trace,
+     libcerror_error_t **error );
+
+int read_trace_get_thread_index(
+     read_trace_t *read_trace,
+     int *thread_index,
+     libcerror_error_t **error );
+
+int read_trace_append_entry(
+     read_trace_t *read_trace,
+     int store_index,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int read_trace_copy_field_from_64_bit_in_decimal(
+     const char *line,
+     size_t line_length,
+     size_t *line_index,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int read_trace_read_entry(
+     read_trace_t *read_trace,
+     read_trace_entry_t *entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _READ_TRACE_H ) */
+
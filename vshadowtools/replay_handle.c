@@ -0,0 +1,2113 @@
+/*
+ * Replay handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "read_statistics.h"
+#include "read_trace.h"
+#include "replay_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+extern \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define REPLAY_HANDLE_NOTIFY_STREAM		stdout
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "vshadowtools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a replay handle
+ * Make sure the value replay_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_initialize(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_initialize";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*replay_handle = memory_allocate_structure(
+	                  replay_handle_t );
+
+	if( *replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create replay handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *replay_handle,
+	     0,
+	     sizeof( replay_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear replay handle.",
+		 function );
+
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *replay_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *replay_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *replay_handle )->output_format = REPLAY_HANDLE_OUTPUT_FORMAT_TEXT;
+	( *replay_handle )->notify_stream = REPLAY_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *replay_handle != NULL )
+	{
+		if( ( *replay_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *replay_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a replay handle
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_free(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_free";
+	int result            = 1;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay_handle != NULL )
+	{
+		if( ( *replay_handle )->stores != NULL )
+		{
+			if( replay_handle_close_input(
+			     *replay_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close replay handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_volume_free(
+		     &( ( *replay_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *replay_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *replay_handle )->entries != NULL )
+		{
+			memory_free(
+			 ( *replay_handle )->entries );
+		}
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the replay handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_signal_abort(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_signal_abort";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle->abort = 1;
+
+	if( replay_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     replay_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_set_volume_offset(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets if the trace should be replayed as fast as possible
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_set_maximum_speed(
+     replay_handle_t *replay_handle,
+     uint8_t maximum_speed,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_maximum_speed";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle->maximum_speed = maximum_speed;
+
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_set_output_format(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_output_format";
+	size_t string_length  = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "json" ),
+	       4 ) == 0 ) )
+	{
+		replay_handle->output_format = REPLAY_HANDLE_OUTPUT_FORMAT_JSON;
+	}
+	else if( ( string_length == 4 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "text" ),
+	            4 ) == 0 ) )
+	{
+		replay_handle->output_format = REPLAY_HANDLE_OUTPUT_FORMAT_TEXT;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported output format.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the entries of a read trace
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_read_trace(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	read_trace_entry_t entry;
+
+	read_trace_entry_t *entries        = NULL;
+	read_trace_t *read_trace           = NULL;
+	static char *function              = "replay_handle_read_trace";
+	uint64_t maximum_number_of_entries = 0;
+	uint64_t number_of_entries         = 0;
+	int number_of_threads              = 0;
+	int result                         = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_trace_initialize(
+	     &read_trace,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_trace_open_read(
+	     read_trace,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open read trace.",
+		 function );
+
+		goto on_error;
+	}
+	while( replay_handle->abort == 0 )
+	{
+		result = read_trace_read_entry(
+		          read_trace,
+		          &entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read entry: %" PRIu64 " of read trace.",
+			 function,
+			 number_of_entries );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( entry.size > (size_t) REPLAY_HANDLE_MAXIMUM_READ_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %" PRIu64 " - size value out of bounds.",
+			 function,
+			 number_of_entries );
+
+			goto on_error;
+		}
+		if( entry.thread_index >= REPLAY_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %" PRIu64 " - thread index value out of bounds.",
+			 function,
+			 number_of_entries );
+
+			goto on_error;
+		}
+		if( number_of_entries >= maximum_number_of_entries )
+		{
+			if( maximum_number_of_entries == 0 )
+			{
+				maximum_number_of_entries = 4096;
+			}
+			else
+			{
+				maximum_number_of_entries *= 2;
+			}
+			if( maximum_number_of_entries > (uint64_t) ( SSIZE_MAX / sizeof( read_trace_entry_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of entries value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			entries = (read_trace_entry_t *) memory_reallocate(
+			                                  replay_handle->entries,
+			                                  sizeof( read_trace_entry_t ) * (size_t) maximum_number_of_entries );
+
+			if( entries == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize entries.",
+				 function );
+
+				goto on_error;
+			}
+			replay_handle->entries = entries;
+		}
+		if( memory_copy(
+		     &( replay_handle->entries[ number_of_entries ] ),
+		     &entry,
+		     sizeof( read_trace_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entry.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_entries++;
+
+		if( entry.thread_index >= number_of_threads )
+		{
+			number_of_threads = entry.thread_index + 1;
+		}
+	}
+	if( read_trace_close(
+	     read_trace,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close read trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_trace_free(
+	     &read_trace,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read trace.",
+		 function );
+
+		goto on_error;
+	}
+	replay_handle->number_of_entries = number_of_entries;
+	replay_handle->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( read_trace != NULL )
+	{
+		read_trace_free(
+		 &read_trace,
+		 NULL );
+	}
+	if( replay_handle->entries != NULL )
+	{
+		memory_free(
+		 replay_handle->entries );
+
+		replay_handle->entries = NULL;
+	}
+	return( -1 );
+}
+
+/* Opens the replay handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int replay_handle_open_input(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "replay_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+	int store_index        = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->stores != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - stores value already set.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     replay_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     replay_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     replay_handle->input_file_io_handle,
+	     replay_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          replay_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvshadow_volume_open_file_io_handle(
+	     replay_handle->input_volume,
+	     replay_handle->input_file_io_handle,
+	     LIBVSHADOW_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     replay_handle->input_volume,
+	     &( replay_handle->number_of_stores ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( replay_handle->number_of_stores <= 0 )
+	 || ( (size_t) replay_handle->number_of_stores > (size_t) ( SSIZE_MAX / sizeof( libvshadow_store_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stores value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	replay_handle->stores = (libvshadow_store_t **) memory_allocate(
+	                                                 sizeof( libvshadow_store_t * ) * replay_handle->number_of_stores );
+
+	if( replay_handle->stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     replay_handle->stores,
+	     0,
+	     sizeof( libvshadow_store_t * ) * replay_handle->number_of_stores ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stores.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < replay_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( libvshadow_volume_get_store(
+		     replay_handle->input_volume,
+		     store_index,
+		     &( replay_handle->stores[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	replay_handle_close_input(
+	 replay_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the replay handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int replay_handle_close_input(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_close_input";
+	int result            = 0;
+	int store_index       = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->stores != NULL )
+	{
+		for( store_index = 0;
+		     store_index < replay_handle->number_of_stores;
+		     store_index++ )
+		{
+			if( replay_handle->stores[ store_index ] == NULL )
+			{
+				continue;
+			}
+			if( libvshadow_store_free(
+			     &( replay_handle->stores[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 replay_handle->stores );
+
+		replay_handle->stores = NULL;
+	}
+	if( libvshadow_volume_close(
+	     replay_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		result = -1;
+	}
+	replay_handle->number_of_stores = 0;
+
+	return( result );
+}
+
+/* Suspends the calling thread for a number of microseconds
+ * Without a sleep function the function returns immediately and the caller polls the clock
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_sleep(
+     uint64_t sleep_time,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_NANOSLEEP ) && !defined( WINAPI )
+	struct timespec time_value;
+#endif
+
+	static char *function = "replay_handle_sleep";
+
+#if defined( WINAPI )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( error )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( function )
+
+	Sleep(
+	 (DWORD) ( ( sleep_time + 999 ) / 1000 ) );
+
+#elif defined( HAVE_NANOSLEEP )
+	time_value.tv_sec  = (time_t) ( sleep_time / 1000000 );
+	time_value.tv_nsec = (long) ( ( sleep_time % 1000000 ) * 1000 );
+
+	/* An interrupted sleep is not an error, the caller determines if it needs to sleep again
+	 */
+	if( ( nanosleep(
+	       &time_value,
+	       NULL ) != 0 )
+	 && ( errno != EINTR ) )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to sleep.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( sleep_time )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( error )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( function )
+#endif
+	return( 1 );
+}
+
+/* Runs a replay worker
+ * The worker replays the reads of a single recorded thread in order. At the original
+ * speed a read is not issued before its recorded time relative to the start of the replay.
+ * A failed read is counted and does not stop the worker
+ * Returns 1 if successful or -1 on error
+ */
+int replay_worker_run(
+     replay_worker_t *replay_worker )
+{
+	libcerror_error_t *error       = NULL;
+	read_trace_entry_t *entry      = NULL;
+	replay_handle_t *replay_handle = NULL;
+	static char *function          = "replay_worker_run";
+	ssize_t read_count             = 0;
+	uint64_t current_time          = 0;
+	uint64_t entry_index           = 0;
+	uint64_t lag                   = 0;
+	uint64_t read_end_time         = 0;
+	uint64_t read_start_time       = 0;
+	uint64_t scheduled_time        = 0;
+	uint64_t sleep_time            = 0;
+
+	if( replay_worker == NULL )
+	{
+		return( -1 );
+	}
+	replay_handle = replay_worker->replay_handle;
+
+	replay_worker->result = 1;
+
+	for( entry_index = 0;
+	     entry_index < replay_worker->number_of_entries;
+	     entry_index++ )
+	{
+		if( replay_handle->abort != 0 )
+		{
+			break;
+		}
+		entry = &( replay_worker->entries[ entry_index ] );
+
+		if( replay_handle->maximum_speed == 0 )
+		{
+			scheduled_time = replay_handle->start_time + entry->timestamp;
+
+			while( replay_handle->abort == 0 )
+			{
+				if( read_statistics_get_current_time(
+				     &current_time,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve current time.",
+					 function );
+
+					goto on_error;
+				}
+				if( current_time >= scheduled_time )
+				{
+					break;
+				}
+				/* Sleep in intervals so that an abort does not have to wait for a long gap in the trace
+				 */
+				sleep_time = scheduled_time - current_time;
+
+				if( sleep_time > REPLAY_HANDLE_MAXIMUM_SLEEP_TIME )
+				{
+					sleep_time = REPLAY_HANDLE_MAXIMUM_SLEEP_TIME;
+				}
+				if( replay_handle_sleep(
+				     sleep_time,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to sleep.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( read_statistics_get_current_time(
+		     &read_start_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read start time.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( replay_handle->maximum_speed == 0 )
+		 && ( read_start_time > scheduled_time ) )
+		{
+			lag = read_start_time - scheduled_time;
+
+			replay_worker->total_lag += lag;
+
+			if( lag > replay_worker->maximum_lag )
+			{
+				replay_worker->maximum_lag = lag;
+			}
+		}
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              replay_handle->stores[ entry->store_index ],
+		              replay_worker->file_io_handle,
+		              replay_worker->buffer,
+		              entry->size,
+		              entry->offset,
+		              &error );
+
+		if( read_statistics_get_current_time(
+		     &read_end_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read end time.",
+			 function );
+
+			goto on_error;
+		}
+		/* A read at the end of a store can be smaller than the size requested hence only -1 is a failed read
+		 */
+		if( read_count == -1 )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read %" PRIzu " bytes from store: %d at offset: %" PRIi64 ".\n",
+				 function,
+				 entry->size,
+				 entry->store_index,
+				 entry->offset );
+
+				if( error != NULL )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+			}
+			libcerror_error_free(
+			 &error );
+		}
+		if( read_statistics_update(
+		     &( replay_worker->read_statistics[ entry->store_index ] ),
+		     entry->size,
+		     (uint8_t) ( read_count == -1 ),
+		     0,
+		     read_end_time - read_start_time,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update read statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	replay_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Prints read statistics
+ * The store index is -1 for the read statistics of all the stores
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_read_statistics_fprint(
+     replay_handle_t *replay_handle,
+     int store_index,
+     const read_statistics_t *read_statistics,
+     uint64_t elapsed_time,
+     int is_last,
+     libcerror_error_t **error )
+{
+	static char *function      = "replay_handle_read_statistics_fprint";
+	uint64_t average_latency   = 0;
+	uint64_t bytes_per_second  = 0;
+	uint64_t latency_p50       = 0;
+	uint64_t latency_p90       = 0;
+	uint64_t latency_p99       = 0;
+	uint64_t reads_per_second  = 0;
+	int bucket_index           = 0;
+	int is_first_bucket        = 1;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_statistics->number_of_requests > 0 )
+	{
+		average_latency = read_statistics->read_time / read_statistics->number_of_requests;
+
+		if( ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       50,
+		       &latency_p50,
+		       error ) != 1 )
+		 || ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       90,
+		       &latency_p90,
+		       error ) != 1 )
+		 || ( read_statistics_get_latency_percentile(
+		       read_statistics,
+		       99,
+		       &latency_p99,
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve latency percentiles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( elapsed_time > 0 )
+	{
+		/* Divide first to prevent the multiplication from overflowing on large traces
+		 */
+		bytes_per_second = ( read_statistics->number_of_bytes / elapsed_time ) * 1000000
+		                 + ( ( read_statistics->number_of_bytes % elapsed_time ) * 1000000 ) / elapsed_time;
+		reads_per_second = ( read_statistics->number_of_requests * 1000000 ) / elapsed_time;
+	}
+	if( replay_handle->output_format == REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		if( store_index < 0 )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "    {\n"
+			 "      \"store\": \"all\",\n" );
+		}
+		else
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "    {\n"
+			 "      \"store\": %d,\n",
+			 store_index + 1 );
+		}
+		fprintf(
+		 replay_handle->notify_stream,
+		 "      \"number_of_reads\": %" PRIu64 ",\n"
+		 "      \"number_of_bytes\": %" PRIu64 ",\n"
+		 "      \"number_of_errors\": %" PRIu64 ",\n"
+		 "      \"bytes_per_second\": %" PRIu64 ",\n"
+		 "      \"reads_per_second\": %" PRIu64 ",\n"
+		 "      \"average_latency_us\": %" PRIu64 ",\n"
+		 "      \"latency_p50_us\": %" PRIu64 ",\n"
+		 "      \"latency_p90_us\": %" PRIu64 ",\n"
+		 "      \"latency_p99_us\": %" PRIu64 ",\n"
+		 "      \"latency_histogram\": [",
+		 read_statistics->number_of_requests,
+		 read_statistics->number_of_bytes,
+		 read_statistics->number_of_errors,
+		 bytes_per_second,
+		 reads_per_second,
+		 average_latency,
+		 latency_p50,
+		 latency_p90,
+		 latency_p99 );
+	}
+	else
+	{
+		if( store_index < 0 )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "Reads (all stores):\n" );
+		}
+		else
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "Reads (store: %d):\n",
+			 store_index + 1 );
+		}
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tNumber of reads\t\t: %" PRIu64 "\n"
+		 "\tNumber of bytes\t\t: %" PRIu64 "\n"
+		 "\tNumber of errors\t: %" PRIu64 "\n"
+		 "\tThroughput\t\t: %" PRIu64 ".%02" PRIu64 " MiB/s\n"
+		 "\tReads per second\t: %" PRIu64 "\n"
+		 "\tAverage latency\t\t: %" PRIu64 " us\n"
+		 "\tLatency p50\t\t: < %" PRIu64 " us\n"
+		 "\tLatency p90\t\t: < %" PRIu64 " us\n"
+		 "\tLatency p99\t\t: < %" PRIu64 " us\n"
+		 "\tLatency histogram:\n",
+		 read_statistics->number_of_requests,
+		 read_statistics->number_of_bytes,
+		 read_statistics->number_of_errors,
+		 bytes_per_second / ( 1024 * 1024 ),
+		 ( ( bytes_per_second % ( 1024 * 1024 ) ) * 100 ) / ( 1024 * 1024 ),
+		 reads_per_second,
+		 average_latency,
+		 latency_p50,
+		 latency_p90,
+		 latency_p99 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < READ_STATISTICS_NUMBER_OF_LATENCY_BUCKETS;
+	     bucket_index++ )
+	{
+		if( read_statistics->latency_histogram[ bucket_index ] == 0 )
+		{
+			continue;
+		}
+		if( replay_handle->output_format == REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "%s\n"
+			 "        { \"upper_bound_us\": %" PRIu64 ", \"number_of_reads\": %" PRIu64 " }",
+			 ( is_first_bucket != 0 ) ? "" : ",",
+			 (uint64_t) 1 << bucket_index,
+			 read_statistics->latency_histogram[ bucket_index ] );
+		}
+		else
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "\t\t< %" PRIu64 " us\t\t: %" PRIu64 "\n",
+			 (uint64_t) 1 << bucket_index,
+			 read_statistics->latency_histogram[ bucket_index ] );
+		}
+		is_first_bucket = 0;
+	}
+	if( replay_handle->output_format == REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "%s]\n"
+		 "    }%s\n",
+		 ( is_first_bucket != 0 ) ? "" : "\n      ",
+		 ( is_last != 0 ) ? "" : "," );
+	}
+	else
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
+/* Replays the read trace
+ * Every recorded thread is replayed by a worker thread that reads using its own
+ * file IO handle. Without multi-thread support the reads are replayed in the order
+ * of the trace
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_run(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	read_statistics_t read_statistics;
+
+	read_statistics_t *store_read_statistics = NULL;
+	read_trace_entry_t *entry                = NULL;
+	replay_worker_t *replay_worker           = NULL;
+	replay_worker_t *replay_workers          = NULL;
+	static char *function                    = "replay_handle_run";
+	uint64_t elapsed_time                    = 0;
+	uint64_t end_time                        = 0;
+	uint64_t entry_index                     = 0;
+	uint64_t maximum_lag                     = 0;
+	uint64_t total_lag                       = 0;
+	uint64_t trace_duration                  = 0;
+	int last_store_index                     = -1;
+	int number_of_workers                    = 1;
+	int result                               = 1;
+	int store_index                          = 0;
+	int worker_index                         = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->stores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid replay handle - missing stores.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < replay_handle->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( replay_handle->entries[ entry_index ] );
+
+		if( entry->store_index >= replay_handle->number_of_stores )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %" PRIu64 " - store index: %d value out of bounds, the volume has %d stores.",
+			 function,
+			 entry_index,
+			 entry->store_index,
+			 replay_handle->number_of_stores );
+
+			return( -1 );
+		}
+		if( entry->timestamp > trace_duration )
+		{
+			trace_duration = entry->timestamp;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( replay_handle->number_of_threads > 1 )
+	{
+		number_of_workers = replay_handle->number_of_threads;
+	}
+#endif
+	replay_workers = (replay_worker_t *) memory_allocate(
+	                                      sizeof( replay_worker_t ) * number_of_workers );
+
+	if( replay_workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     replay_workers,
+	     0,
+	     sizeof( replay_worker_t ) * number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 replay_workers );
+
+		return( -1 );
+	}
+	/* Determine the number of entries and the largest read of every worker
+	 */
+	for( entry_index = 0;
+	     entry_index < replay_handle->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( replay_handle->entries[ entry_index ] );
+
+		replay_worker = &( replay_workers[ ( number_of_workers > 1 ) ? entry->thread_index : 0 ] );
+
+		replay_worker->number_of_entries += 1;
+
+		if( entry->size > replay_worker->buffer_size )
+		{
+			replay_worker->buffer_size = entry->size;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		replay_worker = &( replay_workers[ worker_index ] );
+
+		replay_worker->replay_handle = replay_handle;
+
+		if( replay_worker->number_of_entries > 0 )
+		{
+			replay_worker->entries = (read_trace_entry_t *) memory_allocate(
+			                                                 sizeof( read_trace_entry_t ) * (size_t) replay_worker->number_of_entries );
+
+			if( replay_worker->entries == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entries of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+		/* The number of entries is recounted while the entries are copied
+		 */
+		replay_worker->number_of_entries = 0;
+
+		if( replay_worker->buffer_size == 0 )
+		{
+			replay_worker->buffer_size = 1;
+		}
+		replay_worker->buffer = (uint8_t *) memory_allocate(
+		                                     sizeof( uint8_t ) * replay_worker->buffer_size );
+
+		if( replay_worker->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		replay_worker->read_statistics = (read_statistics_t *) memory_allocate(
+		                                                        sizeof( read_statistics_t ) * replay_handle->number_of_stores );
+
+		if( replay_worker->read_statistics == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read statistics of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     replay_worker->read_statistics,
+		     0,
+		     sizeof( read_statistics_t ) * replay_handle->number_of_stores ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear read statistics of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( replay_worker->file_io_handle ),
+		     replay_handle->input_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     replay_worker->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < replay_handle->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( replay_handle->entries[ entry_index ] );
+
+		replay_worker = &( replay_workers[ ( number_of_workers > 1 ) ? entry->thread_index : 0 ] );
+
+		if( memory_copy(
+		     &( replay_worker->entries[ replay_worker->number_of_entries ] ),
+		     entry,
+		     sizeof( read_trace_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entry: %" PRIu64 ".",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		replay_worker->number_of_entries += 1;
+	}
+	if( read_statistics_get_current_time(
+	     &( replay_handle->start_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( replay_workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &replay_worker_run,
+		     (void *) &( replay_workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( replay_workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#else
+	replay_worker_run(
+	 &( replay_workers[ 0 ] ) );
+#endif
+	if( read_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		goto on_error;
+	}
+	elapsed_time = end_time - replay_handle->start_time;
+
+	/* The per store read statistics of the workers are merged into those of the first worker
+	 */
+	store_read_statistics = replay_workers[ 0 ].read_statistics;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		replay_worker = &( replay_workers[ worker_index ] );
+
+		if( replay_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		total_lag += replay_worker->total_lag;
+
+		if( replay_worker->maximum_lag > maximum_lag )
+		{
+			maximum_lag = replay_worker->maximum_lag;
+		}
+		if( worker_index == 0 )
+		{
+			continue;
+		}
+		for( store_index = 0;
+		     store_index < replay_handle->number_of_stores;
+		     store_index++ )
+		{
+			if( read_statistics_merge(
+			     &( store_read_statistics[ store_index ] ),
+			     &( replay_worker->read_statistics[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to merge read statistics of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( memory_set(
+	     &read_statistics,
+	     0,
+	     sizeof( read_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read statistics.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < replay_handle->number_of_stores;
+	     store_index++ )
+	{
+		if( read_statistics_merge(
+		     &read_statistics,
+		     &( store_read_statistics[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to merge read statistics of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( store_read_statistics[ store_index ].number_of_requests > 0 )
+		{
+			last_store_index = store_index;
+		}
+	}
+	if( replay_handle->output_format == REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "{\n"
+		 "  \"number_of_stores\": %d,\n"
+		 "  \"number_of_trace_entries\": %" PRIu64 ",\n"
+		 "  \"number_of_threads\": %d,\n"
+		 "  \"speed\": \"%s\",\n"
+		 "  \"trace_duration_us\": %" PRIu64 ",\n"
+		 "  \"elapsed_time_us\": %" PRIu64 ",\n",
+		 replay_handle->number_of_stores,
+		 replay_handle->number_of_entries,
+		 number_of_workers,
+		 ( replay_handle->maximum_speed != 0 ) ? "maximum" : "original",
+		 trace_duration,
+		 elapsed_time );
+
+		if( replay_handle->maximum_speed == 0 )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "  \"average_lag_us\": %" PRIu64 ",\n"
+			 "  \"maximum_lag_us\": %" PRIu64 ",\n",
+			 ( read_statistics.number_of_requests > 0 ) ? total_lag / read_statistics.number_of_requests : 0,
+			 maximum_lag );
+		}
+		fprintf(
+		 replay_handle->notify_stream,
+		 "  \"reads\": [\n" );
+	}
+	else
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "Volume Shadow Snapshot read trace replay:\n"
+		 "\tNumber of stores\t: %d\n"
+		 "\tNumber of trace entries\t: %" PRIu64 "\n"
+		 "\tNumber of threads\t: %d\n"
+		 "\tSpeed\t\t\t: %s\n"
+		 "\tTrace duration\t\t: %" PRIu64 " us\n"
+		 "\tElapsed time\t\t: %" PRIu64 " us\n",
+		 replay_handle->number_of_stores,
+		 replay_handle->number_of_entries,
+		 number_of_workers,
+		 ( replay_handle->maximum_speed != 0 ) ? "maximum" : "original",
+		 trace_duration,
+		 elapsed_time );
+
+		if( replay_handle->maximum_speed == 0 )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "\tAverage lag\t\t: %" PRIu64 " us\n"
+			 "\tMaximum lag\t\t: %" PRIu64 " us\n",
+			 ( read_statistics.number_of_requests > 0 ) ? total_lag / read_statistics.number_of_requests : 0,
+			 maximum_lag );
+		}
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\n" );
+	}
+	if( replay_handle_read_statistics_fprint(
+	     replay_handle,
+	     -1,
+	     &read_statistics,
+	     elapsed_time,
+	     (int) ( last_store_index == -1 ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print read statistics.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index <= last_store_index;
+	     store_index++ )
+	{
+		if( store_read_statistics[ store_index ].number_of_requests == 0 )
+		{
+			continue;
+		}
+		if( replay_handle_read_statistics_fprint(
+		     replay_handle,
+		     store_index,
+		     &( store_read_statistics[ store_index ] ),
+		     elapsed_time,
+		     (int) ( store_index == last_store_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print read statistics of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	if( replay_handle->output_format == REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "  ]\n"
+		 "}\n" );
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		replay_worker = &( replay_workers[ worker_index ] );
+
+		if( libbfio_handle_free(
+		     &( replay_worker->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+		if( replay_worker->entries != NULL )
+		{
+			memory_free(
+			 replay_worker->entries );
+		}
+		memory_free(
+		 replay_worker->buffer );
+
+		memory_free(
+		 replay_worker->read_statistics );
+	}
+	memory_free(
+	 replay_workers );
+
+	return( result );
+
+on_error:
+	if( replay_workers != NULL )
+	{
+		/* Make sure the workers that were started stop before their resources are freed
+		 */
+		replay_handle->abort = 1;
+
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			replay_worker = &( replay_workers[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( replay_worker->thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( replay_worker->thread ),
+				 NULL );
+			}
+#endif
+			if( replay_worker->file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &( replay_worker->file_io_handle ),
+				 NULL );
+			}
+			if( replay_worker->entries != NULL )
+			{
+				memory_free(
+				 replay_worker->entries );
+			}
+			if( replay_worker->buffer != NULL )
+			{
+				memory_free(
+				 replay_worker->buffer );
+			}
+			if( replay_worker->read_statistics != NULL )
+			{
+				memory_free(
+				 replay_worker->read_statistics );
+			}
+		}
+		memory_free(
+		 replay_workers );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,233 @@
+/*
+ * Replay handle
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _REPLAY_HANDLE_H )
+#define _REPLAY_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "read_statistics.h"
+#include "read_trace.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define REPLAY_HANDLE_MAXIMUM_READ_SIZE			( 64 * 1024 * 1024 )
+#define REPLAY_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
+/* The maximum time a worker sleeps before checking if abort was signalled in microseconds
+ */
+#define REPLAY_HANDLE_MAXIMUM_SLEEP_TIME		100000
+
+enum REPLAY_HANDLE_OUTPUT_FORMATS
+{
+	REPLAY_HANDLE_OUTPUT_FORMAT_JSON		= (int) 'j',
+	REPLAY_HANDLE_OUTPUT_FORMAT_TEXT		= (int) 't'
+};
+
+typedef struct replay_handle replay_handle_t;
+
+typedef struct replay_worker replay_worker_t;
+
+struct replay_worker
+{
+	/* The replay handle
+	 */
+	replay_handle_t *replay_handle;
+
+	/* The entries replayed by the worker
+	 */
+	read_trace_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The libbfio file IO handle used by the worker
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read buffer size
+	 */
+	size_t buffer_size;
+
+	/* The read statistics per store
+	 */
+	read_statistics_t *read_statistics;
+
+	/* The total time reads were issued later than recorded in microseconds
+	 */
+	uint64_t total_lag;
+
+	/* The maximum time a read was issued later than recorded in microseconds
+	 */
+	uint64_t maximum_lag;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+};
+
+struct replay_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* Value to indicate the trace should be replayed as fast as possible
+	 * instead of at the speed it was recorded
+	 */
+	uint8_t maximum_speed;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The trace entries
+	 */
+	read_trace_entry_t *entries;
+
+	/* The number of trace entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The number of threads that issued the reads in the trace
+	 */
+	int number_of_threads;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The stores
+	 */
+	libvshadow_store_t **stores;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The time the replay started in microseconds
+	 */
+	uint64_t start_time;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int vshadowtools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int replay_handle_initialize(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_free(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_signal_abort(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_set_volume_offset(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int replay_handle_set_maximum_speed(
+     replay_handle_t *replay_handle,
+     uint8_t maximum_speed,
+     libcerror_error_t **error );
+
+int replay_handle_set_output_format(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int replay_handle_read_trace(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int replay_handle_open_input(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int replay_handle_close_input(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_sleep(
+     uint64_t sleep_time,
+     libcerror_error_t **error );
+
+int replay_worker_run(
+     replay_worker_t *replay_worker );
+
+int replay_handle_read_statistics_fprint(
+     replay_handle_t *replay_handle,
+     int store_index,
+     const read_statistics_t *read_statistics,
+     uint64_t elapsed_time,
+     int is_last,
+     libcerror_error_t **error );
+
+int replay_handle_run(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _REPLAY_HANDLE_H ) */
+
@@ -0,0 +1,555 @@
+/*
+ * Benchmarks reading a Windows NT Volume Shadow Snapshot (VSS) volume
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+bench_handle_t *vshadowbench_bench_handle = NULL;
+int vshadowbench_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowbench to measure the open time and the read throughput and\n"
+	                 "latency of the stores of a Windows NT Volume Shadow Snapshot (VSS) volume\n\n" );
+
+	fprintf( stream, "Usage: vshadowbench [ -b block_size ] [ -f format ] [ -l size ]\n"
+	                 "                    [ -n reads ] [ -o offset ] [ -p pattern ]\n"
+	                 "                    [ -s seed ] [ -t threads ] [ -hvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-b:     specify the read block size in bytes, the default is 64KiB\n" );
+	fprintf( stream, "\t-f:     specify the output format, options: json, text (default)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-l:     specify the maximum number of bytes read sequentially per\n"
+	                 "\t        store, the default is the entire store\n" );
+	fprintf( stream, "\t-n:     specify the number of random reads per store, the default\n"
+	                 "\t        is 4096\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-p:     specify the access pattern, options: all (default), random,\n"
+	                 "\t        sequential\n" );
+	fprintf( stream, "\t-s:     specify the seed of the random reads, the default is 1\n" );
+	fprintf( stream, "\t-t:     specify the number of threads, the default is 1\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vshadowbench
+ */
+void vshadowbench_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowbench_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowbench_abort = 1;
+
+	if( vshadowbench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     vshadowbench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal benchmark handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvshadow_error_t *error                     = NULL;
+	system_character_t *option_access_pattern     = NULL;
+	system_character_t *option_block_size         = NULL;
+	system_character_t *option_maximum_size       = NULL;
+	system_character_t *option_number_of_reads    = NULL;
+	system_character_t *option_number_of_threads  = NULL;
+	system_character_t *option_output_format      = NULL;
+	system_character_t *option_random_seed        = NULL;
+	system_character_t *option_volume_offset      = NULL;
+	system_character_t *source                    = NULL;
+	char *program                                 = "vshadowbench";
+	system_integer_t option                       = 0;
+	int result                                    = 0;
+	int verbose                                   = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:f:hl:n:o:p:s:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_output_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'l':
+				option_maximum_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_access_pattern = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_random_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &vshadowbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( option_output_format != NULL )
+	{
+		if( bench_handle_set_output_format(
+		     vshadowbench_bench_handle,
+		     option_output_format,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported output format defaulting to: text.\n" );
+		}
+	}
+	/* The version is not printed with JSON output so that the output can be parsed as-is
+	 */
+	if( vshadowbench_bench_handle->output_format != BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( bench_handle_set_volume_offset(
+		     vshadowbench_bench_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowbench_bench_handle->volume_offset );
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		if( bench_handle_set_block_size(
+		     vshadowbench_bench_handle,
+		     option_block_size,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported block size defaulting to: %" PRIzd ".\n",
+			 vshadowbench_bench_handle->block_size );
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( bench_handle_set_number_of_threads(
+		     vshadowbench_bench_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vshadowbench_bench_handle->number_of_threads );
+		}
+	}
+	if( option_access_pattern != NULL )
+	{
+		if( bench_handle_set_access_patterns(
+		     vshadowbench_bench_handle,
+		     option_access_pattern,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported access pattern defaulting to: all.\n" );
+		}
+	}
+	if( option_number_of_reads != NULL )
+	{
+		if( bench_handle_set_number_of_random_reads(
+		     vshadowbench_bench_handle,
+		     option_number_of_reads,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of random reads defaulting to: %" PRIu64 ".\n",
+			 vshadowbench_bench_handle->number_of_random_reads );
+		}
+	}
+	if( option_maximum_size != NULL )
+	{
+		if( bench_handle_set_maximum_sequential_size(
+		     vshadowbench_bench_handle,
+		     option_maximum_size,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported maximum sequential size defaulting to: entire store.\n" );
+		}
+	}
+	if( option_random_seed != NULL )
+	{
+		if( bench_handle_set_random_seed(
+		     vshadowbench_bench_handle,
+		     option_random_seed,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported random seed defaulting to: %" PRIu64 ".\n",
+			 vshadowbench_bench_handle->random_seed );
+		}
+	}
+	result = bench_handle_open_input(
+	          vshadowbench_bench_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowbench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bench_handle_run(
+	     vshadowbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowbench_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Benchmark aborted.\n" );
+	}
+	if( bench_handle_close_input(
+	     vshadowbench_bench_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_free(
+	     &vshadowbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowbench_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowbench_bench_handle != NULL )
+	{
+		bench_handle_free(
+		 &vshadowbench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
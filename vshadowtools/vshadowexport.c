@@ -0,0 +1,551 @@
+/*
+ * Exports the stores of a Windows NT Volume Shadow Snapshot (VSS) volume
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "export_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+export_handle_t *vshadowexport_export_handle = NULL;
+int vshadowexport_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowexport to export the stores of a Windows NT Volume Shadow\n"
+	                 "Snapshot (VSS) volume to files\n\n" );
+
+	fprintf( stream, "Usage: vshadowexport [ -b block_size ] [ -f format ] [ -m mode ]\n"
+	                 "                     [ -o offset ] [ -s stores ] [ -t threads ]\n"
+	                 "                     [ -hqvV ] source target\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n" );
+	fprintf( stream, "\ttarget: the directory to write the files to, every store is\n"
+	                 "\t        written to a file named vssN, or vssN.qcow2 with the\n"
+	                 "\t        current volume in a file named base.raw\n\n" );
+
+	fprintf( stream, "\t-b:     specify the physical block size in bytes, a multiple of 4KiB,\n"
+	                 "\t        the default is 1MiB\n" );
+	fprintf( stream, "\t-f:     specify the output format, options: qcow2, raw (default),\n"
+	                 "\t        qcow2 only stores the data that differs from the current\n"
+	                 "\t        volume\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     specify the export mode, options: clone, copy (default),\n"
+	                 "\t        clone shares the data with the source file if the file\n"
+	                 "\t        system supports it\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-q:     quiet, do not print the progress\n" );
+	fprintf( stream, "\t-s:     specify the stores to export, such as 1,3-5, the default is\n"
+	                 "\t        all\n" );
+	fprintf( stream, "\t-t:     specify the number of threads, the default is 4\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vshadowexport
+ */
+void vshadowexport_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowexport_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowexport_abort = 1;
+
+	if( vshadowexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vshadowexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvshadow_error_t *error                    = NULL;
+	system_character_t *option_block_size        = NULL;
+	system_character_t *option_export_mode       = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_output_format     = NULL;
+	system_character_t *option_stores            = NULL;
+	system_character_t *option_volume_offset     = NULL;
+	system_character_t *source                   = NULL;
+	system_character_t *target                   = NULL;
+	char *program                                = "vshadowexport";
+	system_integer_t option                      = 0;
+	uint8_t print_progress                       = 1;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:f:hm:o:qs:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_output_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_export_mode = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'q':
+				print_progress = 0;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_stores = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing target.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	vshadowoutput_version_fprint(
+	 stdout,
+	 program );
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( export_handle_set_volume_offset(
+		     vshadowexport_export_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowexport_export_handle->volume_offset );
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		if( export_handle_set_block_size(
+		     vshadowexport_export_handle,
+		     option_block_size,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported block size defaulting to: %" PRIzu ".\n",
+			 vshadowexport_export_handle->block_size );
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( export_handle_set_number_of_threads(
+		     vshadowexport_export_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vshadowexport_export_handle->number_of_threads );
+		}
+	}
+	if( option_export_mode != NULL )
+	{
+		if( export_handle_set_export_mode(
+		     vshadowexport_export_handle,
+		     option_export_mode,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported export mode: %" PRIs_SYSTEM ".\n",
+			 option_export_mode );
+
+			goto on_error;
+		}
+	}
+	if( option_output_format != NULL )
+	{
+		if( export_handle_set_output_format(
+		     vshadowexport_export_handle,
+		     option_output_format,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported output format: %" PRIs_SYSTEM ".\n",
+			 option_output_format );
+
+			goto on_error;
+		}
+	}
+	/* Exporting other stores than the ones requested is not a sensible default
+	 */
+	if( option_stores != NULL )
+	{
+		if( export_handle_set_selected_stores(
+		     vshadowexport_export_handle,
+		     option_stores,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported stores: %" PRIs_SYSTEM ".\n",
+			 option_stores );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_set_print_progress(
+	     vshadowexport_export_handle,
+	     print_progress,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set print progress.\n" );
+
+		goto on_error;
+	}
+	result = export_handle_open_input(
+	          vshadowexport_export_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_open_output(
+	     vshadowexport_export_handle,
+	     target,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create output files in: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_handle_run(
+	     vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to export stores.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowexport_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Export aborted.\n" );
+	}
+	if( export_handle_close_input(
+	     vshadowexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowexport_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &vshadowexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,470 @@
+/*
+ * Hashes the blocks of the stores of a Windows NT Volume Shadow Snapshot (VSS) volume
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "hash_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+hash_handle_t *vshadowhash_hash_handle = NULL;
+int vshadowhash_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowhash to calculate the digests of the 16KiB blocks of the\n"
+	                 "stores of a Windows NT Volume Shadow Snapshot (VSS) volume. Data\n"
+	                 "that is shared by multiple blocks is only read and hashed once\n\n" );
+
+	fprintf( stream, "Usage: vshadowhash [ -d digest_type ] [ -o offset ] [ -s stores ]\n"
+	                 "                   [ -t threads ] [ -hqvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-d:     specify the digest type, options: sha256 (default), xxh64\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-q:     quiet, do not print the summary\n" );
+	fprintf( stream, "\t-s:     specify the stores to hash, such as 1,3-5, the default is\n"
+	                 "\t        all\n" );
+	fprintf( stream, "\t-t:     specify the number of threads, the default is 4\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vshadowhash
+ */
+void vshadowhash_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowhash_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowhash_abort = 1;
+
+	if( vshadowhash_hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     vshadowhash_hash_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal hash handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvshadow_error_t *error                    = NULL;
+	system_character_t *option_digest_type       = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_stores            = NULL;
+	system_character_t *option_volume_offset     = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vshadowhash";
+	system_integer_t option                      = 0;
+	uint8_t print_summary                        = 1;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	/* A line is written to stdout for every block, hence the output is buffered
+	 */
+	if( vshadowtools_output_initialize(
+	     _IOFBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "d:ho:qs:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'd':
+				option_digest_type = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'q':
+				print_summary = 0;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_stores = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	/* The digests are written to stdout
+	 */
+	vshadowoutput_version_fprint(
+	 stderr,
+	 program );
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( hash_handle_initialize(
+	     &vshadowhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize hash handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( hash_handle_set_volume_offset(
+		     vshadowhash_hash_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowhash_hash_handle->volume_offset );
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( hash_handle_set_number_of_threads(
+		     vshadowhash_hash_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vshadowhash_hash_handle->number_of_threads );
+		}
+	}
+	if( option_digest_type != NULL )
+	{
+		if( hash_handle_set_digest_type(
+		     vshadowhash_hash_handle,
+		     option_digest_type,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported digest type: %" PRIs_SYSTEM ".\n",
+			 option_digest_type );
+
+			goto on_error;
+		}
+	}
+	/* Hashing other stores than the ones requested is not a sensible default
+	 */
+	if( option_stores != NULL )
+	{
+		if( hash_handle_set_selected_stores(
+		     vshadowhash_hash_handle,
+		     option_stores,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported stores: %" PRIs_SYSTEM ".\n",
+			 option_stores );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle_set_print_summary(
+	     vshadowhash_hash_handle,
+	     print_summary,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set print summary.\n" );
+
+		goto on_error;
+	}
+	result = hash_handle_open_input(
+	          vshadowhash_hash_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowhash_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle_run(
+	     vshadowhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to hash stores.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowhash_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Hash aborted.\n" );
+	}
+	if( hash_handle_close_input(
+	     vshadowhash_hash_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close hash handle.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_free(
+	     &vshadowhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free hash handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowhash_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowhash_hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &vshadowhash_hash_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
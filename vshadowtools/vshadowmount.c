@@ -65,7 +65,9 @@
 #include <dokan.h>
 #endif
 
+#include "block_cache.h"
 #include "mount_handle.h"
+#include "read_trace.h"
 #include "vshadowtools_getopt.h"
 #include "vshadowtools_libcerror.h"
 #include "vshadowtools_libclocale.h"
@@ -75,8 +77,11 @@
 #include "vshadowtools_signal.h"
 #include "vshadowtools_unused.h"
 
-mount_handle_t *vshadowmount_mount_handle = NULL;
-int vshadowmount_abort                    = 0;
+mount_handle_t **vshadowmount_mount_handles = NULL;
+int vshadowmount_number_of_mount_handles     = 0;
+block_cache_t *vshadowmount_block_cache      = NULL;
+read_trace_t *vshadowmount_read_trace        = NULL;
+int vshadowmount_abort                       = 0;
 
 /* Prints the executable usage mountrmation
  */
@@ -90,14 +95,24 @@ void usage_fprint(
 	fprintf( stream, "Use vshadowmount to mount a Windows NT Volume Shadow Snapshot (VSS)\n"
 	                 "volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowmount [ -o offset ] [ -X extended_options ]\n"
-	                 "                    [ -hvV ] source mount_point\n\n" );
+	fprintf( stream, "Usage: vshadowmount [ -m cache_size ] [ -o offset ] [ -T trace_file ]\n"
+	                 "                    [ -X extended_options ] [ -hvV ] source [ source ... ]\n"
+	                 "                    mount_point\n\n" );
 
-	fprintf( stream, "\tsource:      the source file or device\n" );
+	fprintf( stream, "\tsource:      the source file or device, if multiple sources are\n"
+	                 "\t             specified every source is mounted in a sub directory\n"
+	                 "\t             named after the source\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
 	fprintf( stream, "\t-h:          shows this help\n" );
-	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-m:          specify the size of the read cache shared by all sources\n"
+	                 "\t             in MiB, default is 64, 0 disables the read cache,\n"
+	                 "\t             reads of 16 KiB or more bypass the read cache\n" );
+	fprintf( stream, "\t-o:          specify the volume offset in bytes, can be specified\n"
+	                 "\t             multiple times, the Nth offset applies to the Nth source\n" );
+	fprintf( stream, "\t-T:          record the store reads, including cached reads, in a trace\n"
+	                 "\t             file, that can be replayed with vshadowreplay, only\n"
+	                 "\t             supported with a single source\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             vshadowmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -111,25 +126,36 @@ void vshadowmount_signal_handler(
 {
 	libcerror_error_t *error = NULL;
 	static char *function    = "vshadowmount_signal_handler";
+	int mount_handle_index   = 0;
 
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
 
 	vshadowmount_abort = 1;
 
-	if( vshadowmount_mount_handle != NULL )
+	if( vshadowmount_mount_handles != NULL )
 	{
-		if( mount_handle_signal_abort(
-		     vshadowmount_mount_handle,
-		     &error ) != 1 )
+		for( mount_handle_index = 0;
+		     mount_handle_index < vshadowmount_number_of_mount_handles;
+		     mount_handle_index++ )
 		{
-			libcnotify_printf(
-			 "%s: unable to signal mount handle to abort.\n",
-			 function );
-
-			libcnotify_print_error_backtrace(
-			 error );
-			libcerror_error_free(
-			 &error );
+			if( vshadowmount_mount_handles[ mount_handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( mount_handle_signal_abort(
+			     vshadowmount_mount_handles[ mount_handle_index ],
+			     &error ) != 1 )
+			{
+				libcnotify_printf(
+				 "%s: unable to signal mount handle: %d to abort.\n",
+				 function,
+				 mount_handle_index );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
 		}
 	}
 	/* Force stdin to close otherwise any function reading it will remain blocked
@@ -148,19 +174,538 @@ void vshadowmount_signal_handler(
 	}
 }
 
+/* Frees the mount handles, the read cache and the read trace
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowmount_free_mount_handles(
+     libcerror_error_t **error )
+{
+	static char *function  = "vshadowmount_free_mount_handles";
+	int mount_handle_index = 0;
+	int result             = 1;
+
+	if( vshadowmount_mount_handles != NULL )
+	{
+		for( mount_handle_index = 0;
+		     mount_handle_index < vshadowmount_number_of_mount_handles;
+		     mount_handle_index++ )
+		{
+			if( vshadowmount_mount_handles[ mount_handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( mount_handle_free(
+			     &( vshadowmount_mount_handles[ mount_handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mount handle: %d.",
+				 function,
+				 mount_handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 vshadowmount_mount_handles );
+
+		vshadowmount_mount_handles           = NULL;
+		vshadowmount_number_of_mount_handles = 0;
+	}
+	/* The read cache is freed after the mount handles that reference it
+	 */
+	if( vshadowmount_block_cache != NULL )
+	{
+		if( block_cache_free(
+		     &vshadowmount_block_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The read trace is freed after the mount handles that reference it
+	 */
+	if( vshadowmount_read_trace != NULL )
+	{
+		if( read_trace_free(
+		     &vshadowmount_read_trace,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read trace.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 
 #if ( SIZEOF_OFF_T != 8 ) && ( SIZEOF_OFF_T != 4 )
 #error Size of off_t not supported
 #endif
 
-static char *vshadowmount_fuse_path_prefix         = "/vss";
-static size_t vshadowmount_fuse_path_prefix_length = 4;
+/* The file types
+ */
+enum VSHADOWMOUNT_FILE_TYPES
+{
+	VSHADOWMOUNT_FILE_TYPE_STORE		= 1,
+	VSHADOWMOUNT_FILE_TYPE_STORE_DELTA	= 2,
+	VSHADOWMOUNT_FILE_TYPE_STATISTICS	= 3,
+	VSHADOWMOUNT_FILE_TYPE_VOLUME_DIRECTORY	= 4,
+	VSHADOWMOUNT_FILE_TYPE_STORE_EXTENTS	= 5
+};
+
+static char *vshadowmount_fuse_path_prefix              = "/vss";
+static size_t vshadowmount_fuse_path_prefix_length      = 4;
+
+static char *vshadowmount_fuse_delta_suffix             = ".delta";
+static size_t vshadowmount_fuse_delta_suffix_length     = 6;
+
+static char *vshadowmount_fuse_extents_suffix           = ".extents";
+static size_t vshadowmount_fuse_extents_suffix_length   = 8;
+
+static char *vshadowmount_fuse_statistics_path          = "/.stats";
+static size_t vshadowmount_fuse_statistics_path_length  = 7;
 
 #if defined( HAVE_TIME )
-time_t vshadowmount_timestamp                      = 0;
+time_t vshadowmount_timestamp                           = 0;
 #endif
 
+/* Determines the mount handle, input index and file type from a path
+ * The statistics file is not bound to a mount handle or input, the mount handle is set to NULL
+ * and the input index to -1. The input index of a volume directory is set to -1
+ * Returns 1 if successful, 0 if the path does not refer to an input or -1 on error
+ */
+int vshadowmount_fuse_get_input_index_from_path(
+     const char *path,
+     size_t path_length,
+     mount_handle_t **mount_handle,
+     int *input_index,
+     int *file_type,
+     libcerror_error_t **error )
+{
+	mount_handle_t *safe_mount_handle = NULL;
+	static char *function             = "vshadowmount_fuse_get_input_index_from_path";
+	size_t name_length                = 0;
+	size_t string_index               = 0;
+	int mount_handle_index            = 0;
+	int number_of_digits              = 0;
+	int safe_input_index              = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_length == vshadowmount_fuse_statistics_path_length )
+	 && ( narrow_string_compare(
+	       path,
+	       vshadowmount_fuse_statistics_path,
+	       vshadowmount_fuse_statistics_path_length ) == 0 ) )
+	{
+		*mount_handle = NULL;
+		*input_index  = -1;
+		*file_type    = VSHADOWMOUNT_FILE_TYPE_STATISTICS;
+
+		return( 1 );
+	}
+	if( vshadowmount_number_of_mount_handles == 1 )
+	{
+		safe_mount_handle = vshadowmount_mount_handles[ 0 ];
+	}
+	else
+	{
+		/* If multiple volumes are mounted the path starts with /<name>
+		 */
+		if( ( path_length < 2 )
+		 || ( path[ 0 ] != '/' ) )
+		{
+			return( 0 );
+		}
+		for( mount_handle_index = 0;
+		     mount_handle_index < vshadowmount_number_of_mount_handles;
+		     mount_handle_index++ )
+		{
+			safe_mount_handle = vshadowmount_mount_handles[ mount_handle_index ];
+
+			if( ( safe_mount_handle == NULL )
+			 || ( safe_mount_handle->name == NULL ) )
+			{
+				continue;
+			}
+			name_length = safe_mount_handle->name_size - 1;
+
+			if( ( ( path_length - 1 ) >= name_length )
+			 && ( narrow_string_compare(
+			       &( path[ 1 ] ),
+			       safe_mount_handle->name,
+			       name_length ) == 0 )
+			 && ( ( ( path_length - 1 ) == name_length )
+			  ||  ( path[ name_length + 1 ] == '/' ) ) )
+			{
+				break;
+			}
+		}
+		if( mount_handle_index >= vshadowmount_number_of_mount_handles )
+		{
+			return( 0 );
+		}
+		string_index = name_length + 1;
+
+		if( string_index == path_length )
+		{
+			*mount_handle = safe_mount_handle;
+			*input_index  = -1;
+			*file_type    = VSHADOWMOUNT_FILE_TYPE_VOLUME_DIRECTORY;
+
+			return( 1 );
+		}
+	}
+	if( ( ( path_length - string_index ) <= vshadowmount_fuse_path_prefix_length )
+	 || ( narrow_string_compare(
+	       &( path[ string_index ] ),
+	       vshadowmount_fuse_path_prefix,
+	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	{
+		return( 0 );
+	}
+	string_index += vshadowmount_fuse_path_prefix_length;
+
+	while( string_index < path_length )
+	{
+		if( ( path[ string_index ] < '0' )
+		 || ( path[ string_index ] > '9' ) )
+		{
+			break;
+		}
+		if( number_of_digits >= 3 )
+		{
+			return( 0 );
+		}
+		safe_input_index *= 10;
+		safe_input_index += path[ string_index++ ] - '0';
+
+		number_of_digits++;
+	}
+	if( ( number_of_digits == 0 )
+	 || ( safe_input_index == 0 ) )
+	{
+		return( 0 );
+	}
+	if( string_index == path_length )
+	{
+		*file_type = VSHADOWMOUNT_FILE_TYPE_STORE;
+	}
+	else if( ( ( path_length - string_index ) == vshadowmount_fuse_delta_suffix_length )
+	      && ( narrow_string_compare(
+	            &( path[ string_index ] ),
+	            vshadowmount_fuse_delta_suffix,
+	            vshadowmount_fuse_delta_suffix_length ) == 0 ) )
+	{
+		*file_type = VSHADOWMOUNT_FILE_TYPE_STORE_DELTA;
+	}
+	else if( ( ( path_length - string_index ) == vshadowmount_fuse_extents_suffix_length )
+	      && ( narrow_string_compare(
+	            &( path[ string_index ] ),
+	            vshadowmount_fuse_extents_suffix,
+	            vshadowmount_fuse_extents_suffix_length ) == 0 ) )
+	{
+		*file_type = VSHADOWMOUNT_FILE_TYPE_STORE_EXTENTS;
+	}
+	else
+	{
+		return( 0 );
+	}
+	*mount_handle = safe_mount_handle;
+	*input_index  = safe_input_index - 1;
+
+	return( 1 );
+}
+
+/* Retrieves a string with the statistics of all the mount handles and the read cache
+ * The string must be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowmount_get_statistics_string(
+     char **string,
+     size_t *string_size,
+     libcerror_error_t **error )
+{
+	char *mount_handle_string       = NULL;
+	char *reallocation              = NULL;
+	char *safe_string               = NULL;
+	static char *function           = "vshadowmount_get_statistics_string";
+	size_t mount_handle_string_size = 0;
+	size_t safe_size                = 0;
+	size_t string_index             = 0;
+	uint64_t hit_percentage         = 0;
+	uint64_t number_of_hits         = 0;
+	uint64_t number_of_misses       = 0;
+	int mount_handle_index          = 0;
+	int number_of_blocks            = 0;
+	int print_count                 = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	for( mount_handle_index = 0;
+	     mount_handle_index < vshadowmount_number_of_mount_handles;
+	     mount_handle_index++ )
+	{
+		if( mount_handle_get_statistics_string(
+		     vshadowmount_mount_handles[ mount_handle_index ],
+		     &mount_handle_string,
+		     &mount_handle_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics string of mount handle: %d.",
+			 function,
+			 mount_handle_index );
+
+			goto on_error;
+		}
+		/* The additional 64 bytes are used for the volume header
+		 */
+		reallocation = (char *) memory_reallocate(
+		                         safe_string,
+		                         sizeof( char ) * ( safe_size + mount_handle_string_size + vshadowmount_mount_handles[ mount_handle_index ]->name_size + 64 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize string.",
+			 function );
+
+			goto on_error;
+		}
+		safe_string = reallocation;
+		safe_size  += mount_handle_string_size + vshadowmount_mount_handles[ mount_handle_index ]->name_size + 64;
+
+		if( vshadowmount_number_of_mount_handles > 1 )
+		{
+			print_count = narrow_string_snprintf(
+			               &( safe_string[ string_index ] ),
+			               safe_size - string_index,
+			               "Volume: %s\n\n",
+			               vshadowmount_mount_handles[ mount_handle_index ]->name );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= ( safe_size - string_index ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to print volume header.",
+				 function );
+
+				goto on_error;
+			}
+			string_index += (size_t) print_count;
+		}
+		if( memory_copy(
+		     &( safe_string[ string_index ] ),
+		     mount_handle_string,
+		     mount_handle_string_size - 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy statistics string of mount handle: %d.",
+			 function,
+			 mount_handle_index );
+
+			goto on_error;
+		}
+		string_index += mount_handle_string_size - 1;
+
+		memory_free(
+		 mount_handle_string );
+
+		mount_handle_string = NULL;
+	}
+	/* The read cache section fits in 512 bytes
+	 */
+	reallocation = (char *) memory_reallocate(
+	                         safe_string,
+	                         sizeof( char ) * ( safe_size + 512 ) );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize string.",
+		 function );
+
+		goto on_error;
+	}
+	safe_string = reallocation;
+	safe_size  += 512;
+
+	if( vshadowmount_block_cache == NULL )
+	{
+		print_count = narrow_string_snprintf(
+		               &( safe_string[ string_index ] ),
+		               safe_size - string_index,
+		               "Read cache:\n"
+		               "\tDisabled\n" );
+	}
+	else
+	{
+		if( block_cache_get_statistics(
+		     vshadowmount_block_cache,
+		     &number_of_blocks,
+		     &number_of_hits,
+		     &number_of_misses,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read cache statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( number_of_hits + number_of_misses ) > 0 )
+		{
+			hit_percentage = ( number_of_hits * 100 ) / ( number_of_hits + number_of_misses );
+		}
+		print_count = narrow_string_snprintf(
+		               &( safe_string[ string_index ] ),
+		               safe_size - string_index,
+		               "Read cache:\n"
+		               "\tBlock size\t\t\t: %" PRIzd " bytes\n"
+		               "\tMaximum number of blocks\t: %d\n"
+		               "\tNumber of cached blocks\t\t: %d\n"
+		               "\tNumber of hits\t\t\t: %" PRIu64 "\n"
+		               "\tNumber of misses\t\t: %" PRIu64 "\n"
+		               "\tHit ratio\t\t\t: %" PRIu64 " %%\n",
+		               vshadowmount_block_cache->block_size,
+		               vshadowmount_block_cache->maximum_number_of_values,
+		               number_of_blocks,
+		               number_of_hits,
+		               number_of_misses,
+		               hit_percentage );
+	}
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( safe_size - string_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to print read cache statistics.",
+		 function );
+
+		goto on_error;
+	}
+	string_index += (size_t) print_count;
+
+	*string      = safe_string;
+	*string_size = string_index + 1;
+
+	return( 1 );
+
+on_error:
+	if( mount_handle_string != NULL )
+	{
+		memory_free(
+		 mount_handle_string );
+	}
+	if( safe_string != NULL )
+	{
+		memory_free(
+		 safe_string );
+	}
+	return( -1 );
+}
+
 /* Opens a file
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -168,10 +713,15 @@ int vshadowmount_fuse_open(
      const char *path,
      struct fuse_file_info *file_info )
 {
-	libcerror_error_t *error = NULL;
-	static char *function    = "vshadowmount_fuse_open";
-	size_t path_length       = 0;
-	int result               = 0;
+	libcerror_error_t *error     = NULL;
+	mount_handle_t *mount_handle = NULL;
+	char *generated_string       = NULL;
+	static char *function        = "vshadowmount_fuse_open";
+	size_t generated_string_size = 0;
+	size_t path_length           = 0;
+	int file_type                = 0;
+	int input_index              = 0;
+	int result                   = 0;
 
 	if( path == NULL )
 	{
@@ -202,12 +752,28 @@ int vshadowmount_fuse_open(
 	path_length = narrow_string_length(
 	               path );
 
-	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
-	 || ( path_length > ( vshadowmount_fuse_path_prefix_length + 3 ) )
-	 || ( narrow_string_compare(
-	       path,
-	       vshadowmount_fuse_path_prefix,
-	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          path_length,
+	          &mount_handle,
+	          &input_index,
+	          &file_type,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 &error,
@@ -220,6 +786,19 @@ int vshadowmount_fuse_open(
 
 		goto on_error;
 	}
+	if( file_type == VSHADOWMOUNT_FILE_TYPE_VOLUME_DIRECTORY )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path - path refers to a directory.",
+		 function );
+
+		result = -EISDIR;
+
+		goto on_error;
+	}
 	if( ( file_info->flags & 0x03 ) != O_RDONLY )
 	{
 		libcerror_error_set(
@@ -233,6 +812,58 @@ int vshadowmount_fuse_open(
 
 		goto on_error;
 	}
+	if( file_type == VSHADOWMOUNT_FILE_TYPE_STATISTICS )
+	{
+		/* Every open of the statistics file reads a snapshot of the statistics
+		 * taken at open time, direct I/O is used since the size is not known
+		 * in advance
+		 */
+		if( vshadowmount_get_statistics_string(
+		     &generated_string,
+		     &generated_string_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics string.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		file_info->fh        = (uint64_t) (intptr_t) generated_string;
+		file_info->direct_io = 1;
+	}
+	else if( file_type == VSHADOWMOUNT_FILE_TYPE_STORE_EXTENTS )
+	{
+		/* The extent map is generated at open time, which requires
+		 * a walk of the store block descriptors
+		 */
+		if( mount_handle_get_extents_string(
+		     mount_handle,
+		     input_index,
+		     &generated_string,
+		     &generated_string_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extents string of input: %d.",
+			 function,
+			 input_index );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		file_info->fh        = (uint64_t) (intptr_t) generated_string;
+		file_info->direct_io = 1;
+	}
 	return( 0 );
 
 on_error:
@@ -243,7 +874,30 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	return( result );
+	return( result );
+}
+
+/* Releases a file
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int vshadowmount_fuse_release(
+     const char *path VSHADOWTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info )
+{
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( path )
+
+	if( file_info == NULL )
+	{
+		return( -EINVAL );
+	}
+	if( file_info->fh != 0 )
+	{
+		memory_free(
+		 (char *) (intptr_t) file_info->fh );
+
+		file_info->fh = 0;
+	}
+	return( 0 );
 }
 
 /* Reads a buffer of data at the specified offset
@@ -256,13 +910,16 @@ int vshadowmount_fuse_read(
      off_t offset,
      struct fuse_file_info *file_info )
 {
-	libcerror_error_t *error = NULL;
-	static char *function    = "vshadowmount_fuse_read";
-	size_t path_length       = 0;
-	ssize_t read_count       = 0;
-	int input_index          = 0;
-	int result               = 0;
-	int string_index         = 0;
+	libcerror_error_t *error       = NULL;
+	mount_handle_t *mount_handle   = NULL;
+	char *generated_string         = NULL;
+	static char *function          = "vshadowmount_fuse_read";
+	size_t generated_string_length = 0;
+	size_t path_length             = 0;
+	ssize_t read_count             = 0;
+	int file_type                  = 0;
+	int input_index                = 0;
+	int result                     = 0;
 
 	if( path == NULL )
 	{
@@ -306,12 +963,28 @@ int vshadowmount_fuse_read(
 	path_length = narrow_string_length(
 	               path );
 
-	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
-	 || ( path_length > ( vshadowmount_fuse_path_prefix_length + 3 ) )
-	 || ( narrow_string_compare(
-	       path,
-	       vshadowmount_fuse_path_prefix,
-	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          path_length,
+	          &mount_handle,
+	          &input_index,
+	          &file_type,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 &error,
@@ -324,47 +997,88 @@ int vshadowmount_fuse_read(
 
 		goto on_error;
 	}
-	string_index = vshadowmount_fuse_path_prefix_length;
+	if( ( file_type == VSHADOWMOUNT_FILE_TYPE_STATISTICS )
+	 || ( file_type == VSHADOWMOUNT_FILE_TYPE_STORE_EXTENTS ) )
+	{
+		generated_string = (char *) (intptr_t) file_info->fh;
+
+		if( generated_string == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file info - missing generated string.",
+			 function );
 
-	input_index = path[ string_index++ ] - '0';
+			result = -EBADF;
 
-	if( string_index < (int) path_length )
+			goto on_error;
+		}
+		generated_string_length = narrow_string_length(
+		                           generated_string );
+
+		if( ( offset < 0 )
+		 || ( (size_t) offset >= generated_string_length ) )
+		{
+			return( 0 );
+		}
+		read_count = (ssize_t) ( generated_string_length - (size_t) offset );
+
+		if( (size_t) read_count > size )
+		{
+			read_count = (ssize_t) size;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( generated_string[ offset ] ),
+		     (size_t) read_count ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy generated string.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	else if( file_type == VSHADOWMOUNT_FILE_TYPE_STORE_DELTA )
 	{
-		input_index *= 10;
-		input_index += path[ string_index++ ] - '0';
+		read_count = mount_handle_read_delta_buffer_at_offset(
+		              mount_handle,
+		              input_index,
+		              (uint8_t *) buffer,
+		              size,
+		              (off64_t) offset,
+		              &error );
 	}
-	if( string_index < (int) path_length )
+	else if( file_type == VSHADOWMOUNT_FILE_TYPE_STORE )
 	{
-		input_index *= 10;
-		input_index += path[ string_index++ ] - '0';
+		read_count = mount_handle_read_buffer_at_offset(
+		              mount_handle,
+		              input_index,
+		              (uint8_t *) buffer,
+		              size,
+		              (off64_t) offset,
+		              &error );
 	}
-	input_index -= 1;
-
-	if( mount_handle_seek_offset(
-	     vshadowmount_mount_handle,
-	     input_index,
-	     (off64_t) offset,
-	     SEEK_SET,
-	     &error ) == -1 )
+	else
 	{
 		libcerror_error_set(
 		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in mount handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path - path refers to a directory.",
 		 function );
 
-		result = -EIO;
+		result = -EISDIR;
 
 		goto on_error;
 	}
-	read_count = mount_handle_read_buffer(
-	              vshadowmount_mount_handle,
-	              input_index,
-	              (uint8_t *) buffer,
-	              size,
-	              &error );
-
 	if( read_count == -1 )
 	{
 		libcerror_error_set(
@@ -576,16 +1290,19 @@ int vshadowmount_fuse_readdir(
      off_t offset VSHADOWTOOLS_ATTRIBUTE_UNUSED,
      struct fuse_file_info *file_info VSHADOWTOOLS_ATTRIBUTE_UNUSED )
 {
-	char vshadowmount_fuse_path[ 9 ];
-
-	libcerror_error_t *error = NULL;
-	struct stat *stat_info   = NULL;
-	static char *function    = "vshadowmount_fuse_readdir";
-	size_t path_length       = 0;
-	int input_index          = 0;
-	int number_of_inputs     = 0;
-	int result               = 0;
-	int string_index         = 0;
+	char vshadowmount_fuse_path[ 16 ];
+
+	libcerror_error_t *error     = NULL;
+	mount_handle_t *mount_handle = NULL;
+	struct stat *stat_info       = NULL;
+	static char *function        = "vshadowmount_fuse_readdir";
+	size_t path_length           = 0;
+	int file_type                = 0;
+	int input_index              = 0;
+	int mount_handle_index       = 0;
+	int number_of_inputs         = 0;
+	int result                   = 0;
+	int string_index             = 0;
 
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( offset )
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( file_info )
@@ -606,19 +1323,53 @@ int vshadowmount_fuse_readdir(
 	path_length = narrow_string_length(
 	               path );
 
-	if( ( path_length != 1 )
-	 || ( path[ 0 ] != '/' ) )
+	if( ( path_length == 1 )
+	 && ( path[ 0 ] == '/' ) )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported path.",
-		 function );
+		/* If a single volume is mounted its stores are in the root directory
+		 */
+		if( vshadowmount_number_of_mount_handles == 1 )
+		{
+			mount_handle = vshadowmount_mount_handles[ 0 ];
+		}
+	}
+	else
+	{
+		result = vshadowmount_fuse_get_input_index_from_path(
+		          path,
+		          path_length,
+		          &mount_handle,
+		          &input_index,
+		          &file_type,
+		          &error );
 
-		result = -ENOENT;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine input index from path.",
+			 function );
 
-		goto on_error;
+			result = -EINVAL;
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( file_type != VSHADOWMOUNT_FILE_TYPE_VOLUME_DIRECTORY ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported path.",
+			 function );
+
+			result = -ENOENT;
+
+			goto on_error;
+		}
 	}
 	if( memory_copy(
 	     vshadowmount_fuse_path,
@@ -636,35 +1387,38 @@ int vshadowmount_fuse_readdir(
 
 		goto on_error;
 	}
-	if( mount_handle_get_number_of_inputs(
-	     vshadowmount_mount_handle,
-	     &number_of_inputs,
-	     &error ) != 1 )
+	if( mount_handle != NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of inputs.",
-		 function );
+		if( mount_handle_get_number_of_inputs(
+		     mount_handle,
+		     &number_of_inputs,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of inputs.",
+			 function );
 
-		result = -EIO;
+			result = -EIO;
 
-		goto on_error;
-	}
-	if( ( number_of_inputs < 0 )
-	 || ( number_of_inputs > 255 ) )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported number of inputs.",
-		 function );
+			goto on_error;
+		}
+		if( ( number_of_inputs < 0 )
+		 || ( number_of_inputs > 255 ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported number of inputs.",
+			 function );
 
-		result = -ENOENT;
+			result = -ENOENT;
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	stat_info = memory_allocate_structure(
 	             struct stat );
@@ -724,22 +1478,190 @@ int vshadowmount_fuse_readdir(
 
 		goto on_error;
 	}
+	if( path_length == 1 )
+	{
+		/* The statistics file is listed with a size of 0 since its content
+		 * is generated when it is opened
+		 */
+		if( memory_set(
+		     stat_info,
+		     0,
+		     sizeof( struct stat ) ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear stat info.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( vshadowmount_fuse_set_stat_info(
+		     stat_info,
+		     0,
+		     0,
+		     1,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set stat info.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( filler(
+		     buffer,
+		     &( vshadowmount_fuse_statistics_path[ 1 ] ),
+		     stat_info,
+		     0 ) == 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	if( mount_handle == NULL )
+	{
+		for( mount_handle_index = 0;
+		     mount_handle_index < vshadowmount_number_of_mount_handles;
+		     mount_handle_index++ )
+		{
+			if( vshadowmount_fuse_filldir(
+			     buffer,
+			     filler,
+			     vshadowmount_mount_handles[ mount_handle_index ]->name,
+			     vshadowmount_mount_handles[ mount_handle_index ]->name_size,
+			     stat_info,
+			     NULL,
+			     1,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set directory entry.",
+				 function );
+
+				result = -EIO;
+
+				goto on_error;
+			}
+		}
+	}
 	for( input_index = 1;
 	     input_index <= number_of_inputs;
 	     input_index++ )
 	{
 		string_index = vshadowmount_fuse_path_prefix_length;
 
-		if( input_index >= 100 )
+		if( input_index >= 100 )
+		{
+			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 100 );
+		}
+		if( input_index >= 10 )
+		{
+			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( ( input_index / 10 ) % 10 );
+		}
+		vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index % 10 );
+		vshadowmount_fuse_path[ string_index++ ] = 0;
+
+		if( vshadowmount_fuse_filldir(
+		     buffer,
+		     filler,
+		     &( vshadowmount_fuse_path[ 1 ] ),
+		     string_index - 1,
+		     stat_info,
+		     mount_handle,
+		     1,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		string_index--;
+
+		if( memory_copy(
+		     &( vshadowmount_fuse_path[ string_index ] ),
+		     vshadowmount_fuse_delta_suffix,
+		     vshadowmount_fuse_delta_suffix_length + 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fuse delta suffix.",
+			 function );
+
+			result = -errno;
+
+			goto on_error;
+		}
+		string_index += vshadowmount_fuse_delta_suffix_length + 1;
+
+		if( vshadowmount_fuse_filldir(
+		     buffer,
+		     filler,
+		     &( vshadowmount_fuse_path[ 1 ] ),
+		     string_index - 1,
+		     stat_info,
+		     mount_handle,
+		     1,
+		     &error ) != 1 )
 		{
-			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 100 );
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
 		}
-		if( input_index >= 10 )
+		string_index -= vshadowmount_fuse_delta_suffix_length + 1;
+
+		if( memory_copy(
+		     &( vshadowmount_fuse_path[ string_index ] ),
+		     vshadowmount_fuse_extents_suffix,
+		     vshadowmount_fuse_extents_suffix_length + 1 ) == NULL )
 		{
-			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 10 );
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fuse extents suffix.",
+			 function );
+
+			result = -errno;
+
+			goto on_error;
 		}
-		vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index % 10 );
-		vshadowmount_fuse_path[ string_index++ ] = 0;
+		string_index += vshadowmount_fuse_extents_suffix_length + 1;
 
 		if( vshadowmount_fuse_filldir(
 		     buffer,
@@ -747,7 +1669,7 @@ int vshadowmount_fuse_readdir(
 		     &( vshadowmount_fuse_path[ 1 ] ),
 		     string_index - 1,
 		     stat_info,
-		     vshadowmount_mount_handle,
+		     mount_handle,
 		     1,
 		     &error ) != 1 )
 		{
@@ -791,13 +1713,16 @@ int vshadowmount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
 {
-	libcerror_error_t *error = NULL;
-	static char *function    = "vshadowmount_fuse_getattr";
-	size64_t volume_size     = 0;
-	size_t path_length       = 0;
-	uint8_t use_mount_time   = 0;
-	int number_of_sub_items  = 0;
-	int result               = -ENOENT;
+	libcerror_error_t *error     = NULL;
+	mount_handle_t *mount_handle = NULL;
+	static char *function        = "vshadowmount_fuse_getattr";
+	size64_t volume_size         = 0;
+	size_t path_length           = 0;
+	uint8_t use_mount_time       = 0;
+	int file_type                = 0;
+	int input_index              = 0;
+	int number_of_sub_items      = 0;
+	int result                   = -ENOENT;
 
 	if( path == NULL )
 	{
@@ -853,16 +1778,54 @@ int vshadowmount_fuse_getattr(
 			result              = 0;
 		}
 	}
-	else if( ( path_length > vshadowmount_fuse_path_prefix_length )
-	      && ( path_length <= ( vshadowmount_fuse_path_prefix_length + 3 ) ) )
+	else
 	{
-		if( narrow_string_compare(
-		     path,
-		     vshadowmount_fuse_path_prefix,
-		     vshadowmount_fuse_path_prefix_length ) == 0 )
+		result = vshadowmount_fuse_get_input_index_from_path(
+		          path,
+		          path_length,
+		          &mount_handle,
+		          &input_index,
+		          &file_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine input index from path.",
+			 function );
+
+			result = -EINVAL;
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			result = -ENOENT;
+		}
+		else if( ( file_type == VSHADOWMOUNT_FILE_TYPE_STATISTICS )
+		      || ( file_type == VSHADOWMOUNT_FILE_TYPE_STORE_EXTENTS ) )
+		{
+			/* The size of the generated files is not known in advance
+			 */
+			use_mount_time = 1;
+			result         = 0;
+		}
+		else if( file_type == VSHADOWMOUNT_FILE_TYPE_VOLUME_DIRECTORY )
+		{
+			number_of_sub_items = 1;
+			use_mount_time      = 1;
+			result              = 0;
+		}
+		else
 		{
+			/* The delta has the same size as the store data, the ranges
+			 * that do not differ from the current volume are zero filled
+			 */
 			if( mount_handle_get_size(
-			     vshadowmount_mount_handle,
+			     mount_handle,
 			     &volume_size,
 			     &error ) != 1 )
 			{
@@ -924,21 +1887,17 @@ void vshadowmount_fuse_destroy(
 
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( private_data )
 
-	if( vshadowmount_mount_handle != NULL )
+	if( vshadowmount_free_mount_handles(
+	     &error ) != 1 )
 	{
-		if( mount_handle_free(
-		     &vshadowmount_mount_handle,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free mount handle.",
-			 function );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free mount handles.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
 	return;
 
@@ -1291,7 +2250,7 @@ int __stdcall vshadowmount_dokan_ReadFile(
 	input_index -= 1;
 
 	if( mount_handle_seek_offset(
-	     vshadowmount_mount_handle,
+	     vshadowmount_mount_handles[ 0 ],
 	     input_index,
 	     (off64_t) offset,
 	     SEEK_SET,
@@ -1309,7 +2268,7 @@ int __stdcall vshadowmount_dokan_ReadFile(
 		goto on_error;
 	}
 	read_count = mount_handle_read_buffer(
-		      vshadowmount_mount_handle,
+		      vshadowmount_mount_handles[ 0 ],
 		      input_index,
 		      (uint8_t *) buffer,
 		      (size_t) number_of_bytes_to_read,
@@ -1618,7 +2577,7 @@ int __stdcall vshadowmount_dokan_FindFiles(
 		goto on_error;
 	}
 	if( mount_handle_get_number_of_inputs(
-	     vshadowmount_mount_handle,
+	     vshadowmount_mount_handles[ 0 ],
 	     &number_of_inputs,
 	     &error ) != 1 )
 	{
@@ -1712,7 +2671,7 @@ int __stdcall vshadowmount_dokan_FindFiles(
 		     &( vshadowmount_dokan_path[ 1 ] ),
 		     string_index - 1,
 		     &find_data,
-		     vshadowmount_mount_handle,
+		     vshadowmount_mount_handles[ 0 ],
 		     1,
 		     &error ) != 1 )
 		{
@@ -1888,7 +2847,7 @@ int __stdcall vshadowmount_dokan_GetFileInformation(
 
 /* TODO get creation time */
 		if( mount_handle_get_size(
-		     vshadowmount_mount_handle,
+		     vshadowmount_mount_handles[ 0 ],
 		     &volume_size,
 		     &error ) != 1 )
 		{
@@ -2052,12 +3011,22 @@ int main( int argc, char * const argv[] )
 #endif
 {
 	libvshadow_error_t *error                    = NULL;
+	system_character_t **option_volume_offsets   = NULL;
 	system_character_t *mount_point              = NULL;
+	system_character_t *option_cache_size        = NULL;
 	system_character_t *option_extended_options  = NULL;
-	system_character_t *option_volume_offset     = NULL;
+	system_character_t *option_trace_file        = NULL;
 	system_character_t *source                   = NULL;
 	char *program                                = "vshadowmount";
+	size_t name_length                           = 0;
+	size_t name_start                            = 0;
+	size_t source_length                         = 0;
 	system_integer_t option                      = 0;
+	uint64_t cache_size                          = 64;
+	int mount_handle_index                       = 0;
+	int name_index                               = 0;
+	int number_of_sources                        = 0;
+	int number_of_volume_offsets                 = 0;
 	int result                                   = 0;
 	int verbose                                  = 0;
 
@@ -2103,10 +3072,23 @@ int main( int argc, char * const argv[] )
 	 stdout,
 	 program );
 
+	/* Every -o option corresponds with a source hence there cannot be more than argc
+	 */
+	option_volume_offsets = (system_character_t **) memory_allocate(
+	                                                 sizeof( system_character_t * ) * argc );
+
+	if( option_volume_offsets == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create volume offsets.\n" );
+
+		goto on_error;
+	}
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "ho:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hm:o:T:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2120,16 +3102,29 @@ int main( int argc, char * const argv[] )
 				usage_fprint(
 				 stdout );
 
-				return( EXIT_FAILURE );
+				goto on_error;
 
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
+				memory_free(
+				 option_volume_offsets );
+
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'm':
+				option_cache_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
-				option_volume_offset = optarg;
+				option_volume_offsets[ number_of_volume_offsets++ ] = optarg;
+
+				break;
+
+			case (system_integer_t) 'T':
+				option_trace_file = optarg;
 
 				break;
 
@@ -2142,6 +3137,9 @@ int main( int argc, char * const argv[] )
 				vshadowoutput_copyright_fprint(
 				 stdout );
 
+				memory_free(
+				 option_volume_offsets );
+
 				return( EXIT_SUCCESS );
 
 			case (system_integer_t) 'X':
@@ -2159,11 +3157,9 @@ int main( int argc, char * const argv[] )
 		usage_fprint(
 		 stdout );
 
-		return( EXIT_FAILURE );
+		goto on_error;
 	}
-	source = argv[ optind++ ];
-
-	if( optind == argc )
+	if( ( optind + 1 ) == argc )
 	{
 		fprintf(
 		 stderr,
@@ -2172,9 +3168,40 @@ int main( int argc, char * const argv[] )
 		usage_fprint(
 		 stdout );
 
-		return( EXIT_FAILURE );
+		goto on_error;
+	}
+	/* The last argument is the mount point, the preceding arguments are sources
+	 */
+	number_of_sources = argc - optind - 1;
+	mount_point       = argv[ argc - 1 ];
+
+	if( number_of_volume_offsets > number_of_sources )
+	{
+		fprintf(
+		 stderr,
+		 "More volume offsets than sources specified.\n" );
+
+		goto on_error;
+	}
+	if( ( option_trace_file != NULL )
+	 && ( number_of_sources > 1 ) )
+	{
+		fprintf(
+		 stderr,
+		 "A read trace is only supported with a single source.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBDOKAN )
+	if( number_of_sources > 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Multiple sources are currently not supported by dokan.\n" );
+
+		goto on_error;
 	}
-	mount_point = argv[ optind ];
+#endif
 
 	libcnotify_verbose_set(
 	 verbose );
@@ -2184,21 +3211,15 @@ int main( int argc, char * const argv[] )
 	libvshadow_notify_set_verbose(
 	 verbose );
 
-	if( mount_handle_initialize(
-	     &vshadowmount_mount_handle,
-	     &error ) != 1 )
+	if( option_cache_size != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to initialize mount handle.\n" );
+		source_length = system_string_length(
+		                 option_cache_size );
 
-		goto on_error;
-	}
-	if( option_volume_offset != NULL )
-	{
-		if( mount_handle_set_volume_offset(
-		     vshadowmount_mount_handle,
-		     option_volume_offset,
+		if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+		     option_cache_size,
+		     source_length + 1,
+		     &cache_size,
 		     &error ) != 1 )
 		{
 			libcnotify_print_error_backtrace(
@@ -2206,34 +3227,242 @@ int main( int argc, char * const argv[] )
 			libcerror_error_free(
 			 &error );
 
+			cache_size = 64;
+
+			fprintf(
+			 stderr,
+			 "Unsupported cache size defaulting to: %" PRIu64 " MiB.\n",
+			 cache_size );
+		}
+		else if( cache_size > (uint64_t) ( 1024 * 1024 ) )
+		{
+			cache_size = 64;
+
 			fprintf(
 			 stderr,
-			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
-			 vshadowmount_mount_handle->volume_offset );
+			 "Unsupported cache size defaulting to: %" PRIu64 " MiB.\n",
+			 cache_size );
 		}
 	}
-	result = mount_handle_open_input(
-	          vshadowmount_mount_handle,
-	          source,
-	          &error );
+	/* A single read cache is shared by all the sources to bound the memory
+	 * used by the cache regardless of the number of sources
+	 */
+	if( cache_size > 0 )
+	{
+		if( block_cache_initialize(
+		     &vshadowmount_block_cache,
+		     BLOCK_CACHE_DEFAULT_BLOCK_SIZE,
+		     (size64_t) cache_size * 1024 * 1024,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize read cache.\n" );
 
-	if( result == -1 )
+			goto on_error;
+		}
+	}
+	if( option_trace_file != NULL )
+	{
+		if( read_trace_initialize(
+		     &vshadowmount_read_trace,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize read trace.\n" );
+
+			goto on_error;
+		}
+		if( read_trace_open_write(
+		     vshadowmount_read_trace,
+		     option_trace_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open read trace: %" PRIs_SYSTEM ".\n",
+			 option_trace_file );
+
+			goto on_error;
+		}
+	}
+	vshadowmount_mount_handles = (mount_handle_t **) memory_allocate(
+	                                                  sizeof( mount_handle_t * ) * number_of_sources );
+
+	if( vshadowmount_mount_handles == NULL )
 	{
 		fprintf(
 		 stderr,
-		 "Unable to open: %" PRIs_SYSTEM ".\n",
-		 source );
+		 "Unable to create mount handles.\n" );
 
 		goto on_error;
 	}
-	else if( result == 0 )
+	if( memory_set(
+	     vshadowmount_mount_handles,
+	     0,
+	     sizeof( mount_handle_t * ) * number_of_sources ) == NULL )
 	{
 		fprintf(
 		 stderr,
-		 "No Volume Shadow Snapshots found.\n" );
+		 "Unable to clear mount handles.\n" );
 
 		goto on_error;
 	}
+	vshadowmount_number_of_mount_handles = number_of_sources;
+
+	for( mount_handle_index = 0;
+	     mount_handle_index < number_of_sources;
+	     mount_handle_index++ )
+	{
+		source = argv[ optind + mount_handle_index ];
+
+		if( mount_handle_initialize(
+		     &( vshadowmount_mount_handles[ mount_handle_index ] ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize mount handle.\n" );
+
+			goto on_error;
+		}
+		if( mount_handle_index < number_of_volume_offsets )
+		{
+			if( mount_handle_set_volume_offset(
+			     vshadowmount_mount_handles[ mount_handle_index ],
+			     option_volume_offsets[ mount_handle_index ],
+			     &error ) != 1 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+
+				fprintf(
+				 stderr,
+				 "Unsupported volume offset of: %" PRIs_SYSTEM " defaulting to: %" PRIi64 ".\n",
+				 source,
+				 vshadowmount_mount_handles[ mount_handle_index ]->volume_offset );
+			}
+		}
+		if( mount_handle_set_block_cache(
+		     vshadowmount_mount_handles[ mount_handle_index ],
+		     vshadowmount_block_cache,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read cache.\n" );
+
+			goto on_error;
+		}
+		if( mount_handle_set_read_trace(
+		     vshadowmount_mount_handles[ mount_handle_index ],
+		     vshadowmount_read_trace,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read trace.\n" );
+
+			goto on_error;
+		}
+		/* The name of the sub directory is the last path segment of the source
+		 */
+		source_length = system_string_length(
+		                 source );
+
+		while( ( source_length > 1 )
+		    && ( ( source[ source_length - 1 ] == (system_character_t) '/' )
+		     ||  ( source[ source_length - 1 ] == (system_character_t) '\\' ) ) )
+		{
+			source_length--;
+		}
+		name_start = source_length;
+
+		while( ( name_start > 0 )
+		    && ( source[ name_start - 1 ] != (system_character_t) '/' )
+		    && ( source[ name_start - 1 ] != (system_character_t) '\\' ) )
+		{
+			name_start--;
+		}
+		name_length = source_length - name_start;
+
+		if( ( name_length == 0 )
+		 || ( source[ name_start ] == (system_character_t) '.' ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported source name: %" PRIs_SYSTEM ".\n",
+			 source );
+
+			goto on_error;
+		}
+		for( name_index = 0;
+		     name_index < mount_handle_index;
+		     name_index++ )
+		{
+			if( ( vshadowmount_mount_handles[ name_index ]->name_size == ( name_length + 1 ) )
+			 && ( system_string_compare(
+			       vshadowmount_mount_handles[ name_index ]->name,
+			       &( source[ name_start ] ),
+			       name_length ) == 0 ) )
+			{
+				break;
+			}
+		}
+		if( name_index < mount_handle_index )
+		{
+			fprintf(
+			 stderr,
+			 "Multiple sources with the same name: %" PRIs_SYSTEM ".\n",
+			 vshadowmount_mount_handles[ name_index ]->name );
+
+			goto on_error;
+		}
+		if( mount_handle_set_name(
+		     vshadowmount_mount_handles[ mount_handle_index ],
+		     &( source[ name_start ] ),
+		     name_length,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set name of: %" PRIs_SYSTEM ".\n",
+			 source );
+
+			goto on_error;
+		}
+		result = mount_handle_open_input(
+		          vshadowmount_mount_handles[ mount_handle_index ],
+		          source,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open: %" PRIs_SYSTEM ".\n",
+			 source );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "No Volume Shadow Snapshots found in: %" PRIs_SYSTEM ".\n",
+			 source );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 option_volume_offsets );
+
+	option_volume_offsets = NULL;
+
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	if( memory_set(
 	     &vshadowmount_fuse_operations,
@@ -2282,6 +3511,7 @@ int main( int argc, char * const argv[] )
 		}
 	}
 	vshadowmount_fuse_operations.open    = &vshadowmount_fuse_open;
+	vshadowmount_fuse_operations.release = &vshadowmount_fuse_release;
 	vshadowmount_fuse_operations.read    = &vshadowmount_fuse_read;
 	vshadowmount_fuse_operations.readdir = &vshadowmount_fuse_readdir;
 	vshadowmount_fuse_operations.getattr = &vshadowmount_fuse_getattr;
@@ -2304,7 +3534,7 @@ int main( int argc, char * const argv[] )
 	                            &vshadowmount_fuse_arguments,
 	                            &vshadowmount_fuse_operations,
 	                            sizeof( struct fuse_operations ),
-	                            vshadowmount_mount_handle );
+	                            NULL );
 	
 	if( vshadowmount_fuse_handle == NULL )
 	{
@@ -2326,8 +3556,16 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The fuse worker threads are shared by all the sources, reads of the same
+	 * source are serialized by its mount handle
+	 */
+	result = fuse_loop_mt(
+	          vshadowmount_fuse_handle );
+#else
 	result = fuse_loop(
 	          vshadowmount_fuse_handle );
+#endif
 
 	if( result != 0 )
 	{
@@ -2487,11 +3725,13 @@ on_error:
 	fuse_opt_free_args(
 	 &vshadowmount_fuse_arguments );
 #endif
-	if( vshadowmount_mount_handle != NULL )
+	vshadowmount_free_mount_handles(
+	 NULL );
+
+	if( option_volume_offsets != NULL )
 	{
-		mount_handle_free(
-		 &vshadowmount_mount_handle,
-		 NULL );
+		memory_free(
+		 option_volume_offsets );
 	}
 	return( EXIT_FAILURE );
 }
@@ -0,0 +1,453 @@
+/*
+ * Replays a read trace against a Windows NT Volume Shadow Snapshot (VSS) volume
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "replay_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+replay_handle_t *vshadowreplay_replay_handle = NULL;
+int vshadowreplay_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowreplay to replay a read trace recorded by vshadowmount against\n"
+	                 "the stores of a Windows NT Volume Shadow Snapshot (VSS) volume\n\n" );
+
+	fprintf( stream, "Usage: vshadowreplay [ -f format ] [ -m ] [ -o offset ] [ -hvV ]\n"
+	                 "                     trace_file source\n\n" );
+
+	fprintf( stream, "\ttrace_file: the read trace file, see vshadowmount -T\n" );
+	fprintf( stream, "\tsource:     the source file or device\n\n" );
+
+	fprintf( stream, "\t-f:         specify the output format, options: json, text (default)\n" );
+	fprintf( stream, "\t-h:         shows this help\n" );
+	fprintf( stream, "\t-m:         replay the reads as fast as possible instead of at the\n"
+	                 "\t            speed they were recorded\n" );
+	fprintf( stream, "\t-o:         specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-v:         verbose output to stderr\n" );
+	fprintf( stream, "\t-V:         print version\n" );
+}
+
+/* Signal handler for vshadowreplay
+ */
+void vshadowreplay_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowreplay_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowreplay_abort = 1;
+
+	if( vshadowreplay_replay_handle != NULL )
+	{
+		if( replay_handle_signal_abort(
+		     vshadowreplay_replay_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal replay handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvshadow_error_t *error                 = NULL;
+	system_character_t *option_output_format  = NULL;
+	system_character_t *option_volume_offset  = NULL;
+	system_character_t *source                = NULL;
+	system_character_t *trace_file            = NULL;
+	char *program                             = "vshadowreplay";
+	system_integer_t option                   = 0;
+	uint8_t maximum_speed                     = 0;
+	int result                                = 0;
+	int verbose                               = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "f:hmo:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'f':
+				option_output_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				maximum_speed = 1;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowoutput_version_fprint(
+				 stdout,
+				 program );
+
+				vshadowoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing trace file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	trace_file = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( replay_handle_initialize(
+	     &vshadowreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize replay handle.\n" );
+
+		goto on_error;
+	}
+	if( option_output_format != NULL )
+	{
+		if( replay_handle_set_output_format(
+		     vshadowreplay_replay_handle,
+		     option_output_format,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported output format defaulting to: text.\n" );
+		}
+	}
+	/* The version is not printed with JSON output so that the output can be parsed as-is
+	 */
+	if( vshadowreplay_replay_handle->output_format != REPLAY_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		vshadowoutput_version_fprint(
+		 stdout,
+		 program );
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( replay_handle_set_volume_offset(
+		     vshadowreplay_replay_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowreplay_replay_handle->volume_offset );
+		}
+	}
+	if( replay_handle_set_maximum_speed(
+	     vshadowreplay_replay_handle,
+	     maximum_speed,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum speed.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_read_trace(
+	     vshadowreplay_replay_handle,
+	     trace_file,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read trace file: %" PRIs_SYSTEM ".\n",
+		 trace_file );
+
+		goto on_error;
+	}
+	result = replay_handle_open_input(
+	          vshadowreplay_replay_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowreplay_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( replay_handle_run(
+	     vshadowreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to replay trace.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowreplay_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Replay aborted.\n" );
+	}
+	if( replay_handle_close_input(
+	     vshadowreplay_replay_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close replay handle.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_free(
+	     &vshadowreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free replay handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowreplay_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowreplay_replay_handle != NULL )
+	{
+		replay_handle_free(
+		 &vshadowreplay_replay_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,368 @@
+/*
+ * Zero-copy functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* copy_file_range is only declared by glibc when _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_IOCTL_H )
+#include <sys/ioctl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_unused.h"
+#include "zero_copy.h"
+
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+
+/* Opens a file descriptor
+ * The file must exist
+ * Returns 1 if successful or -1 on error
+ */
+int zero_copy_open(
+     const char *filename,
+     int *descriptor,
+     uint8_t write_access,
+     libcerror_error_t **error )
+{
+	static char *function = "zero_copy_open";
+	int flags             = O_RDONLY;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_access != 0 )
+	{
+		flags = O_WRONLY;
+	}
+#if defined( O_CLOEXEC )
+	flags |= O_CLOEXEC;
+#endif
+	*descriptor = open(
+	               filename,
+	               flags );
+
+	if( *descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes a file descriptor
+ * Returns 0 if successful or -1 on error
+ */
+int zero_copy_close(
+     int *descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "zero_copy_close";
+
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *descriptor == -1 )
+	{
+		return( 0 );
+	}
+	if( close(
+	     *descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		*descriptor = -1;
+
+		return( -1 );
+	}
+	*descriptor = -1;
+
+	return( 0 );
+}
+
+/* Clones a range of the source file into the destination file
+ * The cloned range shares its storage with the source, which requires
+ * both files to be on the same file system, such as btrfs or XFS, and
+ * the offsets and size to be aligned with the block size of the file system
+ * Returns 1 if successful, 0 if the range cannot be cloned or -1 on error
+ */
+int zero_copy_clone_range(
+     int source_descriptor,
+     off64_t source_offset,
+     int destination_descriptor,
+     off64_t destination_offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_SYS_IOCTL_H ) && defined( FICLONERANGE )
+	struct file_clone_range clone_range;
+#endif
+
+	static char *function = "zero_copy_clone_range";
+
+	if( source_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid source offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid destination offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_IOCTL_H ) && defined( FICLONERANGE )
+	clone_range.src_fd      = (int64_t) source_descriptor;
+	clone_range.src_offset  = (uint64_t) source_offset;
+	clone_range.src_length  = (uint64_t) size;
+	clone_range.dest_offset = (uint64_t) destination_offset;
+
+	if( ioctl(
+	     destination_descriptor,
+	     FICLONERANGE,
+	     &clone_range ) == 0 )
+	{
+		return( 1 );
+	}
+	/* The file system does not support cloning, the files are on different
+	 * file systems or the range is not aligned with the file system block size
+	 */
+	if( ( errno == EINVAL )
+	 || ( errno == ENOSYS )
+	 || ( errno == ENOTTY )
+	 || ( errno == EOPNOTSUPP )
+	 || ( errno == EXDEV ) )
+	{
+		return( 0 );
+	}
+	libcerror_system_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_WRITE_FAILED,
+	 errno,
+	 "%s: unable to clone %" PRIu64 " bytes at offset: %" PRIi64 " to offset: %" PRIi64 ".",
+	 function,
+	 size,
+	 source_offset,
+	 destination_offset );
+
+	return( -1 );
+#else
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( source_descriptor )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( destination_descriptor )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( size )
+
+	return( 0 );
+#endif
+}
+
+/* Copies a range of the source file into the destination file within the kernel
+ * File systems that support it, such as btrfs, XFS and NFS, can share the
+ * storage of the range or copy it without transferring the data
+ * Returns 1 if successful, 0 if the range cannot be copied or -1 on error
+ */
+int zero_copy_copy_range(
+     int source_descriptor,
+     off64_t source_offset,
+     int destination_descriptor,
+     off64_t destination_offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "zero_copy_copy_range";
+
+#if defined( HAVE_COPY_FILE_RANGE )
+	loff_t input_offset   = 0;
+	loff_t output_offset  = 0;
+	ssize_t copy_count    = 0;
+	size_t copy_size      = 0;
+	size64_t total_size   = 0;
+#endif
+
+	if( source_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid source offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid destination offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_COPY_FILE_RANGE )
+	input_offset  = (loff_t) source_offset;
+	output_offset = (loff_t) destination_offset;
+
+	while( total_size < size )
+	{
+		copy_size = SSIZE_MAX;
+
+		if( (size64_t) copy_size > ( size - total_size ) )
+		{
+			copy_size = (size_t) ( size - total_size );
+		}
+		copy_count = copy_file_range(
+		              source_descriptor,
+		              &input_offset,
+		              destination_descriptor,
+		              &output_offset,
+		              copy_size,
+		              0 );
+
+		if( copy_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* The kernel does not support the system call, the files are on
+			 * different file systems or the source is not a regular file,
+			 * such as a device. Only the first copy is expected to fail
+			 * for these reasons
+			 */
+			if( ( total_size == 0 )
+			 && ( ( errno == EINVAL )
+			  ||  ( errno == ENOSYS )
+			  ||  ( errno == EOPNOTSUPP )
+			  ||  ( errno == EXDEV ) ) )
+			{
+				return( 0 );
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to copy %" PRIzu " bytes at offset: %" PRIi64 " to offset: %" PRIi64 ".",
+			 function,
+			 copy_size,
+			 (int64_t) input_offset,
+			 (int64_t) output_offset );
+
+			return( -1 );
+		}
+		else if( copy_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of source file at offset: %" PRIi64 ".",
+			 function,
+			 (int64_t) input_offset );
+
+			return( -1 );
+		}
+		total_size += (size64_t) copy_count;
+	}
+	return( 1 );
+#else
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( source_descriptor )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( destination_descriptor )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( size )
+
+	return( 0 );
+#endif
+}
+
+#endif /* defined( HAVE_ZERO_COPY_SUPPORT ) */
+
@@ -0,0 +1,81 @@
+/*
+ * Zero-copy functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _ZERO_COPY_H )
+#define _ZERO_COPY_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LINUX_FS_H )
+#include <linux/fs.h>
+#endif
+
+#include "vshadowtools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && ( defined( HAVE_COPY_FILE_RANGE ) || ( defined( HAVE_SYS_IOCTL_H ) && defined( FICLONERANGE ) ) )
+#define HAVE_ZERO_COPY_SUPPORT
+#endif
+
+/* The alignment of the offsets and size of a range that can be cloned
+ */
+#define ZERO_COPY_CLONE_ALIGNMENT	4096
+
+#if defined( HAVE_ZERO_COPY_SUPPORT )
+
+int zero_copy_open(
+     const char *filename,
+     int *descriptor,
+     uint8_t write_access,
+     libcerror_error_t **error );
+
+int zero_copy_close(
+     int *descriptor,
+     libcerror_error_t **error );
+
+int zero_copy_clone_range(
+     int source_descriptor,
+     off64_t source_offset,
+     int destination_descriptor,
+     off64_t destination_offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int zero_copy_copy_range(
+     int source_descriptor,
+     off64_t source_offset,
+     int destination_descriptor,
+     off64_t destination_offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_ZERO_COPY_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _ZERO_COPY_H ) */
+